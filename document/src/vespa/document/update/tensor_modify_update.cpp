@@ -153,6 +153,12 @@ TensorModifyUpdate::applyTo(const Value &tensor) const
     return apply_to(tensor, FastValueBuilderFactory::get());
 }
 
+TensorModifyUpdate::JoinFunction
+TensorModifyUpdate::get_join_function() const
+{
+    return getJoinFunction(_operation);
+}
+
 std::unique_ptr<Value>
 TensorModifyUpdate::apply_to(const Value &old_tensor,
                              const ValueBuilderFactory &factory) const
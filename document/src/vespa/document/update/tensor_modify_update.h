@@ -45,6 +45,9 @@ public:
 
     bool operator==(const ValueUpdate &other) const override;
     Operation getOperation() const { return _operation; }
+    using JoinFunction = double (*)(double, double);
+    // Returns the function combining an old cell value with the corresponding cell value of the operand.
+    JoinFunction get_join_function() const;
     const TensorFieldValue &getTensor() const { return *_tensor; }
     const std::optional<double>& get_default_cell_value() const { return _default_cell_value; }
     void checkCompatibility(const Field &field) const override;
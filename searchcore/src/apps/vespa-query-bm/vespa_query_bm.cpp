@@ -0,0 +1,457 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/config/documenttypes_config_fwd.h>
+#include <vespa/document/repo/configbuilder.h>
+#include <vespa/document/repo/document_type_repo_factory.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/datatype/datatype.h>
+#include <vespa/vespalib/util/signalhandler.h>
+#include <vespa/searchcore/bmcluster/avg_sampler.h>
+#include <vespa/searchcore/bmcluster/bm_cluster.h>
+#include <vespa/searchcore/bmcluster/bm_cluster_params.h>
+#include <vespa/searchcore/bmcluster/bm_feed.h>
+#include <vespa/searchcore/bmcluster/bm_feeder.h>
+#include <vespa/searchcore/bmcluster/bm_feed_params.h>
+#include <vespa/searchcore/bmcluster/bm_node_stats_reporter.h>
+#include <vespa/searchcore/bmcluster/bm_querier.h>
+#include <vespa/searchcore/bmcluster/bm_queries.h>
+#include <vespa/searchcore/bmcluster/bm_query_params.h>
+#include <vespa/searchcore/bmcluster/bm_range.h>
+#include <vespa/searchcore/bmcluster/bucket_selector.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <getopt.h>
+#include <filesystem>
+#include <iostream>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vespa-query-bm");
+
+using namespace std::chrono_literals;
+
+using document::DocumentTypeRepo;
+using search::bmcluster::AvgSampler;
+using search::bmcluster::BmCluster;
+using search::bmcluster::BmClusterParams;
+using search::bmcluster::BmFeed;
+using search::bmcluster::BmFeedParams;
+using search::bmcluster::BmFeeder;
+using search::bmcluster::BmNodeStatsReporter;
+using search::bmcluster::BmQuerier;
+using search::bmcluster::BmQueries;
+using search::bmcluster::BmQueryParams;
+using search::bmcluster::BmRange;
+using search::bmcluster::BucketSelector;
+using search::bmcluster::IBmFeedHandler;
+using search::index::DummyFileHeaderContext;
+using vespalib::makeLambdaTask;
+
+namespace {
+
+std::string base_dir = "testdb";
+constexpr int base_port = 9017;
+
+std::shared_ptr<DocumenttypesConfig> make_document_types() {
+    using Struct = document::config_builder::Struct;
+    using DataType = document::DataType;
+    document::config_builder::DocumenttypesConfigBuilderHelper builder;
+    builder.document(42, "test", Struct("test.header").addField("int", DataType::T_INT), Struct("test.body"));
+    return std::make_shared<DocumenttypesConfig>(builder.config());
+}
+
+class BMParams : public BmClusterParams,
+                 public BmFeedParams,
+                 public BmQueryParams
+{
+    bool _feed_while_querying;
+public:
+    BMParams()
+        : BmClusterParams(),
+          BmFeedParams(),
+          BmQueryParams(),
+          _feed_while_querying(false)
+    {
+    }
+    bool get_feed_while_querying() const { return _feed_while_querying; }
+    void set_feed_while_querying(bool value) { _feed_while_querying = value; }
+    bool check() const;
+};
+
+bool
+BMParams::check() const
+{
+    if (!BmClusterParams::check()) {
+        return false;
+    }
+    if (!BmFeedParams::check()) {
+        return false;
+    }
+    if (!BmQueryParams::check()) {
+        return false;
+    }
+    if (get_groups() > 0 && !needs_distributor()) {
+        std::cerr << "grouped distribution only allowed when using distributor" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Feeds document updates in the background until destroyed.
+ */
+class BackgroundFeed {
+    vespalib::ThreadStackExecutor           _top_executor;
+    vespalib::ThreadStackExecutor           _executor;
+    BmFeeder                                _feeder;
+    const BMParams&                         _params;
+    int64_t&                                _time_bias;
+    const std::vector<vespalib::nbostream>& _feed;
+
+    void run();
+public:
+    BackgroundFeed(const BMParams& params, std::shared_ptr<const DocumentTypeRepo> repo, IBmFeedHandler& feed_handler, int64_t& time_bias, const std::vector<vespalib::nbostream>& feed);
+    ~BackgroundFeed();
+};
+
+BackgroundFeed::BackgroundFeed(const BMParams& params, std::shared_ptr<const DocumentTypeRepo> repo, IBmFeedHandler& feed_handler, int64_t& time_bias, const std::vector<vespalib::nbostream>& feed)
+    : _top_executor(1),
+      _executor(params.get_client_threads()),
+      _feeder(repo, feed_handler, _executor),
+      _params(params),
+      _time_bias(time_bias),
+      _feed(feed)
+{
+    _top_executor.execute(makeLambdaTask([this]() { run(); }));
+}
+
+BackgroundFeed::~BackgroundFeed()
+{
+    _feeder.stop();
+    _top_executor.sync();
+    _top_executor.shutdown();
+}
+
+void
+BackgroundFeed::run()
+{
+    _feeder.run_feed_tasks_loop(_time_bias, _feed, _params, "update");
+}
+
+}
+
+class Benchmark {
+    BMParams                                   _params;
+    std::shared_ptr<const DocumenttypesConfig> _document_types;
+    std::shared_ptr<const DocumentTypeRepo>    _repo;
+    std::unique_ptr<BmCluster>                 _cluster;
+    BmFeed                                     _feed;
+    BmQueries                                  _queries;
+
+    void feed_documents(vespalib::ThreadStackExecutor& executor, int64_t& time_bias);
+    void benchmark_queries(vespalib::ThreadStackExecutor& executor);
+public:
+    explicit Benchmark(const BMParams& params);
+    ~Benchmark();
+    bool load_queries();
+    void run();
+};
+
+Benchmark::Benchmark(const BMParams& params)
+    : _params(params),
+      _document_types(make_document_types()),
+      _repo(document::DocumentTypeRepoFactory::make(*_document_types)),
+      _cluster(std::make_unique<BmCluster>(base_dir, base_port, _params, _document_types, _repo)),
+      _feed(_repo),
+      _queries()
+{
+    _cluster->make_nodes();
+}
+
+Benchmark::~Benchmark() = default;
+
+bool
+Benchmark::load_queries()
+{
+    if (_params.get_query_file().empty()) {
+        _queries.generate(_params.get_queries(), _params.get_documents());
+        return true;
+    }
+    return _queries.load(_params.get_query_file());
+}
+
+void
+Benchmark::feed_documents(vespalib::ThreadStackExecutor& executor, int64_t& time_bias)
+{
+    BmFeeder feeder(_repo, *_cluster->get_feed_handler(), executor);
+    auto put_feed = _feed.make_feed(executor, _params, [this](BmRange range, BucketSelector bucket_selector) { return _feed.make_put_feed(range, bucket_selector); }, _feed.num_buckets(), "put");
+    AvgSampler sampler;
+    LOG(info, "--------------------------------");
+    LOG(info, "putAsync: %u small documents", _params.get_documents());
+    feeder.run_feed_tasks(0, time_bias, put_feed, _params, sampler, "put");
+    LOG(info, "putAsync: AVG put/s: %8.2f", sampler.avg());
+}
+
+void
+Benchmark::benchmark_queries(vespalib::ThreadStackExecutor& executor)
+{
+    BmQuerier querier(*_cluster, _queries, _params, executor);
+    LOG(info, "--------------------------------");
+    LOG(info, "query: %zu queries, passes=%u, threads=%u, rank-profile=%s, docsum=%s",
+        _queries.size(), _params.get_query_passes(), _params.get_query_threads(),
+        _params.get_rank_profile().c_str(), (_params.get_docsum() ? "true" : "false"));
+    for (uint32_t pass = 0; pass < _params.get_query_passes(); ++pass) {
+        querier.run_query_pass(pass);
+    }
+}
+
+void
+Benchmark::run()
+{
+    _cluster->start(_feed);
+    if (!_params.needs_distributor()) {
+        _cluster->activate_buckets(_feed);
+    }
+    vespalib::ThreadStackExecutor executor(std::max(_params.get_client_threads(), _params.get_query_threads()));
+    BmNodeStatsReporter reporter(*_cluster, false);
+    reporter.start(500ms);
+    int64_t time_bias = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch() - 24h).count();
+    LOG(info, "Feed handler is '%s'", _cluster->get_feed_handler()->get_name().c_str());
+    feed_documents(executor, time_bias);
+    reporter.report_now();
+    if (_params.get_feed_while_querying()) {
+        auto update_feed = _feed.make_feed(executor, _params, [this](BmRange range, BucketSelector bucket_selector) { return _feed.make_update_feed(range, bucket_selector); }, _feed.num_buckets(), "update");
+        BackgroundFeed background_feed(_params, _repo, *_cluster->get_feed_handler(), time_bias, update_feed);
+        benchmark_queries(executor);
+    } else {
+        benchmark_queries(executor);
+    }
+    reporter.report_now();
+    reporter.stop();
+    LOG(info, "--------------------------------");
+
+    _cluster->stop();
+}
+
+class App
+{
+    BMParams _bm_params;
+public:
+    App();
+    ~App();
+    void usage();
+    bool get_options(int argc, char **argv);
+    int main(int argc, char **argv);
+};
+
+App::App()
+    : _bm_params()
+{
+}
+
+App::~App() = default;
+
+void
+App::usage()
+{
+    std::cerr <<
+        "vespa-query-bm version 0.0\n"
+        "\n"
+        "USAGE:\n";
+    std::cerr <<
+        "vespa-query-bm\n"
+        "[--bucket-db-stripe-bits bits]\n"
+        "[--client-threads threads]\n"
+        "[--distributor-stripes stripes]\n"
+        "[--documents documents]\n"
+        "[--enable-distributor]\n"
+        "[--enable-service-layer]\n"
+        "[--feed-while-querying]\n"
+        "[--hits hits]\n"
+        "[--indexing-sequencer [latency,throughput,adaptive]]\n"
+        "[--max-pending max-pending]\n"
+        "[--no-docsum]\n"
+        "[--queries queries]\n"
+        "[--query-file query-file]\n"
+        "[--query-passes query-passes]\n"
+        "[--query-threads threads]\n"
+        "[--rank-profile [default,second_phase]]\n"
+        "[--response-threads threads]\n"
+        "[--rpc-network-threads threads]\n"
+        "[--rpc-targets-per-node targets]\n"
+        "[--use-async-message-handling]\n"
+        "[--use-document-api]\n"
+        "[--use-message-bus]\n"
+        "[--use-storage-chain]\n"
+        "\n"
+        "Each line in the query file is either a base64 encoded query stack\n"
+        "dump prefixed by 'base64:' or a list of field:term items that must\n"
+        "all match, e.g. 'int:42' or 'int:[10;20]'." << std::endl;
+}
+
+bool
+App::get_options(int argc, char **argv)
+{
+    int c;
+    int long_opt_index = 0;
+    static struct option long_opts[] = {
+        { "bucket-db-stripe-bits", 1, nullptr, 0 },
+        { "client-threads", 1, nullptr, 0 },
+        { "distributor-stripes", 1, nullptr, 0 },
+        { "documents", 1, nullptr, 0 },
+        { "enable-distributor", 0, nullptr, 0 },
+        { "enable-service-layer", 0, nullptr, 0 },
+        { "feed-while-querying", 0, nullptr, 0 },
+        { "hits", 1, nullptr, 0 },
+        { "indexing-sequencer", 1, nullptr, 0 },
+        { "max-pending", 1, nullptr, 0 },
+        { "no-docsum", 0, nullptr, 0 },
+        { "queries", 1, nullptr, 0 },
+        { "query-file", 1, nullptr, 0 },
+        { "query-passes", 1, nullptr, 0 },
+        { "query-threads", 1, nullptr, 0 },
+        { "rank-profile", 1, nullptr, 0 },
+        { "response-threads", 1, nullptr, 0 },
+        { "rpc-network-threads", 1, nullptr, 0 },
+        { "rpc-targets-per-node", 1, nullptr, 0 },
+        { "use-async-message-handling", 0, nullptr, 0 },
+        { "use-document-api", 0, nullptr, 0 },
+        { "use-message-bus", 0, nullptr, 0 },
+        { "use-storage-chain", 0, nullptr, 0 },
+        { nullptr, 0, nullptr, 0 }
+    };
+    enum longopts_enum {
+        LONGOPT_BUCKET_DB_STRIPE_BITS,
+        LONGOPT_CLIENT_THREADS,
+        LONGOPT_DISTRIBUTOR_STRIPES,
+        LONGOPT_DOCUMENTS,
+        LONGOPT_ENABLE_DISTRIBUTOR,
+        LONGOPT_ENABLE_SERVICE_LAYER,
+        LONGOPT_FEED_WHILE_QUERYING,
+        LONGOPT_HITS,
+        LONGOPT_INDEXING_SEQUENCER,
+        LONGOPT_MAX_PENDING,
+        LONGOPT_NO_DOCSUM,
+        LONGOPT_QUERIES,
+        LONGOPT_QUERY_FILE,
+        LONGOPT_QUERY_PASSES,
+        LONGOPT_QUERY_THREADS,
+        LONGOPT_RANK_PROFILE,
+        LONGOPT_RESPONSE_THREADS,
+        LONGOPT_RPC_NETWORK_THREADS,
+        LONGOPT_RPC_TARGETS_PER_NODE,
+        LONGOPT_USE_ASYNC_MESSAGE_HANDLING,
+        LONGOPT_USE_DOCUMENT_API,
+        LONGOPT_USE_MESSAGE_BUS,
+        LONGOPT_USE_STORAGE_CHAIN
+    };
+    optind = 1;
+    while ((c = getopt_long(argc, argv, "", long_opts, &long_opt_index)) != -1) {
+        switch (c) {
+        case 0:
+            switch(long_opt_index) {
+            case LONGOPT_BUCKET_DB_STRIPE_BITS:
+                _bm_params.set_bucket_db_stripe_bits(atoi(optarg));
+                break;
+            case LONGOPT_CLIENT_THREADS:
+                _bm_params.set_client_threads(atoi(optarg));
+                break;
+            case LONGOPT_DISTRIBUTOR_STRIPES:
+                _bm_params.set_distributor_stripes(atoi(optarg));
+                break;
+            case LONGOPT_DOCUMENTS:
+                _bm_params.set_documents(atoi(optarg));
+                break;
+            case LONGOPT_ENABLE_DISTRIBUTOR:
+                _bm_params.set_enable_distributor(true);
+                break;
+            case LONGOPT_ENABLE_SERVICE_LAYER:
+                _bm_params.set_enable_service_layer(true);
+                break;
+            case LONGOPT_FEED_WHILE_QUERYING:
+                _bm_params.set_feed_while_querying(true);
+                break;
+            case LONGOPT_HITS:
+                _bm_params.set_hits(atoi(optarg));
+                break;
+            case LONGOPT_INDEXING_SEQUENCER:
+                _bm_params.set_indexing_sequencer(optarg);
+                break;
+            case LONGOPT_MAX_PENDING:
+                _bm_params.set_max_pending(atoi(optarg));
+                break;
+            case LONGOPT_NO_DOCSUM:
+                _bm_params.set_docsum(false);
+                break;
+            case LONGOPT_QUERIES:
+                _bm_params.set_queries(atoi(optarg));
+                break;
+            case LONGOPT_QUERY_FILE:
+                _bm_params.set_query_file(optarg);
+                break;
+            case LONGOPT_QUERY_PASSES:
+                _bm_params.set_query_passes(atoi(optarg));
+                break;
+            case LONGOPT_QUERY_THREADS:
+                _bm_params.set_query_threads(atoi(optarg));
+                break;
+            case LONGOPT_RANK_PROFILE:
+                _bm_params.set_rank_profile(optarg);
+                break;
+            case LONGOPT_RESPONSE_THREADS:
+                _bm_params.set_response_threads(atoi(optarg));
+                break;
+            case LONGOPT_RPC_NETWORK_THREADS:
+                _bm_params.set_rpc_network_threads(atoi(optarg));
+                break;
+            case LONGOPT_RPC_TARGETS_PER_NODE:
+                _bm_params.set_rpc_targets_per_node(atoi(optarg));
+                break;
+            case LONGOPT_USE_ASYNC_MESSAGE_HANDLING:
+                _bm_params.set_use_async_message_handling_on_schedule(true);
+                break;
+            case LONGOPT_USE_DOCUMENT_API:
+                _bm_params.set_use_document_api(true);
+                break;
+            case LONGOPT_USE_MESSAGE_BUS:
+                _bm_params.set_use_message_bus(true);
+                break;
+            case LONGOPT_USE_STORAGE_CHAIN:
+                _bm_params.set_use_storage_chain(true);
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+    return _bm_params.check();
+}
+
+int
+App::main(int argc, char **argv)
+{
+    if (!get_options(argc, argv)) {
+        usage();
+        return 1;
+    }
+    std::filesystem::remove_all(std::filesystem::path(base_dir));
+    Benchmark bm(_bm_params);
+    if (!bm.load_queries()) {
+        return 1;
+    }
+    bm.run();
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    vespalib::SignalHandler::PIPE.ignore();
+    DummyFileHeaderContext::setCreator("vespa-query-bm");
+    App app;
+    auto exit_value = app.main(argc, argv);
+    std::filesystem::remove_all(std::filesystem::path(base_dir));
+    return exit_value;
+}
@@ -400,7 +400,7 @@ TEST(AttributeFlushTest, require_that_cleanup_is_performed_after_flush)
 
     FlushableAttribute fa(av, diskLayout->getAttributeDir("a6"), TuneFileAttributes(),
                           f._fileHeaderContext, f._attributeFieldWriter,
-                          f._hwInfo);
+                          f._shared, f._hwInfo);
     fa.initFlush(30, std::make_shared<search::FlushToken>())->run();
 
     EXPECT_TRUE(info.load());
@@ -457,6 +457,34 @@ TEST(AttributeUpdaterTest, require_that_tensor_modify_update_is_applied)
     f.assertTensor(TensorSpec(f.type).add({{"x", 0}}, 7).add({{"x", 1}}, 5));
 }
 
+TEST(AttributeUpdaterTest, require_that_tensor_modify_update_is_applied_to_cells_of_multi_dimensional_dense_tensor)
+{
+    TensorFixture<DenseTensorAttribute> f("tensor<float>(x[2],y[3])", "dense_tensor");
+    f.setTensor(TensorSpec(f.type).add({{"x", 0}, {"y", 0}}, 1).add({{"x", 0}, {"y", 1}}, 2).add({{"x", 0}, {"y", 2}}, 3)
+                                  .add({{"x", 1}, {"y", 0}}, 4).add({{"x", 1}, {"y", 1}}, 5).add({{"x", 1}, {"y", 2}}, 6));
+    f.applyValueUpdate(*f.attribute, 1,
+                       std::make_unique<TensorModifyUpdate>(TensorModifyUpdate::Operation::ADD,
+                                          makeTensorFieldValue(TensorSpec("tensor(x{},y{})")
+                                                                       .add({{"x", "0"}, {"y", "0"}}, 10)
+                                                                       .add({{"x", "1"}, {"y", "2"}}, 20)
+                                                                       .add({{"x", "0"}, {"y", "3"}}, 30)
+                                                                       .add({{"x", "a"}, {"y", "1"}}, 40))));
+    f.assertTensor(TensorSpec(f.type).add({{"x", 0}, {"y", 0}}, 11).add({{"x", 0}, {"y", 1}}, 2).add({{"x", 0}, {"y", 2}}, 3)
+                                     .add({{"x", 1}, {"y", 0}}, 4).add({{"x", 1}, {"y", 1}}, 5).add({{"x", 1}, {"y", 2}}, 26));
+}
+
+TEST(AttributeUpdaterTest, require_that_tensor_modify_update_not_changing_cells_keeps_stored_dense_tensor)
+{
+    TensorFixture<DenseTensorAttribute> f("tensor(x[2])", "dense_tensor");
+    f.setTensor(TensorSpec(f.type).add({{"x", 0}}, 3).add({{"x", 1}}, 5));
+    const void* stored_cells = f.attribute->extract_cells_ref(1).data;
+    f.applyValueUpdate(*f.attribute, 1,
+                       std::make_unique<TensorModifyUpdate>(TensorModifyUpdate::Operation::REPLACE,
+                                          makeTensorFieldValue(TensorSpec("tensor(x{})").add({{"x", "1"}}, 5))));
+    f.assertTensor(TensorSpec(f.type).add({{"x", 0}}, 3).add({{"x", 1}}, 5));
+    EXPECT_EQ(stored_cells, f.attribute->extract_cells_ref(1).data);
+}
+
 TEST(AttributeUpdaterTest, require_that_tensor_modify_update_with_create_true_is_applied_to_non_existing_tensor)
 {
     TensorFixture<DenseTensorAttribute> f("tensor(x[2])", "dense_tensor");
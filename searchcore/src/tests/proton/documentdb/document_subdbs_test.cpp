@@ -1113,6 +1113,7 @@ TEST(DocumentSubDBsTest, require_that_underlying_components_are_explorable_in_st
     EXPECT_TRUE(f._explorer.get_child("attribute").get() == nullptr);
     EXPECT_TRUE(f._explorer.get_child("attributewriter").get() == nullptr);
     EXPECT_TRUE(f._explorer.get_child("index").get() == nullptr);
+    EXPECT_TRUE(f._explorer.get_child("matchers").get() == nullptr);
 }
 
 TEST(DocumentSubDBsTest, require_that_underlying_components_are_explorable_in_fast_access_document_subdb)
@@ -1127,8 +1128,9 @@ TEST(DocumentSubDBsTest, require_that_underlying_components_are_explorable_in_fa
 TEST(DocumentSubDBsTest, require_that_underlying_components_are_explorable_in_searchable_document_subdb)
 {
     SearchableExplorerFixture f;
-    assertExplorer({"attribute", "attributewriter", "index"}, f._explorer);
+    assertExplorer({"attribute", "attributewriter", "index", "matchers"}, f._explorer);
     EXPECT_TRUE(f._explorer.get_child("attribute").get() != nullptr);
     EXPECT_TRUE(f._explorer.get_child("attributewriter").get() != nullptr);
     EXPECT_TRUE(f._explorer.get_child("index").get() != nullptr);
+    EXPECT_TRUE(f._explorer.get_child("matchers").get() != nullptr);
 }
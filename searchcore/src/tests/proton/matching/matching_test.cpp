@@ -1,5 +1,6 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
 #include <vespa/searchcore/proton/documentmetastore/documentmetastore.h>
 #include <vespa/searchcore/proton/matching/fakesearchcontext.h>
@@ -13,7 +14,9 @@
 #include <vespa/searchlib/aggregation/aggregation.h>
 #include <vespa/searchlib/aggregation/grouping.h>
 #include <vespa/searchlib/aggregation/perdocexpression.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
+#include <vespa/searchlib/attribute/integerbase.h>
 #include <vespa/searchlib/engine/docsumreply.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/searchreply.h>
@@ -135,6 +138,17 @@ MatchingTestSharedState::attribute_context()
             assert(docid + 1 == NUM_DOCS);
             _attribute_context->add(attr);
         }
+        {
+            // Regular attribute vector, as only its feature executor supports batch execution
+            auto attr = AttributeFactory::createAttribute("a4", search::attribute::Config(BasicType::INT32));
+            attr->addDocs(NUM_DOCS);
+            auto &int_attr = dynamic_cast<IntegerAttribute &>(*attr);
+            for (uint32_t i = 0; i < NUM_DOCS; ++i) {
+                int_attr.update(i, (i * 37) % NUM_DOCS); // all values differ
+            }
+            attr->commit();
+            _attribute_context->add(attr);
+        }
     }
     return *_attribute_context;
 }
@@ -442,6 +456,17 @@ struct MyWorld {
         return match_tools->match_data().get_termwise_limit();
     }
 
+    bool first_phase_uses_batch_execute() {
+        Matcher::SP matcher = createMatcher();
+        SearchRequest::SP request = createSimpleRequest("a1", "all");
+        search::fef::Properties overrides;
+        auto mtf = matcher->create_match_tools_factory(*request, searchContext, attributeContext, metaStore, overrides,
+                                                       ttb(), nullptr, searchContext.getDocIdLimit(), true);
+        MatchTools::UP match_tools = mtf->createMatchTools();
+        match_tools->setup_first_phase(nullptr);
+        return match_tools->rank_program().has_batch_execute();
+    }
+
     SearchReply::UP performSearch(const SearchRequest & req, size_t threads) {
         Matcher::SP matcher = createMatcher();
         SearchSession::OwnershipBundle owned_objects({std::make_unique<MockAttributeContext>(),
@@ -1183,6 +1208,53 @@ TEST_F(MatchingTest, require_that_match_phase_limiting_works)
     }
 }
 
+TEST_F(MatchingTest, require_that_batch_execution_of_first_phase_gives_same_hits_as_per_document_execution)
+{
+    for (bool limit : {false, true}) {
+        for (bool drop : {false, true}) {
+            for (size_t threads : {size_t(1), size_t(75)}) {
+                SCOPED_TRACE(vespalib::make_string("limit=%d, drop=%d, threads=%zu", limit, drop, threads));
+                SearchReply::UP replies[2];
+                for (bool batch : {false, true}) {
+                    MyWorld world(shared_state());
+                    world.basicSetup();
+                    world.schema.addAttributeField(Schema::AttributeField("a4", DataType::INT32));
+                    world.set_property(indexproperties::rank::FirstPhase::NAME, "attribute(a4)");
+                    world.set_property(indexproperties::eval::BatchExecute::NAME, batch ? "true" : "false");
+                    world.verbose_a1_result("all");
+                    if (limit) {
+                        world.setup_match_phase_limiting("limiter", 150, false);
+                        world.add_match_phase_limiting_result("limiter", 152, false, {948, 951, 963, 987, 991, 994, 997});
+                    }
+                    if (drop) {
+                        world.set_property(indexproperties::hitcollector::FirstPhaseRankScoreDropLimit::NAME, "500");
+                    }
+                    EXPECT_EQ(batch, world.first_phase_uses_batch_execute());
+                    SearchRequest::SP request = MyWorld::createSimpleRequest("a1", "all");
+                    replies[batch] = world.performSearch(*request, threads);
+                }
+                const SearchReply &plain = *replies[0];
+                const SearchReply &batched = *replies[1];
+                if (limit && threads > 1) {
+                    EXPECT_EQ(79u, plain.totalHitCount);
+                } else if (!limit) {
+                    EXPECT_EQ(985u, plain.totalHitCount);
+                }
+                EXPECT_EQ(plain.totalHitCount, batched.totalHitCount);
+                ASSERT_EQ(plain.hits.size(), batched.hits.size());
+                EXPECT_FALSE(plain.hits.empty());
+                for (size_t i = 0; i < plain.hits.size(); ++i) {
+                    EXPECT_EQ(plain.hits[i].gid, batched.hits[i].gid);
+                    EXPECT_EQ(plain.hits[i].metric, batched.hits[i].metric);
+                    if (drop) {
+                        EXPECT_GT(batched.hits[i].metric, 500.0);
+                    }
+                }
+            }
+        }
+    }
+}
+
 TEST_F(MatchingTest, require_that_arithmetic_used_for_rank_drop_limit_works)
 {
     double small = -HUGE_VAL;
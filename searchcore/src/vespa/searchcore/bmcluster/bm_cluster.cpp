@@ -292,6 +292,22 @@ BmCluster::create_buckets(BmFeed& feed)
     }
 }
 
+void
+BmCluster::activate_buckets(BmFeed& feed)
+{
+    LOG(info, "activate %u buckets", feed.num_buckets());
+    for (unsigned int i = 0; i < feed.num_buckets(); ++i) {
+        auto bucket = feed.make_bucket(i);
+        uint32_t node_idx = _distribution->get_service_layer_node_idx(bucket);
+        if (node_idx < _nodes.size()) {
+            auto& node = _nodes[node_idx];
+            if (node) {
+                node->activate_bucket(bucket);
+            }
+        }
+    }
+}
+
 void
 BmCluster::start_service_layers()
 {
@@ -79,6 +79,7 @@ public:
     void shutdown_distributors();
     void shutdown_service_layers();
     void create_buckets(BmFeed &feed);
+    void activate_buckets(BmFeed &feed);
     void initialize_providers();
     void start(BmFeed &feed);
     void stop();
@@ -11,6 +11,8 @@
 #include "storage_api_rpc_bm_feed_handler.h"
 #include <vespa/searchcore/proton/test/dummydbowner.h>
 #include <vespa/searchcore/proton/common/alloc_config.h>
+#include <vespa/searchcore/proton/matchengine/matchengine.h>
+#include <vespa/searchcore/proton/matching/matching_stats.h>
 #include <vespa/searchcore/proton/matching/querylimiter.h>
 #include <vespa/searchcore/proton/metrics/dummy_wire_service.h>
 #include <vespa/searchcore/proton/persistenceengine/i_resource_write_filter.h>
@@ -22,8 +24,11 @@
 #include <vespa/searchcore/proton/server/documentdb.h>
 #include <vespa/searchcore/proton/server/documentdbconfigmanager.h>
 #include <vespa/searchcore/proton/server/fileconfigmanager.h>
+#include <vespa/searchcore/proton/server/idocumentsubdb.h>
 #include <vespa/searchcore/proton/server/memoryconfigstore.h>
 #include <vespa/searchcore/proton/server/persistencehandlerproxy.h>
+#include <vespa/searchcore/proton/server/searchhandlerproxy.h>
+#include <vespa/searchcore/proton/summaryengine/summaryengine.h>
 #include <vespa/searchcore/proton/test/disk_mem_usage_notifier.h>
 #include <vespa/searchcore/proton/test/mock_shared_threading_service.h>
 #include <vespa/searchlib/attribute/interlock.h>
@@ -106,7 +111,9 @@ using vespa::config::search::AttributesConfigBuilder;
 using vespa::config::search::ImportedFieldsConfig;
 using vespa::config::search::IndexschemaConfig;
 using vespa::config::search::RankProfilesConfig;
+using vespa::config::search::RankProfilesConfigBuilder;
 using vespa::config::search::SummaryConfig;
+using vespa::config::search::SummaryConfigBuilder;
 using vespa::config::search::core::ProtonConfig;
 using vespa::config::search::core::ProtonConfigBuilder;
 using vespa::config::search::summary::JuniperrcConfig;
@@ -161,15 +168,50 @@ std::shared_ptr<AttributesConfig> make_attributes_config() {
     return std::make_shared<AttributesConfig>(builder);
 }
 
+void add_rank_profile(RankProfilesConfigBuilder& builder, const std::string& name, const std::string& first_phase, const std::string& second_phase) {
+    RankProfilesConfigBuilder::Rankprofile profile;
+    profile.name = name;
+    RankProfilesConfigBuilder::Rankprofile::Fef::Property property;
+    property.name = "vespa.rank.firstphase";
+    property.value = first_phase;
+    profile.fef.property.emplace_back(property);
+    if (!second_phase.empty()) {
+        property.name = "vespa.rank.secondphase";
+        property.value = second_phase;
+        profile.fef.property.emplace_back(property);
+    }
+    builder.rankprofile.emplace_back(std::move(profile));
+}
+
+std::shared_ptr<RankProfilesConfig> make_rank_profiles_config() {
+    RankProfilesConfigBuilder builder;
+    add_rank_profile(builder, "default", "attribute(int)", "");
+    add_rank_profile(builder, "second_phase", "attribute(int)", "attribute(int)*2");
+    return std::make_shared<RankProfilesConfig>(builder);
+}
+
+std::shared_ptr<SummaryConfig> make_summary_config() {
+    SummaryConfigBuilder builder;
+    builder.defaultsummaryid = 0;
+    SummaryConfigBuilder::Classes summary_class;
+    summary_class.id = 0;
+    summary_class.name = "default";
+    SummaryConfigBuilder::Classes::Fields field;
+    field.name = "int";
+    summary_class.fields.emplace_back(field);
+    builder.classes.emplace_back(std::move(summary_class));
+    return std::make_shared<SummaryConfig>(builder);
+}
+
 std::shared_ptr<DocumentDBConfig> make_document_db_config(std::shared_ptr<DocumenttypesConfig> document_types, std::shared_ptr<const DocumentTypeRepo> repo, const DocTypeName& doc_type_name)
 {
     auto indexschema = std::make_shared<IndexschemaConfig>();
     auto attributes = make_attributes_config();
-    auto summary = std::make_shared<SummaryConfig>();
+    auto summary = make_summary_config();
     auto schema = DocumentDBConfig::build_schema(*attributes, *indexschema);
     return std::make_shared<DocumentDBConfig>(
             1,
-            std::make_shared<RankProfilesConfig>(),
+            make_rank_profiles_config(),
             std::make_shared<search::fef::RankingConstants>(),
             std::make_shared<search::fef::RankingExpressions>(),
             std::make_shared<search::fef::OnnxModels>(),
@@ -429,6 +471,8 @@ class MyBmNode : public BmNode
     MyResourceWriteFilter                      _write_filter;
     proton::test::DiskMemUsageNotifier         _disk_mem_usage_notifier;
     std::shared_ptr<proton::PersistenceEngine> _persistence_engine;
+    std::unique_ptr<proton::MatchEngine>       _match_engine;
+    std::unique_ptr<proton::SummaryEngine>     _summary_engine;
     ServiceLayerConfigSet                      _service_layer_config;
     DistributorConfigSet                       _distributor_config;
     ConfigSet                                  _config_set;
@@ -448,6 +492,7 @@ public:
     ~MyBmNode() override;
     void initialize_persistence_provider() override;
     void create_bucket(const document::Bucket& bucket) override;
+    void activate_bucket(const document::Bucket& bucket) override;
     void start_service_layer(const BmClusterParams& params) override;
     void wait_service_layer() override;
     void start_distributor(const BmClusterParams& params) override;
@@ -459,6 +504,9 @@ public:
     bool has_storage_layer(bool distributor) const override;
     PersistenceProvider* get_persistence_provider() override;
     void merge_node_stats(std::vector<BmNodeStats>& node_stats, storage::lib::ClusterState &baseline_state) override;
+    search::engine::SearchServer& get_search_server() override;
+    search::engine::DocsumServer& get_docsum_server() override;
+    proton::matching::MatchingStats get_matching_stats(const std::string& rank_profile) override;
 };
 
 MyBmNode::MyBmNode(const std::string& base_dir, int base_port, uint32_t node_idx, BmCluster& cluster, const BmClusterParams& params, std::shared_ptr<DocumenttypesConfig> document_types, int slobrok_port)
@@ -493,6 +541,8 @@ MyBmNode::MyBmNode(const std::string& base_dir, int base_port, uint32_t node_idx
       _write_filter(),
       _disk_mem_usage_notifier(),
       _persistence_engine(),
+      _match_engine(),
+      _summary_engine(),
       _service_layer_config(_base_dir, _node_idx, "bm-servicelayer", cluster.get_distribution(), *_document_types, _slobrok_port, _service_layer_mbus_port, _service_layer_rpc_port, _service_layer_status_port, params),
       _distributor_config(_base_dir, _node_idx, "bm-distributor", cluster.get_distribution(), *_document_types, _slobrok_port, _distributor_mbus_port, _distributor_rpc_port, _distributor_status_port, params),
       _config_set(),
@@ -510,12 +560,27 @@ MyBmNode::MyBmNode(const std::string& base_dir, int base_port, uint32_t node_idx
     create_document_db(params);
     auto proxy = std::make_shared<proton::PersistenceHandlerProxy>(_document_db);
     _persistence_engine->putHandler(_persistence_engine->getWLock(), _bucket_space, _doc_type_name, proxy);
+    // Match and summary engines are not async, queries are run in the threads calling them
+    _match_engine = std::make_unique<proton::MatchEngine>(1, 1, _node_idx, false);
+    _summary_engine = std::make_unique<proton::SummaryEngine>(1, false);
+    auto search_handler = std::make_shared<proton::SearchHandlerProxy>(_document_db);
+    _match_engine->putSearchHandler(_doc_type_name, search_handler);
+    _summary_engine->putSearchHandler(_doc_type_name, search_handler);
+    _match_engine->setNodeUp(true);
     _service_layer_config.add_builders(_config_set);
     _distributor_config.add_builders(_config_set);
 }
 
 MyBmNode::~MyBmNode()
 {
+    if (_match_engine) {
+        _match_engine->close();
+        _match_engine->removeSearchHandler(_doc_type_name);
+    }
+    if (_summary_engine) {
+        _summary_engine->close();
+        _summary_engine->removeSearchHandler(_doc_type_name);
+    }
     if (_persistence_engine) {
         _persistence_engine->destroyIterators();
         _persistence_engine->removeHandler(_persistence_engine->getWLock(), _bucket_space, _doc_type_name);
@@ -579,6 +644,12 @@ MyBmNode::create_bucket(const document::Bucket& bucket)
     get_persistence_provider()->createBucket(storage::spi::Bucket(bucket));
 }
 
+void
+MyBmNode::activate_bucket(const document::Bucket& bucket)
+{
+    get_persistence_provider()->setActiveState(storage::spi::Bucket(bucket), storage::spi::BucketInfo::ACTIVE);
+}
+
 void
 MyBmNode::start_service_layer(const BmClusterParams& params)
 {
@@ -690,6 +761,24 @@ MyBmNode::wait_distributor_slobrok()
     _cluster.wait_slobrok(s.str());
 }
 
+search::engine::SearchServer&
+MyBmNode::get_search_server()
+{
+    return *_match_engine;
+}
+
+search::engine::DocsumServer&
+MyBmNode::get_docsum_server()
+{
+    return *_summary_engine;
+}
+
+proton::matching::MatchingStats
+MyBmNode::get_matching_stats(const std::string& rank_profile)
+{
+    return _document_db->getReadySubDB()->getMatcherStats(rank_profile);
+}
+
 unsigned int
 BmNode::num_ports()
 {
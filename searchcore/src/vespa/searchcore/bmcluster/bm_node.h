@@ -16,6 +16,11 @@ class Field;
 
 };
 
+namespace proton::matching { class MatchingStats; }
+namespace search::engine {
+class DocsumServer;
+class SearchServer;
+}
 namespace storage::lib { class ClusterState; }
 namespace storage::spi { struct PersistenceProvider; }
 
@@ -39,6 +44,7 @@ public:
     virtual ~BmNode();
     virtual void initialize_persistence_provider() = 0;
     virtual void create_bucket(const document::Bucket& bucket) = 0;
+    virtual void activate_bucket(const document::Bucket& bucket) = 0;
     virtual void start_service_layer(const BmClusterParams& params) = 0;
     virtual void wait_service_layer() = 0;
     virtual void start_distributor(const BmClusterParams& params) = 0;
@@ -50,6 +56,10 @@ public:
     virtual bool has_storage_layer(bool distributor) const = 0;
     virtual storage::spi::PersistenceProvider *get_persistence_provider() = 0;
     virtual void merge_node_stats(std::vector<BmNodeStats>& node_stats, storage::lib::ClusterState &baseline_state) = 0;
+    virtual search::engine::SearchServer& get_search_server() = 0;
+    virtual search::engine::DocsumServer& get_docsum_server() = 0;
+    // Returns matching stats for the rank profile since last call
+    virtual proton::matching::MatchingStats get_matching_stats(const std::string& rank_profile) = 0;
     static unsigned int num_ports();
     static std::unique_ptr<BmNode> create(const std::string &base_dir, int base_port, uint32_t node_idx, BmCluster& cluster, const BmClusterParams& params, std::shared_ptr<DocumenttypesConfig> document_types, int slobrok_port);
 };
@@ -0,0 +1,240 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bm_querier.h"
+#include "bm_cluster.h"
+#include "bm_node.h"
+#include "bm_queries.h"
+#include "bm_query_params.h"
+#include <vespa/searchcore/proton/matching/matching_stats.h>
+#include <vespa/searchlib/engine/docsumapi.h>
+#include <vespa/searchlib/engine/searchapi.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/time.h>
+#include <algorithm>
+#include <cinttypes>
+#include <tuple>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".bmcluster.bm_querier");
+
+using proton::matching::MatchingStats;
+using search::engine::DocsumRequest;
+using search::engine::SearchClient;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using vespalib::makeLambdaTask;
+using namespace std::chrono_literals;
+
+namespace search::bmcluster {
+
+namespace {
+
+constexpr vespalib::duration query_timeout = 10s;
+
+/*
+ * The match engines of the benchmark nodes are not async, thus replies
+ * are returned directly and the search client is never used.
+ */
+class NoopSearchClient : public SearchClient {
+public:
+    void searchDone(SearchReply::UP) override { }
+};
+
+struct MergedHit {
+    document::GlobalId gid;
+    search::HitRank    metric;
+    uint32_t           node_idx;
+    MergedHit(const document::GlobalId& gid_in, search::HitRank metric_in, uint32_t node_idx_in) noexcept
+        : gid(gid_in),
+          metric(metric_in),
+          node_idx(node_idx_in)
+    {
+    }
+};
+
+double
+percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+    return sorted[idx];
+}
+
+double
+per_query_ms(double seconds, size_t queries)
+{
+    return (queries != 0) ? (seconds * 1000.0 / queries) : 0.0;
+}
+
+}
+
+struct BmQuerier::PassStats {
+    std::vector<double> latencies;
+    vespalib::duration  match_cpu;
+    vespalib::duration  docsum_cpu;
+    double              docsum_time;
+    uint64_t            total_hits;
+    uint64_t            docsums;
+
+    PassStats()
+        : latencies(),
+          match_cpu(vespalib::duration::zero()),
+          docsum_cpu(vespalib::duration::zero()),
+          docsum_time(0.0),
+          total_hits(0),
+          docsums(0)
+    {
+    }
+    void merge(const PassStats& rhs) {
+        latencies.insert(latencies.end(), rhs.latencies.begin(), rhs.latencies.end());
+        match_cpu += rhs.match_cpu;
+        docsum_cpu += rhs.docsum_cpu;
+        docsum_time += rhs.docsum_time;
+        total_hits += rhs.total_hits;
+        docsums += rhs.docsums;
+    }
+};
+
+BmQuerier::BmQuerier(BmCluster& cluster, const BmQueries& queries, const BmQueryParams& params, vespalib::ThreadStackExecutor& executor)
+    : _cluster(cluster),
+      _queries(queries),
+      _params(params),
+      _executor(executor)
+{
+}
+
+BmQuerier::~BmQuerier() = default;
+
+void
+BmQuerier::run_queries(uint32_t thread_id, PassStats& stats)
+{
+    // Match engines and summary engines are not async, thus all work is done in this thread
+    auto sampler = vespalib::cpu_usage::create_thread_sampler();
+    NoopSearchClient client;
+    uint32_t num_nodes = _cluster.get_num_nodes();
+    std::vector<MergedHit> hits;
+    for (size_t i = thread_id; i < _queries.size(); i += _params.get_query_threads()) {
+        vespalib::Timer timer;
+        auto start_cpu = sampler->sample();
+        hits.clear();
+        for (uint32_t node_idx = 0; node_idx < num_nodes; ++node_idx) {
+            auto* node = _cluster.get_node(node_idx);
+            if (node == nullptr) {
+                continue;
+            }
+            auto request = std::make_unique<SearchRequest>();
+            request->setTimeout(query_timeout);
+            request->ranking = _params.get_rank_profile();
+            request->maxhits = _params.get_hits();
+            const auto& stack_dump = _queries.get(i);
+            request->stackDump.assign(stack_dump.begin(), stack_dump.end());
+            auto reply = node->get_search_server().search(std::move(request), client);
+            if (!reply) {
+                continue;
+            }
+            stats.total_hits += reply->totalHitCount;
+            for (const auto& hit : reply->hits) {
+                hits.emplace_back(hit.gid, hit.metric, node_idx);
+            }
+        }
+        auto match_done_cpu = sampler->sample();
+        stats.match_cpu += match_done_cpu - start_cpu;
+        if (_params.get_docsum() && !hits.empty()) {
+            vespalib::Timer docsum_timer;
+            std::sort(hits.begin(), hits.end(), [](const MergedHit& lhs, const MergedHit& rhs) noexcept
+                      { return std::tie(rhs.metric, lhs.node_idx) < std::tie(lhs.metric, rhs.node_idx); });
+            if (hits.size() > _params.get_hits()) {
+                hits.erase(hits.begin() + _params.get_hits(), hits.end());
+            }
+            for (uint32_t node_idx = 0; node_idx < num_nodes; ++node_idx) {
+                auto* node = _cluster.get_node(node_idx);
+                if (node == nullptr) {
+                    continue;
+                }
+                auto request = std::make_unique<DocsumRequest>();
+                for (const auto& hit : hits) {
+                    if (hit.node_idx == node_idx) {
+                        request->hits.emplace_back(hit.gid);
+                    }
+                }
+                if (request->hits.empty()) {
+                    continue;
+                }
+                request->setTimeout(query_timeout);
+                request->ranking = _params.get_rank_profile();
+                auto reply = node->get_docsum_server().getDocsums(std::move(request));
+                if (reply && reply->hasResult()) {
+                    stats.docsums += reply->root()["docsums"].entries();
+                }
+            }
+            stats.docsum_cpu += sampler->sample() - match_done_cpu;
+            stats.docsum_time += vespalib::to_s(docsum_timer.elapsed());
+        }
+        stats.latencies.push_back(vespalib::to_s(timer.elapsed()));
+    }
+}
+
+void
+BmQuerier::run_query_pass(uint32_t pass)
+{
+    const auto& rank_profile = _params.get_rank_profile();
+    uint32_t num_nodes = _cluster.get_num_nodes();
+    for (uint32_t node_idx = 0; node_idx < num_nodes; ++node_idx) {
+        auto* node = _cluster.get_node(node_idx);
+        if (node != nullptr) {
+            // Reset matching stats
+            (void) node->get_matching_stats(rank_profile);
+        }
+    }
+    uint32_t threads = _params.get_query_threads();
+    std::vector<PassStats> thread_stats(threads);
+    vespalib::Timer timer;
+    for (uint32_t i = 0; i < threads; ++i) {
+        _executor.execute(makeLambdaTask([this, i, &thread_stats]() { run_queries(i, thread_stats[i]); }));
+    }
+    _executor.sync();
+    double elapsed = vespalib::to_s(timer.elapsed());
+    PassStats stats;
+    for (const auto& thread_stat : thread_stats) {
+        stats.merge(thread_stat);
+    }
+    MatchingStats matching_stats;
+    for (uint32_t node_idx = 0; node_idx < num_nodes; ++node_idx) {
+        auto* node = _cluster.get_node(node_idx);
+        if (node != nullptr) {
+            matching_stats.add(node->get_matching_stats(rank_profile));
+        }
+    }
+    auto& latencies = stats.latencies;
+    std::sort(latencies.begin(), latencies.end());
+    size_t num_queries = latencies.size();
+    double latency_sum = 0.0;
+    for (double latency : latencies) {
+        latency_sum += latency;
+    }
+    LOG(info, "query pass %u: %zu queries, %u threads, %8.2f queries/s, %8.2f hits/query, %8.2f docsums/query",
+        pass, num_queries, threads, (elapsed > 0.0) ? (num_queries / elapsed) : 0.0,
+        (num_queries != 0) ? (static_cast<double>(stats.total_hits) / num_queries) : 0.0,
+        (num_queries != 0) ? (static_cast<double>(stats.docsums) / num_queries) : 0.0);
+    LOG(info, "query pass %u: latency ms: avg %8.3f, p50 %8.3f, p90 %8.3f, p99 %8.3f, max %8.3f",
+        pass, per_query_ms(latency_sum, num_queries),
+        percentile(latencies, 0.5) * 1000.0, percentile(latencies, 0.9) * 1000.0,
+        percentile(latencies, 0.99) * 1000.0, percentile(latencies, 1.0) * 1000.0);
+    LOG(info, "query pass %u: cpu ms/query: match %8.3f, docsum %8.3f",
+        pass, per_query_ms(vespalib::to_s(stats.match_cpu), num_queries),
+        per_query_ms(vespalib::to_s(stats.docsum_cpu), num_queries));
+    // Matching stats are per node query, match time covers both matching and first phase ranking
+    LOG(info, "query pass %u: time ms/node query: setup %8.3f, match+first phase %8.3f, second phase %8.3f, "
+        "docsum ms/query %8.3f, docs matched %" PRIu64 ", ranked %" PRIu64 ", reranked %" PRIu64,
+        pass, matching_stats.querySetupTimeAvg() * 1000.0, matching_stats.matchTimeAvg() * 1000.0,
+        matching_stats.rerankTimeAvg() * 1000.0, per_query_ms(stats.docsum_time, num_queries),
+        static_cast<uint64_t>(matching_stats.docsMatched()), static_cast<uint64_t>(matching_stats.docsRanked()),
+        static_cast<uint64_t>(matching_stats.docsReRanked()));
+}
+
+}
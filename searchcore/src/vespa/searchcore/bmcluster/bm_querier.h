@@ -0,0 +1,36 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace vespalib { class ThreadStackExecutor; }
+
+namespace search::bmcluster {
+
+class BmCluster;
+class BmQueries;
+class BmQueryParams;
+
+/*
+ * Class running queries against the match and summary engines of the
+ * benchmark nodes. Each query is sent to all nodes, the hits are merged
+ * and docsums are fetched for the best hits from the nodes owning them.
+ * Reports QPS, latency percentiles and cpu usage per query for each pass.
+ */
+class BmQuerier {
+    struct PassStats;
+
+    BmCluster&                     _cluster;
+    const BmQueries&               _queries;
+    const BmQueryParams&           _params;
+    vespalib::ThreadStackExecutor& _executor;
+
+    void run_queries(uint32_t thread_id, PassStats& stats);
+public:
+    BmQuerier(BmCluster& cluster, const BmQueries& queries, const BmQueryParams& params, vespalib::ThreadStackExecutor& executor);
+    ~BmQuerier();
+    void run_query_pass(uint32_t pass);
+};
+
+}
@@ -0,0 +1,141 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bm_queries.h"
+#include <vespa/searchlib/query/tree/querybuilder.h>
+#include <vespa/searchlib/query/tree/simplequery.h>
+#include <vespa/searchlib/query/tree/stackdumpcreator.h>
+#include <vespa/vespalib/encoding/base64.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".bmcluster.bm_queries");
+
+using search::query::QueryBuilder;
+using search::query::SimpleQueryNodeTypes;
+using search::query::StackDumpCreator;
+using search::query::Weight;
+
+namespace search::bmcluster {
+
+namespace {
+
+std::string_view base64_prefix("base64:");
+
+std::vector<std::pair<std::string, std::string>>
+split_items(std::string_view line)
+{
+    std::vector<std::pair<std::string, std::string>> items;
+    size_t pos = 0;
+    while (pos < line.size()) {
+        auto start = line.find_first_not_of(" \t\r", pos);
+        if (start == std::string_view::npos) {
+            break;
+        }
+        auto end = line.find_first_of(" \t\r", start);
+        if (end == std::string_view::npos) {
+            end = line.size();
+        }
+        auto item = line.substr(start, end - start);
+        auto colon = item.find(':');
+        if (colon == std::string_view::npos || colon == 0 || colon + 1 == item.size()) {
+            return {};
+        }
+        items.emplace_back(item.substr(0, colon), item.substr(colon + 1));
+        pos = end;
+    }
+    return items;
+}
+
+bool
+is_numeric_term(const std::string& term)
+{
+    char c = term[0];
+    return (c >= '0' && c <= '9') || c == '-' || c == '[';
+}
+
+}
+
+BmQueries::BmQueries()
+    : _stack_dumps()
+{
+}
+
+BmQueries::~BmQueries() = default;
+
+std::string
+BmQueries::make_stack_dump(std::string_view line)
+{
+    if (line.starts_with(base64_prefix)) {
+        try {
+            return vespalib::Base64::decode(std::string(line.substr(base64_prefix.size())));
+        } catch (vespalib::IllegalArgumentException&) {
+            return {};
+        }
+    }
+    auto items = split_items(line);
+    if (items.empty()) {
+        return {};
+    }
+    QueryBuilder<SimpleQueryNodeTypes> builder;
+    if (items.size() > 1) {
+        builder.addAnd(items.size());
+    }
+    int32_t id = 0;
+    for (auto& item : items) {
+        if (is_numeric_term(item.second)) {
+            builder.addNumberTerm(item.second, item.first, ++id, Weight(100));
+        } else {
+            builder.addStringTerm(item.second, item.first, ++id, Weight(100));
+        }
+    }
+    auto node = builder.build();
+    return node ? StackDumpCreator::create(*node) : std::string();
+}
+
+bool
+BmQueries::load(const std::string& file_name)
+{
+    std::ifstream is(file_name);
+    if (!is) {
+        LOG(error, "Could not open query file '%s'", file_name.c_str());
+        return false;
+    }
+    std::string line;
+    uint32_t line_no = 0;
+    while (std::getline(is, line)) {
+        ++line_no;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        auto stack_dump = make_stack_dump(line);
+        if (stack_dump.empty()) {
+            LOG(error, "Malformed query at line %u in query file '%s'", line_no, file_name.c_str());
+            return false;
+        }
+        _stack_dumps.emplace_back(std::move(stack_dump));
+    }
+    LOG(info, "Loaded %zu queries from '%s'", _stack_dumps.size(), file_name.c_str());
+    return !_stack_dumps.empty();
+}
+
+void
+BmQueries::generate(uint32_t num_queries, uint32_t documents)
+{
+    // Mix of single value lookups and range queries on the int field
+    vespalib::Rand48 rnd(42);
+    uint32_t range_width = std::max(1u, documents / 100);
+    for (uint32_t i = 0; i < num_queries; ++i) {
+        uint32_t value = rnd.lrand48() % std::max(1u, documents);
+        std::string line = ((i % 4) == 3)
+            ? vespalib::make_string("int:[%u;%u]", value, value + range_width)
+            : vespalib::make_string("int:%u", value);
+        _stack_dumps.emplace_back(make_stack_dump(line));
+    }
+}
+
+}
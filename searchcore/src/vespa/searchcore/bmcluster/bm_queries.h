@@ -0,0 +1,39 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace search::bmcluster {
+
+/*
+ * Class containing the serialized query stack dumps used when
+ * benchmarking queries. Queries are either loaded from a query file or
+ * generated to match the synthetic documents made by BmFeed.
+ *
+ * Query file format, one query per line:
+ *   - Empty lines and lines starting with '#' are ignored.
+ *   - "base64:<data>" is a base64 encoded query stack dump, e.g. captured
+ *     from a query trace.
+ *   - Otherwise the line is a whitespace separated list of "field:term"
+ *     items that must all match. Terms starting with a digit, '-' or '['
+ *     are numeric terms (including ranges like "[10;20]"), other terms are
+ *     string terms.
+ */
+class BmQueries {
+    std::vector<std::string> _stack_dumps;
+public:
+    BmQueries();
+    ~BmQueries();
+    bool load(const std::string& file_name);
+    void generate(uint32_t num_queries, uint32_t documents);
+    size_t size() const noexcept { return _stack_dumps.size(); }
+    bool empty() const noexcept { return _stack_dumps.empty(); }
+    const std::string& get(size_t idx) const noexcept { return _stack_dumps[idx]; }
+    static std::string make_stack_dump(std::string_view line);
+};
+
+}
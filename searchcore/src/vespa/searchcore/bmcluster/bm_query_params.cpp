@@ -0,0 +1,39 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bm_query_params.h"
+#include <iostream>
+
+namespace search::bmcluster {
+
+BmQueryParams::BmQueryParams()
+    : _docsum(true),
+      _hits(10),
+      _queries(10000),
+      _query_file(),
+      _query_passes(2),
+      _query_threads(1),
+      _rank_profile("default")
+{
+}
+
+BmQueryParams::~BmQueryParams() = default;
+
+bool
+BmQueryParams::check() const
+{
+    if (_query_threads < 1) {
+        std::cerr << "Too few query threads: " << _query_threads << std::endl;
+        return false;
+    }
+    if (_query_threads > 1024) {
+        std::cerr << "Too many query threads: " << _query_threads << std::endl;
+        return false;
+    }
+    if (_query_file.empty() && _queries < 1) {
+        std::cerr << "Too few queries: " << _queries << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,43 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace search::bmcluster {
+
+/*
+ * Parameters for generating or loading queries and for running them
+ * against the cluster.
+ */
+class BmQueryParams
+{
+    bool        _docsum;
+    uint32_t    _hits;
+    uint32_t    _queries;
+    std::string _query_file;
+    uint32_t    _query_passes;
+    uint32_t    _query_threads;
+    std::string _rank_profile;
+public:
+    BmQueryParams();
+    ~BmQueryParams();
+    bool get_docsum() const { return _docsum; }
+    uint32_t get_hits() const { return _hits; }
+    uint32_t get_queries() const { return _queries; }
+    const std::string& get_query_file() const { return _query_file; }
+    uint32_t get_query_passes() const { return _query_passes; }
+    uint32_t get_query_threads() const { return _query_threads; }
+    const std::string& get_rank_profile() const { return _rank_profile; }
+    void set_docsum(bool value) { _docsum = value; }
+    void set_hits(uint32_t value) { _hits = value; }
+    void set_queries(uint32_t value) { _queries = value; }
+    void set_query_file(const std::string& value) { _query_file = value; }
+    void set_query_passes(uint32_t value) { _query_passes = value; }
+    void set_query_threads(uint32_t value) { _query_threads = value; }
+    void set_rank_profile(const std::string& value) { _rank_profile = value; }
+    bool check() const;
+};
+
+}
@@ -148,7 +148,7 @@ AttributeManager::addAttribute(AttributeWrap attributeWrap, const ShrinkerSP &sh
     if ( ! isExtra ) {
         // Flushing of extra attributes is handled elsewhere
         AttributeVector * attributeP = attribute.get();
-        auto flusher = std::make_shared<FlushableAttribute>(std::move(attribute), _diskLayout->createAttributeDir(name), _tuneFileAttributes, _fileHeaderContext, _attributeFieldWriter, _hwInfo);
+        auto flusher = std::make_shared<FlushableAttribute>(std::move(attribute), _diskLayout->createAttributeDir(name), _tuneFileAttributes, _fileHeaderContext, _attributeFieldWriter, _shared_executor, _hwInfo);
         _flushables[name] = FlushableWrap(flusher, shrinker);
         _writableAttributes.push_back(attributeP);
     }
@@ -83,13 +83,13 @@ FlushableAttribute::Flusher::saveAttribute()
     SerialNumFileHeaderContext fileHeaderContext(_fattr._fileHeaderContext, _syncToken);
     bool saveSuccess = true;
     if (_saver && _saver->hasGenerationGuard() && _fattr._hwInfo.disk().slow()) {
-        saveSuccess = _saver->save(_saveTarget);
+        saveSuccess = _saver->save(_saveTarget, &_fattr._shared_executor);
         _saver.reset();
     }
     if (saveSuccess) {
         if (_saver) {
             search::AttributeFileSaveTarget saveTarget(_fattr._tuneFileAttributes, fileHeaderContext);
-            saveSuccess = _saver->save(saveTarget);
+            saveSuccess = _saver->save(saveTarget, &_fattr._shared_executor);
             if (saveSuccess) {
                 _fattr._attr->set_size_on_disk(saveTarget.size_on_disk());
             }
@@ -159,6 +159,7 @@ FlushableAttribute::FlushableAttribute(AttributeVectorSP attr,
                                        fileHeaderContext,
                                        vespalib::ISequencedTaskExecutor &
                                        attributeFieldWriter,
+                                       vespalib::Executor &shared_executor,
                                        const vespalib::HwInfo &hwInfo)
     : LeafFlushTarget(make_string("attribute.flush.%s", attr->getName().c_str()), Type::SYNC, Component::ATTRIBUTE),
       _attr(attr),
@@ -167,6 +168,7 @@ FlushableAttribute::FlushableAttribute(AttributeVectorSP attr,
       _tuneFileAttributes(tuneFileAttributes),
       _fileHeaderContext(fileHeaderContext),
       _attributeFieldWriter(attributeFieldWriter),
+      _shared_executor(shared_executor),
       _hwInfo(hwInfo),
       _attrDir(attrDir),
       _replay_operation_cost(0.0),
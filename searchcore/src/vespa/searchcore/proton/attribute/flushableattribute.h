@@ -9,7 +9,10 @@
 namespace search { class AttributeVector; }
 
 namespace search::common { class FileHeaderContext; }
-namespace vespalib { class ISequencedTaskExecutor; }
+namespace vespalib {
+class Executor;
+class ISequencedTaskExecutor;
+}
 
 namespace proton {
 
@@ -35,6 +38,7 @@ private:
     const search::TuneFileAttributes         _tuneFileAttributes;
     const search::common::FileHeaderContext &_fileHeaderContext;
     vespalib::ISequencedTaskExecutor        &_attributeFieldWriter;
+    vespalib::Executor                      &_shared_executor;
     vespalib::HwInfo                         _hwInfo;
     std::shared_ptr<AttributeDirectory>      _attrDir;
     double                                   _replay_operation_cost;
@@ -49,7 +53,8 @@ public:
      * Creates a new instance using the given attribute vector and the
      * given base dir where all attribute vectors are located.
      *
-     * fileHeaderContext must be kept alive by caller.
+     * fileHeaderContext must be kept alive by caller. shared_executor
+     * is used to save parts of large attributes in parallel.
      **/
     FlushableAttribute(AttributeVectorSP attr,
                        const std::shared_ptr<AttributeDirectory> &attrDir,
@@ -57,6 +62,7 @@ public:
                        const search::common::FileHeaderContext &
                        fileHeaderContext,
                        vespalib::ISequencedTaskExecutor &attributeFieldWriter,
+                       vespalib::Executor &shared_executor,
                        const vespalib::HwInfo &hwInfo);
 
     ~FlushableAttribute() override;
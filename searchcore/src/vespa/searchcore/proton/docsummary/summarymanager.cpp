@@ -154,6 +154,13 @@ SummaryManager::putDocument(uint64_t syncToken, search::DocumentIdT lid, const v
     _docStore->write(syncToken, lid, doc);
 }
 
+void
+SummaryManager::updateDocument(uint64_t syncToken, search::DocumentIdT lid, const document::DocumentUpdate & upd,
+                               const document::DocumentTypeRepo & repo)
+{
+    _docStore->update(syncToken, lid, upd, repo);
+}
+
 void
 SummaryManager::removeDocument(uint64_t syncToken, search::DocumentIdT lid)
 {
@@ -65,6 +65,8 @@ public:
 
     void putDocument(uint64_t syncToken, search::DocumentIdT lid, const document::Document & doc);
     void putDocument(uint64_t syncToken, search::DocumentIdT lid, const vespalib::nbostream & doc);
+    void updateDocument(uint64_t syncToken, search::DocumentIdT lid, const document::DocumentUpdate & upd,
+                        const document::DocumentTypeRepo & repo);
     void removeDocument(uint64_t syncToken, search::DocumentIdT lid);
     searchcorespi::IFlushTarget::List getFlushTargets(vespalib::Executor & summaryService);
 
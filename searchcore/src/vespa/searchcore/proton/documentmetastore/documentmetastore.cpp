@@ -420,8 +420,9 @@ DocumentMetaStore::DocumentMetaStore(BucketDBOwnerSP bucketDB, const std::string
 DocumentMetaStore::DocumentMetaStore(BucketDBOwnerSP bucketDB,
                                      const std::string &name,
                                      const GrowStrategy &grow,
-                                     SubDbType subDbType)
-    : DocumentMetaStoreAttribute(name),
+                                     SubDbType subDbType,
+                                     bool sharded_reader_guards)
+    : DocumentMetaStoreAttribute(name, sharded_reader_guards),
       _metaDataStore(grow, getGenerationHolder()),
       _gidToLidMap(),
       _gid_to_lid_map_write_itr(vespalib::datastore::EntryRef(), _gidToLidMap.getAllocator()),
@@ -151,7 +151,8 @@ public:
     DocumentMetaStore(BucketDBOwnerSP bucketDB,
                       const std::string & name,
                       const search::GrowStrategy & grow,
-                      SubDbType subDbType = SubDbType::READY);
+                      SubDbType subDbType = SubDbType::READY,
+                      bool sharded_reader_guards = false);
     ~DocumentMetaStore() override;
 
     /**
@@ -17,8 +17,8 @@ DocumentMetaStoreAttribute::getFixedName()
     return documentMetaStoreName;
 }
 
-DocumentMetaStoreAttribute::DocumentMetaStoreAttribute(const std::string &name)
-    : NotImplementedAttribute(name, Config(BasicType::NONE))
+DocumentMetaStoreAttribute::DocumentMetaStoreAttribute(const std::string &name, bool sharded_reader_guards)
+    : NotImplementedAttribute(name, Config(BasicType::NONE).set_sharded_reader_guards(sharded_reader_guards))
 { }
 
 
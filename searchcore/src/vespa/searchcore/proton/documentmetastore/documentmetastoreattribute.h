@@ -14,7 +14,7 @@ namespace proton {
 class DocumentMetaStoreAttribute : public search::NotImplementedAttribute
 {
 public:
-    explicit DocumentMetaStoreAttribute(const std::string &name);
+    DocumentMetaStoreAttribute(const std::string &name, bool sharded_reader_guards);
     ~DocumentMetaStoreAttribute() override;
 
     static const std::string &getFixedName();
@@ -15,6 +15,9 @@ namespace proton::matching {
 
 namespace {
 
+// Number of hits ahead of the one being scored to prefetch attribute data for
+constexpr size_t prefetch_distance = 8;
+
 LazyValue
 extractScoreFeature(const RankProgram &rankProgram)
 {
@@ -27,7 +30,8 @@ extractScoreFeature(const RankProgram &rankProgram)
 
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
-    : _searchItr(searchItr),
+    : _rankProgram(rankProgram),
+      _searchItr(searchItr),
       _scoreFeature(extractScoreFeature(rankProgram))
 {
 }
@@ -41,8 +45,20 @@ DocumentScorer::score(TaggedHits &hits)
     auto sort_on_docid = [](const TaggedHit &a, const TaggedHit &b){ return (a.first.first < b.first.first); };
     std::sort(hits.begin(), hits.end(), sort_on_docid);
     _searchItr.initRange(hits.front().first.first, hits.back().first.first + 1);
-    for (auto &hit: hits) {
-        hit.first.second = doScore(hit.first.first);
+    if (!_rankProgram.has_prefetch()) {
+        for (auto &hit: hits) {
+            hit.first.second = doScore(hit.first.first);
+        }
+        return;
+    }
+    for (size_t i = 0; i < std::min(prefetch_distance, hits.size()); ++i) {
+        _rankProgram.prefetch(hits[i].first.first);
+    }
+    for (size_t i = 0; i < hits.size(); ++i) {
+        if (i + prefetch_distance < hits.size()) {
+            _rankProgram.prefetch(hits[i + prefetch_distance].first.first);
+        }
+        hits[i].first.second = doScore(hits[i].first.first);
     }
 }
 
@@ -21,6 +21,7 @@ namespace proton::matching {
 class DocumentScorer
 {
 private:
+    const search::fef::RankProgram &_rankProgram;
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
 
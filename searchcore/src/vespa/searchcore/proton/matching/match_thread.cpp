@@ -104,17 +104,52 @@ MatchThread::Context::Context(std::optional<double> first_phase_rank_score_drop_
     : matches(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
       _score_feature(get_score_feature(tools.rank_program())),
+      _prefetcher(tools.rank_program().has_prefetch() ? &tools.rank_program() : nullptr),
+      _batch_program(tools.rank_program().has_batch_execute() ? &tools.rank_program() : nullptr),
+      _batch(),
       _first_phase_rank_score_drop_limit(first_phase_rank_score_drop_limit.value_or(0.0 /* ignored */)),
       _hits(hits),
       _doom(tools.getDoom()),
       dropped()
 {
+    if (_batch_program != nullptr) {
+        _batch.reserve(RankProgram::max_batch_size);
+    }
 }
 
 template <MatchThread::RankDropLimitE use_rank_drop_limit>
 void
 MatchThread::Context::rankHit(uint32_t docId) {
-    double score = _score_feature.as_number(docId);
+    addRankedHit<use_rank_drop_limit>(docId, _score_feature.as_number(docId));
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::batchRankHit(uint32_t docId) {
+    // The block is scored after matching up to max_batch_size hits, giving the prefetch time to complete
+    prefetch(docId);
+    _batch.push_back(docId);
+    if (_batch.size() == RankProgram::max_batch_size) {
+        flushBatch<use_rank_drop_limit>();
+    }
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::flushBatch() {
+    if (_batch.empty()) {
+        return;
+    }
+    auto scores = _batch_program->execute_batch(_batch);
+    for (size_t i = 0; i < _batch.size(); ++i) {
+        addRankedHit<use_rank_drop_limit>(_batch[i], scores[i]);
+    }
+    _batch.clear();
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::addRankedHit(uint32_t docId, double score) {
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
         score = -HUGE_VAL;
@@ -130,6 +165,14 @@ MatchThread::Context::rankHit(uint32_t docId) {
     }
 }
 
+inline void
+MatchThread::Context::prefetch(uint32_t docId) const
+{
+    if (_prefetcher != nullptr) {
+        _prefetcher->prefetch(docId);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 double
@@ -191,8 +234,13 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
     uint32_t docId = search->seekFirst(docid_range.begin);
     while ((docId < docid_range.end) && !context.atSoftDoom()) {
         if (do_rank) {
-            search->unpack(docId);
-            context.rankHit<use_rank_drop_limit>(docId);
+            if (context.useBatch()) {
+                // Batch executors do not use match data, so there is no need to unpack
+                context.batchRankHit<use_rank_drop_limit>(docId);
+            } else {
+                search->unpack(docId);
+                context.rankHit<use_rank_drop_limit>(docId);
+            }
         } else {
             context.addHit(docId);
         }
@@ -207,6 +255,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.flushBatch<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -77,15 +77,27 @@ private:
                 uint32_t num_threads) __attribute__((noinline));
         template <RankDropLimitE use_rank_drop_limit>
         void rankHit(uint32_t docId);
+        template <RankDropLimitE use_rank_drop_limit>
+        void batchRankHit(uint32_t docId);
+        template <RankDropLimitE use_rank_drop_limit>
+        void flushBatch();
+        bool useBatch() const { return _batch_program != nullptr; }
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
+        void prefetch(uint32_t docId) const;
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
         bool   atSoftDoom() const { return _doom.soft_doom(); }
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        template <RankDropLimitE use_rank_drop_limit>
+        void addRankedHit(uint32_t docId, double score);
+
         uint32_t        _matches_limit;
         LazyValue       _score_feature;
+        const search::fef::RankProgram *_prefetcher;
+        const search::fef::RankProgram *_batch_program;
+        std::vector<uint32_t>           _batch;
         double          _first_phase_rank_score_drop_limit;
         HitCollector   &_hits;
         const Doom      _doom;
@@ -11,6 +11,7 @@
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/ranksetup.h>
 #include <vespa/searchlib/queryeval/create_blueprint_params.h>
+#include <vespa/searchlib/queryeval/field_cost_model.h>
 #include <vespa/searchlib/queryeval/flow.h>
 #include <vespa/searchlib/queryeval/wand/wand_parts.h>
 #include <vespa/vespalib/util/issue.h>
@@ -20,6 +21,7 @@ using search::attribute::BasicType;
 using search::attribute::diversity::DiversityFilter;
 using search::queryeval::CreateBlueprintParams;
 using search::queryeval::ExecuteInfo;
+using search::queryeval::FieldCostModel;
 using search::queryeval::IDiversifier;
 using vespalib::Issue;
 
@@ -136,6 +138,9 @@ MatchTools::setup_first_phase(ExecutionProfiler *profiler)
 {
     setup(_rankSetup.create_first_phase_program(), profiler,
           TermwiseLimit::lookup(_queryEnv.getProperties(), _rankSetup.get_termwise_limit()));
+    if (eval::BatchExecute::check(_queryEnv.getProperties(), _rankSetup.use_batch_execute())) {
+        _rank_program->setup_batch_execute();
+    }
 }
 
 void
@@ -181,7 +186,8 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   vespalib::ThreadBundle     & thread_bundle,
                   const search::IDocumentMetaStoreContext::IReadGuard::SP * metaStoreReadGuard,
                   uint32_t                     maxNumHits,
-                  bool                         is_search)
+                  bool                         is_search,
+                  FieldCostModel             * field_cost_model)
     : _queryLimiter(queryLimiter),
       _create_blueprint_params(extract_create_blueprint_params(rankSetup, rankProperties, metaStore.getNumActiveLids(), searchContext.getDocIdLimit())),
       _query(),
@@ -201,6 +207,11 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
     auto trace = root_trace.make_trace();
     trace.addEvent(4, "Start query setup");
     _query.setWhiteListBlueprint(metaStore.createWhiteListBlueprint());
+    uint32_t sample_interval = FieldCostSampleInterval::lookup(rankProperties, rankSetup.get_field_cost_sample_interval());
+    if (field_cost_model != nullptr && sample_interval > 0) {
+        // The model is only used when sampling is configured, avoiding any overhead otherwise
+        _query.set_field_cost_model(field_cost_model, is_search && field_cost_model->should_sample(sample_interval));
+    }
     trace.addEvent(5, "Deserialize and build query tree");
     _valid = _query.buildTree(queryStack, location, viewResolver, indexEnv);
     if (_valid) {
@@ -360,13 +371,18 @@ MatchToolsFactory::extract_create_blueprint_params(const RankSetup& rank_setup,
     // This ensures that when searchable-copies=1, the ratio is 1.0.
     double active_hit_ratio = std::min(active_docids + 1, docid_limit) / static_cast<double>(docid_limit);
 
-    return {lower_limit * active_hit_ratio,
-            upper_limit * active_hit_ratio,
-            target_hits_max_adjustment_factor,
-            fuzzy_matching_algorithm,
-            StopWordStrategy(weakand_stop_word_adjust_limit,
-                             weakand_stop_word_drop_limit, docid_limit),
-            filter_threshold};
+    CreateBlueprintParams params(lower_limit * active_hit_ratio,
+                                 upper_limit * active_hit_ratio,
+                                 target_hits_max_adjustment_factor,
+                                 fuzzy_matching_algorithm,
+                                 StopWordStrategy(weakand_stop_word_adjust_limit,
+                                                  weakand_stop_word_drop_limit, docid_limit),
+                                 filter_threshold);
+    params.use_posting_bitvector_cache = UsePostingBitVectorCache::check(rank_properties, rank_setup.use_posting_bitvector_cache());
+    params.filter_first_threshold = FilterFirstThreshold::lookup(rank_properties, rank_setup.get_filter_first_threshold());
+    params.filter_first_exploration = FilterFirstExploration::lookup(rank_properties, rank_setup.get_filter_first_exploration());
+    params.max_term_expansions = MaxTermExpansions::lookup(rank_properties, rank_setup.get_max_term_expansions());
+    return params;
 }
 
 AttributeOperationTask::AttributeOperationTask(const RequestContext & requestContext,
@@ -160,7 +160,8 @@ public:
                       vespalib::ThreadBundle &thread_bundle,
                       const search::IDocumentMetaStoreContext::IReadGuard::SP * metaStoreReadGuard,
                       uint32_t maxNumHits,
-                      bool is_search);
+                      bool is_search,
+                      search::queryeval::FieldCostModel *field_cost_model);
     ~MatchToolsFactory();
     bool valid() const { return _valid; }
     const MaybeMatchPhaseLimiter &match_limiter() const { return *_match_limiter; }
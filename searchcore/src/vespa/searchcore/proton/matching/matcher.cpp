@@ -17,6 +17,7 @@
 #include <vespa/searchlib/fef/ranksetup.h>
 #include <vespa/searchlib/fef/test/plugin/setup.h>
 #include <vespa/searchlib/common/allocatedbitvector.h>
+#include <vespa/searchlib/queryeval/field_cost_model.h>
 #include <vespa/vespalib/data/slime/inserter.h>
 #include <vespa/vespalib/util/limited_thread_bundle_wrapper.h>
 #include <cinttypes>
@@ -116,7 +117,8 @@ Matcher::Matcher(const search::index::Schema &schema, Properties props, const st
     _startTime(my_clock::now()),
     _now_ref(now_ref),
     _queryLimiter(queryLimiter),
-    _distributionKey(distributionKey)
+    _distributionKey(distributionKey),
+    _field_cost_model(std::make_unique<FieldCostModel>())
 {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
@@ -165,7 +167,7 @@ Matcher::create_match_tools_factory(const search::engine::Request &request, ISea
                                                request.trace(), request.getStackRef(), request.location,
                                                _viewResolver, metaStore, _indexEnv, *_rankSetup,
                                                rankProperties, feature_overrides, thread_bundle,
-                                               metaStoreReadGuard, maxHits, is_search);
+                                               metaStoreReadGuard, maxHits, is_search, _field_cost_model.get());
 }
 
 size_t
@@ -35,6 +35,7 @@ namespace search::engine {
 }
 namespace search { struct IDocumentMetaStore; }
 namespace search::fef { class RankSetup; }
+namespace search::queryeval { class FieldCostModel; }
 
 namespace proton::matching {
 
@@ -59,6 +60,7 @@ private:
     using MatchingElements = search::MatchingElements;
     using MatchingElementsFields = search::MatchingElementsFields;
     using steady_time = vespalib::steady_time;
+    using FieldCostModel = search::queryeval::FieldCostModel;
     IndexEnvironment                _indexEnv;
     search::fef::BlueprintFactory   _blueprintFactory;
     std::shared_ptr<RankSetup>      _rankSetup;
@@ -69,6 +71,7 @@ private:
     const std::atomic<steady_time> &_now_ref;
     QueryLimiter                   &_queryLimiter;
     uint32_t                        _distributionKey;
+    std::unique_ptr<FieldCostModel> _field_cost_model;
 
     size_t computeNumThreadsPerSearch(search::queryeval::Blueprint::HitEstimate hits,
                                       const Properties & rankProperties) const;
@@ -103,6 +106,12 @@ public:
      **/
     MatchingStats getStats();
 
+    /**
+     * Measured per field cost used to adjust query planning for
+     * queries using this matcher.
+     **/
+    const FieldCostModel &get_field_cost_model() const noexcept { return *_field_cost_model; }
+
     /**
      * Create the low-level tools needed to perform matching. This
      * function is exposed for testing purposes.
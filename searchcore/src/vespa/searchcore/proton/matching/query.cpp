@@ -13,6 +13,8 @@
 #include <vespa/searchlib/engine/trace.h>
 #include <vespa/searchlib/parsequery/stackdumpiterator.h>
 #include <vespa/searchlib/query/tree/templatetermvisitor.h>
+#include <vespa/searchlib/queryeval/cost_sampling_iterator.h>
+#include <vespa/searchlib/queryeval/field_cost_model.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
 #include <vespa/vespalib/util/issue.h>
 #include <vespa/vespalib/util/thread_bundle.h>
@@ -38,6 +40,7 @@ using search::query::Weight;
 using search::queryeval::AndBlueprint;
 using search::queryeval::AndNotBlueprint;
 using search::queryeval::Blueprint;
+using search::queryeval::CostSamplingIterator;
 using search::queryeval::GlobalFilter;
 using search::queryeval::IRequestContext;
 using search::queryeval::IntermediateBlueprint;
@@ -228,11 +231,20 @@ Query::enumerate_blueprint_nodes() noexcept
     _blueprint->enumerate(1);
 }
 
+void
+Query::set_field_cost_model(FieldCostModel *model, bool sample)
+{
+    _field_cost_model = model;
+    _field_cost_factors = (model != nullptr) ? model->get_cost_factors() : nullptr;
+    _sample_field_cost = (model != nullptr) && sample;
+}
+
 void
 Query::optimize(InFlow in_flow, bool sort_by_cost)
 {
     _in_flow = in_flow;
-    auto opts = Blueprint::Options().sort_by_cost(sort_by_cost).allow_force_strict(sort_by_cost);
+    auto opts = Blueprint::Options().sort_by_cost(sort_by_cost).allow_force_strict(sort_by_cost)
+                                    .field_cost_factors(sort_by_cost ? _field_cost_factors.get() : nullptr);
     _blueprint = Blueprint::optimize_and_sort(std::move(_blueprint), in_flow, opts);
     LOG(debug, "optimized blueprint:\n%s\n", _blueprint->asString().c_str());
 }
@@ -255,7 +267,8 @@ Query::handle_global_filter(const IRequestContext & requestContext, uint32_t doc
     }
     // optimized order may change after accounting for global filter:
     trace.addEvent(5, "Optimize query execution plan to account for global filter");
-    auto opts = Blueprint::Options().sort_by_cost(sort_by_cost).allow_force_strict(sort_by_cost);
+    auto opts = Blueprint::Options().sort_by_cost(sort_by_cost).allow_force_strict(sort_by_cost)
+                                    .field_cost_factors(sort_by_cost ? _field_cost_factors.get() : nullptr);
     _blueprint = Blueprint::optimize_and_sort(std::move(_blueprint), _in_flow, opts);
     LOG(debug, "blueprint after handle_global_filter:\n%s\n", _blueprint->asString().c_str());
     // strictness may change if optimized order changed:
@@ -329,6 +342,7 @@ Query::estimate() const
 SearchIterator::UP
 Query::createSearch(MatchData &md) const
 {
+    CostSamplingIterator::Bind bind(_sample_field_cost ? _field_cost_model : nullptr);
     return _blueprint->createSearch(md);
 }
 
@@ -12,6 +12,7 @@
 
 namespace vespalib { struct ThreadBundle; }
 namespace search::engine { class Trace; }
+namespace search::queryeval { class FieldCostModel; }
 
 namespace proton::matching {
 
@@ -27,12 +28,17 @@ private:
     using IRequestContext = search::queryeval::IRequestContext;
     using GeoLocationSpec = search::common::GeoLocationSpec;
     using InFlow = search::queryeval::InFlow;
+    using FieldCostFactors = search::queryeval::FieldCostFactors;
+    using FieldCostModel = search::queryeval::FieldCostModel;
     search::query::Node::UP      _query_tree;
     InFlow                       _in_flow = InFlow(true);
     Blueprint::UP                _blueprint;
     Blueprint::UP                _whiteListBlueprint;
     std::vector<GeoLocationSpec> _locations;
     bool                         _needs_ranking = false;
+    FieldCostModel              *_field_cost_model = nullptr;
+    std::shared_ptr<const FieldCostFactors> _field_cost_factors;
+    bool                         _sample_field_cost = false;
 
 public:
     /** Convenience typedef. */
@@ -101,6 +107,14 @@ public:
      * test to verify the original query without optimization.
      **/
     void optimize(InFlow in_flow, bool sort_by_cost);
+
+    /**
+     * Use measured per field cost from the given model when
+     * optimizing the query. If 'sample' is true, the leaf iterators
+     * created by createSearch will also report their measured cost
+     * back to the model.
+     **/
+    void set_field_cost_model(FieldCostModel *model, bool sample);
     void fetchPostings(const ExecuteInfo & executeInfo);
 
     void handle_global_filter(const IRequestContext & requestContext, uint32_t docid_limit,
@@ -338,6 +338,7 @@ DocumentDB::initFinish(DocumentDBConfig::SP configSnapshot)
     assert(_writeService.master().isCurrentThread());
     _bucketHandler.setReadyBucketHandler(_subDBs.getReadySubDB()->getDocumentMetaStoreContext().get());
     _subDBs.initViews(*configSnapshot);
+    _subDBs.getReadySubDB()->getSummaryManager()->getBackingStore().set_cache_budget_manager(_owner.get_summary_cache_budget_manager());
     syncFeedView();
     // Check that feed view has been activated.
     assert(_feedView.get());
@@ -603,6 +604,10 @@ DocumentDB::~DocumentDB()
 void
 DocumentDB::closeSubDBs()
 {
+    const auto & summary_manager = _subDBs.getReadySubDB()->getSummaryManager();
+    if (summary_manager) {
+        summary_manager->getBackingStore().set_cache_budget_manager({});
+    }
     _subDBs.close();
 }
 
@@ -185,6 +185,8 @@ deriveConfig(const ProtonConfig::Summary & summary, const vespalib::HwInfo & hwI
     logConfig.setMaxFileSize(log.maxfilesize)
             .setMaxNumLids(log.maxnumlids)
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
+            .setMaxDeltaFactor(log.maxdeltafactor)
+            .setMaxReadAhead(log.maxreadahead)
             .compactCompression(deriveCompression(log.compact.compression))
             .setFileConfig(fileConfig);
     return {config, logConfig};
@@ -42,6 +42,12 @@ FastAccessFeedView::updateAttributes(SerialNum serialNum, Lid lid, FutureDoc fut
     }
 }
 
+bool
+FastAccessFeedView::updateAttributesNeedsDocument() const
+{
+    return _attributeWriter->hasStructFieldAttribute();
+}
+
 void
 FastAccessFeedView::removeAttributes(SerialNum serialNum, search::DocumentIdT lid, const OnRemoveDoneType& onWriteDone)
 {
@@ -41,6 +41,7 @@ private:
     void updateAttributes(SerialNum serialNum, search::DocumentIdT lid, const document::DocumentUpdate &upd,
                           const OnOperationDoneType& onWriteDone, IFieldUpdateCallback & onUpdate) override;
     void updateAttributes(SerialNum serialNum, Lid lid, FutureDoc doc, const OnOperationDoneType& onWriteDone) override;
+    bool updateAttributesNeedsDocument() const override;
     void removeAttributes(SerialNum serialNum, search::DocumentIdT lid, const OnRemoveDoneType& onWriteDone) override;
 
     void removeAttributes(SerialNum serialNum, const LidVector &lidsToRemove, const OnWriteDoneType& onWriteDone) override;
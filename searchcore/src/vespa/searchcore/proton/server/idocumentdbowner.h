@@ -5,6 +5,8 @@
 #include <memory>
 #include <cstdint>
 
+namespace vespalib { class CacheBudgetManager; }
+
 namespace proton {
 
 class IDocumentDBReferenceRegistry;
@@ -21,6 +23,7 @@ public:
     virtual uint32_t getNumThreadsPerSearch() const = 0;
     virtual SessionManager & session_manager() = 0;
     virtual std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const = 0;
+    virtual std::shared_ptr<vespalib::CacheBudgetManager> get_summary_cache_budget_manager() const = 0;
 };
 
 } // namespace proton
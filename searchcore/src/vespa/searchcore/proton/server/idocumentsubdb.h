@@ -39,6 +39,7 @@ class IReplayConfig;
 class ISearchHandler;
 class ISummaryAdapter;
 class ISummaryManager;
+class Matchers;
 class PendingLidTrackerBase;
 class ReconfigParams;
 class RemoveDocumentsOperation;
@@ -126,6 +127,7 @@ public:
     virtual std::shared_ptr<IDocumentRetriever> getDocumentRetriever() = 0;
 
     virtual matching::MatchingStats getMatcherStats(const std::string &rankProfile) const = 0;
+    virtual std::shared_ptr<const Matchers> get_matchers() const = 0;
     virtual void close() = 0;
     virtual std::shared_ptr<IDocumentDBReference> getDocumentDBReference() = 0;
     virtual void tearDownReferences(IDocumentDBReferenceResolver &resolver) = 0;
@@ -8,6 +8,7 @@
 namespace document {
     class Document;
     class DocumentTypeRepo;
+    class DocumentUpdate;
 }
 namespace search { class IDocumentStore; }
 namespace vespalib { class nbostream; }
@@ -31,6 +32,13 @@ public:
     // feed interface
     virtual void put(SerialNum serialNum, const DocumentIdT lid, const Document &doc) = 0;
     virtual void put(SerialNum serialNum, const DocumentIdT lid, const vespalib::nbostream & os) = 0;
+    /**
+     * Apply a partial update directly to the stored document. Only used when has_update_deltas() is true,
+     * otherwise the updated document is put.
+     */
+    virtual void update(SerialNum serialNum, const DocumentIdT lid, const document::DocumentUpdate & upd,
+                        const DocumentTypeRepo & repo) = 0;
+    virtual bool has_update_deltas() const = 0;
     virtual void remove(SerialNum serialNum, const DocumentIdT lid) = 0;
     virtual void heartBeat(SerialNum serialNum) = 0;
     virtual const search::IDocumentStore &getDocumentStore() const = 0;
@@ -70,4 +70,12 @@ Matchers::lookup(const std::string &name) const
     return found->second;
 }
 
+void
+Matchers::for_each(const std::function<void(const std::string &name, const matching::Matcher &matcher)> &func) const
+{
+    for (const auto &entry : _rpmap) {
+        func(entry.first, *entry.second);
+    }
+}
+
 } // namespace proton
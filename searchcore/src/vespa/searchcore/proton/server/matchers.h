@@ -5,6 +5,7 @@
 #include <vespa/searchcore/proton/matching/matching_stats.h>
 #include <vespa/searchlib/fef/ranking_assets_repo.h>
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <functional>
 
 namespace proton {
 
@@ -32,6 +33,7 @@ public:
     matching::MatchingStats getStats() const;
     matching::MatchingStats getStats(const std::string &name) const;
     std::shared_ptr<matching::Matcher> lookup(const std::string &name) const;
+    void for_each(const std::function<void(const std::string &name, const matching::Matcher &matcher)> &func) const;
     const search::fef::RankingAssetsRepo& get_ranking_assets_repo() const noexcept { return _ranking_assets_repo; }
 };
 
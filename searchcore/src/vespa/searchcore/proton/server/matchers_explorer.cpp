@@ -0,0 +1,41 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "matchers_explorer.h"
+#include "matchers.h"
+#include <vespa/searchcore/proton/matching/matcher.h>
+#include <vespa/searchlib/queryeval/field_cost_model.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/data/slime/inserter.h>
+
+using proton::matching::Matcher;
+using vespalib::slime::Cursor;
+using vespalib::slime::Inserter;
+
+namespace proton {
+
+MatchersExplorer::MatchersExplorer(std::shared_ptr<const Matchers> matchers)
+    : _matchers(std::move(matchers))
+{
+}
+
+MatchersExplorer::~MatchersExplorer() = default;
+
+void
+MatchersExplorer::get_state(const Inserter &inserter, bool full) const
+{
+    Cursor &object = inserter.insertObject();
+    if (full) {
+        Cursor &profiles = object.setObject("rank_profiles");
+        _matchers->for_each([&profiles](const std::string &name, const Matcher &matcher) {
+            const auto &index_env = matcher.get_index_env();
+            auto field_name = [&index_env](uint32_t field_id) -> std::string {
+                const auto *field = index_env.getField(field_id);
+                return (field != nullptr) ? field->name() : std::string();
+            };
+            Cursor &profile = profiles.setObject(name);
+            matcher.get_field_cost_model().to_slime(profile.setObject("field_cost"), field_name);
+        });
+    }
+}
+
+}
@@ -0,0 +1,29 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/net/http/state_explorer.h>
+#include <memory>
+
+namespace proton {
+
+class Matchers;
+
+/**
+ * Class used to explore the state of the matchers (one per rank
+ * profile) of a document sub database, exposing the measured per
+ * field cost used when planning queries.
+ */
+class MatchersExplorer : public vespalib::StateExplorer
+{
+private:
+    std::shared_ptr<const Matchers> _matchers;
+
+public:
+    explicit MatchersExplorer(std::shared_ptr<const Matchers> matchers);
+    ~MatchersExplorer() override;
+
+    void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
+};
+
+}
@@ -44,6 +44,7 @@
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/net/http/state_server.h>
+#include <vespa/vespalib/stllike/cache_budget_manager.h>
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/host_name.h>
@@ -185,6 +186,20 @@ make_posting_list_cache(const ProtonConfig& cfg)
     return std::make_shared<PostingListCache>(params);
 }
 
+std::shared_ptr<vespalib::CacheBudgetManager>
+make_summary_cache_budget_manager(const ProtonConfig& cfg, const vespalib::HwInfo& hwInfo)
+{
+    int64_t max_bytes = cfg.summary.cache.budget.maxbytes;
+    if (max_bytes == 0) {
+        return {};
+    }
+    if (max_bytes < 0) {
+        // Same semantics as summary.cache.maxbytes, cf. DocumentDBConfigManager
+        max_bytes = (hwInfo.memory().sizeBytes() * std::min(INT64_C(50), -max_bytes)) / 100l;
+    }
+    return std::make_shared<vespalib::CacheBudgetManager>(max_bytes, 0);
+}
+
 } // namespace <unnamed>
 
 Proton::ProtonFileHeaderContext::ProtonFileHeaderContext(const std::string &creator)
@@ -295,7 +310,8 @@ Proton::Proton(FNET_Transport & transport, const config::ConfigUri & configUri,
       _documentDBReferenceRegistry(std::make_shared<DocumentDBReferenceRegistry>()),
       _nodeUpLock(),
       _nodeUp(),
-      _posting_list_cache()
+      _posting_list_cache(),
+      _summary_cache_budget_manager()
 { }
 
 BootstrapConfig::SP
@@ -326,6 +342,7 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     setFS4Compression(protonConfig);
     _diskMemUsageSampler = std::make_unique<DiskMemUsageSampler>(protonConfig.basedir, hwInfo);
     _posting_list_cache = make_posting_list_cache(protonConfig);
+    _summary_cache_budget_manager = make_summary_cache_budget_manager(protonConfig, hwInfo);
 
     _tls = std::make_unique<TLS>(_configUri.createWithNewId(protonConfig.tlsconfigid), _fileHeaderContext);
     _metricsEngine->addMetricsHook(*_metricsHook);
@@ -410,6 +427,12 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _sessionPruneHandle = _scheduler->scheduleAtFixedRate(makeLambdaTask([&]() {
         _sessionManager->pruneTimedOutSessions(vespalib::steady_clock::now(), _shared_service->shared());
     }), pruneSessionsInterval, pruneSessionsInterval);
+    if (_summary_cache_budget_manager) {
+        vespalib::duration rebalanceInterval = vespalib::from_s(protonConfig.summary.cache.budget.interval);
+        _summaryCacheRebalanceHandle = _scheduler->scheduleAtFixedRate(makeLambdaTask([&]() {
+            _summary_cache_budget_manager->rebalance();
+        }), rebalanceInterval, rebalanceInterval);
+    }
     _isInitializing = false;
     _protonConfigurer.setAllowReconfig(true);
     _initComplete = true;
@@ -499,6 +522,7 @@ Proton::~Proton()
         _diskMemUsageSampler->notifier().removeDiskMemUsageListener(_memoryFlushConfigUpdater.get());
     }
     _sessionPruneHandle.reset();
+    _summaryCacheRebalanceHandle.reset();
     if (_diskMemUsageSampler) {
         _diskMemUsageSampler->close();
     }
@@ -1098,6 +1122,12 @@ Proton::getDocumentDBReferenceRegistry() const
     return _documentDBReferenceRegistry;
 }
 
+std::shared_ptr<vespalib::CacheBudgetManager>
+Proton::get_summary_cache_budget_manager() const
+{
+    return _summary_cache_budget_manager;
+}
+
 matching::SessionManager &
 Proton::session_manager() {
     return *_sessionManager;
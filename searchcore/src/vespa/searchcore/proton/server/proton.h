@@ -30,7 +30,10 @@
 #include <mutex>
 #include <shared_mutex>
 
-namespace vespalib { class StateServer; }
+namespace vespalib {
+    class CacheBudgetManager;
+    class StateServer;
+}
 namespace search {
     namespace attribute { class Interlock; }
     namespace transactionlog { class TransLogServerApp; }
@@ -117,6 +120,7 @@ private:
     std::unique_ptr<SharedThreadingService>   _shared_service;
     std::unique_ptr<matching::SessionManager> _sessionManager;
     IScheduledExecutor::Handle                _sessionPruneHandle;
+    IScheduledExecutor::Handle                _summaryCacheRebalanceHandle;
     std::unique_ptr<ScheduledForwardExecutor> _scheduler;
     vespalib::eval::CompileCache::ExecutorBinding::UP _compile_cache_executor_binding;
     matching::QueryLimiter          _queryLimiter;
@@ -132,6 +136,7 @@ private:
     std::mutex                      _nodeUpLock;
     std::set<BucketSpace>           _nodeUp;   // bucketspaces where node is up
     std::shared_ptr<search::diskindex::IPostingListCache> _posting_list_cache;
+    std::shared_ptr<vespalib::CacheBudgetManager>         _summary_cache_budget_manager;
 
     std::shared_ptr<DocumentDBConfigOwner>
     addDocumentDB(const DocTypeName & docTypeName, BucketSpace bucketSpace, const std::string & configid,
@@ -148,6 +153,7 @@ private:
     uint32_t getDistributionKey() const override { return _distributionKey; }
     BootstrapConfig::SP getActiveConfigSnapshot() const;
     std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const override;
+    std::shared_ptr<vespalib::CacheBudgetManager> get_summary_cache_budget_manager() const override;
     SessionManager & session_manager() override;
     // Returns true if the node is up in _any_ bucket space
     bool updateNodeUp(BucketSpace bucketSpace, bool nodeUpInBucketSpace);
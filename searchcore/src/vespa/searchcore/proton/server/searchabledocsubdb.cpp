@@ -153,6 +153,7 @@ IReprocessingTask::List
 SearchableDocSubDB::applyConfig(const DocumentDBConfig &newConfigSnapshot, const DocumentDBConfig &oldConfigSnapshot,
                                 SerialNum serialNum, const ReconfigParams &params, IDocumentDBReferenceResolver &resolver, const DocumentSubDBReconfig& prepared_reconfig)
 {
+    materializeSummaryDeltas(newConfigSnapshot, oldConfigSnapshot, serialNum);
     AllocStrategy alloc_strategy = newConfigSnapshot.get_alloc_config().make_alloc_strategy(_subDbType);
     StoreOnlyDocSubDB::reconfigure(newConfigSnapshot.getStoreConfig(), alloc_strategy);
     IReprocessingTask::List tasks;
@@ -336,6 +337,12 @@ SearchableDocSubDB::getMatcherStats(const std::string &rankProfile) const
     return _rSearchView.get()->getMatcherStats(rankProfile);
 }
 
+std::shared_ptr<const Matchers>
+SearchableDocSubDB::get_matchers() const
+{
+    return _rSearchView.get()->getMatchView()->getMatchers();
+}
+
 void
 SearchableDocSubDB::close()
 {
@@ -137,6 +137,7 @@ public:
     search::IndexStats get_index_stats(bool clear_disk_io_stats) const override ;
     std::shared_ptr<IDocumentRetriever> getDocumentRetriever() override;
     matching::MatchingStats getMatcherStats(const std::string &rankProfile) const override;
+    std::shared_ptr<const Matchers> get_matchers() const override;
     void close() override;
     std::shared_ptr<IDocumentDBReference> getDocumentDBReference() override;
     void tearDownReferences(IDocumentDBReferenceResolver &resolver) override;
@@ -10,6 +10,7 @@
 #include "minimal_document_retriever.h"
 #include "reconfig_params.h"
 #include "ibucketstatecalculator.h"
+#include <vespa/config-attributes.h>
 #include <vespa/searchcore/proton/attribute/attribute_writer.h>
 #include <vespa/searchcore/proton/bucketdb/ibucketdbhandlerinitializer.h>
 #include <vespa/searchcore/proton/common/alloc_config.h>
@@ -248,6 +249,7 @@ StoreOnlyDocSubDB::setupSummaryManager(SummaryManager::SP summaryManager)
 InitializerTask::SP
 StoreOnlyDocSubDB::
 createDocumentMetaStoreInitializer(const AllocStrategy& alloc_strategy,
+                                   bool sharded_reader_guards,
                                    const search::TuneFileAttributes &tuneFile,
                                    std::shared_ptr<DocumentMetaStoreInitializerResult::SP> result) const
 {
@@ -261,7 +263,8 @@ createDocumentMetaStoreInitializer(const AllocStrategy& alloc_strategy,
     // initializers to get hold of document meta store instance in
     // their constructors.
     *result = std::make_shared<DocumentMetaStoreInitializerResult>
-              (std::make_shared<DocumentMetaStore>(_bucketDB, attrFileName, grow, _subDbType), tuneFile);
+              (std::make_shared<DocumentMetaStore>(_bucketDB, attrFileName, grow, _subDbType, sharded_reader_guards),
+               tuneFile);
     return std::make_shared<documentmetastore::DocumentMetaStoreInitializer>
         (baseDir, getSubDbName(), _docTypeName.toString(), (*result)->documentMetaStore());
 }
@@ -302,6 +305,21 @@ createStoreConfig(const search::LogDocumentStore::Config &original, SubDbType su
     return cfg;
 }
 
+/*
+ * The document meta store is read by the same query threads as the attributes, so it
+ * uses sharded reader guards when any attribute in the document type is configured to.
+ */
+bool
+use_sharded_reader_guards(const DocumentDBConfig::AttributesConfig &attributes_config)
+{
+    for (const auto &attribute : attributes_config.attribute) {
+        if (attribute.shardedreaderguards) {
+            return true;
+        }
+    }
+    return false;
+}
+
 }
 
 DocumentSubDbInitializer::UP
@@ -311,6 +329,7 @@ StoreOnlyDocSubDB::createInitializer(const DocumentDBConfig &configSnapshot, Ser
                                                              _writeService.master());
     AllocStrategy alloc_strategy = configSnapshot.get_alloc_config().make_alloc_strategy(_subDbType);
     auto dmsInitTask = createDocumentMetaStoreInitializer(alloc_strategy,
+                                                          use_sharded_reader_guards(configSnapshot.getAttributesConfig()),
                                                           configSnapshot.getTuneFileDocumentDBSP()->_attr,
                                                           result->writableResult().writableDocumentMetaStore());
     result->addDocumentMetaStoreInitTask(dmsInitTask);
@@ -438,12 +457,11 @@ IReprocessingTask::List
 StoreOnlyDocSubDB::applyConfig(const DocumentDBConfig &newConfigSnapshot, const DocumentDBConfig &oldConfigSnapshot,
                                SerialNum serialNum, const ReconfigParams &params, IDocumentDBReferenceResolver &resolver, const DocumentSubDBReconfig& prepared_reconfig)
 {
-    (void) oldConfigSnapshot;
-    (void) serialNum;
     (void) params;
     (void) resolver;
     (void) prepared_reconfig;
     assert(_writeService.master().isCurrentThread());
+    materializeSummaryDeltas(newConfigSnapshot, oldConfigSnapshot, serialNum);
     AllocStrategy alloc_strategy = newConfigSnapshot.get_alloc_config().make_alloc_strategy(_subDbType);
     reconfigure(newConfigSnapshot.getStoreConfig(), alloc_strategy);
     initFeedView(newConfigSnapshot);
@@ -492,6 +510,32 @@ StoreOnlyDocSubDB::reconfigure(const search::LogDocumentStore::Config & config,
     _rSummaryMgr->reconfigure(config);
 }
 
+/*
+ * Partial updates stored as deltas in the document store are applied when the document is read.
+ * They are written back as full documents using the old document type before it changes, as they
+ * might not apply against the new one.
+ */
+void
+StoreOnlyDocSubDB::materializeSummaryDeltas(const DocumentDBConfig &newConfigSnapshot,
+                                            const DocumentDBConfig &oldConfigSnapshot, SerialNum serialNum)
+{
+    if (newConfigSnapshot.getDocumentTypeRepoSP() == oldConfigSnapshot.getDocumentTypeRepoSP()) {
+        return;
+    }
+    auto &docStore = _rSummaryMgr->getBackingStore();
+    if (serialNum <= docStore.tentativeLastSyncToken()) {
+        return;
+    }
+    const auto &repo = *oldConfigSnapshot.getDocumentTypeRepoSP();
+    std::promise<void> promise;
+    auto future = promise.get_future();
+    _writeService.summary().execute(makeLambdaTask([&]() {
+        docStore.materialize_deltas(serialNum, repo);
+        promise.set_value();
+    }));
+    future.wait();
+}
+
 void
 StoreOnlyDocSubDB::setBucketStateCalculator(const std::shared_ptr<IBucketStateCalculator> & calc, OnDone onDone) {
     bool was_node_retired_or_maintenance = is_node_retired_or_maintenance();
@@ -564,6 +608,12 @@ StoreOnlyDocSubDB::getMatcherStats(const std::string &rankProfile) const
     return {};
 }
 
+std::shared_ptr<const Matchers>
+StoreOnlyDocSubDB::get_matchers() const
+{
+    return {};
+}
+
 void
 StoreOnlyDocSubDB::close()
 {
@@ -173,6 +173,7 @@ protected:
 
     std::shared_ptr<initializer::InitializerTask>
     createDocumentMetaStoreInitializer(const AllocStrategy& alloc_strategy,
+                                       bool sharded_reader_guards,
                                        const search::TuneFileAttributes &tuneFile,
                                        std::shared_ptr<std::shared_ptr<DocumentMetaStoreInitializerResult>> result) const;
 
@@ -183,6 +184,8 @@ protected:
     StoreOnlyFeedView::PersistentParams getFeedViewPersistentParams();
     std::string getSubDbName() const;
     void reconfigure(const search::LogDocumentStore::Config & protonConfig, const AllocStrategy& alloc_strategy);
+    void materializeSummaryDeltas(const DocumentDBConfig &newConfigSnapshot, const DocumentDBConfig &oldConfigSnapshot,
+                                  SerialNum serialNum);
     void reconfigureAttributesConsideringNodeState(OnDone onDone);
 public:
     StoreOnlyDocSubDB(const Config &cfg, const Context &ctx);
@@ -234,6 +237,7 @@ public:
     search::IndexStats get_index_stats(bool) const override;
     std::shared_ptr<IDocumentRetriever> getDocumentRetriever() override;
     matching::MatchingStats getMatcherStats(const std::string &rankProfile) const override;
+    std::shared_ptr<const Matchers> get_matchers() const override;
     void close() override;
     std::shared_ptr<IDocumentDBReference> getDocumentDBReference() override;
     void tearDownReferences(IDocumentDBReferenceResolver &resolver) override;
@@ -375,6 +375,17 @@ StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid,
             }));
 }
 
+void
+StoreOnlyFeedView::updateSummary(SerialNum serialNum, Lid lid, DocumentUpdateSP upd, const OnOperationDoneType& onDone)
+{
+    summaryExecutor().execute(
+            makeLambdaTask([serialNum, lid, upd = std::move(upd), trackerToken = _pendingLidsForDocStore.produce(lid), onDone, this] {
+                (void) onDone;
+                (void) trackerToken;
+                _summaryAdapter->update(serialNum, lid, *upd, *_repo);
+            }));
+}
+
 void
 StoreOnlyFeedView::putSummaryNoop(FutureStream futureStream, const OnOperationDoneType& onDone)
 {
@@ -463,7 +474,12 @@ StoreOnlyFeedView::internalUpdate(FeedToken token, const UpdateOperation &updOp)
     UpdateScope updateScope(_indexedFields, upd);
     updateAttributes(serialNum, lid, upd, onWriteDone, updateScope);
 
-    if (updateScope.hasIndexOrNonAttributeFields()) {
+    if (updateScope.hasIndexOrNonAttributeFields() && ! updateScope._hasIndexedFields &&
+        ! updateAttributesNeedsDocument() && useDocumentStore(serialNum) && _summaryAdapter->has_update_deltas())
+    {
+        // Only the document store needs the updated document, so it can apply the update itself.
+        updateSummary(serialNum, lid, updOp.getUpdate(), onWriteDone);
+    } else if (updateScope.hasIndexOrNonAttributeFields()) {
         PromisedDoc promisedDoc;
         FutureDoc futureDoc = promisedDoc.get_future().share();
         onWriteDone->setDocument(futureDoc);
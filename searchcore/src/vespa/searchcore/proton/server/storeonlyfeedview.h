@@ -140,6 +140,7 @@ private:
     }
     void putSummary(SerialNum serialNum, Lid lid, FutureStream doc, const OnOperationDoneType& onDone);
     void putSummaryNoop(FutureStream doc, const OnOperationDoneType& onDone);
+    void updateSummary(SerialNum serialNum, Lid lid, DocumentUpdateSP upd, const OnOperationDoneType& onDone);
     void putSummary(SerialNum serialNum, Lid lid, DocumentSP doc, const OnOperationDoneType& onDone);
     void removeSummary(SerialNum serialNum, Lid lid, const OnWriteDoneType& onDone);
     void removeSummaries(SerialNum serialNum, const LidVector & lids, const OnWriteDoneType& onDone);
@@ -184,6 +185,7 @@ private:
                                   const OnOperationDoneType& onWriteDone, IFieldUpdateCallback & onUpdate);
 
     virtual void updateAttributes(SerialNum serialNum, Lid lid, FutureDoc doc, const OnOperationDoneType& onWriteDone);
+    virtual bool updateAttributesNeedsDocument() const { return false; }
     virtual void updateIndexedFields(SerialNum serialNum, Lid lid, FutureDoc doc, const OnOperationDoneType& onWriteDone);
     virtual void removeAttributes(SerialNum serialNum, Lid lid, const OnRemoveDoneType& onWriteDone);
     virtual void removeIndexedFields(SerialNum serialNum, Lid lid, const OnRemoveDoneType& onWriteDone);
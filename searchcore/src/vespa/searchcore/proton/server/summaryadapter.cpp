@@ -2,6 +2,7 @@
 
 #include "summaryadapter.h"
 #include <vespa/searchcore/proton/docsummary/summarymanager.h>
+#include <vespa/document/update/documentupdate.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <cassert>
 #include <cinttypes>
@@ -50,6 +51,24 @@ SummaryAdapter::put(SerialNum serialNum, const DocumentIdT lid, const vespalib::
     }
 }
 
+void
+SummaryAdapter::update(SerialNum serialNum, const DocumentIdT lid, const DocumentUpdate & upd,
+                       const DocumentTypeRepo & repo)
+{
+    if ( ! ignore(serialNum) ) {
+        LOG(spam, "SummaryAdapter::update(serialnum = '%" PRIu64 "', lid = %u, docId = '%s')",
+            serialNum, lid, upd.getId().toString().c_str());
+        _mgr->updateDocument(serialNum, lid, upd, repo);
+        _lastSerial = serialNum;
+    }
+}
+
+bool
+SummaryAdapter::has_update_deltas() const
+{
+    return imgr().getBackingStore().has_update_deltas();
+}
+
 void
 SummaryAdapter::remove(SerialNum serialNum, const DocumentIdT lid)
 {
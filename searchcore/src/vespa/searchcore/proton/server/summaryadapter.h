@@ -22,6 +22,9 @@ public:
 
     void put(SerialNum serialNum, const DocumentIdT lid, const Document &doc) override;
     void put(SerialNum serialNum, const DocumentIdT lid, const vespalib::nbostream &doc) override;
+    void update(SerialNum serialNum, const DocumentIdT lid, const document::DocumentUpdate & upd,
+                const DocumentTypeRepo & repo) override;
+    bool has_update_deltas() const override;
     void remove(SerialNum serialNum, const DocumentIdT lid) override;
     void heartBeat(SerialNum serialNum) override;
     const search::IDocumentStore &getDocumentStore() const override;
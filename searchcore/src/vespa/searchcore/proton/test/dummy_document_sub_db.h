@@ -83,6 +83,9 @@ struct DummyDocumentSubDb : public IDocumentSubDB
     matching::MatchingStats getMatcherStats(const std::string &) const override {
         return {};
     }
+    std::shared_ptr<const Matchers> get_matchers() const override {
+        return {};
+    }
     std::shared_ptr<IDocumentDBReference> getDocumentDBReference() override {
         return {};
     }
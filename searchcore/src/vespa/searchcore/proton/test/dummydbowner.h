@@ -19,6 +19,7 @@ struct DummyDBOwner : IDocumentDBOwner {
     uint32_t getDistributionKey() const override { return -1; }
     uint32_t getNumThreadsPerSearch() const override { return 1; }
     std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const override;
+    std::shared_ptr<vespalib::CacheBudgetManager> get_summary_cache_budget_manager() const override { return {}; }
     SessionManager & session_manager() override;
 };
 
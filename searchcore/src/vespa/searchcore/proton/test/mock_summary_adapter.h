@@ -12,6 +12,8 @@ struct MockSummaryAdapter : public ISummaryAdapter
 {
     void put(SerialNum, DocumentIdT, const Document &) override {}
     void put(SerialNum, DocumentIdT, const vespalib::nbostream &) override {}
+    void update(SerialNum, DocumentIdT, const document::DocumentUpdate &, const DocumentTypeRepo &) override {}
+    bool has_update_deltas() const override { return false; }
     void remove(SerialNum, DocumentIdT) override {}
     void heartBeat(SerialNum) override {}
     const search::IDocumentStore &getDocumentStore() const override {
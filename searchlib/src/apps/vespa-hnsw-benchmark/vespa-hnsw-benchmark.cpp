@@ -0,0 +1,746 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/eval/eval/value_type_spec.h>
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/distance_metric_utils.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/queryeval/global_filter.h>
+#include <vespa/searchlib/tensor/bound_distance_function.h>
+#include <vespa/searchlib/tensor/dense_tensor_attribute.h>
+#include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/tensor/nearest_neighbor_index.h>
+#include <vespa/vespalib/util/bfloat16.h>
+#include <vespa/vespalib/util/doom.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/signalhandler.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/time.h>
+#include <algorithm>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <sstream>
+
+using search::BitVector;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::DistanceMetric;
+using search::attribute::DistanceMetricUtils;
+using search::attribute::HnswIndexParams;
+using search::queryeval::GlobalFilter;
+using search::tensor::BoundDistanceFunction;
+using search::tensor::DenseTensorAttribute;
+using search::tensor::NearestNeighborIndex;
+using search::tensor::PrepareResult;
+using vespalib::BFloat16;
+using vespalib::eval::CellType;
+using vespalib::eval::DenseValueView;
+using vespalib::eval::Int8Float;
+using vespalib::eval::TypedCells;
+using vespalib::eval::ValueType;
+
+/*
+ * Measures recall and latency of approximate nearest neighbor search
+ * using a hnsw index in a dense tensor attribute. Vectors are loaded from
+ * files in fvecs or bvecs format (as used by the SIFT and GIST data sets):
+ * each vector is stored as a 32-bit little endian dimension count followed
+ * by the cells as 32-bit floats (fvecs) or unsigned bytes (bvecs).
+ *
+ * Ground truth is calculated with exact distances over all documents
+ * passing the filter. Visited nodes are counted as the number of distance
+ * calculations performed by the index when searching.
+ */
+
+namespace {
+
+using Neighbors = std::vector<NearestNeighborIndex::Neighbor>;
+
+std::vector<uint32_t>
+parse_list(const std::string &value)
+{
+    std::vector<uint32_t> result;
+    std::istringstream is(value);
+    std::string elem;
+    while (std::getline(is, elem, ',')) {
+        result.push_back(std::stoul(elem));
+    }
+    return result;
+}
+
+std::vector<double>
+parse_double_list(const std::string &value)
+{
+    std::vector<double> result;
+    std::istringstream is(value);
+    std::string elem;
+    while (std::getline(is, elem, ',')) {
+        result.push_back(std::stod(elem));
+    }
+    return result;
+}
+
+class BenchmarkParams {
+    std::string           _base_file;
+    std::string           _query_file;
+    uint32_t              _max_documents;
+    uint32_t              _max_queries;
+    uint32_t              _max_links_per_node;
+    uint32_t              _neighbors_to_explore_at_insert;
+    std::vector<uint32_t> _explore_k;
+    uint32_t              _target_hits;
+    DistanceMetric        _distance_metric;
+    CellType              _cell_type;
+    uint32_t              _insert_threads;
+    uint32_t              _ground_truth_threads;
+    std::vector<double>   _filter_hit_ratios;
+    double                _filter_first_threshold;
+    double                _filter_first_exploration;
+public:
+    BenchmarkParams();
+    ~BenchmarkParams();
+    const std::string& get_base_file() const noexcept { return _base_file; }
+    const std::string& get_query_file() const noexcept { return _query_file; }
+    uint32_t get_max_documents() const noexcept { return _max_documents; }
+    uint32_t get_max_queries() const noexcept { return _max_queries; }
+    uint32_t get_max_links_per_node() const noexcept { return _max_links_per_node; }
+    uint32_t get_neighbors_to_explore_at_insert() const noexcept { return _neighbors_to_explore_at_insert; }
+    const std::vector<uint32_t>& get_explore_k() const noexcept { return _explore_k; }
+    uint32_t get_target_hits() const noexcept { return _target_hits; }
+    DistanceMetric get_distance_metric() const noexcept { return _distance_metric; }
+    CellType get_cell_type() const noexcept { return _cell_type; }
+    uint32_t get_insert_threads() const noexcept { return _insert_threads; }
+    uint32_t get_ground_truth_threads() const noexcept { return _ground_truth_threads; }
+    const std::vector<double>& get_filter_hit_ratios() const noexcept { return _filter_hit_ratios; }
+    double get_filter_first_threshold() const noexcept { return _filter_first_threshold; }
+    double get_filter_first_exploration() const noexcept { return _filter_first_exploration; }
+    void set_base_file(std::string value) { _base_file = std::move(value); }
+    void set_query_file(std::string value) { _query_file = std::move(value); }
+    void set_max_documents(uint32_t value) { _max_documents = value; }
+    void set_max_queries(uint32_t value) { _max_queries = value; }
+    void set_max_links_per_node(uint32_t value) { _max_links_per_node = value; }
+    void set_neighbors_to_explore_at_insert(uint32_t value) { _neighbors_to_explore_at_insert = value; }
+    void set_explore_k(std::vector<uint32_t> value) { _explore_k = std::move(value); }
+    void set_target_hits(uint32_t value) { _target_hits = value; }
+    void set_distance_metric(DistanceMetric value) { _distance_metric = value; }
+    void set_cell_type(CellType value) { _cell_type = value; }
+    void set_insert_threads(uint32_t value) { _insert_threads = value; }
+    void set_ground_truth_threads(uint32_t value) { _ground_truth_threads = value; }
+    void set_filter_hit_ratios(std::vector<double> value) { _filter_hit_ratios = std::move(value); }
+    void set_filter_first_threshold(double value) { _filter_first_threshold = value; }
+    void set_filter_first_exploration(double value) { _filter_first_exploration = value; }
+    bool check() const;
+};
+
+BenchmarkParams::BenchmarkParams()
+    : _base_file(),
+      _query_file(),
+      _max_documents(std::numeric_limits<uint32_t>::max()),
+      _max_queries(1000),
+      _max_links_per_node(16),
+      _neighbors_to_explore_at_insert(200),
+      _explore_k({0, 10, 50, 100, 200, 400}),
+      _target_hits(10),
+      _distance_metric(DistanceMetric::Euclidean),
+      _cell_type(CellType::FLOAT),
+      _insert_threads(1),
+      _ground_truth_threads(1),
+      _filter_hit_ratios({1.0}),
+      _filter_first_threshold(0.0),
+      _filter_first_exploration(0.3)
+{
+}
+
+BenchmarkParams::~BenchmarkParams() = default;
+
+bool
+BenchmarkParams::check() const
+{
+    if (_base_file.empty() || _query_file.empty()) {
+        std::cerr << "Both base file and query file must be specified" << std::endl;
+        return false;
+    }
+    if (_max_documents < 1u || _max_queries < 1u) {
+        std::cerr << "Too few documents or queries" << std::endl;
+        return false;
+    }
+    if (_max_links_per_node < 1u) {
+        std::cerr << "Too few links per node: " << _max_links_per_node << std::endl;
+        return false;
+    }
+    if (_target_hits < 1u) {
+        std::cerr << "Too few target hits: " << _target_hits << std::endl;
+        return false;
+    }
+    if (_insert_threads < 1u || _ground_truth_threads < 1u) {
+        std::cerr << "Too few threads" << std::endl;
+        return false;
+    }
+    for (double ratio : _filter_hit_ratios) {
+        if (ratio <= 0.0 || ratio > 1.0) {
+            std::cerr << "Filter hit ratio must be in range (0.0, 1.0]: " << ratio << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * A set of vectors loaded from a fvecs or bvecs file, converted to the
+ * cell type used by the tensor attribute.
+ */
+class VectorSet {
+    CellType          _cell_type;
+    uint32_t          _dims;
+    uint32_t          _size;
+    std::vector<char> _cells;
+
+    template <typename CellT>
+    void append(const std::vector<float>& vector) {
+        size_t offset = _cells.size();
+        _cells.resize(offset + vector.size() * sizeof(CellT));
+        auto* dst = reinterpret_cast<CellT*>(_cells.data() + offset);
+        for (float value : vector) {
+            *dst++ = CellT(value);
+        }
+    }
+    void append(const std::vector<float>& vector);
+public:
+    explicit VectorSet(CellType cell_type);
+    ~VectorSet();
+    bool load(const std::string& file_name, uint32_t max_vectors);
+    uint32_t dims() const noexcept { return _dims; }
+    uint32_t size() const noexcept { return _size; }
+    TypedCells get(uint32_t idx) const noexcept {
+        size_t bytes = _dims * vespalib::eval::CellTypeUtils::mem_size(_cell_type, 1);
+        return TypedCells(_cells.data() + idx * bytes, _cell_type, _dims);
+    }
+};
+
+VectorSet::VectorSet(CellType cell_type)
+    : _cell_type(cell_type),
+      _dims(0),
+      _size(0),
+      _cells()
+{
+}
+
+VectorSet::~VectorSet() = default;
+
+void
+VectorSet::append(const std::vector<float>& vector)
+{
+    switch (_cell_type) {
+    case CellType::DOUBLE:
+        append<double>(vector);
+        break;
+    case CellType::FLOAT:
+        append<float>(vector);
+        break;
+    case CellType::BFLOAT16:
+        append<BFloat16>(vector);
+        break;
+    case CellType::INT8:
+        append<Int8Float>(vector);
+        break;
+    }
+    ++_size;
+}
+
+bool
+VectorSet::load(const std::string& file_name, uint32_t max_vectors)
+{
+    bool bvecs = file_name.ends_with(".bvecs");
+    std::ifstream is(file_name, std::ios::binary);
+    if (!is) {
+        std::cerr << "Could not open vector file " << file_name << std::endl;
+        return false;
+    }
+    std::vector<float> vector;
+    std::vector<uint8_t> bytes;
+    int32_t dims = 0;
+    while (_size < max_vectors && is.read(reinterpret_cast<char*>(&dims), sizeof(dims))) {
+        if (dims <= 0 || (_dims != 0 && static_cast<uint32_t>(dims) != _dims)) {
+            std::cerr << "Bad dimension count " << dims << " for vector " << _size << " in " << file_name << std::endl;
+            return false;
+        }
+        _dims = dims;
+        vector.resize(dims);
+        if (bvecs) {
+            bytes.resize(dims);
+            is.read(reinterpret_cast<char*>(bytes.data()), dims);
+            std::copy(bytes.begin(), bytes.end(), vector.begin());
+        } else {
+            is.read(reinterpret_cast<char*>(vector.data()), dims * sizeof(float));
+        }
+        if (!is) {
+            std::cerr << "Truncated vector " << _size << " in " << file_name << std::endl;
+            return false;
+        }
+        append(vector);
+    }
+    if (_size == 0) {
+        std::cerr << "No vectors in " << file_name << std::endl;
+        return false;
+    }
+    std::cout << "Loaded " << _size << " vectors with " << _dims << " dimensions from " << file_name << std::endl;
+    return true;
+}
+
+/*
+ * Wraps the distance function used by the index to count the number of
+ * distance calculations.
+ */
+class CountingDistanceFunction : public BoundDistanceFunction {
+    BoundDistanceFunction::UP _df;
+    mutable uint64_t          _calcs;
+public:
+    explicit CountingDistanceFunction(BoundDistanceFunction::UP df) noexcept
+        : _df(std::move(df)),
+          _calcs(0)
+    {
+    }
+    ~CountingDistanceFunction() override;
+    double calc(TypedCells rhs) const noexcept override {
+        ++_calcs;
+        return _df->calc(rhs);
+    }
+    double calc_with_limit(TypedCells rhs, double limit) const noexcept override {
+        ++_calcs;
+        return _df->calc_with_limit(rhs, limit);
+    }
+    double convert_threshold(double threshold) const noexcept override { return _df->convert_threshold(threshold); }
+    double to_rawscore(double distance) const noexcept override { return _df->to_rawscore(distance); }
+    double to_distance(double rawscore) const noexcept override { return _df->to_distance(rawscore); }
+    double min_rawscore() const noexcept override { return _df->min_rawscore(); }
+    uint64_t calcs() const noexcept { return _calcs; }
+};
+
+CountingDistanceFunction::~CountingDistanceFunction() = default;
+
+double
+percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+    return sorted[idx];
+}
+
+class Benchmark {
+    const BenchmarkParams&                _params;
+    VectorSet                             _base;
+    VectorSet                             _queries;
+    std::shared_ptr<DenseTensorAttribute> _attr;
+
+    Config make_config() const;
+    TypedCells query(uint32_t idx) const noexcept { return _queries.get(idx); }
+    const NearestNeighborIndex& index() const { return *_attr->nearest_neighbor_index(); }
+    void report_memory_usage();
+    std::shared_ptr<GlobalFilter> make_filter(double hit_ratio) const;
+    std::vector<Neighbors> calc_ground_truth(const GlobalFilter* filter) const;
+    void run_queries(uint32_t explore_k, const GlobalFilter* filter, double hit_ratio,
+                     const std::vector<Neighbors>& ground_truth) const;
+public:
+    explicit Benchmark(const BenchmarkParams& params);
+    ~Benchmark();
+    bool load();
+    void build();
+    void run();
+};
+
+Benchmark::Benchmark(const BenchmarkParams& params)
+    : _params(params),
+      _base(params.get_cell_type()),
+      _queries(params.get_cell_type()),
+      _attr()
+{
+}
+
+Benchmark::~Benchmark() = default;
+
+Config
+Benchmark::make_config() const
+{
+    Config cfg(BasicType::TENSOR, CollectionType::SINGLE);
+    cfg.setTensorType(ValueType::make_type(_params.get_cell_type(), {{"x", _base.dims()}}));
+    cfg.set_distance_metric(_params.get_distance_metric());
+    cfg.set_hnsw_index_params(HnswIndexParams(_params.get_max_links_per_node(),
+                                              _params.get_neighbors_to_explore_at_insert(),
+                                              _params.get_distance_metric(),
+                                              _params.get_insert_threads() > 1));
+    return cfg;
+}
+
+bool
+Benchmark::load()
+{
+    if (!_base.load(_params.get_base_file(), _params.get_max_documents()) ||
+        !_queries.load(_params.get_query_file(), _params.get_max_queries())) {
+        return false;
+    }
+    if (_base.dims() != _queries.dims()) {
+        std::cerr << "Dimension mismatch between base vectors (" << _base.dims() <<
+            ") and query vectors (" << _queries.dims() << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void
+Benchmark::report_memory_usage()
+{
+    _attr->commit(true);
+    auto& status = _attr->getStatus();
+    auto index_usage = index().memory_usage();
+    std::cout << "Memory usage: attribute used=" << status.getUsed() << ", allocated=" << status.getAllocated() <<
+        ", hnsw index used=" << index_usage.usedBytes() << ", allocated=" << index_usage.allocatedBytes() << std::endl;
+}
+
+void
+Benchmark::build()
+{
+    _attr = std::make_shared<DenseTensorAttribute>("hnsw", make_config());
+    _attr->addReservedDoc();
+    _attr->addDocs(_base.size());
+    _attr->commit();
+    const ValueType& type = _attr->getConfig().tensorType();
+    uint32_t threads = _params.get_insert_threads();
+    vespalib::Timer timer;
+    if (threads > 1) {
+        // Two-phase insert: prepare a batch of documents in parallel, then complete them in the writer thread.
+        vespalib::ThreadStackExecutor executor(threads);
+        uint32_t batch_size = threads * 16;
+        std::vector<std::unique_ptr<PrepareResult>> prepared(batch_size);
+        for (uint32_t batch_start = 0; batch_start < _base.size(); batch_start += batch_size) {
+            uint32_t batch_end = std::min(batch_start + batch_size, _base.size());
+            for (uint32_t i = batch_start; i < batch_end; ++i) {
+                executor.execute(vespalib::makeLambdaTask([this, &prepared, &type, batch_start, i]() {
+                    prepared[i - batch_start] = _attr->prepare_set_tensor(i + 1, DenseValueView(type, _base.get(i)));
+                }));
+            }
+            executor.sync();
+            for (uint32_t i = batch_start; i < batch_end; ++i) {
+                _attr->complete_set_tensor(i + 1, DenseValueView(type, _base.get(i)), std::move(prepared[i - batch_start]));
+            }
+            _attr->commit();
+        }
+    } else {
+        for (uint32_t i = 0; i < _base.size(); ++i) {
+            _attr->setTensor(i + 1, DenseValueView(type, _base.get(i)));
+            if ((i % 1000) == 999) {
+                _attr->commit();
+            }
+        }
+        _attr->commit();
+    }
+    double build_time = vespalib::to_s(timer.elapsed());
+    std::cout << "Built hnsw index with " << _base.size() << " documents using " << threads << " threads in " <<
+        build_time << " seconds (" << (_base.size() / build_time) << " documents/s)" << std::endl;
+    report_memory_usage();
+}
+
+std::shared_ptr<GlobalFilter>
+Benchmark::make_filter(double hit_ratio) const
+{
+    uint32_t docid_limit = _attr->getCommittedDocIdLimit();
+    auto bv = BitVector::create(docid_limit);
+    vespalib::Rand48 rnd;
+    rnd.srand48(42);
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        if (rnd.lrand48() < hit_ratio * 0x80000000) {
+            bv->setBit(docid);
+        }
+    }
+    bv->invalidateCachedCount();
+    return GlobalFilter::create(std::move(bv));
+}
+
+std::vector<Neighbors>
+Benchmark::calc_ground_truth(const GlobalFilter* filter) const
+{
+    std::vector<Neighbors> result(_queries.size());
+    uint32_t k = _params.get_target_hits();
+    uint32_t docid_limit = _attr->getCommittedDocIdLimit();
+    auto calc_one = [this, &result, k, docid_limit, filter](uint32_t qid) {
+        auto df = index().distance_function_factory().for_query_vector(query(qid));
+        auto cmp = [](const auto& lhs, const auto& rhs) { return lhs.distance < rhs.distance; };
+        std::priority_queue<NearestNeighborIndex::Neighbor, Neighbors, decltype(cmp)> best(cmp);
+        for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+            if (filter != nullptr && !filter->check(docid)) {
+                continue;
+            }
+            double distance = df->calc(_attr->get_vector(docid, 0));
+            if (best.size() < k) {
+                best.emplace(docid, distance);
+            } else if (distance < best.top().distance) {
+                best.pop();
+                best.emplace(docid, distance);
+            }
+        }
+        auto& neighbors = result[qid];
+        while (!best.empty()) {
+            neighbors.push_back(best.top());
+            best.pop();
+        }
+        std::reverse(neighbors.begin(), neighbors.end());
+    };
+    vespalib::ThreadStackExecutor executor(_params.get_ground_truth_threads());
+    vespalib::Timer timer;
+    for (uint32_t qid = 0; qid < _queries.size(); ++qid) {
+        executor.execute(vespalib::makeLambdaTask([&calc_one, qid]() { calc_one(qid); }));
+    }
+    executor.sync();
+    std::cout << "Calculated exact ground truth for " << _queries.size() << " queries in " <<
+        vespalib::to_s(timer.elapsed()) << " seconds" << std::endl;
+    return result;
+}
+
+void
+Benchmark::run_queries(uint32_t explore_k, const GlobalFilter* filter, double hit_ratio,
+                       const std::vector<Neighbors>& ground_truth) const
+{
+    uint32_t k = _params.get_target_hits();
+    std::vector<double> latencies;
+    latencies.reserve(_queries.size());
+    uint64_t visited = 0;
+    uint64_t relevant = 0;
+    uint64_t found = 0;
+    double distance_threshold = std::numeric_limits<double>::max();
+    const auto& doom = vespalib::Doom::never();
+    vespalib::Timer total_timer;
+    for (uint32_t qid = 0; qid < _queries.size(); ++qid) {
+        CountingDistanceFunction df(index().distance_function_factory().for_query_vector(query(qid)));
+        vespalib::Timer timer;
+        Neighbors hits = (filter != nullptr)
+            ? index().find_top_k_with_filter(k, df, *filter, _params.get_filter_first_threshold(),
+                                             _params.get_filter_first_exploration(), explore_k, doom, distance_threshold)
+            : index().find_top_k(k, df, explore_k, doom, distance_threshold);
+        latencies.push_back(vespalib::count_us(timer.elapsed()) / 1000.0);
+        visited += df.calcs();
+        const auto& truth = ground_truth[qid];
+        relevant += truth.size();
+        for (const auto& hit : hits) {
+            if (std::any_of(truth.begin(), truth.end(), [&hit](const auto& elem) { return elem.docid == hit.docid; })) {
+                ++found;
+            }
+        }
+    }
+    double total_time = vespalib::to_s(total_timer.elapsed());
+    std::sort(latencies.begin(), latencies.end());
+    double recall = (relevant != 0) ? (static_cast<double>(found) / relevant) : 1.0;
+    std::cout << "filter_hit_ratio=" << hit_ratio << ", explore_k=" << explore_k << ", target_hits=" << k <<
+        ": recall@" << k << "=" << recall << ", qps=" << (_queries.size() / total_time) <<
+        ", latency ms avg=" << (std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size()) <<
+        ", p50=" << percentile(latencies, 0.5) << ", p90=" << percentile(latencies, 0.9) <<
+        ", p99=" << percentile(latencies, 0.99) << ", max=" << latencies.back() <<
+        ", avg visited nodes=" << (static_cast<double>(visited) / _queries.size()) << std::endl;
+}
+
+void
+Benchmark::run()
+{
+    for (double hit_ratio : _params.get_filter_hit_ratios()) {
+        std::shared_ptr<GlobalFilter> filter;
+        if (hit_ratio < 1.0) {
+            filter = make_filter(hit_ratio);
+            std::cout << "Generated global filter with hit ratio " << hit_ratio << " (" << filter->count() <<
+                " of " << (filter->size() - 1) << " documents)" << std::endl;
+        }
+        auto ground_truth = calc_ground_truth(filter.get());
+        for (uint32_t explore_k : _params.get_explore_k()) {
+            run_queries(explore_k, filter.get(), hit_ratio, ground_truth);
+        }
+    }
+}
+
+class App {
+    BenchmarkParams _params;
+public:
+    App();
+    ~App();
+    void usage();
+    bool get_options(int argc, char **argv);
+    int main(int argc, char **argv);
+};
+
+App::App()
+    : _params()
+{
+}
+
+App::~App() = default;
+
+void
+App::usage()
+{
+    std::cerr <<
+        "vespa-hnsw-benchmark version 0.0\n"
+        "\n"
+        "USAGE:\n";
+    std::cerr <<
+        "vespa-hnsw-benchmark\n"
+        "--base-file base-file\n"
+        "--query-file query-file\n"
+        "[--cell-type [double,float,bfloat16,int8]]\n"
+        "[--distance-metric [euclidean,angular,innerproduct,prenormalized_angular,dotproduct,hamming]]\n"
+        "[--explore-k explore-k[,explore-k...]]\n"
+        "[--filter-first-exploration exploration]\n"
+        "[--filter-first-threshold threshold]\n"
+        "[--filter-hit-ratios ratio[,ratio...]]\n"
+        "[--ground-truth-threads threads]\n"
+        "[--insert-threads threads]\n"
+        "[--max-documents documents]\n"
+        "[--max-links-per-node links]\n"
+        "[--max-queries queries]\n"
+        "[--neighbors-to-explore-at-insert neighbors]\n"
+        "[--target-hits hits]\n"
+        "\n"
+        "Vector files are in fvecs format, or in bvecs format when the file name\n"
+        "ends with '.bvecs'. A filter hit ratio of 1.0 runs queries without a\n"
+        "global filter." << std::endl;
+}
+
+bool
+App::get_options(int argc, char **argv)
+{
+    int c;
+    int long_opt_index = 0;
+    static struct option long_opts[] = {
+        { "base-file", 1, nullptr, 0 },
+        { "cell-type", 1, nullptr, 0 },
+        { "distance-metric", 1, nullptr, 0 },
+        { "explore-k", 1, nullptr, 0 },
+        { "filter-first-exploration", 1, nullptr, 0 },
+        { "filter-first-threshold", 1, nullptr, 0 },
+        { "filter-hit-ratios", 1, nullptr, 0 },
+        { "ground-truth-threads", 1, nullptr, 0 },
+        { "insert-threads", 1, nullptr, 0 },
+        { "max-documents", 1, nullptr, 0 },
+        { "max-links-per-node", 1, nullptr, 0 },
+        { "max-queries", 1, nullptr, 0 },
+        { "neighbors-to-explore-at-insert", 1, nullptr, 0 },
+        { "query-file", 1, nullptr, 0 },
+        { "target-hits", 1, nullptr, 0 },
+        { nullptr, 0, nullptr, 0 }
+    };
+    enum longopts_enum {
+        LONGOPT_BASE_FILE,
+        LONGOPT_CELL_TYPE,
+        LONGOPT_DISTANCE_METRIC,
+        LONGOPT_EXPLORE_K,
+        LONGOPT_FILTER_FIRST_EXPLORATION,
+        LONGOPT_FILTER_FIRST_THRESHOLD,
+        LONGOPT_FILTER_HIT_RATIOS,
+        LONGOPT_GROUND_TRUTH_THREADS,
+        LONGOPT_INSERT_THREADS,
+        LONGOPT_MAX_DOCUMENTS,
+        LONGOPT_MAX_LINKS_PER_NODE,
+        LONGOPT_MAX_QUERIES,
+        LONGOPT_NEIGHBORS_TO_EXPLORE_AT_INSERT,
+        LONGOPT_QUERY_FILE,
+        LONGOPT_TARGET_HITS
+    };
+    optind = 1;
+    try {
+        while ((c = getopt_long(argc, argv, "", long_opts, &long_opt_index)) != -1) {
+            switch (c) {
+            case 0:
+                switch(long_opt_index) {
+                case LONGOPT_BASE_FILE:
+                    _params.set_base_file(optarg);
+                    break;
+                case LONGOPT_CELL_TYPE:
+                {
+                    auto cell_type = vespalib::eval::value_type::cell_type_from_name(optarg);
+                    if (!cell_type.has_value()) {
+                        std::cerr << "Unknown cell type " << optarg << std::endl;
+                        return false;
+                    }
+                    _params.set_cell_type(cell_type.value());
+                    break;
+                }
+                case LONGOPT_DISTANCE_METRIC:
+                    _params.set_distance_metric(DistanceMetricUtils::to_distance_metric(optarg));
+                    break;
+                case LONGOPT_EXPLORE_K:
+                    _params.set_explore_k(parse_list(optarg));
+                    break;
+                case LONGOPT_FILTER_FIRST_EXPLORATION:
+                    _params.set_filter_first_exploration(atof(optarg));
+                    break;
+                case LONGOPT_FILTER_FIRST_THRESHOLD:
+                    _params.set_filter_first_threshold(atof(optarg));
+                    break;
+                case LONGOPT_FILTER_HIT_RATIOS:
+                    _params.set_filter_hit_ratios(parse_double_list(optarg));
+                    break;
+                case LONGOPT_GROUND_TRUTH_THREADS:
+                    _params.set_ground_truth_threads(atoi(optarg));
+                    break;
+                case LONGOPT_INSERT_THREADS:
+                    _params.set_insert_threads(atoi(optarg));
+                    break;
+                case LONGOPT_MAX_DOCUMENTS:
+                    _params.set_max_documents(atoi(optarg));
+                    break;
+                case LONGOPT_MAX_LINKS_PER_NODE:
+                    _params.set_max_links_per_node(atoi(optarg));
+                    break;
+                case LONGOPT_MAX_QUERIES:
+                    _params.set_max_queries(atoi(optarg));
+                    break;
+                case LONGOPT_NEIGHBORS_TO_EXPLORE_AT_INSERT:
+                    _params.set_neighbors_to_explore_at_insert(atoi(optarg));
+                    break;
+                case LONGOPT_QUERY_FILE:
+                    _params.set_query_file(optarg);
+                    break;
+                case LONGOPT_TARGET_HITS:
+                    _params.set_target_hits(atoi(optarg));
+                    break;
+                default:
+                    return false;
+                }
+                break;
+            default:
+                return false;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Bad option value: " << e.what() << std::endl;
+        return false;
+    }
+    return _params.check();
+}
+
+int
+App::main(int argc, char **argv)
+{
+    if (!get_options(argc, argv)) {
+        usage();
+        return 1;
+    }
+    Benchmark bm(_params);
+    if (!bm.load()) {
+        return 1;
+    }
+    bm.build();
+    bm.run();
+    return 0;
+}
+
+}
+
+int main(int argc, char **argv) {
+    vespalib::SignalHandler::PIPE.ignore();
+    App app;
+    return app.main(argc, argv);
+}
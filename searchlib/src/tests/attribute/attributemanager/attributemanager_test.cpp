@@ -254,6 +254,18 @@ TEST(AttributeManagerTest, require_that_config_can_be_converted)
         a.paged = true;
         EXPECT_TRUE(CC::convert(a).paged());
     }
+    {
+        CACA a;
+        EXPECT_FALSE(CC::convert(a).sharded_reader_guards());
+        a.shardedreaderguards = true;
+        EXPECT_TRUE(CC::convert(a).sharded_reader_guards());
+    }
+    {
+        CACA a;
+        EXPECT_FALSE(CC::convert(a).compressed_multi_value());
+        a.compressedmultivalue = true;
+        EXPECT_TRUE(CC::convert(a).compressed_multi_value());
+    }
     { // tensor
         CACA a;
         a.datatype = CACAD::TENSOR;
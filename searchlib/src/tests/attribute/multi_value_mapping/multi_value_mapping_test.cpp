@@ -98,11 +98,11 @@ public:
         _attr = std::make_unique<AttributeType>(*_mvMapping);
         _maxSmallArraySize = _mvMapping->get_mapper().get_array_size(max_array_store_type_id);
     }
-    void setup(uint32_t max_array_store_type_id, size_t min_entries, size_t max_entries, size_t num_entries_for_new_buffer, bool enable_free_lists = true) {
+    void setup(uint32_t max_array_store_type_id, size_t min_entries, size_t max_entries, size_t num_entries_for_new_buffer, bool enable_free_lists = true, bool compress_values = false) {
         ArrayStoreConfig config(max_array_store_type_id,
                                 ArrayStoreConfig::AllocSpec(min_entries, max_entries, num_entries_for_new_buffer, ALLOC_GROW_FACTOR));
         config.enable_free_lists(enable_free_lists);
-        _mvMapping = std::make_unique<MvMapping>(config, ArrayStoreConfig::default_max_buffer_size, vespalib::GrowStrategy(), std::make_unique<MemoryAllocatorObserver>(_stats));
+        _mvMapping = std::make_unique<MvMapping>(config, ArrayStoreConfig::default_max_buffer_size, vespalib::GrowStrategy(), std::make_unique<MemoryAllocatorObserver>(_stats), compress_values);
         _attr = std::make_unique<AttributeType>(*_mvMapping);
         _maxSmallArraySize = _mvMapping->get_mapper().get_array_size(max_array_store_type_id);
     }
@@ -112,7 +112,8 @@ public:
     ConstArrayRef get(uint32_t docId) { return _mvMapping->get(docId); }
     ArrayRef get_writable(uint32_t docId) { return _mvMapping->get_writable(docId); }
     void assertGet(uint32_t docId, const std::vector<ElemT> &exp) {
-        ConstArrayRef act = get(docId);
+        std::vector<ElemT> buffer;
+        ConstArrayRef act = _mvMapping->get(docId, buffer);
         EXPECT_EQ(exp, std::vector<ElemT>(act.begin(), act.end()));
     }
     void assign_generation(generation_t current_gen) { _mvMapping->assign_generation(current_gen); }
@@ -372,4 +373,63 @@ TEST_F(CompactionIntMappingTest, test_that_compaction_works)
     EXPECT_LT(bufferCountAfter, bufferCountBefore);
 }
 
+TEST_F(CompactionIntMappingTest, test_that_compaction_works_with_compressed_values)
+{
+    setup(3, 64, 512, 129, true, true);
+    EXPECT_TRUE(_mvMapping->is_compressed());
+    addRandomDocs(1000);
+    for (uint32_t docId = 0; docId < 500; ++docId) {
+        clearDoc(docId);
+    }
+    for (uint32_t compactIter = 0; compactIter < 3; ++compactIter) {
+        compactWorst();
+        checkRefMapping();
+    }
+}
+
+using Int64MappingTest = MappingTestBase<int64_t>;
+
+TEST_F(Int64MappingTest, test_that_set_and_get_works_with_compressed_values)
+{
+    setup(3, 0, RefType::offsetSize(), 8_Ki, true, true);
+    EXPECT_TRUE(_mvMapping->is_compressed());
+    set(1, {});
+    set(2, {4, 7});
+    set(3, {-5});
+    set(4, {10, 14, 17, 16, 10});
+    set(5, {std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()});
+    assertGet(1, {});
+    assertGet(2, {4, 7});
+    assertGet(3, {-5});
+    assertGet(4, {10, 14, 17, 16, 10});
+    assertGet(5, {std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()});
+    EXPECT_EQ(0u, _mvMapping->get_value_count(1));
+    EXPECT_EQ(5u, _mvMapping->get_value_count(4));
+    EXPECT_EQ(10u, getTotalValueCnt());
+    set(4, {3});
+    assertGet(4, {3});
+    EXPECT_EQ(6u, getTotalValueCnt());
+}
+
+TEST_F(Int64MappingTest, test_that_read_view_decodes_compressed_values)
+{
+    setup(3, 0, RefType::offsetSize(), 8_Ki, true, true);
+    set(1, {1000000, 1000003, 999999});
+    set(2, {42});
+    auto read_view = _mvMapping->make_read_view(size());
+    EXPECT_TRUE(read_view.is_compressed());
+    std::vector<int64_t> buffer;
+    assertArray({1000000, 1000003, 999999}, read_view.get(1, buffer));
+    assertArray({42}, read_view.get(2, buffer));
+    assertArray({}, read_view.get(3, buffer));
+}
+
+TEST_F(IntMappingTest, test_that_compression_is_ignored_for_non_integer_values)
+{
+    using FloatMapping = search::attribute::MultiValueMapping<float>;
+    ArrayStoreConfig config(3, ArrayStoreConfig::AllocSpec(0, RefType::offsetSize(), 8_Ki, ALLOC_GROW_FACTOR));
+    FloatMapping mapping(config, ArrayStoreConfig::default_max_buffer_size, vespalib::GrowStrategy(), std::make_unique<MemoryAllocatorObserver>(_stats), true);
+    EXPECT_FALSE(mapping.is_compressed());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,238 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchcommon/attribute/search_context_params.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/posting_bitvector_cache.h>
+#include <vespa/searchlib/attribute/search_context.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace search;
+using namespace search::attribute;
+
+using BitVectorSP = PostingBitVectorCache::BitVectorSP;
+
+namespace {
+
+BitVectorSP
+make_bv(uint32_t docid_limit, std::vector<uint32_t> docids)
+{
+    BitVectorSP bv(BitVector::create(docid_limit));
+    for (uint32_t docid : docids) {
+        bv->setBit(docid);
+    }
+    bv->invalidateCachedCount();
+    return bv;
+}
+
+std::vector<uint32_t>
+hits_of(const BitVector &bv)
+{
+    std::vector<uint32_t> result;
+    bv.foreach_truebit([&result](uint32_t docid) { result.push_back(docid); });
+    return result;
+}
+
+}
+
+class PostingBitVectorCacheTest : public ::testing::Test {
+protected:
+    PostingBitVectorCache cache;
+    std::vector<bool> values;
+    PostingBitVectorCache::Matcher matches;
+    PostingBitVectorCacheTest();
+    ~PostingBitVectorCacheTest() override;
+    BitVectorSP lookup(const std::string &key, uint32_t docid_limit = 10) {
+        return cache.lookup(key, cache.get_seq(), docid_limit, matches);
+    }
+    void admit(const std::string &key) {
+        while (!lookup(key)) {
+            cache.insert(key, cache.get_seq(), 10, make_bv(10, {1, 3}));
+        }
+    }
+    void set_value(uint32_t docid, bool value) {
+        values[docid] = value;
+        cache.record_changed(docid);
+    }
+};
+
+PostingBitVectorCacheTest::PostingBitVectorCacheTest()
+    : ::testing::Test(),
+      cache(4, 2, 8),
+      values(20, false),
+      matches([this](uint32_t docid) { return values[docid]; })
+{
+    values[1] = true;
+    values[3] = true;
+}
+
+PostingBitVectorCacheTest::~PostingBitVectorCacheTest() = default;
+
+TEST_F(PostingBitVectorCacheTest, terms_are_only_admitted_after_being_looked_up_enough_times)
+{
+    EXPECT_FALSE(lookup("foo"));
+    cache.insert("foo", cache.get_seq(), 10, make_bv(10, {1, 3}));
+    EXPECT_FALSE(lookup("foo"));
+    cache.insert("foo", cache.get_seq(), 10, make_bv(10, {1, 3}));
+    auto bv = lookup("foo");
+    ASSERT_TRUE(bv);
+    EXPECT_EQ((std::vector<uint32_t>{1, 3}), hits_of(*bv));
+    EXPECT_EQ(bv, lookup("foo"));
+    EXPECT_FALSE(lookup("bar"));
+}
+
+TEST_F(PostingBitVectorCacheTest, cached_bit_vector_is_patched_with_documents_changed_since_it_was_built)
+{
+    admit("foo");
+    auto old_bv = lookup("foo");
+    set_value(1, false);
+    set_value(5, true);
+    cache.commit();
+    auto bv = lookup("foo");
+    ASSERT_TRUE(bv);
+    EXPECT_NE(old_bv, bv);
+    EXPECT_EQ((std::vector<uint32_t>{3, 5}), hits_of(*bv));
+    EXPECT_EQ(2u, bv->countTrueBits());
+    EXPECT_EQ((std::vector<uint32_t>{1, 3}), hits_of(*old_bv));
+    EXPECT_EQ(bv, lookup("foo"));
+}
+
+TEST_F(PostingBitVectorCacheTest, cached_bit_vector_is_extended_when_docid_limit_grows)
+{
+    admit("foo");
+    values[12] = true;
+    auto bv = lookup("foo", 15);
+    ASSERT_TRUE(bv);
+    EXPECT_EQ(15u, bv->size());
+    EXPECT_EQ((std::vector<uint32_t>{1, 3, 12}), hits_of(*bv));
+    EXPECT_FALSE(lookup("foo", 10));
+}
+
+TEST_F(PostingBitVectorCacheTest, bit_vector_built_by_reader_behind_cached_entry_is_not_used)
+{
+    admit("foo");
+    uint64_t old_seq = cache.get_seq();
+    set_value(5, true);
+    cache.commit();
+    ASSERT_TRUE(lookup("foo"));
+    EXPECT_FALSE(cache.lookup("foo", old_seq, 10, matches));
+    cache.insert("foo", old_seq, 10, make_bv(10, {1}));
+    EXPECT_EQ((std::vector<uint32_t>{1, 3, 5}), hits_of(*lookup("foo")));
+}
+
+TEST_F(PostingBitVectorCacheTest, cached_bit_vector_is_not_patched_when_change_log_is_truncated)
+{
+    admit("foo");
+    for (uint32_t docid = 5; docid < 15; ++docid) {
+        set_value(docid, true);
+    }
+    cache.commit();
+    EXPECT_FALSE(lookup("foo", 20));
+}
+
+TEST_F(PostingBitVectorCacheTest, changes_are_not_logged_before_cache_is_used)
+{
+    set_value(5, true);
+    cache.commit();
+    admit("foo");
+    set_value(7, true);
+    cache.commit();
+    EXPECT_EQ((std::vector<uint32_t>{1, 3, 7}), hits_of(*lookup("foo")));
+}
+
+TEST_F(PostingBitVectorCacheTest, clear_drops_cached_bit_vectors)
+{
+    admit("foo");
+    auto mem_usage = cache.get_memory_usage();
+    EXPECT_EQ(1u, cache.size());
+    cache.clear();
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_GT(mem_usage.usedBytes(), cache.get_memory_usage().usedBytes());
+    EXPECT_FALSE(lookup("foo"));
+}
+
+TEST_F(PostingBitVectorCacheTest, least_recently_used_terms_are_evicted)
+{
+    admit("foo");
+    for (auto key : {"a", "b", "c", "d"}) {
+        EXPECT_FALSE(lookup(key));
+    }
+    EXPECT_EQ(4u, cache.size());
+    EXPECT_FALSE(lookup("foo"));
+}
+
+class PostingBitVectorCacheAttributeTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t num_docs = 1000;
+    AttributeVector::SP attr;
+    PostingBitVectorCacheAttributeTest();
+    ~PostingBitVectorCacheAttributeTest() override;
+    void update(uint32_t docid, int64_t value) {
+        auto &iattr = dynamic_cast<IntegerAttribute &>(*attr);
+        iattr.update(docid, value);
+    }
+    std::vector<uint32_t> search(const std::string &term, bool use_cache) {
+        SearchContextParams params;
+        params.use_bitvector_cache(use_cache);
+        auto sc = attr->getSearch(std::make_unique<QueryTermSimple>(term, QueryTermSimple::Type::WORD), params);
+        sc->fetchPostings(queryeval::ExecuteInfo::FULL, true);
+        fef::TermFieldMatchData tfmd;
+        auto itr = sc->createIterator(&tfmd, true);
+        itr->initRange(1, attr->getCommittedDocIdLimit());
+        std::vector<uint32_t> result;
+        for (uint32_t docid = itr->seekFirst(1); !itr->isAtEnd(); docid = itr->seekNext(docid + 1)) {
+            result.push_back(docid);
+        }
+        return result;
+    }
+};
+
+PostingBitVectorCacheAttributeTest::PostingBitVectorCacheAttributeTest()
+    : ::testing::Test(),
+      attr()
+{
+    Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    cfg.setFastSearch(true);
+    attr = AttributeFactory::createAttribute("my_attribute", cfg);
+    attr->addReservedDoc();
+    AttributeVector::DocId docid;
+    for (uint32_t i = 1; i < num_docs; ++i) {
+        attr->addDoc(docid);
+        update(docid, docid % 100);
+    }
+    attr->commit();
+}
+
+PostingBitVectorCacheAttributeTest::~PostingBitVectorCacheAttributeTest() = default;
+
+TEST_F(PostingBitVectorCacheAttributeTest, cached_range_search_matches_uncached_search_after_updates)
+{
+    const std::string term("[10;19]");
+    auto expected = search(term, false);
+    EXPECT_EQ(100u, expected.size());
+    for (uint32_t i = 0; i < 2 * PostingBitVectorCache::default_min_uses; ++i) {
+        EXPECT_EQ(expected, search(term, true));
+    }
+    update(5, 15);
+    update(15, 50);
+    attr->commit();
+    AttributeVector::DocId docid;
+    attr->addDoc(docid);
+    update(docid, 11);
+    attr->commit();
+    expected = search(term, false);
+    EXPECT_EQ(101u, expected.size());
+    EXPECT_EQ(expected.back(), docid);
+    for (uint32_t i = 0; i < 2; ++i) {
+        EXPECT_EQ(expected, search(term, true));
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -29,6 +29,7 @@
 #include <initializer_list>
 #include <memory>
 #include <set>
+#include <thread>
 
 #include <vespa/log/log.h>
 LOG_SETUP("searchcontext_test");
@@ -977,7 +978,59 @@ TEST_F(SearchContextTest, test_search_iterator)
     }
 }
 
+TEST_F(SearchContextTest, test_search_context_over_compressed_attribute_shared_by_threads)
+{
+    Config cfg(BasicType::INT64, CollectionType::ARRAY);
+    cfg.set_compressed_multi_value(true);
+    auto ptr = AttributeFactory::createAttribute("compressed-int64", cfg);
+    auto& vec = dynamic_cast<IntegerAttribute &>(*ptr);
+    constexpr uint32_t num_docs = 2000;
+    addDocs(vec, num_docs);
+    DocSet expected;
+    for (uint32_t doc = 1; doc <= num_docs; ++doc) {
+        for (uint32_t i = 0; i < 1 + doc % 7; ++i) {
+            EXPECT_TRUE(vec.append(doc, 1000000 + doc * 10 + i, 1));
+        }
+        if (doc % 3 == 0) {
+            EXPECT_TRUE(vec.append(doc, 42, 1));
+            expected.put(doc);
+        }
+    }
+    ptr->commit(true);
 
+    // A single search context is shared by all match threads, each creating its own iterator.
+    SearchContextPtr sc = getSearch(vec, 42);
+    constexpr size_t num_threads = 4;
+    std::vector<DocSet> hits(num_threads);
+    std::vector<std::thread> threads;
+    for (size_t thread_id = 0; thread_id < num_threads; ++thread_id) {
+        threads.emplace_back([&sc, &hits, thread_id, limit = vec.getCommittedDocIdLimit()]() {
+            for (uint32_t round = 0; round < 10; ++round) {
+                TermFieldMatchData tfmd;
+                SearchBasePtr sb = sc->createIterator(&tfmd, (round % 2) == 0);
+                sb->initRange(1, limit);
+                DocSet result;
+                for (uint32_t doc = 1; doc < limit; ++doc) {
+                    if (sb->seek(doc)) {
+                        result.put(doc);
+                    }
+                }
+                if (round == 0) {
+                    hits[thread_id] = std::move(result);
+                } else if (result != hits[thread_id]) {
+                    hits[thread_id].clear();
+                    return;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& thread_hits : hits) {
+        EXPECT_EQ(expected, thread_hits);
+    }
+}
 
 //-----------------------------------------------------------------------------
 // Test search iterator unpacking
@@ -1,7 +1,11 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
+#include <vespa/searchlib/attribute/attributefilesavetarget.h>
 #include <vespa/searchlib/attribute/attributeguard.h>
+#include <vespa/searchlib/attribute/attributesaver.h>
+#include <vespa/searchlib/common/tunefileinfo.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/queryeval/nearest_neighbor_blueprint.h>
 #include <vespa/searchlib/tensor/default_nearest_neighbor_index_factory.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
@@ -272,6 +276,12 @@ public:
         auto vector = _vectors.get_vector(docid, 0).typify<double>();
         _complete_adds.emplace_back(docid, DoubleVector(vector.begin(), vector.end()));
     }
+    bool bulk_add_documents(std::span<const uint32_t>, vespalib::Executor&, uint32_t) override {
+        return false;
+    }
+    bool supports_bulk_add() const noexcept override {
+        return false;
+    }
     void remove_document(uint32_t docid) override {
         auto vector = _vectors.get_vector(docid, 0).typify<double>();
         _removes.emplace_back(docid, DoubleVector(vector.begin(), vector.end()));
@@ -322,7 +332,10 @@ public:
     }
     std::vector<Neighbor> find_top_k_with_filter(uint32_t k,
                                                  const search::tensor::BoundDistanceFunction &df,
-                                                 const GlobalFilter& filter, uint32_t explore_k,
+                                                 const GlobalFilter& filter,
+                                                 double filter_first_threshold,
+                                                 double filter_first_exploration,
+                                                 uint32_t explore_k,
                                                  const vespalib::Doom& doom,
                                                  double distance_threshold) const override
     {
@@ -330,6 +343,8 @@ public:
         (void) df;
         (void) explore_k;
         (void) filter;
+        (void) filter_first_threshold;
+        (void) filter_first_exploration;
         (void) doom;
         (void) distance_threshold;
         return {};
@@ -606,6 +621,15 @@ struct Fixture {
         return result;
     }
 
+    bool save_with_executor() {
+        search::TuneFileAttributes tune;
+        search::index::DummyFileHeaderContext file_header_context;
+        search::AttributeFileSaveTarget save_target(tune, file_header_context);
+        _attr->commit();
+        auto saver = _attr->initSave(_attr->getBaseFileName());
+        return saver->save(save_target, &_executor);
+    }
+
     void loadWithExecutor() {
         _tensorAttr = makeAttr();
         _attr = _tensorAttr;
@@ -650,6 +674,7 @@ struct Fixture {
     void testOnHoldAccounting();
     void test_populate_address_space_usage();
     void test_mmap_file_allocator();
+    void test_parallel_save_load();
 };
 
 Fixture::Fixture(const std::string &typeSpec, FixtureTraits traits)
@@ -948,6 +973,40 @@ Fixture::test_mmap_file_allocator()
     }
 }
 
+void
+Fixture::test_parallel_save_load()
+{
+    SCOPED_TRACE("test_parallel_save_load");
+    // Spans several save segments and load batches
+    constexpr uint32_t num_docs = 40000;
+    auto make_spec = [](uint32_t docid) {
+        return TensorSpec(sparseSpec).add({{"x", std::to_string(docid % 7)}, {"y", "a"}}, docid);
+    };
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        if ((docid % 3) != 0) {
+            set_tensor(docid, make_spec(docid));
+        } else {
+            ensureSpace(docid);
+        }
+    }
+    auto assert_tensors = [&]() {
+        EXPECT_EQ(num_docs, _attr->getCommittedDocIdLimit());
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            if ((docid % 3) != 0) {
+                EXPECT_EQ(WrapValue(make_spec(docid)), get_tensor(docid));
+            } else {
+                EXPECT_EQ(WrapValue(), get_tensor(docid));
+            }
+        }
+    };
+    EXPECT_TRUE(save_with_executor());
+    // File saved in parallel has the same format as a file saved by a single thread
+    EXPECT_TRUE(load());
+    assert_tensors();
+    loadWithExecutor();
+    assert_tensors();
+}
+
 template <class MakeFixture>
 void testAll(MakeFixture &&f)
 {
@@ -978,6 +1037,18 @@ TEST(TensorAttributeTest, Test_sparse_tensors_with_direct_tensor_attribute)
     testAll([]() { return std::make_shared<Fixture>(sparseSpec, FixtureTraits().direct()); });
 }
 
+TEST(TensorAttributeTest, Sparse_tensors_are_saved_and_loaded_in_parallel_with_generic_tensor_attribute)
+{
+    Fixture f(sparseSpec);
+    f.test_parallel_save_load();
+}
+
+TEST(TensorAttributeTest, Sparse_tensors_are_saved_and_loaded_in_parallel_with_direct_tensor_attribute)
+{
+    Fixture f(sparseSpec, FixtureTraits().direct());
+    f.test_parallel_save_load();
+}
+
 TEST(TensorAttributeTest, Test_dense_tensors_with_generic_tensor_attribute)
 {
     testAll([]() { return std::make_shared<Fixture>(denseSpec); });
@@ -1447,7 +1518,7 @@ public:
             std::make_unique<DistanceCalculator>(this->as_dense_tensor(),
                                                  create_query_tensor(vec_2d(17, 42))),
             3, approximate, 5, 100100.25,
-            global_filter_lower_limit, 1.0, target_hits_max_adjustment_factor, vespalib::Doom::never());
+            global_filter_lower_limit, 1.0, target_hits_max_adjustment_factor, 0.0, 0.3, vespalib::Doom::never());
         EXPECT_EQ(11u, bp->getState().estimate().estHits);
         EXPECT_EQ(100100.25 * 100100.25, bp->get_distance_threshold());
         return bp;
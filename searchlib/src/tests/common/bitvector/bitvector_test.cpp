@@ -799,6 +799,23 @@ TEST("Require that parallell OR computes same result as serial") {
     }
 }
 
+TEST("require that parts copied into a vector give the same result as the original") {
+    srand(7);
+    auto org = BitVector::create(1, 5000);
+    fill(*org);
+    org->invalidateCachedCount();
+    auto assembled = BitVector::create(1, 5000);
+    std::vector<std::pair<uint32_t, uint32_t>> ranges = {{1024, 1536}, {1, 1024}, {4096, 5000}, {1536, 4096}};
+    for (const auto & range : ranges) {
+        auto part = BitVector::create(*org, range.first, range.second);
+        assembled->copy_part(*part);
+    }
+    EXPECT_TRUE(*org == *assembled);
+    EXPECT_EQUAL(org->countTrueBits(), assembled->countTrueBits());
+    assembled->invalidateCachedCount();
+    EXPECT_EQUAL(org->countTrueBits(), assembled->countTrueBits());
+}
+
 namespace {
 
 bool check_full_term_field_match_data_reset_on_unpack(bool strict, bool full_reset)
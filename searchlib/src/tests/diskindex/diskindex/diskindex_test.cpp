@@ -9,6 +9,7 @@
 #include <vespa/searchlib/diskindex/zcposocciterators.h>
 #include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchlib/queryeval/booleanmatchiteratorwrapper.h>
+#include <vespa/searchlib/queryeval/equiv_blueprint.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
@@ -33,11 +34,14 @@ using search::index::DictionaryLookupResult;
 using search::index::DummyFileHeaderContext;
 using search::index::PostingListHandle;
 using search::index::Schema;
+using search::query::SimpleFuzzyTerm;
+using search::query::SimplePrefixTerm;
 using search::query::SimpleStringTerm;
 using search::queryeval::Blueprint;
 using search::queryeval::BooleanMatchIteratorWrapper;
 using search::queryeval::EmptyBlueprint;
 using search::queryeval::EmptySearch;
+using search::queryeval::EquivBlueprint;
 using search::queryeval::ExecuteInfo;
 using search::queryeval::FakeRequestContext;
 using search::queryeval::FieldSpec;
@@ -135,6 +139,7 @@ protected:
     void requireThatWeCanReadBitVector();
     void requireThatBlueprintIsCreated();
     void requireThatBlueprintCanCreateSearchIterators();
+    void require_that_prefix_and_fuzzy_terms_are_expanded();
     void requireThatSearchIteratorsConforms();
     void require_that_get_stats_works();
     void build_index(const IOSettings& io_settings, const EmptySettings& empty_settings);
@@ -143,6 +148,7 @@ protected:
     SimpleResult search(const FieldIndex& field_index, const DictionaryLookupResult& lookup_result,
                         const PostingListHandle& handle);
     Blueprint::UP create_blueprint(const FieldSpec& field, const search::query::Node& term, uint32_t docid_limit=1000);
+    SimpleResult search_blueprint(const FieldSpec& field, const search::query::Node& term);
 };
 
 DiskIndexTest::DiskIndexTest() = default;
@@ -443,6 +449,67 @@ DiskIndexTest::requireThatBlueprintCanCreateSearchIterators()
     }
 }
 
+SimpleResult
+DiskIndexTest::search_blueprint(const FieldSpec& field, const search::query::Node& term)
+{
+    TermFieldMatchData md;
+    TermFieldMatchDataArray mda;
+    mda.add(&md);
+    auto b = create_blueprint(field, term);
+    auto s = dynamic_cast<LeafBlueprint&>(*b).createLeafSearch(mda);
+    return SimpleResult().search(*s);
+}
+
+void
+DiskIndexTest::require_that_prefix_and_fuzzy_terms_are_expanded()
+{
+    SimpleResult result_f1_w1({1,3});
+    SimpleResult result_f2_w1({2,4,6});
+    SimpleResult result_f2_w2({1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17});
+    auto prefix = [](const std::string& term) { return SimplePrefixTerm(term, "field", 0, search::query::Weight(0)); };
+    auto fuzzy = [](const std::string& term, uint32_t max_edits, uint32_t prefix_lock_length) {
+        return SimpleFuzzyTerm(term, "field", 0, search::query::Weight(0), max_edits, prefix_lock_length, false);
+    };
+    { // prefix matching single word
+        auto b = create_blueprint(FieldSpec("f1", 0, 0), prefix("w"));
+        EXPECT_TRUE(dynamic_cast<DiskTermBlueprint *>(b.get()) != nullptr);
+        EXPECT_EQ(result_f1_w1, search_blueprint(FieldSpec("f1", 0, 0), prefix("w")));
+    }
+    { // prefix matching multiple words
+        auto b = create_blueprint(FieldSpec("f2", 0, 0), prefix("w"));
+        EXPECT_TRUE(dynamic_cast<EquivBlueprint *>(b.get()) != nullptr);
+        EXPECT_EQ(result_f2_w2, search_blueprint(FieldSpec("f2", 0, 0), prefix("w")));
+    }
+    { // prefix without matching words
+        EXPECT_TRUE(dynamic_cast<EmptyBlueprint *>(create_blueprint(FieldSpec("f2", 0, 0), prefix("x")).get()) != nullptr);
+        EXPECT_TRUE(dynamic_cast<EmptyBlueprint *>(create_blueprint(FieldSpec("f2", 0, 0), prefix("w3")).get()) != nullptr);
+        EXPECT_TRUE(dynamic_cast<EmptyBlueprint *>(create_blueprint(FieldSpec("f2", 0, 0), prefix("v")).get()) != nullptr);
+    }
+    { // fuzzy matching using dfa
+        EXPECT_TRUE(dynamic_cast<EquivBlueprint *>(create_blueprint(FieldSpec("f2", 0, 0), fuzzy("w3", 1, 0)).get()) != nullptr);
+        EXPECT_EQ(result_f2_w2, search_blueprint(FieldSpec("f2", 0, 0), fuzzy("w3", 1, 0)));
+        EXPECT_EQ(result_f2_w1, search_blueprint(FieldSpec("f2", 0, 0), fuzzy("x1", 1, 0)));
+        EXPECT_EQ(result_f2_w1, search_blueprint(FieldSpec("f2", 0, 0), fuzzy("w1", 1, 2)));
+        EXPECT_TRUE(dynamic_cast<EmptyBlueprint *>(create_blueprint(FieldSpec("f2", 0, 0), fuzzy("w3", 1, 2)).get()) != nullptr);
+        EXPECT_TRUE(dynamic_cast<EmptyBlueprint *>(create_blueprint(FieldSpec("f2", 0, 0), fuzzy("xy", 1, 0)).get()) != nullptr);
+    }
+    { // fuzzy matching without dfa
+        EXPECT_EQ(result_f2_w2, search_blueprint(FieldSpec("f2", 0, 0), fuzzy("xyz", 3, 0)));
+        EXPECT_EQ(result_f2_w1, search_blueprint(FieldSpec("f2", 0, 0), fuzzy("w1", 0, 0)));
+    }
+    { // fuzzy term shorter than locked prefix
+        EXPECT_EQ(result_f2_w1, search_blueprint(FieldSpec("f2", 0, 0), fuzzy("w1", 1, 3)));
+        EXPECT_TRUE(dynamic_cast<EmptyBlueprint *>(create_blueprint(FieldSpec("f2", 0, 0), fuzzy("w", 1, 3)).get()) != nullptr);
+    }
+    { // number of expanded words is limited
+        _requestContext.get_create_blueprint_params().max_term_expansions = 1;
+        auto b = create_blueprint(FieldSpec("f2", 0, 0), prefix("w"));
+        EXPECT_TRUE(dynamic_cast<DiskTermBlueprint *>(b.get()) != nullptr);
+        EXPECT_EQ(result_f2_w1, search_blueprint(FieldSpec("f2", 0, 0), prefix("w")));
+        _requestContext.get_create_blueprint_params().max_term_expansions = search::fef::indexproperties::matching::MaxTermExpansions::DEFAULT_VALUE;
+    }
+}
+
 void
 DiskIndexTest::build_index(const IOSettings& io_settings, const EmptySettings& empty_settings)
 {
@@ -581,6 +648,12 @@ TEST_F(DiskIndexTest, io_settings_directio_posting_list_cache)
     test_io_settings(IOSettings().use_directio().use_posting_list_cache());
 }
 
+TEST_F(DiskIndexTest, prefix_and_fuzzy_terms_are_expanded)
+{
+    build_index(IOSettings(), EmptySettings());
+    require_that_prefix_and_fuzzy_terms_are_expanded();
+}
+
 TEST_F(DiskIndexTest, search_iterators_conformance)
 {
     requireThatSearchIteratorsConforms();
@@ -5,7 +5,11 @@
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/update/assignvalueupdate.h>
+#include <vespa/document/update/documentupdate.h>
+#include <vespa/document/update/fieldupdate.h>
 #include <vespa/searchlib/docstore/chunkformats.h>
+#include <vespa/searchlib/docstore/delta_record.h>
 #include <vespa/searchlib/docstore/logdocumentstore.h>
 #include <vespa/searchlib/docstore/storebybucket.h>
 #include <vespa/searchlib/docstore/visitcache.h>
@@ -24,6 +28,7 @@
 #include <charconv>
 #include <filesystem>
 #include <iomanip>
+#include <map>
 #include <random>
 
 using document::BucketId;
@@ -664,8 +669,9 @@ TEST_F(LogDataStoreTest, Control_static_memory_usage)
     constexpr size_t mutex_size = sizeof(std::mutex) * 2 * (113 + 1); // sizeof(std::mutex) is platform dependent
     constexpr size_t string_size = sizeof(std::string);
     constexpr size_t lru_segment_overhead = 352;
-    EXPECT_EQ(74476 + mutex_size + 3 * string_size + lru_segment_overhead, usage.allocatedBytes());
-    EXPECT_EQ(752u + mutex_size + 3 * string_size + lru_segment_overhead, usage.usedBytes());
+    const size_t sharded_cache_overhead = DocumentStore::get_cache_sharding_overhead_bytes(1000000);
+    EXPECT_EQ(74476 + mutex_size + 3 * string_size + lru_segment_overhead + sharded_cache_overhead, usage.allocatedBytes());
+    EXPECT_EQ(752u + mutex_size + 3 * string_size + lru_segment_overhead + sharded_cache_overhead, usage.usedBytes());
 }
 
 TEST_F(LogDataStoreTest, test_the_update_cache_strategy)
@@ -776,6 +782,145 @@ TEST_F(LogDataStoreTest, test_that_the_integrated_visit_cache_works)
     verifyCacheStats(ds.getCacheStats(), 101, 108, 99, BASE_SZ - 611, "tenth visit");
 }
 
+namespace {
+
+std::unique_ptr<document::DocumentUpdate>
+makeExtraUpdate(const DocumentTypeRepo &repo, uint32_t i, std::string_view value)
+{
+    asciistream idstr;
+    idstr << "id:test:test:: " << i;
+    const DocumentType *docType = repo.getDocumentType(doc_type_name);
+    auto upd = std::make_unique<document::DocumentUpdate>(repo, *docType, DocumentId(idstr.view()));
+    upd->addUpdate(document::FieldUpdate(docType->getField("extra"))
+                           .addUpdate(std::make_unique<document::AssignValueUpdate>(StringFieldValue::make(value))));
+    return upd;
+}
+
+class ExpectedDocs : public IDocumentVisitor, public IDocumentStoreReadVisitor, public IDocumentStoreVisitorProgress {
+public:
+    std::map<uint32_t, Document::UP> docs;
+    std::map<uint32_t, uint32_t>     visits;
+    bool                             allowCaching = false;
+
+    void visit(uint32_t lid, Document::UP doc) override { check(lid, *doc); }
+    bool allowVisitCaching() const override { return allowCaching; }
+    void visit(uint32_t lid, const DocumentSP &doc) override { check(lid, *doc); }
+    void visit(uint32_t lid) override { ++visits[lid]; }
+    void updateProgress(double) override { }
+    void check(uint32_t lid, const Document &doc) {
+        ++visits[lid];
+        ASSERT_TRUE(docs.contains(lid));
+        EXPECT_TRUE(doc == *docs[lid]) << "lid " << lid;
+    }
+    void assertRead(const IDocumentStore &ds, const DocumentTypeRepo &repo) const {
+        for (const auto &entry : docs) {
+            auto doc = ds.read(entry.first, repo);
+            ASSERT_TRUE(doc);
+            EXPECT_TRUE(*doc == *entry.second) << "lid " << entry.first;
+        }
+    }
+};
+
+}
+
+TEST_F(LogDataStoreTest, require_that_document_updates_are_applied_from_delta_records)
+{
+    DirectoryHandler dir("docdeltas");
+    DocumentTypeRepo repo(makeDocTypeRepoConfig());
+    LogDocumentStore::Config config(DocumentStore::Config(CompressionConfig::LZ4, 1000000),
+                                    LogDataStore::Config().setMaxDeltaFactor(1.0));
+    DummyFileHeaderContext fileHeaderContext;
+    vespalib::ThreadStackExecutor executor(1);
+    MyTlSyncer tlSyncer;
+    SerialNum serial(1);
+    ExpectedDocs expected;
+    {
+        LogDocumentStore ds(executor, dir.getDir(), config, GrowStrategy(), TuneFileSummary(), fileHeaderContext,
+                            tlSyncer, nullptr);
+        EXPECT_TRUE(ds.has_update_deltas());
+        for (uint32_t lid(1); lid <= 10; lid++) {
+            expected.docs[lid] = makeDoc(repo, lid, true);
+            ds.write(serial++, lid, *expected.docs[lid]);
+        }
+        for (uint32_t lid : {3u, 7u}) {
+            EXPECT_TRUE(*ds.read(lid, repo) == *expected.docs[lid]);
+            for (std::string_view value : {"bar", "baz"}) {
+                auto upd = makeExtraUpdate(repo, lid, value);
+                upd->applyTo(*expected.docs[lid]);
+                ds.update(serial++, lid, *upd, repo);
+            }
+        }
+        EXPECT_EQ("baz", expected.docs[7]->getValue("extra")->getAsString());
+        expected.assertRead(ds, repo);
+        for (bool allowCaching : {false, true, true}) {
+            expected.allowCaching = allowCaching;
+            ds.visit({2, 3, 7, 8}, repo, expected);
+        }
+        expected.visits.clear();
+        ds.accept(static_cast<IDocumentStoreReadVisitor &>(expected), expected, repo);
+        EXPECT_EQ(10u, expected.visits.size());
+        for (const auto &entry : expected.visits) {
+            EXPECT_EQ(1u, entry.second) << "lid " << entry.first;
+        }
+        ds.flush(ds.initFlush(serial));
+    }
+    {
+        LogDocumentStore ds(executor, dir.getDir(), config, GrowStrategy(), TuneFileSummary(), fileHeaderContext,
+                            tlSyncer, nullptr);
+        expected.assertRead(ds, repo);
+    }
+}
+
+namespace {
+
+class RewriteDocs : public IDocumentStoreRewriteVisitor {
+public:
+    ExpectedDocs &expected;
+    explicit RewriteDocs(ExpectedDocs &expected_in) : expected(expected_in) { }
+    void visit(uint32_t lid, const DocumentSP &doc) override { expected.visit(lid, doc); }
+};
+
+}
+
+TEST_F(LogDataStoreTest, require_that_documents_with_delta_records_in_later_files_are_rewritten_with_pruning)
+{
+    DirectoryHandler dir("docdeltasprune");
+    DocumentTypeRepo repo(makeDocTypeRepoConfig());
+    LogDocumentStore::Config config(DocumentStore::Config(CompressionConfig::LZ4, 1000000),
+                                    LogDataStore::Config().setMaxDeltaFactor(1.0).setMaxNumLids(3));
+    DummyFileHeaderContext fileHeaderContext;
+    vespalib::ThreadStackExecutor executor(1);
+    MyTlSyncer tlSyncer;
+    SerialNum serial(1);
+    ExpectedDocs expected;
+    LogDocumentStore ds(executor, dir.getDir(), config, GrowStrategy(), TuneFileSummary(), fileHeaderContext,
+                        tlSyncer, nullptr);
+    for (uint32_t lid(1); lid <= 10; lid++) {
+        expected.docs[lid] = makeDoc(repo, lid, true);
+        ds.write(serial++, lid, *expected.docs[lid]);
+    }
+    auto update = [&](uint32_t lid, std::string_view value) {
+        auto upd = makeExtraUpdate(repo, lid, value);
+        upd->applyTo(*expected.docs[lid]);
+        ds.update(serial++, lid, *upd, repo);
+    };
+    for (uint32_t lid : {1u, 2u, 5u}) {
+        update(lid, "bar");
+    }
+    ds.materialize_deltas(serial++, repo);
+    expected.assertRead(ds, repo);
+    for (uint32_t lid : {1u, 4u, 9u}) {
+        update(lid, "baz");
+    }
+    RewriteDocs rewrite(expected);
+    ds.accept(rewrite, expected, repo);
+    EXPECT_EQ(10u, expected.visits.size());
+    for (const auto &entry : expected.visits) {
+        EXPECT_EQ(1u, entry.second) << "lid " << entry.first;
+    }
+    expected.assertRead(ds, repo);
+}
+
 TEST_F(LogDataStoreTest, testWriteRead)
 {
     auto empty = build_testdata() + "/empty";
@@ -946,13 +1091,14 @@ struct Fixture {
 
     Fixture(const std::string& dirName,
             bool dirCleanup = true,
-            size_t maxFileSize = 4_Ki * 2)
+            size_t maxFileSize = 4_Ki * 2,
+            double maxDeltaFactor = 0.0)
         : executor(1),
           dir(dirName),
           serialNum(0),
           fileHeaderCtx(),
           tlSyncer(),
-          store(executor, dirName, getBasicConfig(maxFileSize), GrowStrategy(),
+          store(executor, dirName, getBasicConfig(maxFileSize).setMaxDeltaFactor(maxDeltaFactor), GrowStrategy(),
                 TuneFileSummary(), fileHeaderCtx, tlSyncer, nullptr)
     {
         dir.cleanup(dirCleanup);
@@ -968,6 +1114,24 @@ struct Fixture {
         store.write(nextSerialNum(), lid, data.c_str(), data.size());
         return *this;
     }
+    bool writeDelta(uint32_t lid, uint32_t deltaId) {
+        std::string data = genData(deltaId, 40);
+        return store.write_delta(nextSerialNum(), lid, data.c_str(), data.size());
+    }
+    void assertDeltas(uint32_t lid, const std::vector<uint32_t> &deltaIds, std::string_view label) {
+        SCOPED_TRACE(label);
+        vespalib::DataBuffer buffer;
+        EXPECT_GT(store.read(lid, buffer), 0);
+        vespalib::ConstBufferRef blob(buffer.getData(), buffer.getDataLen());
+        std::vector<vespalib::ConstBufferRef> updates;
+        EXPECT_EQ( ! deltaIds.empty(), DeltaRecord::is_merged(blob));
+        vespalib::ConstBufferRef base = DeltaRecord::is_merged(blob) ? DeltaRecord::split_merged(blob, updates) : blob;
+        EXPECT_EQ(genData(lid, 1024), std::string(base.c_str(), base.size()));
+        ASSERT_EQ(deltaIds.size(), updates.size());
+        for (size_t i = 0; i < deltaIds.size(); ++i) {
+            EXPECT_EQ(genData(deltaIds[i], 40), std::string(updates[i].c_str(), updates[i].size()));
+        }
+    }
     uint32_t writeUntilNewChunk(uint32_t startLid) {
         size_t numChunksStart = store.getFileChunkStats().size();
         for (uint32_t lid = startLid; ; ++lid) {
@@ -1089,6 +1253,96 @@ TEST_F(LogDataStoreTest, require_that_lid_space_can_be_compacted_and_entries_fro
     }
 }
 
+TEST_F(LogDataStoreTest, require_that_delta_records_are_merged_on_read_and_kept_by_compaction_and_load)
+{
+    auto dir = build_testdata() + "/deltas";
+    {
+        Fixture f(dir, false, 4_Ki, 0.1);
+        for (uint32_t lid = 1; lid <= 20; ++lid) {
+            f.write(lid);
+        }
+        EXPECT_TRUE(f.writeDelta(1, 1001));
+        EXPECT_TRUE(f.writeDelta(1, 1002));
+        EXPECT_FALSE(f.writeDelta(1, 1003)); // Delta record would be too large compared to the document
+        EXPECT_FALSE(f.writeDelta(30, 3001)); // No document
+        f.assertDeltas(1, {1001, 1002}, "after deltas");
+        EXPECT_TRUE(f.writeDelta(2, 2001));
+        f.write(2);
+        f.assertDeltas(2, {}, "full write drops delta");
+        EXPECT_TRUE(f.writeDelta(5, 5001));
+        f.store.remove(f.nextSerialNum(), 5);
+        vespalib::DataBuffer removed;
+        EXPECT_EQ(0, f.store.read(5, removed));
+        f.store.remove(f.nextSerialNum(), 3);
+        f.store.remove(f.nextSerialNum(), 4);
+        f.flush();
+        f.store.compactBloat(f.serialNum);
+        f.assertDeltas(1, {1001, 1002}, "after compaction");
+        EXPECT_EQ(std::vector<uint32_t>({1}), f.store.get_delta_lids());
+        f.flush();
+    }
+    {
+        Fixture f(dir, true, 4_Ki, 0.1);
+        f.assertDeltas(1, {1001, 1002}, "after load");
+        f.assertDeltas(2, {}, "after load");
+        vespalib::DataBuffer removed;
+        EXPECT_EQ(0, f.store.read(5, removed));
+        EXPECT_TRUE(f.writeDelta(2, 2002));
+        f.assertDeltas(2, {2002}, "delta after load");
+    }
+}
+
+namespace {
+
+struct CollectingBufferVisitor : public IBufferVisitor {
+    std::map<uint32_t, std::string> visited;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        visited[lid] = std::string(buffer.c_str(), buffer.size());
+    }
+};
+
+void
+assertVisited(const LogDataStore &store, const std::vector<uint32_t> &lids, std::string_view label)
+{
+    SCOPED_TRACE(label);
+    CollectingBufferVisitor visitor;
+    store.read(lids, visitor);
+    ASSERT_EQ(lids.size(), visitor.visited.size());
+    for (uint32_t lid : lids) {
+        EXPECT_EQ(genData(lid, 1024), visitor.visited[lid]);
+    }
+}
+
+}
+
+TEST_F(LogDataStoreTest, require_that_lids_in_nearby_chunks_are_visited_with_read_ahead)
+{
+    auto dir = build_testdata() + "/readahead";
+    std::vector<uint32_t> lids = {40, 1, 2, 5, 9, 10, 11, 17, 30, 31, 38};
+    {
+        Fixture f(dir, false, 1_Mi);
+        for (uint32_t lid = 1; lid <= 40; ++lid) {
+            f.write(lid);
+            if ((lid % 3) == 0) {
+                f.flush();
+            }
+        }
+        f.store.remove(f.nextSerialNum(), 20);
+        assertVisited(f.store, lids, "chunks both on disk and in memory");
+        f.flush();
+        assertVisited(f.store, lids, "all chunks on disk");
+    }
+    {
+        Fixture f(dir, true, 1_Mi);
+        assertVisited(f.store, lids, "after load");
+        std::vector<uint32_t> withRemoved = {19, 20, 21};
+        CollectingBufferVisitor visitor;
+        f.store.read(withRemoved, visitor);
+        EXPECT_EQ(2u, visitor.visited.size());
+        EXPECT_FALSE(visitor.visited.contains(20));
+    }
+}
+
 TEST_F(LogDataStoreTest, require_that_getLid_is_protected_by_docIdLimit)
 {
     auto tmp4 = build_testdata() + "/tmp4";
@@ -1190,6 +1444,8 @@ TEST_F(LogDataStoreTest, require_that_config_equality_operator_detects_inequalit
     EXPECT_FALSE(C() == C().setMaxFileSize(1));
     EXPECT_FALSE(C() == C().setMaxBucketSpread(0.3));
     EXPECT_FALSE(C() == C().setMinFileSizeFactor(0.3));
+    EXPECT_FALSE(C() == C().setMaxDeltaFactor(0.3));
+    EXPECT_FALSE(C() == C().setMaxReadAhead(4_Ki));
     EXPECT_FALSE(C() == C().setFileConfig(WriteableFileChunk::Config({}, 70)));
     EXPECT_FALSE(C() == C().compactCompression({CompressionConfig::ZSTD}));
 }
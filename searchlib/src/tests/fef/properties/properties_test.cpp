@@ -243,6 +243,15 @@ TEST(PropertiesTest, test_stuff)
             p.add("vespa.eval.use_fast_forest", "true");
             EXPECT_EQ(eval::UseFastForest::check(p), true);
         }
+        { // vespa.eval.batch_execute
+            EXPECT_EQ(eval::BatchExecute::NAME, std::string("vespa.eval.batch_execute"));
+            EXPECT_EQ(eval::BatchExecute::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQ(eval::BatchExecute::check(p), false);
+            EXPECT_EQ(eval::BatchExecute::check(p, true), true);
+            p.add("vespa.eval.batch_execute", "true");
+            EXPECT_EQ(eval::BatchExecute::check(p), true);
+        }
         { // vespa.rank.firstphase
             EXPECT_EQ(rank::FirstPhase::NAME, std::string("vespa.rank.firstphase"));
             EXPECT_EQ(rank::FirstPhase::DEFAULT_VALUE, std::string("nativeRank"));
@@ -77,13 +77,15 @@ struct Fixture {
     MatchData::UP match_data;
     RankProgram program;
     size_t track_cnt;
+    std::vector<uint32_t> prefetched;
     Fixture() : factory(), indexEnv(), resolver(new BlueprintResolver(factory, indexEnv)),
-                overrides(), match_data(), program(resolver), track_cnt(0)
+                overrides(), match_data(), program(resolver), track_cnt(0), prefetched()
     {
         factory.addPrototype(Blueprint::SP(new BoxingBlueprint()));
         factory.addPrototype(Blueprint::SP(new DocidBlueprint()));
         factory.addPrototype(Blueprint::SP(new DoubleBlueprint()));
         factory.addPrototype(Blueprint::SP(new ImpureValueBlueprint()));
+        factory.addPrototype(Blueprint::SP(new PrefetchingBlueprint(prefetched)));
         factory.addPrototype(Blueprint::SP(new RankingExpressionBlueprint()));
         factory.addPrototype(Blueprint::SP(new SumBlueprint()));
         factory.addPrototype(Blueprint::SP(new TrackingBlueprint(track_cnt)));        
@@ -255,6 +257,60 @@ TEST(RankProgramTest, only_non_const_features_are_calculated_per_document)
     EXPECT_EQ(f1.track_cnt, 5u);
 }
 
+TEST(RankProgramTest, only_non_const_features_are_prefetched)
+{
+    Fixture f1;
+    f1.add("mysum(prefetch(docid),prefetch(value(10)))").compile();
+    EXPECT_TRUE(f1.program.has_prefetch());
+    f1.program.prefetch(3);
+    f1.program.prefetch(7);
+    EXPECT_EQ((std::vector<uint32_t>{3, 7}), f1.prefetched);
+    EXPECT_EQ(17.0, f1.get(7));
+}
+
+TEST(RankProgramTest, program_without_prefetching_features_has_no_prefetch)
+{
+    Fixture f1;
+    f1.add("mysum(docid,prefetch(value(10)))").compile();
+    EXPECT_FALSE(f1.program.has_prefetch());
+    f1.program.prefetch(3);
+    EXPECT_TRUE(f1.prefetched.empty());
+}
+
+TEST(RankProgramTest, seed_can_be_calculated_for_a_batch_of_documents)
+{
+    Fixture f1;
+    f1.add("mysum(docid,mysum(docid,value(10)))").compile();
+    ASSERT_TRUE(f1.program.setup_batch_execute());
+    EXPECT_TRUE(f1.program.has_batch_execute());
+    std::vector<uint32_t> docids = {1, 5, 7};
+    auto scores = f1.program.execute_batch(docids);
+    EXPECT_EQ((std::vector<search::feature_t>{12.0, 20.0, 24.0}), std::vector<search::feature_t>(scores.begin(), scores.end()));
+    docids = {3};
+    scores = f1.program.execute_batch(docids);
+    ASSERT_EQ(1u, scores.size());
+    EXPECT_EQ(16.0, scores[0]);
+    EXPECT_EQ(24.0, f1.get(7));
+}
+
+TEST(RankProgramTest, batch_execution_requires_all_non_const_executors_to_support_it)
+{
+    Fixture f1;
+    f1.add("mysum(docid,ivalue(5))").compile();
+    EXPECT_FALSE(f1.program.setup_batch_execute());
+    EXPECT_FALSE(f1.program.has_batch_execute());
+}
+
+TEST(RankProgramTest, batch_execution_requires_single_number_seed)
+{
+    Fixture f1;
+    f1.add("mysum(docid,value(10))").add("docid").compile();
+    EXPECT_FALSE(f1.program.setup_batch_execute());
+    Fixture f2;
+    f2.add("box(mysum(docid,value(10)))").compile();
+    EXPECT_FALSE(f2.program.setup_batch_execute());
+}
+
 TEST(RankProgramTest, unused_features_are_not_calculated)
 {
     Fixture f1;
@@ -11,12 +11,17 @@
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/index/docidandfeatures.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/index/term_expander.h>
 #include <vespa/searchlib/memoryindex/document_inverter.h>
 #include <vespa/searchlib/memoryindex/document_inverter_context.h>
 #include <vespa/searchlib/memoryindex/field_index_collection.h>
 #include <vespa/searchlib/memoryindex/field_inverter.h>
 #include <vespa/searchlib/memoryindex/ordered_field_index_inserter.h>
 #include <vespa/searchlib/memoryindex/posting_iterator.h>
+#include <vespa/searchlib/memoryindex/sharded_field_index.h>
+#include <vespa/searchlib/memoryindex/word_shard.h>
+#include <vespa/searchlib/queryeval/blueprint.h>
+#include <vespa/searchlib/queryeval/field_spec.h>
 #include <vespa/searchlib/queryeval/iterators.h>
 #include <vespa/searchlib/test/doc_builder.h>
 #include <vespa/searchlib/test/schema_builder.h>
@@ -28,6 +33,7 @@
 #include <vespa/vespalib/util/gate.h>
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <unordered_set>
 
 #include <vespa/vespalib/gtest/gtest.h>
@@ -368,7 +374,7 @@ public:
         if (_inserter != nullptr) {
             _inserter->flush();
         }
-        _inserter = &_fieldIndexes.getFieldIndex(fieldId)->getInserter();
+        _inserter = &_fieldIndexes.get_inserter(fieldId, 0);
         _inserter->rewind();
         _mock.setNextField(fieldId);
     }
@@ -440,11 +446,11 @@ public:
     void remove(const std::string_view, uint32_t) override { }
 
     MyDrainRemoves(FieldIndexCollection &fieldIndexes, uint32_t fieldId)
-        : _remover(fieldIndexes.getFieldIndex(fieldId)->getDocumentRemover())
+        : _remover(fieldIndexes.get_remover(fieldId, 0))
     {
     }
 
-    explicit MyDrainRemoves(IFieldIndex& field_index)
+    explicit MyDrainRemoves(IFieldIndexShard& field_index)
         : _remover(field_index.getDocumentRemover())
     {
     }
@@ -465,13 +471,13 @@ myPushDocument(DocumentInverter &inv)
 const FeatureStore *
 featureStorePtr(const FieldIndexCollection &fieldIndexes, uint32_t fieldId)
 {
-    return &fieldIndexes.getFieldIndex(fieldId)->getFeatureStore();
+    return &fieldIndexes.getFieldIndex(fieldId)->get_shard(0).getFeatureStore();
 }
 
 const FeatureStore &
 featureStoreRef(const FieldIndexCollection &fieldIndexes, uint32_t fieldId)
 {
-    return fieldIndexes.getFieldIndex(fieldId)->getFeatureStore();
+    return fieldIndexes.getFieldIndex(fieldId)->get_shard(0).getFeatureStore();
 }
 
 MemoryStats
@@ -480,7 +486,7 @@ getFeatureStoreMemStats(const FieldIndexCollection &fieldIndexes)
     MemoryStats res;
     uint32_t numFields = fieldIndexes.getNumFields();
     for (uint32_t fieldId = 0; fieldId < numFields; ++fieldId) {
-        auto stats = fieldIndexes.getFieldIndex(fieldId)->getFeatureStore().getMemStats();
+        auto stats = fieldIndexes.getFieldIndex(fieldId)->get_shard(0).getFeatureStore().getMemStats();
         res += stats;
     }
     return res;
@@ -1044,8 +1050,10 @@ TEST_F(BasicInverterTest, require_that_inversion_is_working)
     myCompactFeatures(_fic, *_pushThreads);
     std::vector<std::unique_ptr<GenerationHandler::Guard>> guards;
     for (auto &fieldIndex : _fic.getFieldIndexes()) {
-        guards.push_back(std::make_unique<GenerationHandler::Guard>
-                         (fieldIndex->takeGenerationGuard()));
+        for (uint32_t shard_id = 0; shard_id < fieldIndex->get_num_shards(); ++shard_id) {
+            guards.push_back(std::make_unique<GenerationHandler::Guard>
+                             (fieldIndex->get_shard(shard_id).takeGenerationGuard()));
+        }
     }
     myCommit(_fic, *_pushThreads);
     auto duringStats = getFeatureStoreMemStats(_fic);
@@ -1294,10 +1302,154 @@ insertAndAssertTuple(const std::string &word, uint32_t fieldId, uint32_t docId,
 {
     EntryRef wordRef = WrapInserter(dict, fieldId).rewind().word(word).
                        add(docId).flush().getWordRef();
-    EXPECT_EQ(word, dict.getFieldIndex(fieldId)->getWordStore().getWord(wordRef));
+    EXPECT_EQ(word, dict.getFieldIndex(fieldId)->get_shard(0).getWordStore().getWord(wordRef));
     MyDrainRemoves(dict, fieldId).drain(docId);
 }
 
+Schema
+make_sharded_schema(const Schema& schema, uint32_t num_shards)
+{
+    Schema result;
+    for (uint32_t field_id = 0; field_id < schema.getNumIndexFields(); ++field_id) {
+        auto field = schema.getIndexField(field_id);
+        field.set_memory_index_shards(num_shards);
+        result.addIndexField(field);
+    }
+    return result;
+}
+
+struct InvertedIndex {
+    Schema schema;
+    FieldIndexCollection fic;
+    DocumentInverterContext inv_context;
+    DocumentInverter inv;
+
+    InvertedIndex(const Schema& schema_in, ISequencedTaskExecutor& invert_threads, ISequencedTaskExecutor& push_threads)
+        : schema(schema_in),
+          fic(schema, MockFieldLengthInspector()),
+          inv_context(schema, invert_threads, push_threads, fic),
+          inv(inv_context)
+    {
+    }
+    ~InvertedIndex();
+    std::string dump() {
+        MyBuilder b(schema);
+        fic.dump(b);
+        return b.toStr();
+    }
+    uint32_t est_hits(std::unique_ptr<queryeval::Blueprint> blueprint) {
+        return blueprint->getState().estimate().estHits;
+    }
+    uint32_t term_hits(const std::string& term) {
+        queryeval::FieldSpec field("f0", 0, 0);
+        return est_hits(fic.getFieldIndex(0)->make_term_blueprint(term, field, 0));
+    }
+    uint32_t prefix_hits(const std::string& prefix) {
+        queryeval::FieldSpec field("f0", 0, 0);
+        auto expander = TermExpander::make_prefix(prefix);
+        return est_hits(fic.getFieldIndex(0)->make_expanded_term_blueprint(expander, field, 0, 1000));
+    }
+};
+
+InvertedIndex::~InvertedIndex() = default;
+
+class ShardedInverterTest : public ::testing::Test {
+public:
+    static constexpr uint32_t num_shards = 4;
+    DocBuilder _b;
+    std::unique_ptr<ISequencedTaskExecutor> _invertThreads;
+    std::unique_ptr<ISequencedTaskExecutor> _pushThreads;
+    InvertedIndex _unsharded;
+    InvertedIndex _sharded;
+
+    ShardedInverterTest()
+        : _b(make_multi_field_add_fields()),
+          _invertThreads(SequencedTaskExecutor::create(invert_executor, 2)),
+          _pushThreads(SequencedTaskExecutor::create(push_executor, 4)),
+          _unsharded(SchemaBuilder(_b).add_all_indexes().build(), *_invertThreads, *_pushThreads),
+          _sharded(make_sharded_schema(_unsharded.schema, num_shards), *_invertThreads, *_pushThreads)
+    {
+    }
+    ~ShardedInverterTest() override;
+    void invert(uint32_t doc_id, const std::string& f0, const std::string& f2) {
+        StringFieldBuilder sfb(_b);
+        auto doc = _b.make_document(vespalib::make_string("id:ns:searchdocument::%u", doc_id));
+        doc->setValue("f0", sfb.tokenize(f0).build());
+        auto string_array = _b.make_array("f2");
+        string_array.add(sfb.tokenize(f2).build());
+        string_array.add(sfb.tokenize(f0).build());
+        doc->setValue("f2", string_array);
+        _unsharded.inv.invertDocument(doc_id, *doc, {});
+        _sharded.inv.invertDocument(doc_id, *doc, {});
+    }
+    void remove(uint32_t doc_id) {
+        _unsharded.inv.removeDocument(doc_id);
+        _sharded.inv.removeDocument(doc_id);
+    }
+    void push() {
+        _invertThreads->sync_all();
+        myPushDocument(_unsharded.inv);
+        myPushDocument(_sharded.inv);
+    }
+};
+
+ShardedInverterTest::~ShardedInverterTest() = default;
+
+TEST_F(ShardedInverterTest, sharded_field_index_is_instantiated_based_on_schema_config)
+{
+    auto* field_index = dynamic_cast<ShardedFieldIndex<false>*>(_sharded.fic.getFieldIndex(0));
+    ASSERT_TRUE(field_index != nullptr);
+    EXPECT_EQ(num_shards, field_index->get_num_shards());
+    EXPECT_EQ(num_shards, _sharded.fic.get_num_shards(0));
+    EXPECT_EQ(1u, _unsharded.fic.get_num_shards(0));
+    EXPECT_EQ(num_shards, _sharded.inv.getInverter(0)->get_num_shards());
+    EXPECT_EQ(1u, _unsharded.inv.getInverter(0)->get_num_shards());
+}
+
+TEST_F(ShardedInverterTest, sharded_field_index_has_same_content_as_unsharded_field_index)
+{
+    invert(10, "a b c d e f g h", "w x y z");
+    invert(11, "a a b c dd ee ff", "x y");
+    invert(12, "foo bar baz qux", "w w w");
+    push();
+    invert(13, "b d f h j l n", "a b c");
+    invert(11, "aa bb cc dd", "w x");
+    remove(12);
+    push();
+    for (uint32_t field_id = 0; field_id < _sharded.fic.getNumFields(); ++field_id) {
+        EXPECT_EQ(_unsharded.fic.getFieldIndex(field_id)->getNumUniqueWords(),
+                  _sharded.fic.getFieldIndex(field_id)->getNumUniqueWords());
+    }
+    EXPECT_EQ(_unsharded.dump(), _sharded.dump());
+    for (auto term : {"a", "b", "dd", "foo", "h", "n", "q"}) {
+        EXPECT_EQ(_unsharded.term_hits(term), _sharded.term_hits(term)) << term;
+    }
+    EXPECT_EQ(2u, _sharded.term_hits("b"));
+    EXPECT_EQ(0u, _sharded.term_hits("foo"));
+    for (auto prefix : {"a", "b", "d", "f", "z"}) {
+        EXPECT_EQ(_unsharded.prefix_hits(prefix), _sharded.prefix_hits(prefix)) << prefix;
+    }
+}
+
+TEST_F(ShardedInverterTest, words_are_stored_in_owning_shard)
+{
+    invert(10, "a b c d e f g h i j k l m n o p", "q r s t u v w x y z");
+    push();
+    auto& field_index = *_sharded.fic.getFieldIndex(0);
+    uint32_t non_empty_shards = 0;
+    for (uint32_t shard_id = 0; shard_id < num_shards; ++shard_id) {
+        auto& shard = dynamic_cast<FieldIndex<false>&>(field_index.get_shard(shard_id));
+        for (char c = 'a'; c <= 'p'; ++c) {
+            std::string word(1, c);
+            EXPECT_EQ(get_word_shard(word, num_shards) == shard_id, shard.find(word).valid()) << word;
+        }
+        if (shard.getNumUniqueWords() != 0) {
+            ++non_empty_shards;
+        }
+    }
+    EXPECT_LT(1u, non_empty_shards);
+}
+
 TEST_F(FieldIndexCollectionTest, require_that_insert_tells_which_word_ref_that_was_inserted)
 {
     insertAndAssertTuple("a", 1, 11, fic);
@@ -1331,7 +1483,7 @@ struct RemoverTest : public FieldIndexCollectionTest {
         DocumentInverterContext inv_context(schema, *_invertThreads, *_pushThreads, fic);
         DocumentInverter inv(inv_context);
         myremove(docId, inv);
-        EXPECT_FALSE(fic.getFieldIndex(0u)->getDocumentRemover().
+        EXPECT_FALSE(fic.get_remover(0u, 0).
                      getStore().get(docId).valid());
     }
 };
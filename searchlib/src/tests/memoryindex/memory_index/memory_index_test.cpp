@@ -12,6 +12,7 @@
 #include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/queryeval/booleanmatchiteratorwrapper.h>
+#include <vespa/searchlib/queryeval/equiv_blueprint.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
 #include <vespa/searchlib/queryeval/fake_searchable.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
@@ -41,7 +42,9 @@ using search::ScheduleTaskCallback;
 using search::index::FieldLengthInfo;
 using search::index::IFieldLengthInspector;
 using search::query::Node;
+using search::query::SimpleFuzzyTerm;
 using search::query::SimplePhrase;
+using search::query::SimplePrefixTerm;
 using search::query::SimpleStringTerm;
 using search::test::DocBuilder;
 using search::test::SchemaBuilder;
@@ -549,6 +552,59 @@ TEST(MemoryIndexTest, require_that_we_can_fake_bit_vector)
     }
 }
 
+namespace {
+
+SimplePrefixTerm makePrefixTerm(const std::string &term) {
+    return SimplePrefixTerm(term, "field", 0, search::query::Weight(0));
+}
+
+SimpleFuzzyTerm makeFuzzyTerm(const std::string &term, uint32_t max_edits) {
+    return SimpleFuzzyTerm(term, "field", 0, search::query::Weight(0), max_edits, 0, false);
+}
+
+std::string
+search_expanded(Searchable &searchable, const Node &term, uint32_t max_term_expansions, bool expect_equiv)
+{
+    uint32_t fieldId = 0;
+    MatchDataLayout mdl;
+    FakeRequestContext requestContext;
+    requestContext.get_create_blueprint_params().max_term_expansions = max_term_expansions;
+    TermFieldHandle handle = mdl.allocTermField(fieldId);
+    MatchData::UP match_data = mdl.createMatchData();
+    FieldSpecList fields;
+    fields.add(FieldSpec(title, fieldId, handle));
+    auto res = searchable.createBlueprint(requestContext, fields, term);
+    EXPECT_EQ(expect_equiv, dynamic_cast<EquivBlueprint *>(res.get()) != nullptr);
+    res->basic_plan(true, 100);
+    res->fetchPostings(search::queryeval::ExecuteInfo::FULL);
+    SearchIterator::UP search = res->createSearch(*match_data);
+    search->initFullRange();
+    return toString(*search);
+}
+
+}
+
+TEST(MemoryIndexTest, require_that_prefix_and_fuzzy_terms_are_expanded)
+{
+    Index index(MySetup().field(title));
+    index.doc(1).field(title).add("fob").commit();
+    index.doc(2).field(title).add(foo).commit();
+    index.doc(3).field(title).add(bar).commit();
+    index.doc(4).field(title).add("food").add(foo).commit();
+    index.doc(5).field(title).add("fo").commit();
+    index.remove(5);
+    Searchable &searchable = index.index;
+    EXPECT_EQ("1,2,4", search_expanded(searchable, makePrefixTerm("fo"), 1000, true));
+    EXPECT_EQ("4", search_expanded(searchable, makePrefixTerm("food"), 1000, false));
+    EXPECT_EQ("", search_expanded(searchable, makePrefixTerm("x"), 1000, false));
+    EXPECT_EQ("1,2,4", search_expanded(searchable, makeFuzzyTerm("fox", 1), 1000, true));
+    EXPECT_EQ("3", search_expanded(searchable, makeFuzzyTerm("baz", 1), 1000, false));
+    EXPECT_EQ("1,2,3,4", search_expanded(searchable, makeFuzzyTerm("bob", 3), 1000, true));
+    EXPECT_EQ("", search_expanded(searchable, makeFuzzyTerm("xyz", 1), 1000, false));
+    // Words are expanded in dictionary order, skipping words without postings
+    EXPECT_EQ("1", search_expanded(searchable, makePrefixTerm("fo"), 1, false));
+}
+
 TEST(MemoryIndexTest, field_length_info_can_be_retrieved_per_field)
 {
     Index index(MySetup().field(title).field(body)
@@ -0,0 +1,217 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/queryeval/cost_sampling_iterator.h>
+#include <vespa/searchlib/queryeval/field_cost_model.h>
+#include <vespa/searchlib/queryeval/leaf_blueprints.h>
+#include <vespa/searchlib/queryeval/simplesearch.h>
+#include <vespa/searchlib/fef/matchdata.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace search::queryeval;
+using search::fef::MatchData;
+
+constexpr uint32_t min_samples = 10;
+
+void add_samples(FieldCostModel &model, uint32_t field_id, double ns_per_cost, size_t n = min_samples) {
+    for (size_t i = 0; i < n; ++i) {
+        model.add_sample(field_id, 100.0, 100.0 * ns_per_cost);
+    }
+}
+
+TEST(FieldCostModelTest, unknown_or_rarely_sampled_fields_have_neutral_cost_factor)
+{
+    FieldCostModel model(min_samples, 1.0);
+    EXPECT_EQ(1.0, model.cost_factor(1));
+    add_samples(model, 1, 5.0, min_samples - 1);
+    add_samples(model, 2, 1.0);
+    EXPECT_EQ(1.0, model.cost_factor(1));
+    EXPECT_EQ(min_samples - 1, model.get_field_stats(1).samples);
+}
+
+TEST(FieldCostModelTest, cost_factor_is_relative_to_average_of_all_fields)
+{
+    FieldCostModel model(min_samples, 1.0);
+    add_samples(model, 1, 3.0);
+    add_samples(model, 2, 1.0);
+    EXPECT_DOUBLE_EQ(1.5, model.cost_factor(1));
+    EXPECT_DOUBLE_EQ(0.5, model.cost_factor(2));
+}
+
+TEST(FieldCostModelTest, cost_factor_is_capped)
+{
+    FieldCostModel model(min_samples, 1.0);
+    add_samples(model, 1, 1000.0);
+    add_samples(model, 2, 1.0, 1000);
+    EXPECT_EQ(FieldCostModel::max_cost_factor, model.cost_factor(1));
+    add_samples(model, 3, 0.0001);
+    EXPECT_EQ(1.0 / FieldCostModel::max_cost_factor, model.cost_factor(3));
+}
+
+TEST(FieldCostModelTest, cost_factor_snapshot_is_rebuilt_when_samples_are_added)
+{
+    FieldCostModel model(min_samples, 1.0, min_samples);
+    add_samples(model, 1, 3.0);
+    add_samples(model, 2, 1.0);
+    auto factors = model.get_cost_factors();
+    EXPECT_EQ(factors, model.get_cost_factors());
+    EXPECT_DOUBLE_EQ(1.5, factors->cost_factor(1));
+    EXPECT_DOUBLE_EQ(0.5, factors->cost_factor(2));
+    EXPECT_EQ(1.0, factors->cost_factor(3));
+    add_samples(model, 2, 1.0, 2 * min_samples);
+    auto new_factors = model.get_cost_factors();
+    EXPECT_NE(factors, new_factors);
+    EXPECT_DOUBLE_EQ(1.5, factors->cost_factor(1));
+    EXPECT_DOUBLE_EQ(model.cost_factor(1), new_factors->cost_factor(1));
+    EXPECT_LT(1.5, new_factors->cost_factor(1));
+}
+
+TEST(FieldCostModelTest, cost_factor_snapshot_is_rebuilt_once_per_update_interval)
+{
+    FieldCostModel model(min_samples, 1.0, min_samples);
+    add_samples(model, 1, 3.0);
+    add_samples(model, 2, 1.0);
+    auto factors = model.get_cost_factors();
+    add_samples(model, 2, 1.0, min_samples - 1);
+    EXPECT_EQ(factors, model.get_cost_factors());
+    add_samples(model, 2, 1.0, 1);
+    auto new_factors = model.get_cost_factors();
+    EXPECT_NE(factors, new_factors);
+    EXPECT_LT(1.5, new_factors->cost_factor(1));
+}
+
+TEST(FieldCostModelTest, invalid_samples_are_ignored)
+{
+    FieldCostModel model(min_samples, 1.0);
+    model.add_sample(1, 0.0, 100.0);
+    model.add_sample(1, 10.0, -1.0);
+    EXPECT_EQ(0u, model.get_field_stats(1).samples);
+}
+
+TEST(FieldCostModelTest, queries_are_sampled_at_given_interval)
+{
+    FieldCostModel model;
+    size_t sampled = 0;
+    for (size_t i = 0; i < 100; ++i) {
+        if (model.should_sample(10)) {
+            ++sampled;
+        }
+    }
+    EXPECT_EQ(10u, sampled);
+    EXPECT_FALSE(model.should_sample(0));
+}
+
+TEST(FieldCostModelTest, model_can_be_converted_to_slime)
+{
+    FieldCostModel model(min_samples, 1.0);
+    add_samples(model, 1, 3.0);
+    add_samples(model, 2, 1.0);
+    vespalib::Slime slime;
+    model.to_slime(slime.setObject(), [](uint32_t id) { return "f" + std::to_string(id); });
+    auto &fields = slime.get()["fields"];
+    EXPECT_EQ(2u * min_samples, slime.get()["samples"].asLong());
+    ASSERT_EQ(2u, fields.entries());
+    for (size_t i = 0; i < fields.entries(); ++i) {
+        auto id = fields[i]["field_id"].asLong();
+        EXPECT_EQ("f" + std::to_string(id), fields[i]["name"].asString().make_string());
+        EXPECT_DOUBLE_EQ(model.cost_factor(id), fields[i]["cost_factor"].asDouble());
+    }
+}
+
+TEST(CostSamplingIteratorTest, measured_cost_is_reported_when_iterator_is_destructed)
+{
+    FieldCostModel model(1, 1.0);
+    {
+        auto inner = std::make_unique<SimpleSearch>(SimpleResult().addHit(3).addHit(5), false);
+        CostSamplingIterator search(std::move(inner), model, 7, false, 0.5, 0.25);
+        search.initRange(1, 11);
+        EXPECT_FALSE(search.seek(2));
+        EXPECT_TRUE(search.seek(3));
+        EXPECT_TRUE(search.seek(5));
+        EXPECT_DOUBLE_EQ(1.5, search.estimated_cost());
+    }
+    auto stats = model.get_field_stats(7);
+    EXPECT_EQ(1u, stats.samples);
+    EXPECT_DOUBLE_EQ(1.5, stats.estimated_cost);
+    EXPECT_GT(stats.measured_ns, 0.0);
+}
+
+TEST(CostSamplingIteratorTest, strict_iterators_are_charged_for_covered_docid_range)
+{
+    FieldCostModel model(1, 1.0);
+    auto inner = std::make_unique<SimpleSearch>(SimpleResult().addHit(3).addHit(5), true);
+    CostSamplingIterator search(std::move(inner), model, 7, true, 0.5, 0.25);
+    search.initRange(1, 11);
+    EXPECT_TRUE(search.seek(3));
+    EXPECT_DOUBLE_EQ(2.5, search.estimated_cost());
+}
+
+struct BlueprintFixture {
+    FieldCostModel model;
+    MatchData::UP md;
+    std::unique_ptr<FakeBlueprint> bp;
+    BlueprintFixture()
+        : model(min_samples, 1.0),
+          md(MatchData::makeTestInstance(1, 1)),
+          bp(std::make_unique<FakeBlueprint>(FieldSpec("foo", 1, 0), FakeResult().doc(3).doc(5)))
+    {
+        add_samples(model, 1, 3.0);
+        add_samples(model, 2, 1.0);
+        bp->setDocIdLimit(100);
+    }
+};
+
+TEST(CostModelBlueprintTest, bound_cost_model_scales_flow_stats_of_single_field_leafs)
+{
+    BlueprintFixture f;
+    f.bp->update_flow_stats(100);
+    double cost = f.bp->cost();
+    double strict_cost = f.bp->strict_cost();
+    {
+        auto factors = f.model.get_cost_factors();
+        auto guard = Blueprint::bind_opts(Blueprint::Options().field_cost_factors(factors.get()));
+        f.bp->update_flow_stats(100);
+    }
+    EXPECT_DOUBLE_EQ(cost * 1.5, f.bp->cost());
+    EXPECT_DOUBLE_EQ(strict_cost * 1.5, f.bp->strict_cost());
+}
+
+TEST(CostModelBlueprintTest, sampled_leaf_searches_report_cost_estimate_before_scaling)
+{
+    BlueprintFixture f;
+    f.bp->basic_plan(true, 100);
+    double strict_cost = f.bp->strict_cost();
+    {
+        auto factors = f.model.get_cost_factors();
+        auto guard = Blueprint::bind_opts(Blueprint::Options().field_cost_factors(factors.get()));
+        f.bp->update_flow_stats(100);
+    }
+    EXPECT_DOUBLE_EQ(strict_cost * 1.5, f.bp->strict_cost());
+    f.bp->fetchPostings(ExecuteInfo::FULL);
+    double estimated_cost = f.model.get_field_stats(1).estimated_cost;
+    {
+        CostSamplingIterator::Bind bind(&f.model);
+        auto search = f.bp->createSearch(*f.md);
+        search->initRange(1, 100);
+        EXPECT_TRUE(search->seek(3));
+    }
+    EXPECT_DOUBLE_EQ(estimated_cost + strict_cost * 99, f.model.get_field_stats(1).estimated_cost);
+}
+
+TEST(CostModelBlueprintTest, leaf_searches_are_wrapped_when_sampling_is_bound)
+{
+    BlueprintFixture f;
+    f.bp->basic_plan(true, 100);
+    f.bp->fetchPostings(ExecuteInfo::FULL);
+    EXPECT_EQ(nullptr, dynamic_cast<CostSamplingIterator *>(f.bp->createSearch(*f.md).get()));
+    {
+        CostSamplingIterator::Bind bind(&f.model);
+        auto search = f.bp->createSearch(*f.md);
+        ASSERT_NE(nullptr, dynamic_cast<CostSamplingIterator *>(search.get()));
+        search->initRange(1, 100);
+        EXPECT_TRUE(search->seek(3));
+    }
+    EXPECT_EQ(min_samples + 1, f.model.get_field_stats(1).samples);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -196,6 +196,17 @@ TEST(GlobalFilterTest, multi_threaded_global_filter_works_with_few_documents) {
     }
 }
 
+TEST(GlobalFilterTest, multi_threaded_global_filter_is_assembled_into_a_single_bitvector) {
+    SimpleThreadBundle thread_bundle(7);
+    for (uint32_t limit : {513u, 1024u, 1025u, 5000u, 100000u}) {
+        auto blueprint = create_blueprint(7, limit);
+        auto filter = GlobalFilter::create(*blueprint, limit, thread_bundle);
+        auto class_name = vespalib::getClassName(*filter);
+        EXPECT_TRUE(class_name.find("MultiBitVectorFilter") >= class_name.size());
+        verify(*filter, 7, limit);
+    }
+}
+
 TEST(GlobalFilterTest, multi_threaded_global_filter_works_with_docid_limit_0) {
     SimpleThreadBundle thread_bundle(7);
     auto blueprint = create_blueprint(2, 100);
@@ -38,6 +38,7 @@ assertIndexField(const Schema::IndexField& exp,
     assertField(exp, act);
     EXPECT_EQ(exp.getAvgElemLen(), act.getAvgElemLen());
     EXPECT_EQ(exp.use_interleaved_features(), act.use_interleaved_features());
+    EXPECT_EQ(exp.get_memory_index_shards(), act.get_memory_index_shards());
 }
 
 void
@@ -153,7 +154,7 @@ TEST(SchemaTest, test_load_and_save)
         EXPECT_EQ(3u, s.getNumIndexFields());
         assertIndexField(SIF("a", SDT::STRING), s.getIndexField(0));
         assertIndexField(SIF("b", SDT::INT64), s.getIndexField(1));
-        assertIndexField(SIF("c", SDT::STRING).set_interleaved_features(true), s.getIndexField(2));
+        assertIndexField(SIF("c", SDT::STRING).set_interleaved_features(true).set_memory_index_shards(4), s.getIndexField(2));
 
         EXPECT_EQ(9u, s.getNumAttributeFields());
         assertField(SAF("a", SDT::STRING, SCT::SINGLE),
@@ -21,6 +21,7 @@
 #include <vespa/vespalib/net/http/state_explorer.h>
 #include <vespa/vespalib/util/fake_doom.h>
 #include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <type_traits>
@@ -181,6 +182,8 @@ class HnswIndexTest : public ::testing::Test {
 public:
     FloatVectors vectors;
     std::shared_ptr<GlobalFilter> global_filter;
+    double filter_first_threshold;
+    double filter_first_exploration;
     LevelGenerator* level_generator;
     GenerationHandler gen_handler;
     std::unique_ptr<IndexType> index;
@@ -189,6 +192,8 @@ public:
     HnswIndexTest()
         : vectors(),
           global_filter(GlobalFilter::create()),
+          filter_first_threshold(0.0),
+          filter_first_exploration(0.3),
           level_generator(),
           gen_handler(),
           index(),
@@ -236,6 +241,10 @@ public:
         uint32_t sz = 10;
         global_filter = GlobalFilter::create(docids, sz);
     }
+    void set_filter_first(double threshold, double exploration) {
+        filter_first_threshold = threshold;
+        filter_first_exploration = exploration;
+    }
     GenerationHandler::Guard take_read_guard() {
         return gen_handler.takeGuard();
     }
@@ -273,7 +282,8 @@ public:
         vespalib::eval::TypedCells qv_cells(qv_ref);
         auto df = index->distance_function_factory().for_query_vector(qv_cells);
         auto got_by_docid = (global_filter->is_active()) ?
-                            index->find_top_k_with_filter(k, *df, *global_filter, explore_k, _doom->get_doom(), 10000.0) :
+                            index->find_top_k_with_filter(k, *df, *global_filter, filter_first_threshold, filter_first_exploration,
+                                                          explore_k, _doom->get_doom(), 10000.0) :
                             index->find_top_k(k, *df, explore_k, _doom->get_doom(), 10000.0);
         std::vector<uint32_t> act;
         act.reserve(got_by_docid.size());
@@ -286,7 +296,8 @@ public:
         uint32_t k = 3;
         auto qv = vectors.get_vector(docid, 0);
         auto df = index->distance_function_factory().for_query_vector(qv);
-        auto rv = index->top_k_candidates(*df, k, global_filter->ptr_if_active(), _doom->get_doom()).peek();
+        auto rv = index->top_k_candidates(*df, k, global_filter->ptr_if_active(), filter_first_threshold,
+                                          filter_first_exploration, _doom->get_doom()).peek();
         std::sort(rv.begin(), rv.end(), LesserDistance());
         size_t idx = 0;
         for (const auto & hit : rv) {
@@ -310,13 +321,15 @@ public:
         auto qv = vectors.get_vector(docid, 0);
         auto df = index->distance_function_factory().for_query_vector(qv);
         uint32_t k = 3;
-        auto rv = index->top_k_candidates(*df, k, global_filter->ptr_if_active(), _doom->get_doom()).peek();
+        auto rv = index->top_k_candidates(*df, k, global_filter->ptr_if_active(), filter_first_threshold,
+                                          filter_first_exploration, _doom->get_doom()).peek();
         std::sort(rv.begin(), rv.end(), LesserDistance());
         EXPECT_EQ(rv.size(), 3);
         EXPECT_LE(rv[0].distance, rv[1].distance);
         double thr = (rv[0].distance + rv[1].distance) * 0.5;
         auto got_by_docid = (global_filter->is_active())
-            ? index->find_top_k_with_filter(k, *df, *global_filter, k, _doom->get_doom(), thr)
+            ? index->find_top_k_with_filter(k, *df, *global_filter, filter_first_threshold, filter_first_exploration,
+                                            k, _doom->get_doom(), thr)
             : index->find_top_k(k, *df, k, _doom->get_doom(), thr);
         EXPECT_EQ(got_by_docid.size(), 1);
         EXPECT_EQ(got_by_docid[0].docid, index->get_docid(rv[0].nodeid));
@@ -471,6 +484,32 @@ TYPED_TEST(HnswIndexTest, 2d_vectors_inserted_in_level_0_graph_with_simple_selec
     this->expect_top_3(2, {});
 }
 
+TYPED_TEST(HnswIndexTest, filter_first_exploration_finds_hits_through_nodes_rejected_by_filter)
+{
+    this->init(false);
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        this->add_document(docid);
+    }
+    this->set_filter({2,3,4,6});
+    this->set_filter_first(1.0, 1.0);
+    this->expect_top_3(2, {2, 3});
+    this->expect_top_3(4, {4, 3});
+    this->expect_top_3(5, {6, 2});
+    this->expect_top_3(6, {6, 2});
+    this->expect_top_3(7, {3, 2});
+    this->expect_top_3(8, {4, 3});
+    this->expect_top_3(9, {3, 2});
+    // Entry point 1 and all its neighbors are rejected by the filter
+    this->set_filter({5,6});
+    for (double exploration : {0.0, 0.3, 1.0}) {
+        this->set_filter_first(1.0, exploration);
+        this->expect_top_3_by_docid("{2, 2}", {2, 2}, {5, 6});
+        this->expect_top_3_by_docid("{8, 3}", {8, 3}, {5, 6});
+    }
+    this->set_filter_first(0.0, 0.3);
+    this->expect_top_3_by_docid("{2, 2}", {2, 2}, {5, 6});
+}
+
 TYPED_TEST(HnswIndexTest, 2d_vectors_inserted_and_removed)
 {
     this->init(false);
@@ -1218,4 +1257,95 @@ TYPED_TEST(TwoPhaseTest, prepare_insert_during_remove_heuristic_select_neighbors
     this->prepare_insert_during_remove(true);
 }
 
+/*
+ * Vectors on a 2d grid, accessed by multiple threads during bulk add.
+ */
+class GridVectors : public DocVectorAccess {
+    std::vector<float> _cells;
+    SubspaceType       _subspace_type;
+public:
+    GridVectors(uint32_t docid_limit, uint32_t width)
+        : _cells(),
+          _subspace_type(ValueType::make_type(vespalib::eval::CellType::FLOAT, {{"dims", 2}}))
+    {
+        for (uint32_t docid = 0; docid < docid_limit; ++docid) {
+            _cells.push_back(docid % width);
+            _cells.push_back(docid / width);
+        }
+    }
+    ~GridVectors() override;
+    vespalib::eval::TypedCells get_vector(uint32_t docid, uint32_t subspace) const noexcept override {
+        (void) subspace;
+        return get_vectors(docid).cells(0);
+    }
+    VectorBundle get_vectors(uint32_t docid) const noexcept override {
+        return {&_cells[docid * 2], 1, _subspace_type};
+    }
+};
+
+GridVectors::~GridVectors() = default;
+
+template <typename IndexType>
+class BulkAddTest : public ::testing::Test {
+public:
+    static constexpr uint32_t docid_limit = 2001;
+    GridVectors                 vectors;
+    GenerationHandler           gen_handler;
+    std::unique_ptr<IndexType>  index;
+    vespalib::ThreadStackExecutor executor;
+
+    BulkAddTest()
+        : vectors(docid_limit, 50),
+          gen_handler(),
+          index(std::make_unique<IndexType>(vectors,
+                                            make_distance_function_factory(search::attribute::DistanceMetric::Euclidean,
+                                                                           vespalib::eval::CellType::FLOAT),
+                                            std::make_unique<InvLogLevelGenerator>(8),
+                                            HnswIndexConfig(16, 8, 100, 10, true))),
+          executor(4)
+    {
+    }
+    ~BulkAddTest() override;
+    void bulk_add(uint32_t docid_begin, uint32_t docid_end) {
+        std::vector<uint32_t> docids;
+        for (uint32_t docid = docid_begin; docid < docid_end; ++docid) {
+            docids.push_back(docid);
+        }
+        EXPECT_TRUE(index->bulk_add_documents(docids, executor, 4));
+        index->assign_generation(gen_handler.getCurrentGeneration());
+        gen_handler.incGeneration();
+        index->reclaim_memory(gen_handler.get_oldest_used_generation());
+    }
+    uint32_t find_nearest(uint32_t docid) {
+        auto df = index->distance_function_factory().for_query_vector(vectors.get_vector(docid, 0));
+        auto hits = index->find_top_k(1, *df, 100, vespalib::Doom::never(), 10000.0);
+        return hits.empty() ? 0 : hits[0].docid;
+    }
+};
+
+template <typename IndexType>
+BulkAddTest<IndexType>::~BulkAddTest() = default;
+
+TYPED_TEST_SUITE(BulkAddTest, HnswIndexTestTypes);
+
+TYPED_TEST(BulkAddTest, documents_are_added_in_parallel_to_a_connected_graph)
+{
+    EXPECT_TRUE(this->index->supports_bulk_add());
+    this->bulk_add(1, 1000);
+    this->bulk_add(1000, this->docid_limit);
+    uint32_t docs = this->docid_limit - 1;
+    EXPECT_EQ(docs, this->index->get_active_nodes());
+    EXPECT_TRUE(this->index->check_link_symmetry());
+    auto reachable = this->index->count_reachable_nodes();
+    EXPECT_EQ(docs, reachable.first);
+    EXPECT_TRUE(reachable.second);
+    auto& progress = this->index->bulk_add_progress();
+    EXPECT_FALSE(progress.active());
+    EXPECT_EQ(docs, progress.added_docs());
+    EXPECT_EQ(0u, progress.pending_docs());
+    for (uint32_t docid = 1; docid < this->docid_limit; docid += 37) {
+        EXPECT_EQ(docid, this->find_nearest(docid));
+    }
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
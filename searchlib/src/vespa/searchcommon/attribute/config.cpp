@@ -23,6 +23,8 @@ Config::Config(BasicType bt, CollectionType ct, bool fastSearch_) noexcept
       _fastAccess(false),
       _mutable(false),
       _paged(false),
+      _sharded_reader_guards(false),
+      _compressed_multi_value(false),
       _distance_metric(DistanceMetric::Euclidean),
       _match(Match::UNCASED),
       _dictionary(),
@@ -51,6 +53,8 @@ Config::operator==(const Config &b) const noexcept
            _fastAccess == b._fastAccess &&
            _mutable == b._mutable &&
            _paged == b._paged &&
+           _sharded_reader_guards == b._sharded_reader_guards &&
+           _compressed_multi_value == b._compressed_multi_value &&
            _maxUnCommittedMemory == b._maxUnCommittedMemory &&
            _match == b._match &&
            _dictionary == b._dictionary &&
@@ -55,6 +55,19 @@ public:
      */
     bool fastAccess() const noexcept { return _fastAccess; }
 
+    /**
+     * Check if readers of this attribute should use sharded reader guards,
+     * i.e. a generation handler where reader threads are spread over multiple
+     * reader slots. Used for attributes searched by many query threads concurrently.
+     */
+    bool sharded_reader_guards() const noexcept { return _sharded_reader_guards; }
+
+    /**
+     * Check if the values of a multi-value attribute should be stored compressed.
+     * Only used for integer array attributes without fast-search, ignored otherwise.
+     */
+    bool compressed_multi_value() const noexcept { return _compressed_multi_value; }
+
     const GrowStrategy & getGrowStrategy() const { return _growStrategy; }
     const CompactionStrategy &getCompactionStrategy() const { return _compactionStrategy; }
     const DictionaryConfig & get_dictionary_config() const { return _dictionary; }
@@ -85,6 +98,8 @@ public:
     Config & setMutable(bool isMutable) { _mutable = isMutable; return *this; }
     Config & setPaged(bool paged_in) { _paged = paged_in; return *this; }
     Config & setFastAccess(bool v) { _fastAccess = v; return *this; }
+    Config & set_sharded_reader_guards(bool v) { _sharded_reader_guards = v; return *this; }
+    Config & set_compressed_multi_value(bool v) { _compressed_multi_value = v; return *this; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config & setCompactionStrategy(const CompactionStrategy &compactionStrategy) {
         _compactionStrategy = compactionStrategy;
@@ -107,6 +122,8 @@ private:
     bool           _fastAccess : 1;
     bool           _mutable : 1;
     bool           _paged : 1;
+    bool           _sharded_reader_guards : 1;
+    bool           _compressed_multi_value : 1;
     DistanceMetric                 _distance_metric;
     Match                          _match;
     DictionaryConfig               _dictionary;
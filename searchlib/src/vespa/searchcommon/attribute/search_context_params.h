@@ -23,6 +23,7 @@ private:
     uint32_t                                          _diversityCutoffGroups;
     bool                                              _useBitVector;
     bool                                              _diversityCutoffStrict;
+    bool                                              _use_bitvector_cache;
     vespalib::FuzzyMatchingAlgorithm                  _fuzzy_matching_algorithm;
 
 
@@ -33,6 +34,7 @@ public:
           _diversityCutoffGroups(std::numeric_limits<uint32_t>::max()),
           _useBitVector(false),
           _diversityCutoffStrict(false),
+          _use_bitvector_cache(false),
           _fuzzy_matching_algorithm(search::fef::indexproperties::matching::FuzzyAlgorithm::DEFAULT_VALUE)
     { }
     bool useBitVector() const { return _useBitVector; }
@@ -41,6 +43,7 @@ public:
     bool diversityCutoffStrict() const { return _diversityCutoffStrict; }
     const IDocumentMetaStoreContext::IReadGuard::SP * metaStoreReadGuard() const { return _metaStoreReadGuard; }
     vespalib::FuzzyMatchingAlgorithm fuzzy_matching_algorithm() const { return _fuzzy_matching_algorithm; }
+    bool use_bitvector_cache() const { return _use_bitvector_cache; }
 
     SearchContextParams &useBitVector(bool value) {
         _useBitVector = value;
@@ -66,6 +69,10 @@ public:
         _fuzzy_matching_algorithm = value;
         return *this;
     }
+    SearchContextParams& use_bitvector_cache(bool value) {
+        _use_bitvector_cache = value;
+        return *this;
+    }
 };
 
 }
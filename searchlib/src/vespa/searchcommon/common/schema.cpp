@@ -128,7 +128,8 @@ Schema::Field::operator!=(const Field &rhs) const noexcept
 Schema::IndexField::IndexField(std::string_view name, DataType dt) noexcept
     : Field(name, dt),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _memory_index_shards(1)
 {
 }
 
@@ -136,14 +137,16 @@ Schema::IndexField::IndexField(std::string_view name, DataType dt,
                                CollectionType ct) noexcept
     : Field(name, dt, ct),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _memory_index_shards(1)
 {
 }
 
 Schema::IndexField::IndexField(const config::StringVector &lines)
     : Field(lines),
       _avgElemLen(ConfigParser::parse<int32_t>("averageelementlen", lines, 512)),
-      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false))
+      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false)),
+      _memory_index_shards(ConfigParser::parse<int32_t>("memoryindexshards", lines, 1))
 {
 }
 
@@ -158,6 +161,7 @@ Schema::IndexField::write(vespalib::asciistream & os, std::string_view prefix) c
     Field::write(os, prefix);
     os << prefix << "averageelementlen " << static_cast<int32_t>(_avgElemLen) << "\n";
     os << prefix << "interleavedfeatures " << (_interleaved_features ? "true" : "false") << "\n";
+    os << prefix << "memoryindexshards " << static_cast<int32_t>(_memory_index_shards) << "\n";
 
     // TODO: Remove prefix, phrases and positions when breaking downgrade is no longer an issue.
     os << prefix << "prefix false" << "\n";
@@ -170,7 +174,8 @@ Schema::IndexField::operator==(const IndexField &rhs) const noexcept
 {
     return Field::operator==(rhs) &&
             _avgElemLen == rhs._avgElemLen &&
-            _interleaved_features == rhs._interleaved_features;
+            _interleaved_features == rhs._interleaved_features &&
+            _memory_index_shards == rhs._memory_index_shards;
 }
 
 bool
@@ -178,7 +183,8 @@ Schema::IndexField::operator!=(const IndexField &rhs) const noexcept
 {
     return Field::operator!=(rhs) ||
             _avgElemLen != rhs._avgElemLen ||
-            _interleaved_features != rhs._interleaved_features;
+            _interleaved_features != rhs._interleaved_features ||
+            _memory_index_shards != rhs._memory_index_shards;
 }
 
 Schema::FieldSet::FieldSet(const config::StringVector & lines) :
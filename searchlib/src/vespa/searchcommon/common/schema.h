@@ -74,6 +74,7 @@ public:
     private:
         uint32_t _avgElemLen;
         bool _interleaved_features;
+        uint32_t _memory_index_shards;
 
     public:
         IndexField(std::string_view name, DataType dt) noexcept;
@@ -92,12 +93,21 @@ public:
             _interleaved_features = value;
             return *this;
         }
+        IndexField &set_memory_index_shards(uint32_t value) noexcept {
+            _memory_index_shards = value;
+            return *this;
+        }
 
         void write(vespalib::asciistream &os,
                    std::string_view prefix) const override;
 
         uint32_t getAvgElemLen() const noexcept { return _avgElemLen; }
         bool use_interleaved_features() const noexcept { return _interleaved_features; }
+        /**
+         * The number of shards the memory index for this field is split into, each shard
+         * owning the words hashing to it and being updated by its own push thread.
+         */
+        uint32_t get_memory_index_shards() const noexcept { return _memory_index_shards; }
 
         bool operator==(const IndexField &rhs) const noexcept;
         bool operator!=(const IndexField &rhs) const noexcept;
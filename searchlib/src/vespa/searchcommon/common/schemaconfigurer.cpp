@@ -9,6 +9,7 @@
 #include <vespa/config-summary.h>
 #include <vespa/searchcommon/attribute/collectiontype.h>
 #include <vespa/searchcommon/attribute/basictype.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".index.schemaconfigurer");
@@ -113,7 +114,8 @@ SchemaBuilder::build(const IndexschemaConfig &cfg, Schema &schema)
         schema.addIndexField(Schema::IndexField(f.name, convertIndexDataType(f.datatype),
                                                 convertIndexCollectionType(f.collectiontype)).
                 setAvgElemLen(f.averageelementlen).
-                set_interleaved_features(f.interleavedfeatures));
+                set_interleaved_features(f.interleavedfeatures).
+                set_memory_index_shards(std::max(f.memoryindexshards, 1)));
     }
     for (size_t i = 0; i < cfg.fieldset.size(); ++i) {
         const IndexschemaConfig::Fieldset &fs = cfg.fieldset[i];
@@ -621,8 +621,10 @@ public:
 
     template <class TermNode>
     void visitTerm(TermNode &n) {
+        const auto& create_params = getRequestContext().get_create_blueprint_params();
         SearchContextParams scParams = createContextParams(_field.isFilter());
-        scParams.fuzzy_matching_algorithm(getRequestContext().get_create_blueprint_params().fuzzy_matching_algorithm);
+        scParams.fuzzy_matching_algorithm(create_params.fuzzy_matching_algorithm)
+                .use_bitvector_cache(create_params.use_posting_bitvector_cache);
         const string stack = StackDumpCreator::create(n);
         setResult(std::make_unique<AttributeFieldBlueprint>(_field, _attr, stack, scParams));
     }
@@ -661,6 +663,7 @@ public:
                 setResult(std::make_unique<queryeval::EmptyBlueprint>(_field));
             }
         } else {
+            scParams.use_bitvector_cache(getRequestContext().get_create_blueprint_params().use_posting_bitvector_cache);
             setResult(std::make_unique<AttributeFieldBlueprint>(_field, _attr, stack, scParams));
         }
     }
@@ -776,6 +779,8 @@ public:
                                                                             params.global_filter_lower_limit,
                                                                             params.global_filter_upper_limit,
                                                                             params.target_hits_max_adjustment_factor,
+                                                                            params.filter_first_threshold,
+                                                                            params.filter_first_exploration,
                                                                             getRequestContext().getDoom()));
         } catch (const vespalib::IllegalArgumentException& ex) {
             return fail_nearest_neighbor_term(n, ex.getMessage());
@@ -10,7 +10,8 @@ namespace search {
 AttributeSaver::AttributeSaver(GenerationHandler::Guard &&guard,
                                const attribute::AttributeHeader &header)
     : _guard(std::move(guard)),
-      _header(header)
+      _header(header),
+      _executor(nullptr)
 {
 }
 
@@ -18,8 +19,9 @@ AttributeSaver::AttributeSaver(GenerationHandler::Guard &&guard,
 AttributeSaver::~AttributeSaver() = default;
 
 bool
-AttributeSaver::save(IAttributeSaveTarget &saveTarget)
+AttributeSaver::save(IAttributeSaveTarget &saveTarget, vespalib::Executor* executor)
 {
+    _executor = executor;
     saveTarget.setHeader(_header);
     if (!saveTarget.setup()) {
         return false;
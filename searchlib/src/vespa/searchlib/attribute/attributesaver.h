@@ -5,6 +5,8 @@
 #include "attribute_header.h"
 #include <vespa/vespalib/util/generationhandler.h>
 
+namespace vespalib { class Executor; }
+
 namespace search {
 
 class IAttributeSaveTarget;
@@ -20,6 +22,7 @@ class AttributeSaver
 private:
     vespalib::GenerationHandler::Guard _guard;
     attribute::AttributeHeader _header;
+    vespalib::Executor* _executor;
 
 protected:
     AttributeSaver(vespalib::GenerationHandler::Guard &&guard,
@@ -28,10 +31,15 @@ protected:
     virtual bool onSave(IAttributeSaveTarget &saveTarget) = 0;
 
     uint32_t get_header_version() const { return _header.getVersion(); }
+    /*
+     * Executor that can be used by onSave() to encode parts of the
+     * attribute in parallel. nullptr means that saving is single threaded.
+     */
+    vespalib::Executor* get_executor() const noexcept { return _executor; }
 public:
     virtual ~AttributeSaver();
 
-    bool save(IAttributeSaveTarget &saveTarget);
+    bool save(IAttributeSaveTarget &saveTarget, vespalib::Executor* executor = nullptr);
 
     bool hasGenerationGuard() const;
 
@@ -88,7 +88,7 @@ AttributeVector::AttributeVector(std::string_view baseFileName, const Config &c)
       _config(std::make_unique<Config>(c)),
       _interlock(std::make_shared<attribute::Interlock>()),
       _enumLock(),
-      _genHandler(),
+      _genHandler(c.sharded_reader_guards() ? GenerationHandler::default_num_reader_slots() : 1u),
       _genHolder(),
       _status(),
       _highestValueCount(1),
@@ -144,6 +144,10 @@ AttributeVector::commit(bool forceUpdateStats)
 {
     onCommit();
     updateCommittedDocIdLimit();
+    auto *pab = getIPostingListAttributeBase();
+    if (pab != nullptr) {
+        pab->forwardedCommit();
+    }
     updateStat(forceUpdateStats);
     _loaded = true;
 }
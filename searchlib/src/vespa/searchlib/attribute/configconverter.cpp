@@ -108,6 +108,8 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setFastAccess(cfg.fastaccess);
     retval.setMutable(cfg.ismutable);
     retval.setPaged(cfg.paged);
+    retval.set_sharded_reader_guards(cfg.shardedreaderguards);
+    retval.set_compressed_multi_value(cfg.compressedmultivalue);
     retval.setMaxUnCommittedMemory(cfg.maxuncommittedmemory);
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
@@ -9,6 +9,7 @@ namespace search::attribute {
 template <typename MultiValueType, typename RawMultiValueType>
 CopyMultiValueReadView<MultiValueType, RawMultiValueType>::CopyMultiValueReadView(MultiValueMappingReadView<RawMultiValueType> mv_mapping_read_view)
     : _mv_mapping_read_view(mv_mapping_read_view),
+      _raw_buffer(),
       _copy()
 {
 }
@@ -20,7 +21,7 @@ template <typename MultiValueType, typename RawMultiValueType>
 std::span<const MultiValueType>
 CopyMultiValueReadView<MultiValueType, RawMultiValueType>::get_values(uint32_t docid) const
 {
-    auto raw = _mv_mapping_read_view.get(docid);
+    auto raw = _mv_mapping_read_view.get(docid, _raw_buffer);
     if (_copy.size() < raw.size()) {
         _copy.resize(raw.size());
     }
@@ -11,7 +11,8 @@ namespace search::attribute {
 
 /**
  * Read view for the data stored in a multi-value attribute that handles
- * addition and removal of weight.
+ * addition and removal of weight. The read view is created per thread,
+ * compressed values are decoded into a buffer owned by it.
  * @tparam MultiValueType The multi-value type of the data to access.
  * @tparam RawMultiValueType The multi-value type of the raw data to access.
  */
@@ -21,6 +22,7 @@ class CopyMultiValueReadView : public IMultiValueReadView<MultiValueType>
     static_assert(std::is_same_v<multivalue::ValueType_t<MultiValueType>, multivalue::ValueType_t<RawMultiValueType>>);
     using ValueType = multivalue::ValueType_t<MultiValueType>;
     MultiValueMappingReadView<RawMultiValueType> _mv_mapping_read_view;
+    mutable std::vector<RawMultiValueType>       _raw_buffer;
     mutable std::vector<MultiValueType>          _copy;
 public:
     CopyMultiValueReadView(MultiValueMappingReadView<RawMultiValueType> mv_mapping_read_view);
@@ -0,0 +1,202 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "integer_array_codec.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace search::attribute {
+
+namespace {
+
+void
+write_varint(uint64_t value, std::vector<char>& dst)
+{
+    while (value >= 0x80) {
+        dst.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    dst.push_back(static_cast<char>(value));
+}
+
+uint64_t
+read_varint(const char*& p) noexcept
+{
+    uint64_t value = 0;
+    uint32_t shift = 0;
+    uint8_t byte;
+    do {
+        byte = static_cast<uint8_t>(*p++);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        shift += 7;
+    } while ((byte & 0x80) != 0);
+    return value;
+}
+
+constexpr uint64_t
+zigzag_encode(int64_t value) noexcept
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+constexpr int64_t
+zigzag_decode(uint64_t value) noexcept
+{
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+constexpr uint64_t
+low_bits_mask(uint32_t width) noexcept
+{
+    return (width >= 64) ? ~uint64_t(0) : ((uint64_t(1) << width) - 1);
+}
+
+/*
+ * Writes values of a fixed bit width, least significant bit first. Fewer than 8 bits
+ * are kept in the accumulator between calls.
+ */
+class BitWriter {
+    std::vector<char>& _dst;
+    uint64_t           _acc;
+    uint32_t           _bits;
+
+    void flush_bytes() {
+        while (_bits >= 8) {
+            _dst.push_back(static_cast<char>(_acc & 0xff));
+            _acc = (_bits > 8) ? (_acc >> 8) : 0;
+            _bits -= 8;
+        }
+    }
+public:
+    explicit BitWriter(std::vector<char>& dst) noexcept : _dst(dst), _acc(0), _bits(0) { }
+    void write(uint64_t value, uint32_t width) {
+        uint32_t space = 64 - _bits;
+        _acc |= value << _bits;
+        if (width <= space) {
+            _bits += width;
+            flush_bytes();
+        } else {
+            _bits = 64;
+            flush_bytes();
+            _acc = value >> space;
+            _bits = width - space;
+        }
+    }
+    void finish() {
+        if (_bits > 0) {
+            _dst.push_back(static_cast<char>(_acc & 0xff));
+            _acc = 0;
+            _bits = 0;
+        }
+    }
+};
+
+/*
+ * Reads values of a fixed bit width written by BitWriter. Bytes are only consumed
+ * when needed, so no reads are done beyond the packed data.
+ */
+class BitReader {
+    const char* _p;
+    uint64_t    _acc;
+    uint32_t    _bits;
+public:
+    explicit BitReader(const char* p) noexcept : _p(p), _acc(0), _bits(0) { }
+    uint64_t read(uint32_t width) noexcept {
+        while (_bits < width && _bits <= 56) {
+            _acc |= static_cast<uint64_t>(static_cast<uint8_t>(*_p++)) << _bits;
+            _bits += 8;
+        }
+        if (_bits >= width) {
+            uint64_t result = _acc & low_bits_mask(width);
+            _acc = (width >= 64) ? 0 : (_acc >> width);
+            _bits -= width;
+            return result;
+        }
+        // The accumulator can't hold all remaining bits of the value, take the last ones from the next byte.
+        uint64_t next = static_cast<uint8_t>(*_p++);
+        uint32_t from_next = width - _bits;
+        uint64_t result = (_acc | (next << _bits)) & low_bits_mask(width);
+        _acc = next >> from_next;
+        _bits = 8 - from_next;
+        return result;
+    }
+};
+
+}
+
+template <typename T>
+void
+IntegerArrayCodec::encode(std::span<const T> values, std::vector<char>& dst)
+{
+    dst.clear();
+    write_varint(values.size(), dst);
+    if (values.empty()) {
+        return;
+    }
+    auto [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+    int64_t min_value = *min_it;
+    uint64_t max_offset = static_cast<uint64_t>(static_cast<int64_t>(*max_it)) - static_cast<uint64_t>(min_value);
+    uint32_t width = std::bit_width(max_offset);
+    write_varint(zigzag_encode(min_value), dst);
+    dst.push_back(static_cast<char>(width));
+    if (width == 0) {
+        return;
+    }
+    dst.reserve(dst.size() + (values.size() * width + 7) / 8);
+    BitWriter writer(dst);
+    for (T value : values) {
+        writer.write(static_cast<uint64_t>(static_cast<int64_t>(value)) - static_cast<uint64_t>(min_value), width);
+    }
+    writer.finish();
+}
+
+template <typename T>
+std::span<const T>
+IntegerArrayCodec::decode(std::span<const char> src, std::vector<T>& buf)
+{
+    if (src.empty()) {
+        return {};
+    }
+    const char* p = src.data();
+    size_t value_count = read_varint(p);
+    if (buf.size() < value_count) {
+        buf.resize(value_count);
+    }
+    if (value_count == 0) {
+        return {};
+    }
+    uint64_t min_value = static_cast<uint64_t>(zigzag_decode(read_varint(p)));
+    uint32_t width = static_cast<uint8_t>(*p++);
+    T* dst = buf.data();
+    if (width == 0) {
+        std::fill(dst, dst + value_count, static_cast<T>(static_cast<int64_t>(min_value)));
+    } else {
+        BitReader reader(p);
+        for (size_t i = 0; i < value_count; ++i) {
+            dst[i] = static_cast<T>(static_cast<int64_t>(min_value + reader.read(width)));
+        }
+    }
+    assert(p <= src.data() + src.size());
+    return {dst, value_count};
+}
+
+uint32_t
+IntegerArrayCodec::decode_value_count(std::span<const char> src) noexcept
+{
+    if (src.empty()) {
+        return 0;
+    }
+    const char* p = src.data();
+    return read_varint(p);
+}
+
+template void IntegerArrayCodec::encode<int8_t>(std::span<const int8_t>, std::vector<char>&);
+template void IntegerArrayCodec::encode<int16_t>(std::span<const int16_t>, std::vector<char>&);
+template void IntegerArrayCodec::encode<int32_t>(std::span<const int32_t>, std::vector<char>&);
+template void IntegerArrayCodec::encode<int64_t>(std::span<const int64_t>, std::vector<char>&);
+template std::span<const int8_t> IntegerArrayCodec::decode<int8_t>(std::span<const char>, std::vector<int8_t>&);
+template std::span<const int16_t> IntegerArrayCodec::decode<int16_t>(std::span<const char>, std::vector<int16_t>&);
+template std::span<const int32_t> IntegerArrayCodec::decode<int32_t>(std::span<const char>, std::vector<int32_t>&);
+template std::span<const int64_t> IntegerArrayCodec::decode<int64_t>(std::span<const char>, std::vector<int64_t>&);
+
+}
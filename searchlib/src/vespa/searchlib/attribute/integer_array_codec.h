@@ -0,0 +1,36 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace search::attribute {
+
+/**
+ * Codec used when storing arrays of integers compressed in a multi-value mapping.
+ *
+ * The values of an array are stored as offsets from the smallest value, bit packed using the
+ * number of bits needed by the largest offset. The order of the values is kept, so an array
+ * decodes to exactly the values that were encoded.
+ *
+ * Layout: value count (varint), smallest value (zigzag varint), bits per offset (1 byte),
+ * followed by the bit packed offsets.
+ */
+class IntegerArrayCodec {
+public:
+    template <typename T>
+    static void encode(std::span<const T> values, std::vector<char>& dst);
+
+    /*
+     * Decodes the array into buf, which is resized as needed, and returns a span
+     * over the decoded values. The span is valid until buf is modified.
+     */
+    template <typename T>
+    static std::span<const T> decode(std::span<const char> src, std::vector<T>& buf);
+
+    static uint32_t decode_value_count(std::span<const char> src) noexcept;
+};
+
+}
@@ -18,6 +18,8 @@ public:
     virtual ~IPostingListAttributeBase() = default;
     virtual void clearPostings(IAttributeVector::EnumHandle eidx, uint32_t fromLid, uint32_t toLid) = 0;
     virtual void forwardedShrinkLidSpace(uint32_t newSize) = 0;
+    // Called when all changes for a commit have been applied to the posting lists
+    virtual void forwardedCommit() = 0;
     virtual PostingStoreMemoryUsage getMemoryUsage() const = 0;
     virtual bool consider_compact_worst_btree_nodes(const CompactionStrategy& compaction_strategy) = 0;
     virtual bool consider_compact_worst_buffers(const CompactionStrategy& compaction_strategy) = 0;
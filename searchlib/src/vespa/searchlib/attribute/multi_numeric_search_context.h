@@ -28,10 +28,19 @@ private:
         return find(docId, elemId);
     }
 
+    std::span<const M> get_values(DocId doc) const {
+        if (_mv_mapping_read_view.is_compressed()) [[unlikely]] {
+            // The search context is shared by all match threads, decode into a buffer owned by the calling thread.
+            thread_local std::vector<M> buffer;
+            return _mv_mapping_read_view.get(doc, buffer);
+        }
+        return _mv_mapping_read_view.get(doc);
+    }
+
 public:
     MultiNumericSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const AttributeVector& toBeSearched, MultiValueMappingReadView<M> mv_mapping_read_view);
     int32_t find(DocId doc, int32_t elemId, int32_t & weight) const {
-        auto values(_mv_mapping_read_view.get(doc));
+        auto values(get_values(doc));
         for (uint32_t i(elemId); i < values.size(); i++) {
             if (this->match(multivalue::get_value(values[i]))) {
                 weight = multivalue::get_weight(values[i]);
@@ -43,7 +52,7 @@ public:
     }
 
     int32_t find(DocId doc, int32_t elemId) const {
-        auto values(_mv_mapping_read_view.get(doc));
+        auto values(get_values(doc));
         for (uint32_t i(elemId); i < values.size(); i++) {
             if (this->match(multivalue::get_value(values[i]))) {
                 return i;
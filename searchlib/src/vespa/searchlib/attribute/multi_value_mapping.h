@@ -8,11 +8,16 @@
 #include <vespa/vespalib/datastore/array_store_dynamic_type_mapper.h>
 #include <vespa/vespalib/datastore/dynamic_array_buffer_type.h>
 #include <vespa/vespalib/util/address_space.h>
+#include <type_traits>
 
 namespace search::attribute {
 
 /**
  * Class for mapping from document id to an array of values.
+ *
+ * For arrays of integers the values can optionally be stored compressed (see IntegerArrayCodec)
+ * in a separate store. Values are then decoded on read into a buffer provided by the caller,
+ * or owned by the read view, and get() without a buffer must not be used.
  */
 template <typename ElemT, typename RefT = vespalib::datastore::EntryRefT<19> >
 class MultiValueMapping : public MultiValueMappingBase
@@ -24,24 +29,59 @@ public:
 
     static constexpr double array_store_grow_factor = 1.03;
     static constexpr uint32_t array_store_max_type_id = 300;
+    static constexpr bool supports_compression = std::is_integral_v<ElemT>;
 private:
     using ArrayRef = std::span<ElemT>;
     using ArrayStoreTypeMapper = vespalib::datastore::ArrayStoreDynamicTypeMapper<ElemT>;
     using ArrayStore = vespalib::datastore::ArrayStore<ElemT, RefT, ArrayStoreTypeMapper>;
     using generation_t = vespalib::GenerationHandler::generation_t;
     using ConstArrayRef = std::span<const ElemT>;
+    using CompressedArrayStore = typename ReadView::CompressedArrayStore;
 
     ArrayStore _store;
+    std::unique_ptr<CompressedArrayStore> _compressed_store;
+    std::vector<char> _encode_buffer;
+
+    ConstArrayRef get_compressed(EntryRef ref, std::vector<ElemT>& buffer) const;
+    uint32_t get_compressed_value_count(EntryRef ref) const;
+    void set_compressed(uint32_t docId, ConstArrayRef values);
 public:
     MultiValueMapping(const MultiValueMapping &) = delete;
     MultiValueMapping & operator = (const MultiValueMapping &) = delete;
     MultiValueMapping(const vespalib::datastore::ArrayStoreConfig &storeCfg,
                       size_t max_buffer_size,
                       const vespalib::GrowStrategy &gs,
-                      std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator);
+                      std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator,
+                      bool compress_values = false);
     ~MultiValueMapping() override;
+    bool is_compressed() const noexcept { return static_cast<bool>(_compressed_store); }
+    // Only valid when values are not compressed, see get(docId, buffer).
     ConstArrayRef get(uint32_t docId) const { return _store.get(acquire_entry_ref(docId)); }
+    /*
+     * Returns the values for the given document. Compressed values are decoded into buffer,
+     * and the returned span is then only valid until buffer is modified.
+     */
+    ConstArrayRef get(uint32_t docId, std::vector<ElemT>& buffer) const {
+        EntryRef ref = acquire_entry_ref(docId);
+        if (_compressed_store) [[unlikely]] {
+            return get_compressed(ref, buffer);
+        }
+        return _store.get(ref);
+    }
+    uint32_t get_value_count(uint32_t docId) const {
+        EntryRef ref = acquire_entry_ref(docId);
+        if (_compressed_store) [[unlikely]] {
+            return get_compressed_value_count(ref);
+        }
+        return _store.get(ref).size();
+    }
     ConstArrayRef getDataForIdx(EntryRef idx) const { return _store.get(idx); }
+    ConstArrayRef getDataForIdx(EntryRef idx, std::vector<ElemT>& buffer) const {
+        if (_compressed_store) [[unlikely]] {
+            return get_compressed(idx, buffer);
+        }
+        return _store.get(idx);
+    }
     void set(uint32_t docId, ConstArrayRef values);
 
     // get_writable is generally unsafe and should only be used when
@@ -53,28 +93,37 @@ public:
      * get a read view to the multi value mapping. Array bound (read_size) must
      * be specified by reader, cf. committed docid limit in attribute vectors.
      */
-    ReadView make_read_view(size_t read_size) const { return ReadView(_indices.make_read_view(read_size), &_store); }
-    // Pass on hold list management to underlying store
-    void assign_generation(generation_t current_gen) { _store.assign_generation(current_gen); }
-    void reclaim_memory(generation_t oldest_used_gen) { _store.reclaim_memory(oldest_used_gen); }
-    void prepareLoadFromMultiValue() { _store.setInitializing(true); }
-
-    void doneLoadFromMultiValue() { _store.setInitializing(false); }
+    ReadView make_read_view(size_t read_size) const {
+        return ReadView(_indices.make_read_view(read_size), &_store, _compressed_store.get());
+    }
+    // Pass on hold list management to underlying stores
+    void assign_generation(generation_t current_gen);
+    void reclaim_memory(generation_t oldest_used_gen);
+    void prepareLoadFromMultiValue();
+    void doneLoadFromMultiValue();
 
     vespalib::AddressSpace getAddressSpaceUsage() const override;
     vespalib::MemoryUsage getArrayStoreMemoryUsage() const override;
     vespalib::MemoryUsage update_stat(const CompactionStrategy& compaction_strategy);
     bool consider_compact(const CompactionStrategy &compactionStrategy) {
-        if (_store.consider_compact()) {
+        if (_compressed_store ? _compressed_store->consider_compact() : _store.consider_compact()) {
             compact_worst(compactionStrategy);
             return true;
         }
         return false;
     }
     void compact_worst(const CompactionStrategy& compaction_strategy);
-    bool has_free_lists_enabled() const { return _store.has_free_lists_enabled(); }
+    bool has_free_lists_enabled() const {
+        return _compressed_store ? _compressed_store->has_free_lists_enabled() : _store.has_free_lists_enabled();
+    }
     // Set compaction spec. Only used by unit tests.
-    void set_compaction_spec(vespalib::datastore::CompactionSpec compaction_spec) noexcept { _store.set_compaction_spec(compaction_spec); }
+    void set_compaction_spec(vespalib::datastore::CompactionSpec compaction_spec) noexcept {
+        if (_compressed_store) {
+            _compressed_store->set_compaction_spec(compaction_spec);
+        } else {
+            _store.set_compaction_spec(compaction_spec);
+        }
+    }
     // Get type mapper. Only used by unit tests.
     const ArrayStoreTypeMapper &get_mapper() const noexcept { return _store.get_mapper(); }
 
@@ -4,6 +4,8 @@
 
 #include "multi_value_mapping.h"
 #include <vespa/vespalib/datastore/array_store.hpp>
+#include <vespa/vespalib/util/memory_allocator.h>
+#include <vespa/vespalib/util/size_literals.h>
 
 namespace search::attribute {
 
@@ -11,20 +13,79 @@ template <typename ElemT, typename RefT>
 MultiValueMapping<ElemT,RefT>::MultiValueMapping(const vespalib::datastore::ArrayStoreConfig &storeCfg,
                                                  size_t max_buffer_size,
                                                   const vespalib::GrowStrategy &gs,
-                                                  std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator)
+                                                  std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator,
+                                                  bool compress_values)
   : MultiValueMappingBase(gs, ArrayStore::getGenerationHolderLocation(_store), memory_allocator),
-    _store(storeCfg, std::move(memory_allocator), ArrayStoreTypeMapper(storeCfg.max_type_id(), array_store_grow_factor, max_buffer_size))
+    _store(storeCfg, memory_allocator, ArrayStoreTypeMapper(storeCfg.max_type_id(), array_store_grow_factor, max_buffer_size)),
+    _compressed_store(),
+    _encode_buffer()
 {
+    if (compress_values && supports_compression) {
+        using CompressedTypeMapper = vespalib::datastore::ArrayStoreDynamicTypeMapper<char>;
+        CompressedTypeMapper mapper(storeCfg.max_type_id(), array_store_grow_factor, max_buffer_size);
+        auto compressed_cfg = CompressedArrayStore::optimizedConfigForHugePage(storeCfg.max_type_id(), mapper,
+                                                                               vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+                                                                               vespalib::alloc::MemoryAllocator::PAGE_SIZE,
+                                                                               max_buffer_size, 8_Ki,
+                                                                               storeCfg.spec_for_type_id(0).allocGrowFactor);
+        compressed_cfg.enable_free_lists(storeCfg.enable_free_lists());
+        _compressed_store = std::make_unique<CompressedArrayStore>(compressed_cfg, std::move(memory_allocator), std::move(mapper));
+    }
 }
 
 template <typename ElemT, typename RefT>
 MultiValueMapping<ElemT,RefT>::~MultiValueMapping() = default;
 
+template <typename ElemT, typename RefT>
+typename MultiValueMapping<ElemT,RefT>::ConstArrayRef
+MultiValueMapping<ElemT,RefT>::get_compressed(EntryRef ref, std::vector<ElemT>& buffer) const
+{
+    if constexpr (supports_compression) {
+        return IntegerArrayCodec::decode(_compressed_store->get(ref), buffer);
+    } else {
+        (void) ref;
+        (void) buffer;
+        return {};
+    }
+}
+
+template <typename ElemT, typename RefT>
+uint32_t
+MultiValueMapping<ElemT,RefT>::get_compressed_value_count(EntryRef ref) const
+{
+    return IntegerArrayCodec::decode_value_count(_compressed_store->get(ref));
+}
+
+template <typename ElemT, typename RefT>
+void
+MultiValueMapping<ElemT,RefT>::set_compressed(uint32_t docId, ConstArrayRef values)
+{
+    if constexpr (supports_compression) {
+        EntryRef oldRef(_indices[docId].load_relaxed());
+        uint32_t old_value_count = get_compressed_value_count(oldRef);
+        EntryRef newRef;
+        if (!values.empty()) {
+            IntegerArrayCodec::encode(values, _encode_buffer);
+            newRef = _compressed_store->add(_encode_buffer);
+        }
+        _indices[docId].store_release(newRef);
+        updateValueCount(old_value_count, values.size());
+        _compressed_store->remove(oldRef);
+    } else {
+        (void) docId;
+        (void) values;
+    }
+}
+
 template <typename ElemT, typename RefT>
 void
 MultiValueMapping<ElemT,RefT>::set(uint32_t docId, ConstArrayRef values)
 {
     _indices.ensure_size(docId + 1);
+    if (_compressed_store) [[unlikely]] {
+        set_compressed(docId, values);
+        return;
+    }
     EntryRef oldRef(_indices[docId].load_relaxed());
     ConstArrayRef oldValues = _store.get(oldRef);
     _indices[docId].store_release(_store.add(values));
@@ -32,11 +93,54 @@ MultiValueMapping<ElemT,RefT>::set(uint32_t docId, ConstArrayRef values)
     _store.remove(oldRef);
 }
 
+template <typename ElemT, typename RefT>
+void
+MultiValueMapping<ElemT,RefT>::assign_generation(generation_t current_gen)
+{
+    _store.assign_generation(current_gen);
+    if (_compressed_store) {
+        _compressed_store->assign_generation(current_gen);
+    }
+}
+
+template <typename ElemT, typename RefT>
+void
+MultiValueMapping<ElemT,RefT>::reclaim_memory(generation_t oldest_used_gen)
+{
+    _store.reclaim_memory(oldest_used_gen);
+    if (_compressed_store) {
+        _compressed_store->reclaim_memory(oldest_used_gen);
+    }
+}
+
+template <typename ElemT, typename RefT>
+void
+MultiValueMapping<ElemT,RefT>::prepareLoadFromMultiValue()
+{
+    _store.setInitializing(true);
+    if (_compressed_store) {
+        _compressed_store->setInitializing(true);
+    }
+}
+
+template <typename ElemT, typename RefT>
+void
+MultiValueMapping<ElemT,RefT>::doneLoadFromMultiValue()
+{
+    _store.setInitializing(false);
+    if (_compressed_store) {
+        _compressed_store->setInitializing(false);
+    }
+}
+
 template <typename ElemT, typename RefT>
 vespalib::MemoryUsage
 MultiValueMapping<ElemT,RefT>::update_stat(const CompactionStrategy& compaction_strategy)
 {
     auto retval = _store.update_stat(compaction_strategy);
+    if (_compressed_store) {
+        retval.merge(_compressed_store->update_stat(compaction_strategy));
+    }
     retval.merge(_indices.getMemoryUsage());
     return retval;
 }
@@ -45,7 +149,9 @@ template <typename ElemT, typename RefT>
 void
 MultiValueMapping<ElemT,RefT>::compact_worst(const CompactionStrategy& compaction_strategy)
 {
-    vespalib::datastore::ICompactionContext::UP compactionContext(_store.compact_worst(compaction_strategy));
+    vespalib::datastore::ICompactionContext::UP compactionContext(_compressed_store
+                                                                  ? _compressed_store->compact_worst(compaction_strategy)
+                                                                  : _store.compact_worst(compaction_strategy));
     if (compactionContext) {
         compactionContext->compact(std::span<AtomicEntryRef>(&_indices[0], _indices.size()));
     }
@@ -55,13 +161,17 @@ template <typename ElemT, typename RefT>
 vespalib::MemoryUsage
 MultiValueMapping<ElemT,RefT>::getArrayStoreMemoryUsage() const
 {
-    return _store.getMemoryUsage();
+    auto retval = _store.getMemoryUsage();
+    if (_compressed_store) {
+        retval.merge(_compressed_store->getMemoryUsage());
+    }
+    return retval;
 }
 
 template <typename ElemT, typename RefT>
 vespalib::AddressSpace
 MultiValueMapping<ElemT, RefT>::getAddressSpaceUsage() const {
-    return _store.addressSpaceUsage();
+    return _compressed_store ? _compressed_store->addressSpaceUsage() : _store.addressSpaceUsage();
 }
 
 template <typename ElemT, typename RefT>
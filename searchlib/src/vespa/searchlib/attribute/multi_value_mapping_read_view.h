@@ -2,39 +2,71 @@
 
 #pragma once
 
+#include "integer_array_codec.h"
 #include <vespa/vespalib/datastore/atomic_entry_ref.h>
 #include <vespa/vespalib/datastore/array_store.h>
 #include <vespa/vespalib/datastore/array_store_dynamic_type_mapper.h>
 #include <vespa/vespalib/datastore/dynamic_array_buffer_type.h>
 #include <vespa/vespalib/util/address_space.h>
+#include <type_traits>
+#include <vector>
 
 namespace search::attribute {
 
 /**
  * Class for mapping from document id to an array of values as reader.
+ *
+ * The read view is shared by all threads searching the attribute. When the values are stored
+ * compressed they are decoded into a buffer owned by the caller, and the span returned by
+ * get(doc_id, buffer) is then only valid until the buffer is modified.
  */
 template <typename ElemT, typename RefT = vespalib::datastore::EntryRefT<19> >
 class MultiValueMappingReadView
 {
+public:
+    using CompressedArrayStore = vespalib::datastore::ArrayStore<char, RefT, vespalib::datastore::ArrayStoreDynamicTypeMapper<char>>;
+private:
     using AtomicEntryRef = vespalib::datastore::AtomicEntryRef;
     using Indices = std::span<const AtomicEntryRef>;
     using ArrayStoreTypeMapper = vespalib::datastore::ArrayStoreDynamicTypeMapper<ElemT>;
     using ArrayStore = vespalib::datastore::ArrayStore<ElemT, RefT, ArrayStoreTypeMapper>;
 
-    Indices           _indices;
-    const ArrayStore* _store;
+    Indices                     _indices;
+    const ArrayStore*           _store;
+    const CompressedArrayStore* _compressed_store;
+
+    std::span<const ElemT> get_compressed(vespalib::datastore::EntryRef ref, std::vector<ElemT>& buffer) const {
+        if constexpr (std::is_integral_v<ElemT>) {
+            return IntegerArrayCodec::decode(_compressed_store->get(ref), buffer);
+        } else {
+            return {};
+        }
+    }
 public:
     constexpr MultiValueMappingReadView()
         : _indices(),
-          _store(nullptr)
+          _store(nullptr),
+          _compressed_store(nullptr)
     {
     }
-    MultiValueMappingReadView(Indices indices, const ArrayStore* store)
+    MultiValueMappingReadView(Indices indices, const ArrayStore* store, const CompressedArrayStore* compressed_store = nullptr)
         : _indices(indices),
-          _store(store)
+          _store(store),
+          _compressed_store(compressed_store)
     {
     }
-    std::span<const ElemT> get(uint32_t doc_id) const { return _store->get(_indices[doc_id].load_acquire()); }
+    // Only valid when values are not stored compressed, cf. is_compressed().
+    std::span<const ElemT> get(uint32_t doc_id) const {
+        return _store->get(_indices[doc_id].load_acquire());
+    }
+    std::span<const ElemT> get(uint32_t doc_id, std::vector<ElemT>& buffer) const {
+        auto ref = _indices[doc_id].load_acquire();
+        if (_compressed_store != nullptr) [[unlikely]] {
+            return get_compressed(ref, buffer);
+        }
+        return _store->get(ref);
+    }
+    bool is_compressed() const noexcept { return _compressed_store != nullptr; }
     bool valid() const noexcept { return _store != nullptr; }
     uint32_t get_committed_docid_limit() const noexcept { return _indices.size(); }
 };
@@ -45,9 +45,19 @@ private:
     T getFromEnum(EnumHandle e) const override;
     bool findEnum(T value, EnumHandle & e) const override;
 
+    // The returned values are only valid until the next call from the same thread.
+    MultiValueArrayRef get_values(DocId doc) const {
+        if (this->_mvMapping.is_compressed()) [[unlikely]] {
+            thread_local std::vector<MultiValueType> values_buffer;
+            return this->_mvMapping.get(doc, values_buffer);
+        }
+        return this->_mvMapping.get(doc);
+    }
+
 protected:
     using generation_t = typename B::generation_t;
     using WType = MultiValueType;
+    // Only used by attributes with fast-search, which never store their values compressed.
     uint32_t get(DocId doc, const WType * & values) const {
         MultiValueArrayRef array(this->_mvMapping.get(doc));
         values = array.data();
@@ -82,15 +92,15 @@ public:
     // new read api
     //-------------------------------------------------------------------------
     T get(DocId doc) const override {
-        MultiValueArrayRef values(this->_mvMapping.get(doc));
+        MultiValueArrayRef values(get_values(doc));
         return ((values.size() > 0) ? multivalue::get_value(values[0]) : T());
     }
     largeint_t getInt(DocId doc) const override {
-        MultiValueArrayRef values(this->_mvMapping.get(doc));
+        MultiValueArrayRef values(get_values(doc));
         return static_cast<largeint_t>((values.size() > 0) ? multivalue::get_value(values[0]) : T());
     }
     double getFloat(DocId doc) const override {
-        MultiValueArrayRef values(this->_mvMapping.get(doc));
+        MultiValueArrayRef values(get_values(doc));
         return static_cast<double>((values.size() > 0) ? multivalue::get_value(values[0]) : T());
     }
     EnumHandle getEnum(DocId doc) const override {
@@ -105,7 +115,7 @@ public:
     }
     template <typename BufferType>
     uint32_t getHelper(DocId doc, BufferType * buffer, uint32_t sz) const {
-        MultiValueArrayRef handle(this->_mvMapping.get(doc));
+        MultiValueArrayRef handle(get_values(doc));
         uint32_t ret = handle.size();
         for(size_t i(0), m(std::min(sz, ret)); i < m; i++) {
             buffer[i] = static_cast<BufferType>(multivalue::get_value(handle[i]));
@@ -120,8 +130,7 @@ public:
     }
     template <typename E>
     uint32_t getEnumHelper(DocId doc, E * e, uint32_t sz) const {
-        MultiValueArrayRef values(this->_mvMapping.get(doc));
-        uint32_t available = values.size();
+        uint32_t available = this->_mvMapping.get_value_count(doc);
         uint32_t num2Read = std::min(available, sz);
         for (uint32_t i = 0; i < num2Read; ++i) {
             e[i] = E(std::numeric_limits<uint32_t>::max()); // does not have enum
@@ -136,7 +145,7 @@ public:
     }
     template <typename WeightedType, typename ValueType>
     uint32_t getWeightedHelper(DocId doc, WeightedType * buffer, uint32_t sz) const {
-        MultiValueArrayRef handle(this->_mvMapping.get(doc));
+        MultiValueArrayRef handle(get_values(doc));
         uint32_t ret = handle.size();
         for(size_t i(0), m(std::min(sz, ret)); i < m; i++) {
             buffer[i] = WeightedType(static_cast<ValueType>(multivalue::get_value(handle[i])),
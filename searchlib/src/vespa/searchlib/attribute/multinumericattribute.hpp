@@ -45,8 +45,7 @@ uint32_t MultiValueNumericAttribute<B, M>::getValueCount(DocId doc) const
     if (doc >= B::getNumDocs()) {
         return 0;
     }
-    MultiValueArrayRef values(this->_mvMapping.get(doc));
-    return values.size();
+    return this->_mvMapping.get_value_count(doc);
 }
 
 template <typename B, typename M>
@@ -199,7 +198,7 @@ long
 MultiValueNumericAttribute<B, M>::on_serialize_for_sort(DocId doc, void* serTo, long available) const
 {
     attribute::NumericSortBlobWriter<T, asc> writer;
-    auto indices = this->_mvMapping.get(doc);
+    auto indices = get_values(doc);
     for (auto& v : indices) {
         writer.candidate(multivalue::get_value(v));
     }
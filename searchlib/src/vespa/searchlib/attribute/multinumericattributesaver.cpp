@@ -61,9 +61,10 @@ MultiValueNumericAttributeSaver<MultiValueT>::onSave(IAttributeSaveTarget &saveT
     WeightWriter<multivalue::is_WeightedValue_v<MultiValueType>> weightWriter(saveTarget);
     DatWriter datWriter(saveTarget);
 
+    std::vector<MultiValueType> buffer;
     for (uint32_t docId = 0; docId < _frozenIndices.size(); ++docId) {
         vespalib::datastore::EntryRef idx = _frozenIndices[docId];
-        std::span<const MultiValueType> values(_mvMapping.getDataForIdx(idx));
+        std::span<const MultiValueType> values(_mvMapping.getDataForIdx(idx, buffer));
         countWriter.writeCount(values.size());
         weightWriter.writeWeights(values);
         datWriter.writeValues(values);
@@ -70,6 +70,8 @@ private:
     void applyValueChanges(const DocIndices& docIndices, EnumStoreBatchUpdater& updater) override;
 
 public:
+    using PostingParent::get_bitvector_cache;
+
     MultiValueNumericPostingAttribute(const std::string & name, const AttributeVector::Config & cfg);
     ~MultiValueNumericPostingAttribute();
 
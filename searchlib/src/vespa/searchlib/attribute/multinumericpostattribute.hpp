@@ -5,6 +5,7 @@
 #include "multinumericpostattribute.h"
 #include "multi_numeric_enum_search_context.h"
 #include "numeric_direct_posting_store_adapter.hpp"
+#include "posting_bitvector_cache.h"
 #include <vespa/searchcommon/attribute/config.h>
 #include <charconv>
 
@@ -23,6 +24,7 @@ MultiValueNumericPostingAttribute<B, M>::mergeMemoryStats(vespalib::MemoryUsage
 {
     auto& compaction_strategy = this->getConfig().getCompactionStrategy();
     total.merge(this->get_posting_store().update_stat(compaction_strategy));
+    total.merge(this->get_bitvector_cache().get_memory_usage());
 }
 
 template <typename B, typename M>
@@ -66,6 +66,7 @@ private:
 
 public:
     using PostingParent::get_posting_store;
+    using PostingParent::get_bitvector_cache;
     using Dictionary = EnumPostingTree;
 
     MultiValueStringPostingAttributeT(const std::string & name, const AttributeVector::Config & c);
@@ -5,6 +5,7 @@
 #include "multistringpostattribute.h"
 #include "multi_string_enum_search_context.h"
 #include "string_direct_posting_store_adapter.hpp"
+#include "posting_bitvector_cache.h"
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/query/query_term_simple.h>
 
@@ -71,6 +72,7 @@ MultiValueStringPostingAttributeT<B, T>::mergeMemoryStats(vespalib::MemoryUsage
 {
     auto& compaction_strategy = this->getConfig().getCompactionStrategy();
     total.merge(this->_posting_store.update_stat(compaction_strategy));
+    total.merge(this->get_bitvector_cache().get_memory_usage());
 }
 
 template <typename B, typename T>
@@ -101,7 +103,7 @@ MultiValueStringPostingAttributeT<B, T>::getSearch(QueryTermSimpleUP qTerm,
     bool cased = this->get_match_is_cased();
     auto doc_id_limit = this->getCommittedDocIdLimit();
     BaseSC base_sc(std::move(qTerm), cased, params.fuzzy_matching_algorithm(), *this, this->_mvMapping.make_read_view(doc_id_limit), this->_enumStore);
-    return std::make_unique<SC>(std::move(base_sc), params.useBitVector(), *this);
+    return std::make_unique<SC>(std::move(base_sc), params, *this);
 }
 
 template <typename B, typename T>
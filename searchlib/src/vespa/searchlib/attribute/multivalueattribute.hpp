@@ -35,7 +35,8 @@ MultiValueAttribute(const std::string &baseFileName,
                                                                cfg.getGrowStrategy().getMultiValueAllocGrowFactor(),
                                                                multivalueattribute::enable_free_lists),
                  ArrayStoreConfig::default_max_buffer_size,
-                 cfg.getGrowStrategy(), this->get_memory_allocator())
+                 cfg.getGrowStrategy(), this->get_memory_allocator(),
+                 cfg.compressed_multi_value() && !cfg.fastSearch())
 {
 }
 
@@ -45,7 +46,8 @@ MultiValueAttribute<B, M>::~MultiValueAttribute() = default;
 template <typename B, typename M>
 int32_t MultiValueAttribute<B, M>::getWeight(DocId doc, uint32_t idx) const
 {
-    MultiValueArrayRef values(this->_mvMapping.get(doc));
+    std::vector<MultiValueType> buffer;
+    MultiValueArrayRef values(this->_mvMapping.get(doc, buffer));
     return ((idx < values.size()) ? multivalue::get_weight(values[idx]) : 1);
 }
 
@@ -87,6 +89,7 @@ MultiValueAttribute<B, M>::apply_attribute_changes_to_array(DocumentValues& docV
 {
     // compute new values for each document with changes
     auto iterable = this->_changes.getDocIdInsertOrder();
+    std::vector<MultiValueType> old_values_buffer;
     for (auto current(iterable.begin()), end(iterable.end()); (current != end); ) {
         DocId doc = current->_doc;
         // find last clear doc
@@ -100,7 +103,7 @@ MultiValueAttribute<B, M>::apply_attribute_changes_to_array(DocumentValues& docV
         if (last_clear_doc != end) {
             current = last_clear_doc;
         }
-        MultiValueArrayRef old_values(_mvMapping.get(doc));
+        MultiValueArrayRef old_values(_mvMapping.get(doc, old_values_buffer));
         ValueVector new_values(old_values.begin(), old_values.end());
         vespalib::hash_map<NonAtomicValueType, size_t, typename HashFn<NonAtomicValueType>::type> tombstones;
 
@@ -160,6 +163,7 @@ MultiValueAttribute<B, M>::apply_attribute_changes_to_wset(DocumentValues& docVa
 {
     // compute new values for each document with changes
     auto iterable = this->_changes.getDocIdInsertOrder();
+    std::vector<MultiValueType> old_values_buffer;
     for (auto current(iterable.begin()), end(iterable.end()); (current != end); ) {
         const DocId doc = current->_doc;
         // find last clear doc
@@ -175,7 +179,7 @@ MultiValueAttribute<B, M>::apply_attribute_changes_to_wset(DocumentValues& docVa
         if (last_clear_doc != end) {
             current = last_clear_doc;
         }
-        MultiValueArrayRef old_values(_mvMapping.get(doc));
+        MultiValueArrayRef old_values(_mvMapping.get(doc, old_values_buffer));
         vespalib::hash_map<NonAtomicValueType, int32_t, typename HashFn<NonAtomicValueType>::type> wset_inserted;
         wset_inserted.resize((old_values.size() + max_elems_inserted) * 2);
         for (const auto& e : old_values) {
@@ -266,8 +270,7 @@ MultiValueAttribute<B, M>::getValueCount(DocId doc) const
     if (doc >= this->getNumDocs()) {
         return 0;
     }
-    MultiValueArrayRef values(this->_mvMapping.get(doc));
-    return values.size();
+    return this->_mvMapping.get_value_count(doc);
 }
 
 
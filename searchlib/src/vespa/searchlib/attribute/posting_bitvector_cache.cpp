@@ -0,0 +1,191 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "posting_bitvector_cache.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <algorithm>
+
+namespace search::attribute {
+
+PostingBitVectorCache::PostingBitVectorCache()
+    : PostingBitVectorCache(default_max_entries, default_min_uses, default_max_logged_changes)
+{
+}
+
+PostingBitVectorCache::PostingBitVectorCache(size_t max_entries, uint32_t min_uses, size_t max_logged_changes)
+    : _lock(),
+      _cache(max_entries),
+      _changes(),
+      _logged_changes(0),
+      _pending(),
+      _pending_dropped(false),
+      _in_use(false),
+      _seq(0),
+      _oldest_patchable_seq(0),
+      _min_uses(min_uses),
+      _max_logged_changes(max_logged_changes)
+{
+}
+
+PostingBitVectorCache::~PostingBitVectorCache() = default;
+
+bool
+PostingBitVectorCache::collect_changes(uint64_t from_seq, uint64_t to_seq, std::vector<uint32_t> &docids) const
+{
+    if (from_seq < _oldest_patchable_seq) {
+        return false;
+    }
+    for (const auto &changes : _changes) {
+        if (changes.seq > from_seq && changes.seq <= to_seq) {
+            docids.insert(docids.end(), changes.docids.begin(), changes.docids.end());
+        }
+    }
+    return true;
+}
+
+PostingBitVectorCache::BitVectorSP
+PostingBitVectorCache::lookup(const std::string &key, uint64_t seq, uint32_t docid_limit, const Matcher &matches)
+{
+    BitVectorSP base;
+    uint32_t base_docid_limit = 0;
+    std::vector<uint32_t> docids;
+    {
+        std::lock_guard guard(_lock);
+        _in_use.store(true, std::memory_order_relaxed);
+        Entry *entry = _cache.find_and_ref(key);
+        if (entry == nullptr) {
+            Entry admission;
+            admission.uses = 1;
+            _cache.insert(key, std::move(admission));
+            return {};
+        }
+        if (entry->uses < _min_uses) {
+            ++entry->uses;
+        }
+        if (!entry->bit_vector || (entry->seq > seq) || (entry->docid_limit > docid_limit)) {
+            return {};
+        }
+        if ((entry->seq == seq) && (entry->docid_limit == docid_limit)) {
+            return entry->bit_vector;
+        }
+        if (!collect_changes(entry->seq, seq, docids)) {
+            return {};
+        }
+        base = entry->bit_vector;
+        base_docid_limit = entry->docid_limit;
+    }
+    // Patch a private copy of the cached bit vector outside the lock.
+    BitVectorSP patched(BitVector::create(*base, 0, docid_limit));
+    for (uint32_t docid : docids) {
+        if (docid < docid_limit) {
+            if (matches(docid)) {
+                patched->setBit(docid);
+            } else {
+                patched->clearBit(docid);
+            }
+        }
+    }
+    for (uint32_t docid = base_docid_limit; docid < docid_limit; ++docid) {
+        if (matches(docid)) {
+            patched->setBit(docid);
+        }
+    }
+    patched->invalidateCachedCount();
+    insert(key, seq, docid_limit, patched);
+    return patched;
+}
+
+void
+PostingBitVectorCache::insert(const std::string &key, uint64_t seq, uint32_t docid_limit, BitVectorSP bit_vector)
+{
+    // Count bits up front, cached bit vectors are shared between readers.
+    bit_vector->countTrueBits();
+    BitVectorSP replaced;
+    std::lock_guard guard(_lock);
+    Entry *entry = _cache.find_and_ref(key);
+    if ((entry == nullptr) || (entry->uses < _min_uses)) {
+        return;
+    }
+    if (entry->bit_vector && ((entry->seq > seq) || ((entry->seq == seq) && (entry->docid_limit >= docid_limit)))) {
+        return;
+    }
+    replaced = std::move(entry->bit_vector);
+    entry->seq = seq;
+    entry->docid_limit = docid_limit;
+    entry->bit_vector = std::move(bit_vector);
+}
+
+void
+PostingBitVectorCache::commit()
+{
+    if (_pending.empty() && !_pending_dropped) {
+        return;
+    }
+    std::vector<uint32_t> docids;
+    docids.swap(_pending);
+    std::sort(docids.begin(), docids.end());
+    docids.erase(std::unique(docids.begin(), docids.end()), docids.end());
+    std::lock_guard guard(_lock);
+    uint64_t seq = _seq.load(std::memory_order_relaxed) + 1;
+    if (_pending_dropped) {
+        _changes.clear();
+        _logged_changes = 0;
+        _oldest_patchable_seq = seq;
+        _pending_dropped = false;
+    } else {
+        _logged_changes += docids.size();
+        _changes.emplace_back(seq, std::move(docids));
+        while ((_logged_changes > _max_logged_changes) && !_changes.empty()) {
+            _logged_changes -= _changes.front().docids.size();
+            _oldest_patchable_seq = _changes.front().seq;
+            _changes.pop_front();
+        }
+    }
+    _seq.store(seq, std::memory_order_release);
+}
+
+void
+PostingBitVectorCache::clear()
+{
+    _pending.clear();
+    _pending_dropped = false;
+    std::vector<BitVectorSP> to_destruct;
+    std::lock_guard guard(_lock);
+    to_destruct.reserve(_cache.size());
+    for (auto itr = _cache.begin(); itr != _cache.end(); ) {
+        to_destruct.emplace_back(std::move(itr->bit_vector));
+        itr = _cache.erase(itr);
+    }
+    _changes.clear();
+    _logged_changes = 0;
+    uint64_t seq = _seq.load(std::memory_order_relaxed) + 1;
+    _oldest_patchable_seq = seq;
+    _seq.store(seq, std::memory_order_release);
+}
+
+size_t
+PostingBitVectorCache::size() const
+{
+    std::lock_guard guard(_lock);
+    return _cache.size();
+}
+
+vespalib::MemoryUsage
+PostingBitVectorCache::get_memory_usage() const
+{
+    std::lock_guard guard(_lock);
+    size_t used = sizeof(PostingBitVectorCache) + _cache.size() * (sizeof(std::string) + sizeof(Entry));
+    auto &cache = const_cast<Cache &>(_cache);
+    for (auto itr = cache.begin(); itr != cache.end(); ++itr) {
+        if (itr->bit_vector) {
+            used += itr->bit_vector->getFileBytes();
+        }
+    }
+    for (const auto &changes : _changes) {
+        used += sizeof(Changes) + changes.docids.capacity() * sizeof(uint32_t);
+    }
+    return vespalib::MemoryUsage(used, used, 0, 0);
+}
+
+}
@@ -0,0 +1,116 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace search { class BitVector; }
+namespace vespalib { class MemoryUsage; }
+
+namespace search::attribute {
+
+/**
+ * Cache of synthetic posting lists (as bit vectors) for search terms
+ * spanning multiple posting lists in a fast-search attribute, e.g.
+ * range, prefix and regex terms. Only terms that have been looked up
+ * a few times are admitted, and the least recently used entries are
+ * evicted when the cache is full.
+ *
+ * The attribute reports the documents touched by posting list changes
+ * (record_changed()) and publishes them when committing (commit()).
+ * A cached bit vector built before the latest commit is brought up to
+ * date by re-evaluating the search term for the touched documents
+ * only, as long as the change log still covers it. Otherwise it is
+ * rebuilt from the posting lists.
+ *
+ * Readers must sample the sequence number (get_seq()) before looking
+ * at the dictionary and posting lists used to build a bit vector.
+ * Changes are not logged until the cache has been used, and cached
+ * bit vectors cannot be patched across a commit where changes were
+ * not logged.
+ **/
+class PostingBitVectorCache {
+public:
+    using BitVectorSP = std::shared_ptr<BitVector>;
+    using Matcher = std::function<bool(uint32_t docid)>;
+    static constexpr size_t default_max_entries = 64;
+    static constexpr uint32_t default_min_uses = 4;
+    static constexpr size_t default_max_logged_changes = 64_Ki;
+
+private:
+    struct Entry {
+        uint64_t    seq;
+        uint32_t    docid_limit;
+        uint32_t    uses;
+        BitVectorSP bit_vector;
+        Entry() noexcept : seq(0), docid_limit(0), uses(0), bit_vector() {}
+    };
+    struct Changes {
+        uint64_t              seq;
+        std::vector<uint32_t> docids;
+        Changes(uint64_t seq_in, std::vector<uint32_t> docids_in) noexcept
+            : seq(seq_in), docids(std::move(docids_in)) {}
+    };
+    using Cache = vespalib::lrucache_map<vespalib::LruParam<std::string, Entry>>;
+
+    mutable std::mutex    _lock;
+    Cache                 _cache;
+    std::deque<Changes>   _changes;
+    size_t                _logged_changes;
+    std::vector<uint32_t> _pending;
+    bool                  _pending_dropped;
+    std::atomic<bool>     _in_use;
+    std::atomic<uint64_t> _seq;
+    uint64_t              _oldest_patchable_seq;
+    uint32_t              _min_uses;
+    size_t                _max_logged_changes;
+
+    bool collect_changes(uint64_t from_seq, uint64_t to_seq, std::vector<uint32_t> &docids) const;
+
+public:
+    PostingBitVectorCache();
+    PostingBitVectorCache(size_t max_entries, uint32_t min_uses, size_t max_logged_changes);
+    PostingBitVectorCache(const PostingBitVectorCache &) = delete;
+    PostingBitVectorCache &operator=(const PostingBitVectorCache &) = delete;
+    ~PostingBitVectorCache();
+
+    uint64_t get_seq() const noexcept { return _seq.load(std::memory_order_acquire); }
+
+    /**
+     * Look up the bit vector for the given term, as seen by a reader
+     * that sampled 'seq' and uses the given docid limit. A cached bit
+     * vector from an earlier commit is patched using 'matches'.
+     * Returns an empty pointer on cache miss.
+     **/
+    BitVectorSP lookup(const std::string &key, uint64_t seq, uint32_t docid_limit, const Matcher &matches);
+
+    /**
+     * Insert a bit vector built by a reader that sampled 'seq'. It is
+     * only retained if the term has been looked up often enough.
+     **/
+    void insert(const std::string &key, uint64_t seq, uint32_t docid_limit, BitVectorSP bit_vector);
+
+    // Used by the attribute writer thread.
+    void record_changed(uint32_t docid) {
+        if (_in_use.load(std::memory_order_relaxed)) {
+            _pending.push_back(docid);
+        } else {
+            _pending_dropped = true;
+        }
+    }
+    void commit();
+    void clear();
+
+    size_t size() const;
+    vespalib::MemoryUsage get_memory_usage() const;
+};
+
+}
@@ -34,6 +34,8 @@ public:
 
     void reserveArray(uint32_t postingsCount, size_t postingsSize);
     void allocBitVector();
+    // Adopt an already merged (e.g. cached) bitvector, it must not be modified
+    void setBitVector(std::shared_ptr<BitVector> bitVector) noexcept { _bitVector = std::move(bitVector); }
     void merge();
     bool hasArray() const noexcept { return _arrayValid; }
     bool hasBitVector() const noexcept { return static_cast<bool>(_bitVector); }
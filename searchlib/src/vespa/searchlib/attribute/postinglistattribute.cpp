@@ -4,6 +4,7 @@
 #include "loadednumericvalue.h"
 #include "enumcomparator.h"
 #include "enum_store_loaders.h"
+#include "posting_bitvector_cache.h"
 #include <vespa/vespalib/util/array.hpp>
 
 namespace search {
@@ -18,7 +19,8 @@ PostingListAttributeBase(AttributeVector &attr,
       _posting_store(enumStore.get_dictionary(), attr.getStatus(),
                      attr.getConfig()),
       _attr(attr),
-      _dictionary(enumStore.get_dictionary())
+      _dictionary(enumStore.get_dictionary()),
+      _bitvector_cache(std::make_unique<attribute::PostingBitVectorCache>())
 { }
 
 template <typename P>
@@ -28,6 +30,7 @@ template <typename P>
 void
 PostingListAttributeBase<P>::clearAllPostings()
 {
+    _bitvector_cache->clear();
     _posting_store.clearBuilder();
     _attr.incGeneration(); // Force freeze
     auto clearer = [this](EntryRef posting_idx)
@@ -110,6 +113,12 @@ PostingListAttributeBase<P>::updatePostings(PostingMap &changePost,
         EnumIndex idx = elem.first.getEnumIdx();
         auto& change = elem.second;
         change.removeDups();
+        for (const auto& addition : change._additions) {
+            _bitvector_cache->record_changed(addition._key);
+        }
+        for (uint32_t docid : change._removals) {
+            _bitvector_cache->record_changed(docid);
+        }
         auto updater= [this, &change](EntryRef posting_idx) -> EntryRef
                       {
                           _posting_store.apply(posting_idx,
@@ -150,6 +159,7 @@ clearPostings(attribute::IAttributeVector::EnumHandle eidx,
 
     for (uint32_t lid = fromLid; lid < toLid; ++lid) {
         postings.remove(lid);
+        _bitvector_cache->record_changed(lid);
     }
 
     EntryRef er(eidx);
@@ -170,6 +180,14 @@ void
 PostingListAttributeBase<P>::forwardedShrinkLidSpace(uint32_t newSize)
 {
     (void) _posting_store.resizeBitVectors(newSize, newSize);
+    _bitvector_cache->clear();
+}
+
+template <typename P>
+void
+PostingListAttributeBase<P>::forwardedCommit()
+{
+    _bitvector_cache->commit();
 }
 
 template <typename P>
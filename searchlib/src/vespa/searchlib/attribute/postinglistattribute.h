@@ -14,6 +14,9 @@
 #include <vespa/vespalib/datastore/entry_comparator.h>
 #include <vespa/vespalib/datastore/entryref.h>
 #include <map>
+#include <memory>
+
+namespace search::attribute { class PostingBitVectorCache; }
 
 namespace search {
 
@@ -49,6 +52,7 @@ protected:
     PostingStore _posting_store;
     AttributeVector &_attr;
     IEnumStoreDictionary& _dictionary;
+    std::unique_ptr<attribute::PostingBitVectorCache> _bitvector_cache;
 
     PostingListAttributeBase(AttributeVector &attr, IEnumStore &enumStore);
     ~PostingListAttributeBase() override;
@@ -66,6 +70,7 @@ protected:
                        uint32_t toLid, const vespalib::datastore::EntryComparator &cmp);
 
     void forwardedShrinkLidSpace(uint32_t newSize) override;
+    void forwardedCommit() override;
     attribute::PostingStoreMemoryUsage getMemoryUsage() const override;
     bool consider_compact_worst_btree_nodes(const CompactionStrategy& compaction_strategy) override;
     bool consider_compact_worst_buffers(const CompactionStrategy& compaction_strategy) override;
@@ -73,6 +78,8 @@ protected:
 public:
     const PostingStore & get_posting_store() const { return _posting_store; }
     PostingStore & get_posting_store()             { return _posting_store; }
+    // The cache is shared by concurrent searches and updated by the writer thread
+    attribute::PostingBitVectorCache & get_bitvector_cache() const { return *_bitvector_cache; }
 };
 
 template <typename P, typename LoadedVector, typename LoadedValueType,
@@ -13,10 +13,13 @@ bool PostingListSearchContext::_preserve_weight = true;
 
 PostingListSearchContext::
 PostingListSearchContext(const IEnumStoreDictionary& dictionary, bool has_btree_dictionary, uint32_t docIdLimit,
-                         uint64_t numValues, bool useBitVector, const ISearchContext &baseSearchCtx)
+                         uint64_t numValues, bool useBitVector, PostingBitVectorCache* bitvector_cache,
+                         const ISearchContext &baseSearchCtx)
     : _dictionary(dictionary),
       _baseSearchCtx(baseSearchCtx),
       _bv(nullptr),
+      _bitvector_cache(bitvector_cache),
+      _bitvector_cache_seq(bitvector_cache != nullptr ? bitvector_cache->get_seq() : 0),
       _frozenDictionary(has_btree_dictionary ? _dictionary.get_posting_dictionary().getFrozenView() : FrozenDictionary()),
       _lowerDictItr(has_btree_dictionary ? DictionaryConstIterator(BTreeNode::Ref(), _frozenDictionary.getAllocator()) : DictionaryConstIterator()),
       _upperDictItr(has_btree_dictionary ? DictionaryConstIterator(BTreeNode::Ref(), _frozenDictionary.getAllocator()) : DictionaryConstIterator()),
@@ -82,6 +85,32 @@ PostingListSearchContext::estimated_hits_in_range() const
     return result;
 }
 
+std::string
+PostingListSearchContext::bitvector_cache_key() const
+{
+    const auto &term = *_baseSearchCtx.queryTerm();
+    std::string key;
+    if (term.isPrefix()) {
+        key = "prefix:";
+    } else if (term.isSubstring()) {
+        key = "substring:";
+    } else if (term.isSuffix()) {
+        key = "suffix:";
+    } else if (term.isExactstring()) {
+        key = "exact:";
+    } else if (term.isRegex()) {
+        key = "regex:";
+    } else if (term.isFuzzy()) {
+        key = "fuzzy(" + std::to_string(term.fuzzy_max_edit_distance()) + "," +
+              std::to_string(term.fuzzy_prefix_lock_length()) + "," +
+              (term.fuzzy_prefix_match() ? "prefix" : "full") + "):";
+    } else {
+        key = "term:";
+    }
+    key += term.getTermString();
+    return key;
+}
+
 template class PostingListSearchContextT<vespalib::btree::BTreeNoLeafData>;
 template class PostingListSearchContextT<int32_t>;
 template class PostingListFoldedSearchContextT<vespalib::btree::BTreeNoLeafData>;
@@ -19,6 +19,7 @@
 namespace search::attribute {
 
 class ISearchContext;
+class PostingBitVectorCache;
 
 /**
  * Search context helper for posting list attributes, used to instantiate
@@ -39,6 +40,8 @@ protected:
     const IEnumStoreDictionary&   _dictionary;
     const ISearchContext&         _baseSearchCtx;
     const BitVector*              _bv; // bitvector if _useBitVector has been set
+    PostingBitVectorCache*        _bitvector_cache; // cache of merged posting lists, if enabled
+    const uint64_t                _bitvector_cache_seq; // sampled before _frozenDictionary
     const FrozenDictionary        _frozenDictionary;
     DictionaryConstIterator       _lowerDictItr;
     DictionaryConstIterator       _upperDictItr;
@@ -53,7 +56,8 @@ protected:
     static bool                   _preserve_weight; // Use temporary posting list with weight information
 
     PostingListSearchContext(const IEnumStoreDictionary& dictionary, bool has_btree_dictionary, uint32_t docIdLimit,
-                             uint64_t numValues, bool useBitVector, const ISearchContext &baseSearchCtx);
+                             uint64_t numValues, bool useBitVector, PostingBitVectorCache* bitvector_cache,
+                             const ISearchContext &baseSearchCtx);
 
     ~PostingListSearchContext() override;
 
@@ -68,6 +72,7 @@ protected:
     void lookupRange(const vespalib::datastore::EntryComparator &low, const vespalib::datastore::EntryComparator &high);
     void lookupSingle();
     size_t estimated_hits_in_range() const;
+    std::string bitvector_cache_key() const;
     virtual bool use_dictionary_entry(DictionaryConstIterator& it) const {
         (void) it;
         return true;
@@ -109,13 +114,14 @@ protected:
     static constexpr bool merged_array_has_weight = !std::is_same_v<DataT, vespalib::btree::BTreeNoLeafData>;
 
     PostingListSearchContextT(const IEnumStoreDictionary& dictionary, uint32_t docIdLimit, uint64_t numValues,
-                              const PostingStore& posting_store,
-                              bool useBitVector, const ISearchContext &baseSearchCtx);
+                              const PostingStore& posting_store, bool useBitVector,
+                              PostingBitVectorCache* bitvector_cache, const ISearchContext &baseSearchCtx);
     ~PostingListSearchContextT() override;
 
     void lookupSingle();
     virtual void fillArray();
     virtual void fillBitVector(const ExecuteInfo &);
+    void fillBitVectorCached(const ExecuteInfo &);
 
     void fetchPostings(const ExecuteInfo &exec, bool strict) override;
     // this will be called instead of the fetchPostings function in some cases
@@ -158,8 +164,8 @@ protected:
     mutable std::vector<EntryRef>   _posting_indexes;
 
     PostingListFoldedSearchContextT(const IEnumStoreDictionary& dictionary, uint32_t docIdLimit, uint64_t numValues,
-                                    const PostingStore& posting_store,
-                                    bool useBitVector, const ISearchContext &baseSearchCtx);
+                                    const PostingStore& posting_store, bool useBitVector,
+                                    PostingBitVectorCache* bitvector_cache, const ISearchContext &baseSearchCtx);
     ~PostingListFoldedSearchContextT() override;
 
     size_t calc_estimated_hits_in_range() const override;
@@ -182,7 +188,7 @@ protected:
     const AttrT           &_toBeSearched;
     const EnumStore       &_enumStore;
 
-    PostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toBeSearched);
+    PostingSearchContext(BaseSC&& base_sc, const SearchContextParams& params, const AttrT &toBeSearched);
     ~PostingSearchContext();
 };
 
@@ -203,7 +209,7 @@ private:
     }
     bool use_posting_lists_when_non_strict(const ExecuteInfo& info) const override;
 public:
-    StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toBeSearched);
+    StringPostingSearchContext(BaseSC&& base_sc, const SearchContextParams& params, const AttrT &toBeSearched);
 };
 
 template <typename BaseSC, typename AttrT, typename DataT>
@@ -254,13 +260,14 @@ public:
 
 template <typename BaseSC, typename BaseSC2, typename AttrT>
 PostingSearchContext<BaseSC, BaseSC2, AttrT>::
-PostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toBeSearched)
+PostingSearchContext(BaseSC&& base_sc, const SearchContextParams& params, const AttrT &toBeSearched)
     : BaseSC(std::move(base_sc)),
       BaseSC2(toBeSearched.getEnumStore().get_dictionary(),
               toBeSearched.getCommittedDocIdLimit(),
               toBeSearched.getStatus().getNumValues(),
               toBeSearched.get_posting_store(),
-              useBitVector,
+              params.useBitVector(),
+              params.use_bitvector_cache() ? &toBeSearched.get_bitvector_cache() : nullptr,
               *this),
       _toBeSearched(toBeSearched),
       _enumStore(_toBeSearched.getEnumStore())
@@ -274,9 +281,13 @@ PostingSearchContext<BaseSC, BaseSC2, AttrT>::~PostingSearchContext() = default;
 template <typename BaseSC, typename AttrT, typename DataT>
 NumericPostingSearchContext<BaseSC, AttrT, DataT>::
 NumericPostingSearchContext(BaseSC&& base_sc, const Params & params_in, const AttrT &toBeSearched)
-    : Parent(std::move(base_sc), params_in.useBitVector(), toBeSearched),
+    : Parent(std::move(base_sc), params_in, toBeSearched),
       _params(params_in)
 {
+    if (this->getRangeLimit() != 0) {
+        // Range limited results are not given by the term alone
+        this->_bitvector_cache = nullptr;
+    }
     if (valid()) {
         if (_low == _high) {
             auto comp = _enumStore.make_comparator(_low);
@@ -4,6 +4,7 @@
 
 #include "postinglistsearchcontext.h"
 #include "array_iterator.h"
+#include "posting_bitvector_cache.h"
 #include "attributeiterators.h"
 #include "diversity.h"
 #include "postingstore.hpp"
@@ -21,8 +22,10 @@ namespace search::attribute {
 template <typename DataT>
 PostingListSearchContextT<DataT>::
 PostingListSearchContextT(const IEnumStoreDictionary& dictionary, uint32_t docIdLimit, uint64_t numValues,
-                          const PostingStore& posting_store, bool useBitVector, const ISearchContext &searchContext)
-    : PostingListSearchContext(dictionary, dictionary.get_has_btree_dictionary(), docIdLimit, numValues, useBitVector, searchContext),
+                          const PostingStore& posting_store, bool useBitVector,
+                          PostingBitVectorCache* bitvector_cache, const ISearchContext &searchContext)
+    : PostingListSearchContext(dictionary, dictionary.get_has_btree_dictionary(), docIdLimit, numValues, useBitVector,
+                               bitvector_cache, searchContext),
       _posting_store(posting_store),
       _merger(docIdLimit)
 {
@@ -135,6 +138,29 @@ PostingListSearchContextT<DataT>::fillBitVector(const ExecuteInfo & exec_info)
     BitVector::parallellOr(thread_bundle, vectors);
 }
 
+template <typename DataT>
+void
+PostingListSearchContextT<DataT>::fillBitVectorCached(const ExecuteInfo & exec_info)
+{
+    if (_bitvector_cache == nullptr) {
+        _merger.allocBitVector();
+        fillBitVector(exec_info);
+        _merger.merge();
+        return;
+    }
+    std::string key = bitvector_cache_key();
+    auto matches = [this](uint32_t docid) { return _baseSearchCtx.matches(docid); };
+    auto cached = _bitvector_cache->lookup(key, _bitvector_cache_seq, _docIdLimit, matches);
+    if (cached) {
+        _merger.setBitVector(std::move(cached));
+        return;
+    }
+    _merger.allocBitVector();
+    fillBitVector(exec_info);
+    _merger.merge();
+    _bitvector_cache->insert(key, _bitvector_cache_seq, _docIdLimit, _merger.getBitVectorSP());
+}
+
 template <typename DataT>
 void
 PostingListSearchContextT<DataT>::fetchPostings(const ExecuteInfo & exec_info, bool strict)
@@ -175,11 +201,10 @@ PostingListSearchContextT<DataT>::fetchPostings(const ExecuteInfo & exec_info, b
             if (sum < (_docIdLimit * threshold_for_using_array) || force_array) {
                 _merger.reserveArray(_uniqueValues, sum);
                 fillArray();
+                _merger.merge();
             } else {
-                _merger.allocBitVector();
-                fillBitVector(exec_info);
+                fillBitVectorCached(exec_info);
             }
-            _merger.merge();
         }
     }
 }
@@ -348,9 +373,9 @@ PostingListSearchContextT<DataT>::applyRangeLimit(long rangeLimit)
 template <typename DataT>
 PostingListFoldedSearchContextT<DataT>::
 PostingListFoldedSearchContextT(const IEnumStoreDictionary& dictionary, uint32_t docIdLimit, uint64_t numValues,
-                                const PostingStore& posting_store,
-                                bool useBitVector, const ISearchContext &searchContext)
-    : Parent(dictionary, docIdLimit, numValues, posting_store, useBitVector, searchContext),
+                                const PostingStore& posting_store, bool useBitVector,
+                                PostingBitVectorCache* bitvector_cache, const ISearchContext &searchContext)
+    : Parent(dictionary, docIdLimit, numValues, posting_store, useBitVector, bitvector_cache, searchContext),
       _resume_scan_itr(),
       _posting_indexes()
 {
@@ -437,8 +462,8 @@ PostingListFoldedSearchContextT<DataT>::fillBitVector(const ExecuteInfo & exec_i
 
 template <typename BaseSC, typename AttrT, typename DataT>
 StringPostingSearchContext<BaseSC, AttrT, DataT>::
-StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toBeSearched)
-    : Parent(std::move(base_sc), useBitVector, toBeSearched)
+StringPostingSearchContext(BaseSC&& base_sc, const SearchContextParams& params, const AttrT &toBeSearched)
+    : Parent(std::move(base_sc), params, toBeSearched)
 {
     if (this->valid()) {
         if (this->isPrefix()) {
@@ -6,7 +6,8 @@ namespace search::attribute {
 
 template <typename MultiValueType>
 RawMultiValueReadView<MultiValueType>::RawMultiValueReadView(MultiValueMappingReadView<MultiValueType> mv_mapping_read_view)
-    : _mv_mapping_read_view(mv_mapping_read_view)
+    : _mv_mapping_read_view(mv_mapping_read_view),
+      _buffer()
 {
 }
 
@@ -17,7 +18,7 @@ template <typename MultiValueType>
 std::span<const MultiValueType>
 RawMultiValueReadView<MultiValueType>::get_values(uint32_t docid) const
 {
-    return _mv_mapping_read_view.get(docid);
+    return _mv_mapping_read_view.get(docid, _buffer);
 }
 
 template class RawMultiValueReadView<int8_t>;
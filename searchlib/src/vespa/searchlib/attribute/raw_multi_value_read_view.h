@@ -9,12 +9,14 @@ namespace search::attribute {
 
 /**
  * Read view for the raw data stored in a multi-value attribute.
+ * The read view is created per thread, compressed values are decoded into a buffer owned by it.
  * @tparam MultiValueType The multi-value type of the raw data to access.
  */
 template <typename MultiValueType>
 class RawMultiValueReadView : public IMultiValueReadView<MultiValueType>
 {
     MultiValueMappingReadView<MultiValueType> _mv_mapping_read_view;
+    mutable std::vector<MultiValueType>       _buffer;
 public:
     RawMultiValueReadView(MultiValueMappingReadView<MultiValueType> mv_mapping_read_view);
     ~RawMultiValueReadView() override;
@@ -73,6 +73,10 @@ public:
         return vespalib::atomic::load_ref_relaxed(_data.acquire_elem_ref(doc));
     }
 
+    void prefetch(DocId doc) const noexcept {
+        __builtin_prefetch(&_data.acquire_elem_ref(doc));
+    }
+
     //-------------------------------------------------------------------------
     // new read api
     //-------------------------------------------------------------------------
@@ -73,6 +73,8 @@ private:
     void applyValueChanges(EnumStoreBatchUpdater& updater) override;
 
 public:
+    using PostingParent::get_bitvector_cache;
+
     SingleValueNumericPostingAttribute(const std::string & name, const AttributeVector::Config & cfg);
     ~SingleValueNumericPostingAttribute();
 
@@ -7,6 +7,7 @@
 #include "enumstore.h"
 #include "numeric_direct_posting_store_adapter.hpp"
 #include "singlenumericenumattribute.hpp"
+#include "posting_bitvector_cache.h"
 
 namespace search {
 
@@ -40,6 +41,7 @@ SingleValueNumericPostingAttribute<B>::mergeMemoryStats(vespalib::MemoryUsage &
 {
     auto& compaction_strategy = this->getConfig().getCompactionStrategy();
     total.merge(this->_posting_store.update_stat(compaction_strategy));
+    total.merge(this->get_bitvector_cache().get_memory_usage());
 }
 
 template <typename B>
@@ -55,6 +55,7 @@ public:
     using PostingStore = typename PostingParent::PostingStore;
     using Dictionary = EnumPostingTree;
     using PostingParent::get_posting_store;
+    using PostingParent::get_bitvector_cache;
 
 private:
     using DirectPostingStoreAdapterType = attribute::StringDirectPostingStoreAdapter<IDocidPostingStore,
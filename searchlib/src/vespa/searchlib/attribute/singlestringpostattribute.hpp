@@ -5,6 +5,7 @@
 #include "singlestringpostattribute.h"
 #include "single_string_enum_search_context.h"
 #include "string_direct_posting_store_adapter.hpp"
+#include "posting_bitvector_cache.h"
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/query/query_term_ucs4.h>
 
@@ -46,6 +47,7 @@ SingleValueStringPostingAttributeT<B>::mergeMemoryStats(vespalib::MemoryUsage &
 {
     auto& compaction_strategy = this->getConfig().getCompactionStrategy();
     total.merge(this->_posting_store.update_stat(compaction_strategy));
+    total.merge(this->get_bitvector_cache().get_memory_usage());
 }
 
 template <typename B>
@@ -149,9 +151,7 @@ SingleValueStringPostingAttributeT<B>::getSearch(QueryTermSimpleUP qTerm,
     bool cased = this->get_match_is_cased();
     auto docid_limit = this->getCommittedDocIdLimit();
     BaseSC base_sc(std::move(qTerm), cased, params.fuzzy_matching_algorithm(), *this, this->_enumIndices.make_read_view(docid_limit), this->_enumStore);
-    return std::make_unique<SC>(std::move(base_sc),
-                                params.useBitVector(),
-                                *this);
+    return std::make_unique<SC>(std::move(base_sc), params, *this);
 }
 
 }
@@ -1503,6 +1503,9 @@ lookup(const SSReader &ssReader,
          */
         _startOffset = l3StartOffset;
         _wordNum = l3WordNum;
+        if (_nextWord != nullptr) {
+            *_nextWord = lastPWord;
+        }
         return false;
     }
 
@@ -1637,6 +1640,11 @@ lookup(const SSReader &ssReader,
     }
     _startOffset = countsStartOffset;
     _wordNum = wordNum;
+    if (_nextWord != nullptr) {
+        // Counts and offsets are for the first word not less than key
+        *_nextWord = word;
+        _counts = counts;
+    }
     // Lookup succeded if word found.
     if (key == word) {
         _counts = counts;
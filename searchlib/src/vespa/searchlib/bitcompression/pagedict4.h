@@ -546,7 +546,7 @@ public:
     StartOffset _startOffset;
     uint64_t _wordNum;
     bool _res;
-    std::string *_nextWord;
+    std::string *_nextWord; // If set, receives first word not less than key
 
 public:
     PageDict4PLookupRes();
@@ -90,6 +90,22 @@ BitVector::parallellOr(vespalib::ThreadBundle & thread_bundle, std::span<BitVect
     }
 }
 
+void
+BitVector::copy_part(const BitVector & part)
+{
+    Index start = part.getStartIndex();
+    Index end = part.size();
+    assert((start >= getStartIndex()) && (end <= size()));
+    assert((bitNum(start) == 0) || (wordNum(start) == getStartWordNum()));
+    assert((bitNum(end) == 0) || (end == size()));
+    if (start < end) {
+        // The last part also brings along the guard bit, which is at the same position in both vectors.
+        size_t words = (end == size()) ? numActiveWords(start, end) : (wordNum(end) - wordNum(start));
+        memcpy(getWordIndex(start), part.getWordIndex(start), words * sizeof(Word));
+    }
+    _numTrueBits.fetch_add(part.countTrueBits(), std::memory_order_relaxed);
+}
+
 Alloc
 BitVector::allocatePaddedAndAligned(Index start, Index end, Index capacity, const Alloc* init_alloc)
 {
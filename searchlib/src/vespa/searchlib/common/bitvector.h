@@ -290,6 +290,14 @@ public:
      * TODO: Extend to handle both AND/OR
      */
     static void parallellOr(vespalib::ThreadBundle & thread_bundle, std::span<BitVector* const> vectors);
+    /**
+     * Copy the bits of 'part' into this vector, writing only the words covered by 'part'.
+     * Disjoint parts may be copied concurrently from different threads as long as each
+     * part starts and ends at a word boundary, except where it starts or ends together
+     * with this vector. The range covered by 'part' must be clear in this vector, and
+     * the cached count is updated by adding the count of 'part'.
+     */
+    void copy_part(const BitVector & part);
     static Index numWords(Index bits) noexcept { return wordNum(bits + 1 + (WordLen - 1)); }
     static Index numBytes(Index bits) noexcept { return numWords(bits) * sizeof(Word); }
     virtual size_t get_allocated_bytes(bool include_self) const noexcept = 0;
@@ -5,6 +5,7 @@
 #include "fileheader.h"
 #include "pagedict4randread.h"
 #include <vespa/searchlib/index/schemautil.h>
+#include <vespa/searchlib/index/term_expander.h>
 #include <vespa/searchlib/queryeval/create_blueprint_params.h>
 #include <vespa/searchlib/queryeval/create_blueprint_visitor_helper.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
@@ -188,6 +189,29 @@ public:
         }
     }
 
+    void visit_expanded_term(TermExpander expander) {
+        uint32_t max_expansions = getRequestContext().get_create_blueprint_params().max_term_expansions;
+        std::vector<std::pair<std::string, DictionaryLookupResult>> words;
+        std::string word;
+        auto lookup_result = _field_index.lookup_lower_bound(expander.first_word(), word);
+        while (lookup_result.valid() && words.size() < max_expansions) {
+            auto step = expander.check(word);
+            if (step == TermExpander::Step::DONE) {
+                break;
+            }
+            if (step == TermExpander::Step::MATCH) {
+                words.emplace_back(word, lookup_result);
+            }
+            // Words never contain a null byte, making word + '\0' the least key greater than word
+            std::string seek_word = (step == TermExpander::Step::SEEK) ? expander.seek_word() : (word + '\0');
+            lookup_result = _field_index.lookup_lower_bound(seek_word, word);
+        }
+        auto field = resolve_field_spec();
+        setResult(make_expanded_term_blueprint(field, words.size(), [this, &words](const FieldSpec& word_field, size_t idx) {
+            return std::make_unique<DiskTermBlueprint>(word_field, _field_index, words[idx].first, words[idx].second);
+        }));
+    }
+
     void visit(NumberTerm &n) override {
         handleNumberTermAsText(n);
     }
@@ -195,7 +219,9 @@ public:
     void not_supported(Node &) {}
 
     void visit(LocationTerm &n)  override { visitTerm(n); }
-    void visit(PrefixTerm &n)    override { visitTerm(n); }
+    void visit(PrefixTerm &n)    override {
+        visit_expanded_term(TermExpander::make_prefix(termAsString(n)));
+    }
     void visit(RangeTerm &n)     override { visitTerm(n); }
     void visit(StringTerm &n)    override { visitTerm(n); }
     void visit(SubstringTerm &n) override { visitTerm(n); }
@@ -203,7 +229,10 @@ public:
     void visit(RegExpTerm &n)    override { visitTerm(n); }
     void visit(PredicateQuery &n) override { not_supported(n); }
     void visit(NearestNeighborTerm &n) override { not_supported(n); }
-    void visit(FuzzyTerm &n)    override { visitTerm(n); }
+    void visit(FuzzyTerm &n)    override {
+        visit_expanded_term(TermExpander::make_fuzzy(termAsString(n), n.max_edit_distance(),
+                                                     n.prefix_lock_length(), n.prefix_match()));
+    }
 };
 
 Blueprint::UP
@@ -178,6 +178,18 @@ FieldIndex::lookup(std::string_view word) const
     return lookup_result;
 }
 
+DictionaryLookupResult
+FieldIndex::lookup_lower_bound(std::string_view word, std::string& found_word) const
+{
+    DictionaryLookupResult lookup_result;
+    PostingListOffsetAndCounts offsetAndCounts;
+    if (_dict->lookup_lower_bound(word, found_word, lookup_result.wordNum, offsetAndCounts)) {
+        lookup_result.counts.swap(offsetAndCounts._counts);
+        lookup_result.bitOffset = offsetAndCounts._offset;
+    }
+    return lookup_result;
+}
+
 PostingListHandle
 FieldIndex::read_uncached_posting_list(const DictionaryLookupResult& lookup_result, bool trim) const
 {
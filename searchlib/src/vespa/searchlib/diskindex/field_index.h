@@ -74,6 +74,8 @@ public:
     bool open(const std::string& field_dir, const TuneFileSearch &tune_file_search);
     void reuse_files(const FieldIndex& rhs);
     index::DictionaryLookupResult lookup(std::string_view word) const;
+    // Lookup the first word not less than the given word, result is invalid if there is no such word
+    index::DictionaryLookupResult lookup_lower_bound(std::string_view word, std::string& found_word) const;
     index::PostingListHandle read_uncached_posting_list(const search::index::DictionaryLookupResult &lookup_result,
                                                         bool trim) const;
     index::PostingListHandle read(const IPostingListCache::Key& key, IPostingListCache::Context& ctx) const override;
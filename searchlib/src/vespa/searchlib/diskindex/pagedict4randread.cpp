@@ -197,6 +197,56 @@ PageDict4RandRead::lookup(std::string_view word,
     }
 }
 
+bool
+PageDict4RandRead::lookup_lower_bound(std::string_view word,
+                                      std::string &found_word,
+                                      uint64_t &wordNum,
+                                      PostingListOffsetAndCounts &offsetAndCounts)
+{
+    SSLookupRes ssRes(_ssReader->lookup(word));
+    if (!ssRes._res) {
+        return false; // All words are less than word
+    }
+    if (ssRes._overflow) {
+        found_word = word;
+        offsetAndCounts._offset = ssRes._startOffset._fileOffset;
+        offsetAndCounts._accNumDocs = ssRes._startOffset._accNumDocs;
+        wordNum = ssRes._l6WordNum;
+        offsetAndCounts._counts = ssRes._counts;
+        return true;
+    }
+    SPLookupRes spRes;
+    size_t pageSize = PageDict4PageParams::getPageByteSize();
+    const char *spData = static_cast<const char *>(_spfile->MemoryMapPtr(0));
+    spRes.lookup(*_ssReader,
+                 spData + pageSize * ssRes._sparsePageNum,
+                 word,
+                 ssRes._l6Word,
+                 ssRes._lastWord,
+                 ssRes._l6StartOffset,
+                 ssRes._l6WordNum,
+                 ssRes._pageNum);
+
+    PLookupRes pRes;
+    pRes._nextWord = &found_word;
+    const char *pData = static_cast<const char *>(_pfile->MemoryMapPtr(0));
+    pRes.lookup(*_ssReader,
+                pData + pageSize * spRes._pageNum,
+                word,
+                spRes._l3Word,
+                spRes._lastWord,
+                spRes._l3StartOffset,
+                spRes._l3WordNum);
+    if (pRes._counts._numDocs == 0) {
+        // Next word is an overflow word, not present in the page
+        return !found_word.empty() && lookup(found_word, wordNum, offsetAndCounts);
+    }
+    offsetAndCounts._offset = pRes._startOffset._fileOffset;
+    offsetAndCounts._accNumDocs = pRes._startOffset._accNumDocs;
+    offsetAndCounts._counts = pRes._counts;
+    wordNum = pRes._wordNum;
+    return true;
+}
 
 bool
 PageDict4RandRead::open(const std::string &name,
@@ -47,6 +47,8 @@ public:
 
     bool lookup(std::string_view word, uint64_t &wordNum,
                 PostingListOffsetAndCounts &offsetAndCounts) override;
+    bool lookup_lower_bound(std::string_view word, std::string &found_word, uint64_t &wordNum,
+                            PostingListOffsetAndCounts &offsetAndCounts) override;
 
     bool open(const std::string &name, const TuneFileRandRead &tuneFileRead) override;
 
@@ -111,7 +111,9 @@ void
 BucketCompacter::write(LockGuard guard, uint32_t chunkId, uint32_t lid, ConstBufferRef data)
 {
     guard.unlock();
-    BucketId bucketId = (data.size() > 0) ? _bucketizer.getBucketOf(_bucketizer.getGuard(), lid) : BucketId();
+    BucketId bucketId = (data.size() > 0)
+                        ? _bucketizer.getBucketOf(_bucketizer.getGuard(), DeltaRecord::lid_of(lid))
+                        : BucketId();
     _tmpStore[_bucketIndexStore.toPartitionId(bucketId)]->add(bucketId, chunkId, lid, data);
 }
 
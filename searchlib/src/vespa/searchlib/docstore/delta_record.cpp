@@ -0,0 +1,51 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "delta_record.h"
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/objects/nbostream.h>
+
+namespace search::docstore {
+
+void
+DeltaRecord::append_update(vespalib::DataBuffer & record, ConstBufferRef update)
+{
+    record.writeInt32(update.size());
+    record.writeBytes(update.data(), update.size());
+}
+
+void
+DeltaRecord::write_merged(vespalib::DataBuffer & merged, ConstBufferRef document, ConstBufferRef delta)
+{
+    merged.writeInt16(MERGED_MARKER);
+    merged.writeInt32(document.size());
+    merged.writeBytes(document.data(), document.size());
+    merged.writeBytes(delta.data(), delta.size());
+}
+
+bool
+DeltaRecord::is_merged(ConstBufferRef blob) noexcept
+{
+    return (blob.size() >= sizeof(uint16_t)) &&
+           (static_cast<uint8_t>(blob.c_str()[0]) == (MERGED_MARKER >> 8)) &&
+           (static_cast<uint8_t>(blob.c_str()[1]) == (MERGED_MARKER & 0xff));
+}
+
+vespalib::ConstBufferRef
+DeltaRecord::split_merged(ConstBufferRef merged, std::vector<ConstBufferRef> & updates)
+{
+    vespalib::nbostream is(merged.c_str(), merged.size());
+    uint16_t marker(0);
+    uint32_t document_size(0);
+    is >> marker >> document_size;
+    ConstBufferRef document(is.peek(), document_size);
+    is.adjustReadPos(document_size);
+    while (is.size() > 0) {
+        uint32_t update_size(0);
+        is >> update_size;
+        updates.emplace_back(is.peek(), update_size);
+        is.adjustReadPos(update_size);
+    }
+    return document;
+}
+
+}
@@ -0,0 +1,53 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/buffer.h>
+#include <cstdint>
+#include <vector>
+
+namespace vespalib { class DataBuffer; }
+
+namespace search::docstore {
+
+/**
+ * Partial updates of a stored document can be appended as a delta record instead of
+ * rewriting the full document. The delta record for a lid is stored in the file chunks
+ * under a separate key (the lid with the top bit set) and holds all updates since the full
+ * document was last written, each as [size][serialized update]. A new update rewrites the
+ * delta record with the update appended, so only the last delta record of a lid is live.
+ *
+ * Reading a lid with a delta record gives a merged blob with both the full document and the
+ * delta record. It starts with a marker that is never the start of a serialized document,
+ * and the updates are applied by the document store when deserializing it.
+ */
+class DeltaRecord {
+public:
+    using ConstBufferRef = vespalib::ConstBufferRef;
+    static constexpr uint32_t DELTA_KEY_BIT = 0x80000000u;
+    static constexpr uint16_t MERGED_MARKER = 0xffff;
+
+    static bool is_delta_key(uint32_t key) noexcept { return (key & DELTA_KEY_BIT) != 0u; }
+    static uint32_t delta_key(uint32_t lid) noexcept { return lid | DELTA_KEY_BIT; }
+    static uint32_t lid_of(uint32_t key) noexcept { return key & ~DELTA_KEY_BIT; }
+
+    /**
+     * Appends a serialized update to a delta record.
+     */
+    static void append_update(vespalib::DataBuffer & record, ConstBufferRef update);
+
+    /**
+     * Writes the merged blob of a full document and its delta record.
+     */
+    static void write_merged(vespalib::DataBuffer & merged, ConstBufferRef document, ConstBufferRef delta);
+
+    static bool is_merged(ConstBufferRef blob) noexcept;
+
+    /**
+     * Splits a merged blob into the full document (returned) and the serialized updates,
+     * in the order they were appended.
+     */
+    static ConstBufferRef split_merged(ConstBufferRef merged, std::vector<ConstBufferRef> & updates);
+};
+
+}
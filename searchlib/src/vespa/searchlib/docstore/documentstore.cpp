@@ -4,8 +4,11 @@
 #include "visitcache.h"
 #include "ibucketizer.h"
 #include "value.h"
+#include "delta_record.h"
 #include <vespa/document/fieldvalue/document.h>
-#include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/document/update/documentupdate.h>
+#include <vespa/vespalib/stllike/cache_budget_manager.h>
+#include <vespa/vespalib/stllike/sharded_cache.hpp>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
 #include <vespa/vespalib/util/size_literals.h>
@@ -15,6 +18,7 @@
 LOG_SETUP(".searchlib.docstore.documentstore");
 
 using document::DocumentTypeRepo;
+using search::docstore::DeltaRecord;
 using vespalib::CacheStats;
 using vespalib::compression::CompressionConfig;
 
@@ -22,6 +26,33 @@ namespace search {
 
 namespace {
 
+/*
+ * Deserializes the full document of a merged blob and applies the updates from its delta record.
+ */
+std::unique_ptr<document::Document>
+makeMergedDocument(const DocumentTypeRepo & repo, vespalib::ConstBufferRef merged)
+{
+    std::vector<vespalib::ConstBufferRef> updates;
+    vespalib::ConstBufferRef base = DeltaRecord::split_merged(merged, updates);
+    vespalib::nbostream is(base.c_str(), base.size());
+    auto doc = std::make_unique<document::Document>(repo, is);
+    for (const auto & update : updates) {
+        vespalib::nbostream us(update.c_str(), update.size());
+        document::DocumentUpdate::createHEAD(repo, us)->applyTo(*doc);
+    }
+    return doc;
+}
+
+std::unique_ptr<document::Document>
+makeDocument(const DocumentTypeRepo & repo, vespalib::DataBuffer && buf)
+{
+    vespalib::ConstBufferRef blob(buf.getData(), buf.getDataLen());
+    if (DeltaRecord::is_merged(blob)) {
+        return makeMergedDocument(repo, blob);
+    }
+    return std::make_unique<document::Document>(repo, std::move(buf));
+}
+
 class DocumentVisitorAdapter : public IBufferVisitor
 {
 public:
@@ -38,8 +69,12 @@ private:
 void
 DocumentVisitorAdapter::visit(uint32_t lid, vespalib::ConstBufferRef buf) {
     if (buf.size() > 0) {
-        vespalib::nbostream is(buf.c_str(), buf.size());
-        _visitor.visit(lid, std::make_unique<document::Document>(_repo, is));
+        if (DeltaRecord::is_merged(buf)) {
+            _visitor.visit(lid, makeMergedDocument(_repo, buf));
+        } else {
+            vespalib::nbostream is(buf.c_str(), buf.size());
+            _visitor.visit(lid, std::make_unique<document::Document>(_repo, is));
+        }
     }
 }
 
@@ -105,9 +140,23 @@ using CacheParams = vespalib::CacheParam<
         vespalib::zero<DocumentIdT>,
         vespalib::size<docstore::Value> >;
 
-class Cache : public vespalib::cache<CacheParams> {
+/*
+ * The summary cache is read by all summary threads, so it is split into shards with
+ * separate locks. Small caches use fewer shards to keep eviction close to a single LRU.
+ */
+class Cache : public vespalib::sharded_cache<CacheParams> {
+    static constexpr size_t min_bytes_per_shard = 4_Mi;
+    static constexpr uint32_t max_shards = 16;
 public:
-    Cache(BackingStore & b, size_t maxBytes) : vespalib::cache<CacheParams>(b, maxBytes) { }
+    static uint32_t num_shards(size_t maxBytes) noexcept {
+        return std::clamp(maxBytes / min_bytes_per_shard, size_t(1), size_t(max_shards));
+    }
+    Cache(BackingStore & b, size_t maxBytes) : vespalib::sharded_cache<CacheParams>(b, maxBytes, num_shards(maxBytes)) { }
+};
+
+class CacheBudgetClient : public vespalib::CacheBudgetClient<Cache> {
+public:
+    using vespalib::CacheBudgetClient<Cache>::CacheBudgetClient;
 };
 
 }
@@ -126,6 +175,12 @@ DocumentStore::getCacheCapacity() const {
     return _cache->capacityBytes();
 }
 
+size_t
+DocumentStore::get_cache_sharding_overhead_bytes(size_t max_cache_bytes)
+{
+    return docstore::Cache::sharding_overhead_bytes(docstore::Cache::num_shards(max_cache_bytes));
+}
+
 DocumentStore::DocumentStore(const Config & config, IDataStore & store)
     : IDocumentStore(),
       _backingStore(store),
@@ -133,14 +188,36 @@ DocumentStore::DocumentStore(const Config & config, IDataStore & store)
       _cache(std::make_unique<docstore::Cache>(*_store, config.getMaxCacheBytes())),
       _visitCache(std::make_unique<docstore::VisitCache>(store, config.getMaxCacheBytes(), config.getCompression())),
       _updateStrategy(config.updateStrategy()),
-      _uncached_lookups(0)
+      _uncached_lookups(0),
+      _cache_budget_manager(),
+      _cache_budget_client()
 { }
 
-DocumentStore::~DocumentStore() = default;
+DocumentStore::~DocumentStore()
+{
+    set_cache_budget_manager({});
+}
+
+void
+DocumentStore::set_cache_budget_manager(std::shared_ptr<vespalib::CacheBudgetManager> manager)
+{
+    if (_cache_budget_client) {
+        _cache_budget_manager->remove_client(*_cache_budget_client);
+        _cache_budget_client.reset();
+    }
+    _cache_budget_manager.reset();
+    if (manager && useCache()) {
+        _cache_budget_manager = std::move(manager);
+        _cache_budget_client = std::make_unique<docstore::CacheBudgetClient>(*_cache);
+        _cache_budget_manager->add_client(*_cache_budget_client);
+    }
+}
 
 void
 DocumentStore::reconfigure(const Config & config) {
-    _cache->setCapacityBytes(config.getMaxCacheBytes());
+    if ( ! _cache_budget_client) {
+        _cache->setCapacityBytes(config.getMaxCacheBytes());
+    }
     _store->reconfigure(config.getCompression());
     _visitCache->reconfigure(config.getMaxCacheBytes(), config.getCompression());
     _updateStrategy.store(config.updateStrategy(), std::memory_order_relaxed);
@@ -180,7 +257,7 @@ DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
         }
         Value::Result result = value.decompressed();
         if ( result.second ) {
-            return std::make_unique<document::Document>(repo, std::move(result.first));
+            return makeDocument(repo, std::move(result.first));
         } else {
             LOG(warning, "Summary cache for lid %u is corrupt. Invalidating and reading directly from backing store", lid);
             _cache->invalidate(lid);
@@ -192,7 +269,7 @@ DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
     if ( ! value.empty() ) {
         Value::Result result = value.decompressed();
         assert(result.second);
-        return std::make_unique<document::Document>(repo, std::move(result.first));
+        return makeDocument(repo, std::move(result.first));
     }
     return std::unique_ptr<document::Document>();
 }
@@ -230,6 +307,37 @@ DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostr
     }
 }
 
+void
+DocumentStore::update(uint64_t syncToken, DocumentIdT lid, const document::DocumentUpdate & upd,
+                      const DocumentTypeRepo &repo)
+{
+    nbostream stream;
+    upd.serializeHEAD(stream);
+    if (_backingStore.write_delta(syncToken, lid, stream.peek(), stream.size())) {
+        if (useCache()) {
+            _cache->invalidate(lid);
+            _visitCache->invalidate(lid);
+        }
+    } else {
+        IDocumentStore::update(syncToken, lid, upd, repo);
+    }
+}
+
+void
+DocumentStore::materialize_deltas(uint64_t syncToken, const DocumentTypeRepo &repo)
+{
+    std::vector<uint32_t> lids = _backingStore.get_delta_lids();
+    for (uint32_t lid : lids) {
+        auto doc = read(lid, repo);
+        if (doc) {
+            write(syncToken, lid, *doc);
+        }
+    }
+    if ( ! lids.empty()) {
+        LOG(info, "Materialized %zu documents with stored partial updates", lids.size());
+    }
+}
+
 void
 DocumentStore::remove(uint64_t syncToken, DocumentIdT lid)
 {
@@ -373,7 +481,7 @@ DocumentStore::WrapVisitor<Visitor>::visit(uint32_t lid, const void *buffer, siz
         value.set(std::move(buf), len);
     }
     if (! value.empty()) {
-        auto doc = std::make_shared<document::Document>(_repo, value.decompressed().first);
+        std::shared_ptr<document::Document> doc = makeDocument(_repo, value.decompressed().first);
         _visitor.visit(lid, doc);
         rewrite(lid, *doc);
     } else {
@@ -9,6 +9,7 @@ namespace search::docstore {
     class VisitCache;
     class BackingStore;
     class Cache;
+    class CacheBudgetClient;
 }
 
 namespace search {
@@ -61,6 +62,10 @@ public:
     void visit(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const override;
     void write(uint64_t synkToken, DocumentIdT lid, const document::Document& doc) override;
     void write(uint64_t synkToken, DocumentIdT lid, const vespalib::nbostream & os) override;
+    void update(uint64_t syncToken, DocumentIdT lid, const document::DocumentUpdate & upd,
+                const document::DocumentTypeRepo &repo) override;
+    bool has_update_deltas() const override { return _backingStore.accepts_deltas(); }
+    void materialize_deltas(uint64_t syncToken, const document::DocumentTypeRepo &repo) override;
     void remove(uint64_t syncToken, DocumentIdT lid) override;
     void flush(uint64_t syncToken) override;
     uint64_t initFlush(uint64_t synctoken) override;
@@ -75,6 +80,7 @@ public:
     size_t      getDiskBloat() const override { return _backingStore.getDiskBloat(); }
     size_t getMaxSpreadAsBloat() const override { return _backingStore.getMaxSpreadAsBloat(); }
     vespalib::CacheStats getCacheStats() const override;
+    void set_cache_budget_manager(std::shared_ptr<vespalib::CacheBudgetManager> manager) override;
     size_t memoryMeta() const override { return _backingStore.memoryMeta(); }
     const std::string & getBaseDir() const override { return _backingStore.getBaseDir(); }
     void accept(IDocumentStoreReadVisitor &visitor, IDocumentStoreVisitorProgress &visitorProgress,
@@ -86,6 +92,8 @@ public:
     vespalib::MemoryUsage getMemoryUsage() const override;
     std::vector<DataStoreFileChunkStats> getFileChunkStats() const override;
     size_t getCacheCapacity() const;
+    // Static memory used by sharding the summary cache of the given size. Only used by unit tests.
+    static size_t get_cache_sharding_overhead_bytes(size_t max_cache_bytes);
 
     /**
      * Implements common::ICompactableLidSpace
@@ -94,6 +102,10 @@ public:
     bool canShrinkLidSpace() const override;
     size_t getEstimatedShrinkLidSpaceGain() const override;
     void shrinkLidSpace() override;
+    /**
+     * The cache capacity in the config is ignored while a cache budget manager is set, as
+     * the manager then owns the capacity.
+     */
     void reconfigure(const Config & config);
 
 private:
@@ -108,6 +120,8 @@ private:
     std::unique_ptr<docstore::VisitCache>    _visitCache;
     std::atomic<Config::UpdateStrategy>      _updateStrategy;
     mutable std::atomic<uint64_t>            _uncached_lookups;
+    std::shared_ptr<vespalib::CacheBudgetManager>   _cache_budget_manager;
+    std::unique_ptr<docstore::CacheBudgetClient>    _cache_budget_client;
 };
 
 } // namespace search
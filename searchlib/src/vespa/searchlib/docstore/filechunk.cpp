@@ -16,6 +16,7 @@
 #include <exception>
 #include <filesystem>
 #include <future>
+#include <sys/mman.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".search.filechunk");
@@ -32,6 +33,18 @@ constexpr size_t ALIGNMENT=0x1000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const std::string DOC_ID_LIMIT_KEY("docIdLimit");
 
+/**
+ * Asks the kernel to start reading in the pages of a memory mapped span that is about to be
+ * visited, so the chunks in it are fetched with a few large reads instead of page by page.
+ */
+void
+adviseWillNeed(const char * data, size_t len)
+{
+    uintptr_t start = reinterpret_cast<uintptr_t>(data) & ~(ALIGNMENT - 1);
+    uintptr_t end = reinterpret_cast<uintptr_t>(data) + len;
+    posix_madvise(reinterpret_cast<void *>(start), end - start, POSIX_MADV_WILLNEED);
+}
+
 }
 
 using vespalib::make_string;
@@ -198,9 +211,10 @@ FileChunk::handleChunk(const unique_lock &guard, ISetLid &ds, uint32_t docIdLimi
     BucketDensityComputer bucketMap(_bucketizer);
     for (size_t i(0), m(chunkMeta.getNumEntries()); i < m; i++) {
         const LidMeta & lidMeta(chunkMeta[i]);
-        if (lidMeta.getLid() < docIdLimit) {
+        const uint32_t lid = docstore::DeltaRecord::lid_of(lidMeta.getLid());
+        if (lid < docIdLimit) {
             if (_bucketizer && (lidMeta.size() > 0)) {
-                document::BucketId bucketId = _bucketizer->getBucketOf(bucketizerGuard, lidMeta.getLid());
+                document::BucketId bucketId = _bucketizer->getBucketOf(bucketizerGuard, lid);
                 bucketMap.recordLid(bucketId);
                 globalBucketMap.recordLid(bucketId);
             }
@@ -366,32 +380,65 @@ FileChunk::appendTo(vespalib::Executor & executor, const IGetLid & db, IWriteDat
 }
 
 void
-FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
+FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor, size_t maxReadAhead) const
 {
     if (count == 0) { return; }
+    ChunkLidsV chunks;
     uint32_t prevChunk = begin->getChunkId();
     uint32_t start(0);
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         if (li.getChunkId() != prevChunk) {
-            ChunkInfo ci = _chunkInfo[prevChunk];
-            read(begin + start, i - start, ci, visitor);
+            chunks.emplace_back(_chunkInfo[prevChunk], begin + start, i - start);
             prevChunk = li.getChunkId();
             start = i;
         }
     }
-    ChunkInfo ci = _chunkInfo[prevChunk];
-    read(begin + start, count - start, ci, visitor);
+    chunks.emplace_back(_chunkInfo[prevChunk], begin + start, count - start);
+    read(chunks, visitor, maxReadAhead);
 }
 
 void
-FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const
+FileChunk::read(const ChunkLidsV & chunks, IBufferVisitor & visitor, size_t maxReadAhead) const
 {
-    vespalib::DataBuffer whole(0ul, ALIGNMENT);
-    FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen());
-    for (size_t i(0); i < count; i++) {
-        const LidInfoWithLid & li = *(begin + i);
+    for (size_t first(0); first < chunks.size(); ) {
+        // Extend the read past the following chunks as long as it stays within the read ahead limit
+        // and at least half of the bytes read belong to chunks that are visited.
+        uint64_t spanStart = chunks[first]._info.getOffset();
+        uint64_t spanEnd = spanStart + chunks[first]._info.getSize();
+        uint64_t usedBytes = chunks[first]._info.getSize();
+        size_t last(first + 1);
+        for (; last < chunks.size(); last++) {
+            const ChunkInfo & next = chunks[last]._info;
+            uint64_t nextEnd = next.getOffset() + next.getSize();
+            if ((next.getOffset() < spanEnd) ||
+                (nextEnd - spanStart > maxReadAhead) ||
+                (nextEnd - spanStart > 2 * (usedBytes + next.getSize())))
+            {
+                break;
+            }
+            usedBytes += next.getSize();
+            spanEnd = nextEnd;
+        }
+        vespalib::DataBuffer whole(0ul, ALIGNMENT);
+        FileRandRead::FSP keepAlive = _file->read(spanStart, whole, spanEnd - spanStart);
+        if ((last - first > 1) && whole.referencesExternalData()) {
+            adviseWillNeed(whole.getData(), whole.getDataLen());
+        }
+        for (size_t i(first); i < last; i++) {
+            const ChunkInfo & ci = chunks[i]._info;
+            visit(chunks[i], whole.getData() + (ci.getOffset() - spanStart), ci.getSize(), visitor);
+        }
+        first = last;
+    }
+}
+
+void
+FileChunk::visit(const ChunkLids & chunkLids, const void * data, size_t len, IBufferVisitor & visitor)
+{
+    Chunk chunk(chunkLids._begin->getChunkId(), data, len);
+    for (size_t i(0); i < chunkLids._count; i++) {
+        const LidInfoWithLid & li = *(chunkLids._begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
         if (buf.size() != 0) {
             visitor.visit(li.getLid(), buf);
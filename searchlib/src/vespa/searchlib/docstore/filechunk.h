@@ -3,6 +3,7 @@
 #pragma once
 
 #include "chunk.h"
+#include "delta_record.h"
 #include "ibucketizer.h"
 #include "lid_info.h"
 #include "randread.h"
@@ -50,7 +51,7 @@ public:
     explicit BucketDensityComputer(const IBucketizer * bucketizer) : _bucketizer(bucketizer), _count(0) { }
     void recordLid(const vespalib::GenerationHandler::Guard & guard, uint32_t lid, uint32_t dataSize) {
         if (_bucketizer && (dataSize > 0)) {
-            recordLid(_bucketizer->getBucketOf(guard, lid));
+            recordLid(_bucketizer->getBucketOf(guard, docstore::DeltaRecord::lid_of(lid)));
         }
     }
     void recordLid(document::BucketId bucketId) {
@@ -111,7 +112,12 @@ public:
 
     virtual void updateLidMap(const unique_lock &guard, ISetLid &lidMap, uint64_t serialNum, uint32_t docIdLimit);
     virtual ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const;
-    virtual void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const;
+    /**
+     * Visits the given lids, sorted by chunk. Chunks that lie close to each other on disk are
+     * fetched with a single read spanning at most maxReadAhead bytes.
+     */
+    virtual void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor,
+                      size_t maxReadAhead) const;
     void remove(uint32_t lid, uint32_t size);
     virtual size_t getDiskFootprint() const { return _diskFootprint.load(std::memory_order_relaxed); }
     virtual size_t getMemoryFootprint() const;
@@ -241,9 +247,23 @@ protected:
         uint32_t _size;
     };
 
+    /**
+     * The lids to visit in a single chunk stored on disk.
+     */
+    struct ChunkLids {
+        ChunkLids(ChunkInfo info, LidInfoWithLidV::const_iterator begin, size_t count) noexcept
+            : _info(info), _begin(begin), _count(count)
+        { }
+        ChunkInfo                       _info;
+        LidInfoWithLidV::const_iterator _begin;
+        size_t                          _count;
+    };
+    using ChunkLidsV = std::vector<ChunkLids>;
+
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
-    void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    void read(const ChunkLidsV & chunks, IBufferVisitor & visitor, size_t maxReadAhead) const;
+    static void visit(const ChunkLids & chunk, const void * data, size_t len, IBufferVisitor & visitor);
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
 
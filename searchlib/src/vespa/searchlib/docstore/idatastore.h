@@ -68,6 +68,23 @@ public:
      **/
     virtual void write(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len) = 0;
 
+    /**
+     * Append a serialized partial update for a key instead of writing the full data.
+     * The data read for the key will then be a merged blob of the full data and the
+     * updates, see docstore::DeltaRecord.
+     * @return false if the update was not stored, and the full data must be written instead.
+     **/
+    virtual bool write_delta(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len) {
+        (void) serialNum; (void) lid; (void) buffer; (void) len;
+        return false;
+    }
+    virtual bool accepts_deltas() const { return false; }
+
+    /**
+     * Returns the keys having a delta record, in increasing order.
+     **/
+    virtual std::vector<uint32_t> get_delta_lids() const { return {}; }
+
     /**
      * Remove old data for a key.  Equivalent to write with len==0.
      * @param serialNum The official unique reference number for this operation.
@@ -2,6 +2,7 @@
 
 #include "idocumentstore.h"
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/update/documentupdate.h>
 
 namespace search {
 
@@ -11,4 +12,13 @@ void IDocumentStore::visit(const LidVector & lids, const document::DocumentTypeR
     }
 }
 
+void IDocumentStore::update(uint64_t syncToken, DocumentIdT lid, const document::DocumentUpdate & upd,
+                            const document::DocumentTypeRepo &repo) {
+    auto doc = read(lid, repo);
+    if (doc && (doc->getId() == upd.getId())) {
+        upd.applyTo(*doc);
+        write(syncToken, lid, *doc);
+    }
+}
+
 } // namespace search
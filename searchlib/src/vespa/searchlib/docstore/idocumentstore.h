@@ -10,9 +10,11 @@
 namespace document {
     class Document;
     class DocumentTypeRepo;
+    class DocumentUpdate;
 }
 
 namespace vespalib {
+class CacheBudgetManager;
 struct CacheStats;
 class nbostream;
 }
@@ -85,6 +87,29 @@ public:
     virtual void write(uint64_t syncToken, DocumentIdT lid, const document::Document& doc) = 0;
     virtual void write(uint64_t synkToken, DocumentIdT lid, const vespalib::nbostream & os) = 0;
 
+    /**
+     * Apply a partial update to a stored document.
+     * The default reads the document, applies the update and writes the full document back.
+     * @param upd The update to apply
+     * @param lid The local ID associated with the document
+     **/
+    virtual void update(uint64_t syncToken, DocumentIdT lid, const document::DocumentUpdate & upd,
+                        const document::DocumentTypeRepo &repo);
+
+    /**
+     * Returns true if update() can store the update without reading and rewriting the full document.
+     **/
+    virtual bool has_update_deltas() const { return false; }
+
+    /**
+     * Apply all stored partial updates and write the full documents back, using the given
+     * document type repo. Used before the document type changes, as stored updates are only
+     * guaranteed to apply against the document type they were made for.
+     **/
+    virtual void materialize_deltas(uint64_t syncToken, const document::DocumentTypeRepo &repo) {
+        (void) syncToken; (void) repo;
+    }
+
     /**
      * Mark a document as removed. A later read() will return NULL for the given lid.
      * @param lid The local ID associated with the document
@@ -166,6 +191,14 @@ public:
      */
     virtual vespalib::CacheStats getCacheStats() const = 0;
 
+    /**
+     * Let the given manager resize the cache as part of a memory budget shared with other
+     * document stores, or stop doing so if null. Stores without a cache ignore this.
+     */
+    virtual void set_cache_budget_manager(std::shared_ptr<vespalib::CacheBudgetManager> manager) {
+        (void) manager;
+    }
+
     /**
      * Returns the base directory from which all structures are stored.
      **/
@@ -3,6 +3,7 @@
 #include "logdatastore.h"
 #include "storebybucket.h"
 #include "compacter.h"
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
@@ -24,10 +25,12 @@ namespace search {
 namespace {
     constexpr size_t DEFAULT_MAX_FILESIZE = 256_Mi;
     constexpr uint32_t DEFAULT_MAX_LIDS_PER_FILE = 1_Mi;
+    constexpr size_t DEFAULT_MAX_READ_AHEAD = 1_Mi;
 }
 
 using common::FileHeaderContext;
 using docstore::BucketCompacter;
+using docstore::DeltaRecord;
 using docstore::StoreByBucket;
 using document::BucketId;
 using namespace std::literals;
@@ -46,6 +49,8 @@ LogDataStore::Config::Config()
     : _maxFileSize(DEFAULT_MAX_FILESIZE),
       _maxBucketSpread(2.5),
       _minFileSizeFactor(0.2),
+      _maxDeltaFactor(0.0),
+      _maxReadAhead(DEFAULT_MAX_READ_AHEAD),
       _maxNumLids(DEFAULT_MAX_LIDS_PER_FILE),
       _compactCompression(CompressionConfig::LZ4),
       _fileConfig()
@@ -56,6 +61,8 @@ LogDataStore::Config::operator == (const Config & rhs) const {
     return (_maxBucketSpread == rhs._maxBucketSpread) &&
             (_maxFileSize == rhs._maxFileSize) &&
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
+            (_maxDeltaFactor == rhs._maxDeltaFactor) &&
+            (_maxReadAhead == rhs._maxReadAhead) &&
             (_compactCompression == rhs._compactCompression) &&
             (_fileConfig == rhs._fileConfig);
 }
@@ -80,6 +87,8 @@ LogDataStore::LogDataStore(vespalib::Executor &executor, const std::string &dirN
       _fileHeaderContext(fileHeaderContext),
       _genHandler(),
       _lidInfo(growStrategy),
+      _deltaShards(),
+      _numDeltas(0),
       _fileChunks(),
       _holdFileChunks(),
       _active(0),
@@ -147,15 +156,28 @@ void
 LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
 {
     LidInfoWithLidV orderedLids;
+    LidVector deltaLids;
     GenerationHandler::Guard guard(_genHandler.takeGuard());
+    const bool checkDeltas = hasDeltas();
     for (uint32_t lid : lids) {
         if (lid < getDocIdLimit()) {
             LidInfo li = vespalib::atomic::load_ref_acquire(_lidInfo.acquire_elem_ref(lid));
             if (!li.empty() && li.valid()) {
-                orderedLids.emplace_back(li, lid);
+                if (checkDeltas && getDelta(lid).valid()) {
+                    deltaLids.push_back(lid);
+                } else {
+                    orderedLids.emplace_back(li, lid);
+                }
             }
         }
     }
+    // Lids with a delta record are merged one by one, as the delta record may be in another chunk.
+    for (uint32_t lid : deltaLids) {
+        vespalib::DataBuffer buf;
+        if (read(lid, buf) > 0) {
+            visitor.visit(lid, vespalib::ConstBufferRef(buf.getData(), buf.getDataLen()));
+        }
+    }
     if (orderedLids.empty()) { return; }
 
     std::sort(orderedLids.begin(), orderedLids.end());
@@ -165,13 +187,13 @@ LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
         const LidInfoWithLid & li = orderedLids[curr];
         if (prevFile != li.getFileId()) {
             const FileChunk & fc(*_fileChunks[prevFile]);
-            fc.read(orderedLids.begin() + start, curr - start, visitor);
+            fc.read(orderedLids.begin() + start, curr - start, visitor, _config.getMaxReadAhead());
             start = curr;
             prevFile = li.getFileId();
         }
     }
     const FileChunk & fc(*_fileChunks[prevFile]);
-    fc.read(orderedLids.begin() + start, orderedLids.size() - start, visitor);
+    fc.read(orderedLids.begin() + start, orderedLids.size() - start, visitor, _config.getMaxReadAhead());
 }
 
 ssize_t
@@ -180,11 +202,18 @@ LogDataStore::read(uint32_t lid, vespalib::DataBuffer& buffer) const
     ssize_t sz(0);
     if (lid < getDocIdLimit()) {
         LidInfo li(0);
+        LidInfo delta;
         {
             GenerationHandler::Guard guard(_genHandler.takeGuard());
             li = vespalib::atomic::load_ref_acquire(_lidInfo.acquire_elem_ref(lid));
+            if (hasDeltas()) {
+                delta = getDelta(lid);
+            }
         }
         if (!li.empty() && li.valid()) {
+            if (delta.valid()) {
+                return readMerged(lid, li, delta, buffer);
+            }
             const FileChunk & fc(*_fileChunks[li.getFileId()]);
             sz = fc.read(lid, li.getChunkId(), buffer);
         }
@@ -192,6 +221,97 @@ LogDataStore::read(uint32_t lid, vespalib::DataBuffer& buffer) const
     return sz;
 }
 
+ssize_t
+LogDataStore::readMerged(uint32_t lid, LidInfo base, LidInfo delta, vespalib::DataBuffer & buffer) const
+{
+    vespalib::DataBuffer baseBuf;
+    _fileChunks[base.getFileId()]->read(lid, base.getChunkId(), baseBuf);
+    if (baseBuf.getDataLen() == 0) {
+        return 0;
+    }
+    size_t oldLen = buffer.getDataLen();
+    mergeDelta(lid, {baseBuf.getData(), baseBuf.getDataLen()}, delta, buffer);
+    return buffer.getDataLen() - oldLen;
+}
+
+void
+LogDataStore::mergeDelta(uint32_t lid, ConstBufferRef base, LidInfo delta, vespalib::DataBuffer & buffer) const
+{
+    vespalib::DataBuffer deltaBuf;
+    readDelta(lid, delta, deltaBuf);
+    DeltaRecord::write_merged(buffer, base, {deltaBuf.getData(), deltaBuf.getDataLen()});
+}
+
+void
+LogDataStore::readDelta(uint32_t lid, LidInfo delta, vespalib::DataBuffer & buffer) const
+{
+    _fileChunks[delta.getFileId()]->read(DeltaRecord::delta_key(lid), delta.getChunkId(), buffer);
+}
+
+LogDataStore::DeltaShard::DeltaShard() = default;
+LogDataStore::DeltaShard::~DeltaShard() = default;
+
+LidInfo
+LogDataStore::getDelta(uint32_t lid) const
+{
+    const DeltaShard & shard = getDeltaShard(lid);
+    std::lock_guard guard(shard._lock);
+    auto found = shard._deltas.find(lid);
+    return (found != shard._deltas.end()) ? LidInfo(found->second) : LidInfo();
+}
+
+void
+LogDataStore::setDelta(const MonitorGuard & guard, uint32_t lid, const LidInfo & meta)
+{
+    (void) guard;
+    DeltaShard & shard = getDeltaShard(lid);
+    std::lock_guard deltaGuard(shard._lock);
+    auto found = shard._deltas.find(lid);
+    if (found != shard._deltas.end()) {
+        LidInfo prev(found->second);
+        _fileChunks[prev.getFileId()]->remove(DeltaRecord::delta_key(lid), prev.size());
+        found->second = meta;
+    } else {
+        shard._deltas[lid] = meta;
+        _numDeltas.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void
+LogDataStore::clearDelta(const MonitorGuard & guard, uint32_t lid)
+{
+    (void) guard;
+    if ( ! hasDeltas()) {
+        return;
+    }
+    DeltaShard & shard = getDeltaShard(lid);
+    std::lock_guard deltaGuard(shard._lock);
+    auto found = shard._deltas.find(lid);
+    if (found != shard._deltas.end()) {
+        LidInfo prev(found->second);
+        _fileChunks[prev.getFileId()]->remove(DeltaRecord::delta_key(lid), prev.size());
+        shard._deltas.erase(found);
+        _numDeltas.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+std::vector<uint32_t>
+LogDataStore::get_delta_lids() const
+{
+    std::vector<uint32_t> lids;
+    if ( ! hasDeltas()) {
+        return lids;
+    }
+    for (const auto & shard : _deltaShards) {
+        std::lock_guard deltaGuard(shard._lock);
+        for (const auto & entry : shard._deltas) {
+            lids.push_back(entry.first);
+        }
+    }
+    std::sort(lids.begin(), lids.end());
+    return lids;
+}
+
 
 void
 LogDataStore::write(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len)
@@ -201,11 +321,66 @@ LogDataStore::write(uint64_t serialNum, uint32_t lid, const void * buffer, size_
     write(std::move(guard), active, serialNum,  lid, {buffer, len}, CpuCategory::WRITE);
 }
 
+bool
+LogDataStore::write_delta(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len)
+{
+    if ( ! accepts_deltas()) {
+        return false;
+    }
+    // The previous delta record is read before taking the update lock, so other writers do not
+    // wait for the disk. Only compaction can move it meanwhile, and then it is read again.
+    vespalib::DataBuffer delta;
+    LidInfo prev = getDelta(lid);
+    if (prev.valid()) {
+        readDelta(lid, prev, delta);
+    }
+    std::unique_lock guard(_updateLock);
+    if (lid >= getDocIdLimit()) {
+        return false;
+    }
+    LidInfo base = vespalib::atomic::load_ref_relaxed(_lidInfo[lid]);
+    if (base.empty() || ! base.valid()) {
+        return false;
+    }
+    LidInfo current = getDelta(lid);
+    if ( ! (current == prev)) {
+        delta.clear();
+        if (current.valid()) {
+            readDelta(lid, current, delta);
+        }
+    }
+    DeltaRecord::append_update(delta, {buffer, len});
+    if (delta.getDataLen() > _config.getMaxDeltaFactor() * base.size()) {
+        return false;
+    }
+    WriteableFileChunk & active = getActive(guard);
+    write(std::move(guard), active, serialNum, DeltaRecord::delta_key(lid), {delta.getData(), delta.getDataLen()},
+          CpuCategory::WRITE);
+    return true;
+}
+
 void
 LogDataStore::write(MonitorGuard guard, FileId destinationFileId, uint32_t lid, ConstBufferRef data)
 {
     auto & destination = static_cast<WriteableFileChunk &>(*_fileChunks[destinationFileId.getId()]);
-    write(std::move(guard), destination, destination.getSerialNum(), lid, data, CpuCategory::COMPACT);
+    LidInfo delta = DeltaRecord::is_delta_key(lid) ? LidInfo() : getDelta(lid);
+    if (delta.valid()) {
+        // The delta record is moved along to stay after the full document. Both are appended before
+        // either location is changed, and the delta record is kept, so a concurrent read sees the
+        // same document whether it gets the old or the new location of each.
+        vespalib::DataBuffer deltaBuf;
+        readDelta(lid, delta, deltaBuf);
+        LidInfo lm = destination.append(destination.getSerialNum(), lid, data, CpuCategory::COMPACT);
+        LidInfo dm = destination.append(destination.getSerialNum(), DeltaRecord::delta_key(lid),
+                                        {deltaBuf.getData(), deltaBuf.getDataLen()}, CpuCategory::COMPACT);
+        setDelta(guard, lid, dm);
+        setBaseLid(guard, lid, lm);
+        if (destination.getFileId() == getActiveFileId(guard)) {
+            requireSpace(std::move(guard), destination, CpuCategory::COMPACT);
+        }
+    } else {
+        write(std::move(guard), destination, destination.getSerialNum(), lid, data, CpuCategory::COMPACT);
+    }
 }
 
 void
@@ -297,6 +472,7 @@ LogDataStore::remove(uint64_t serialNum, uint32_t lid)
         if (lm.valid()) {
             _fileChunks[lm.getFileId()]->remove(lid, lm.size());
         }
+        clearDelta(guard, lid);
         lm = getActive(guard).append(serialNum, lid, {}, CpuCategory::WRITE);
         assert( lm.empty() );
         vespalib::atomic::store_ref_release(_lidInfo[lid], lm);
@@ -544,6 +720,10 @@ LogDataStore::memoryMeta() const
 {
     MonitorGuard guard(_updateLock);
     size_t sz(_lidInfo.getMemoryUsage().allocatedBytes());
+    for (const auto & shard : _deltaShards) {
+        std::lock_guard deltaGuard(shard._lock);
+        sz += shard._deltas.getMemoryConsumption();
+    }
     for (const auto & fc : _fileChunks) {
         if (fc) {
             sz += fc->getMemoryMetaFootprint();
@@ -981,7 +1161,17 @@ LogDataStore::scanDir(const std::string &dir, const std::string &suffix)
 void
 LogDataStore::setLid(const MonitorGuard &guard, uint32_t lid, const LidInfo &meta)
 {
-    (void) guard;
+    if (DeltaRecord::is_delta_key(lid)) {
+        setDelta(guard, DeltaRecord::lid_of(lid), meta);
+        return;
+    }
+    clearDelta(guard, lid);
+    setBaseLid(guard, lid, meta);
+}
+
+void
+LogDataStore::setBaseLid(const MonitorGuard &guard, uint32_t lid, const LidInfo &meta)
+{
     if (lid < _lidInfo.size()) {
         _genHandler.update_oldest_used_generation();
         _lidInfo.reclaim_memory(_genHandler.get_oldest_used_generation());
@@ -1047,18 +1237,36 @@ LogDataStore::verify(bool reportOnly) const
     }
 }
 
+/*
+ * A lid having a delta record is visited where its full document is found, merged with its live
+ * delta record. The delta record is always in the same or a later visited file, as it is written
+ * after the full document and is moved along with it when compacted. Thus the delta record has
+ * not been pruned yet, and the delta record itself is skipped when found.
+ */
 class LogDataStore::WrapVisitor : public IWriteData
 {
-    IDataStoreVisitor &_visitor;
+    const LogDataStore &_store;
+    IDataStoreVisitor  &_visitor;
     
 public:
     void write(MonitorGuard guard, uint32_t chunkId, uint32_t lid, ConstBufferRef data) override {
         (void) chunkId;
-        guard.unlock();
-        _visitor.visit(lid, data.c_str(), data.size());
+        if (DeltaRecord::is_delta_key(lid)) {
+            return;
+        }
+        LidInfo delta = ((data.size() > 0) && _store.hasDeltas()) ? _store.getDelta(lid) : LidInfo();
+        if (delta.valid()) {
+            vespalib::DataBuffer merged;
+            _store.mergeDelta(lid, data, delta, merged);
+            guard.unlock();
+            _visitor.visit(lid, merged.getData(), merged.getDataLen());
+        } else {
+            guard.unlock();
+            _visitor.visit(lid, data.c_str(), data.size());
+        }
     }
 
-    WrapVisitor(IDataStoreVisitor &visitor) : _visitor(visitor) { }
+    WrapVisitor(const LogDataStore &store, IDataStoreVisitor &visitor) : _store(store), _visitor(visitor) { }
     void close() override { }
 };
 
@@ -1106,7 +1314,7 @@ LogDataStore::accept(IDataStoreVisitor &visitor,
                      IDataStoreVisitorProgress &visitorProgress,
                      bool prune)
 {
-    WrapVisitor wrap(visitor);
+    WrapVisitor wrap(*this, visitor);
     internalFlushAll();
     FileIdxVector fileChunks;
     fileChunks.reserve(_fileChunks.size());
@@ -1250,6 +1458,21 @@ LogDataStore::compactLidSpace(uint32_t wantedDocLidLimit)
     for (size_t i = wantedDocLidLimit; i < _lidInfo.size(); ++i) {
         vespalib::atomic::store_ref_release(_lidInfo[i], LidInfo());
     }
+    if (hasDeltas()) {
+        for (auto & shard : _deltaShards) {
+            std::lock_guard deltaGuard(shard._lock);
+            std::vector<uint32_t> toErase;
+            for (const auto & entry : shard._deltas) {
+                if (entry.first >= wantedDocLidLimit) {
+                    toErase.push_back(entry.first);
+                }
+            }
+            for (uint32_t lid : toErase) {
+                shard._deltas.erase(lid);
+            }
+            _numDeltas.fetch_sub(toErase.size(), std::memory_order_release);
+        }
+    }
     setDocIdLimit(wantedDocLidLimit);
     _compactLidSpaceGeneration = _genHandler.getCurrentGeneration();
     incGeneration();
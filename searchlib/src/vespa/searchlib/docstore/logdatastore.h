@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "delta_record.h"
 #include "idatastore.h"
 #include "lid_info.h"
 #include "writeablefilechunk.h"
@@ -15,6 +16,8 @@
 #include <vespa/vespalib/util/executor.h>
 #include <vespa/vespalib/util/rcuvector.h>
 
+#include <array>
+#include <atomic>
 #include <set>
 
 namespace search {
@@ -48,6 +51,8 @@ public:
         Config & setMaxNumLids(size_t v) { _maxNumLids = v; return *this; }
         Config & setMaxBucketSpread(double v) noexcept { _maxBucketSpread.store_relaxed(v); return *this; }
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
+        Config & setMaxDeltaFactor(double v) { _maxDeltaFactor = v; return *this; }
+        Config & setMaxReadAhead(size_t v) { _maxReadAhead = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
@@ -55,7 +60,18 @@ public:
         size_t getMaxFileSize() const { return _maxFileSize; }
         double getMaxBucketSpread() const noexcept { return _maxBucketSpread.load_relaxed(); }
         double getMinFileSizeFactor() const { return _minFileSizeFactor; }
+        /**
+         * Max size of the delta record for a lid relative to the size of the full document.
+         * When exceeded the update is rejected and the full document must be rewritten.
+         * 0.0 means that delta records are not used.
+         */
+        double getMaxDeltaFactor() const { return _maxDeltaFactor; }
         uint32_t getMaxNumLids() const { return _maxNumLids; }
+        /**
+         * Max number of bytes fetched with a single read when visiting documents that are
+         * located in nearby chunks. 0 means that each chunk is read separately.
+         */
+        size_t getMaxReadAhead() const { return _maxReadAhead; }
 
         CompressionConfig compactCompression() const { return _compactCompression; }
 
@@ -66,6 +82,8 @@ public:
         size_t                      _maxFileSize;
         AtomicValueWrapper<double>  _maxBucketSpread;
         double                      _minFileSizeFactor;
+        double                      _maxDeltaFactor;
+        size_t                      _maxReadAhead;
         uint32_t                    _maxNumLids;
         CompressionConfig           _compactCompression;
         WriteableFileChunk::Config  _fileConfig;
@@ -98,6 +116,9 @@ public:
     ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const override;
     void read(const LidVector & lids, IBufferVisitor & visitor) const override;
     void write(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len) override;
+    bool write_delta(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len) override;
+    bool accepts_deltas() const override { return _config.getMaxDeltaFactor() > 0.0; }
+    std::vector<uint32_t> get_delta_lids() const override;
     void remove(uint64_t serialNum, uint32_t lid) override;
     void flush(uint64_t syncToken) override;
     uint64_t initFlush(uint64_t syncToken) override;
@@ -150,10 +171,12 @@ public:
         return IGetLid::unique_lock(_updateLock);
     }
 
-    // Implements IGetLid API
+    // Implements IGetLid API. The key of a delta record gives the location of the delta record.
     LidInfo getLid(const Guard & guard, uint32_t lid) const override {
         (void) guard;
-        if (lid < getDocIdLimit()) {
+        if (docstore::DeltaRecord::is_delta_key(lid)) {
+            return getDelta(docstore::DeltaRecord::lid_of(lid));
+        } else if (lid < getDocIdLimit()) {
             return vespalib::atomic::load_ref_acquire(_lidInfo.acquire_elem_ref(lid));
         } else {
             return {};
@@ -184,6 +207,29 @@ private:
 
     void setLid(const ISetLid::unique_lock & guard, uint32_t lid, const LidInfo & lm) override;
 
+    /*
+     * Location of the live delta record for lids having one, see docstore::DeltaRecord.
+     * Sharded by lid so summary reads of different lids do not contend on a single lock.
+     */
+    struct alignas(64) DeltaShard {
+        mutable std::mutex                     _lock;
+        vespalib::hash_map<uint32_t, uint64_t> _deltas;
+        DeltaShard();
+        ~DeltaShard();
+    };
+    static constexpr uint32_t NUM_DELTA_SHARDS = 16;
+
+    DeltaShard & getDeltaShard(uint32_t lid) noexcept { return _deltaShards[lid % NUM_DELTA_SHARDS]; }
+    const DeltaShard & getDeltaShard(uint32_t lid) const noexcept { return _deltaShards[lid % NUM_DELTA_SHARDS]; }
+    bool hasDeltas() const noexcept { return _numDeltas.load(std::memory_order_acquire) != 0; }
+    LidInfo getDelta(uint32_t lid) const;
+    void setDelta(const MonitorGuard & guard, uint32_t lid, const LidInfo & meta);
+    void clearDelta(const MonitorGuard & guard, uint32_t lid);
+    void readDelta(uint32_t lid, LidInfo delta, vespalib::DataBuffer & buffer) const;
+    void setBaseLid(const MonitorGuard & guard, uint32_t lid, const LidInfo & meta);
+    ssize_t readMerged(uint32_t lid, LidInfo base, LidInfo delta, vespalib::DataBuffer & buffer) const;
+    void mergeDelta(uint32_t lid, ConstBufferRef base, LidInfo delta, vespalib::DataBuffer & buffer) const;
+
     void compactWorst(uint64_t syncToken, bool compactDiskBloat);
     void compactFile(FileId chunkId);
 
@@ -252,6 +298,8 @@ private:
     const search::common::FileHeaderContext &_fileHeaderContext;
     mutable vespalib::GenerationHandler      _genHandler;
     LidInfoVector                            _lidInfo;
+    std::array<DeltaShard, NUM_DELTA_SHARDS> _deltaShards;
+    std::atomic<size_t>                      _numDeltas;
     FileChunkVector                          _fileChunks;
     vespalib::hash_map<uint32_t, uint32_t>   _holdFileChunks;
     FileId                                   _active;
@@ -198,18 +198,6 @@ WriteableFileChunk::restart(uint32_t nextChunkId, CpuUsage::Category cpu_categor
 
 namespace {
 
-LidInfoWithLidV::const_iterator
-find_first(LidInfoWithLidV::const_iterator begin, uint32_t chunkId) {
-   for ( ; begin->getChunkId() != chunkId; ++begin);
-   return begin;
-}
-
-LidInfoWithLidV::const_iterator
-seek_past(LidInfoWithLidV::const_iterator begin, LidInfoWithLidV::const_iterator end, uint32_t chunkId) {
-   for ( ; (begin < end) && (begin->getChunkId() == chunkId); begin++);
-   return begin;
-}
-
 struct LidAndBuffer {
     LidAndBuffer(uint32_t lid, uint32_t sz, vespalib::alloc::Alloc buf) noexcept : _lid(lid), _size(sz), _buf(std::move(buf)) {}
     uint32_t _lid;
@@ -232,11 +220,12 @@ WriteableFileChunk::get_chunk(uint32_t chunk) const
 }
 
 void
-WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
+WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor,
+                         size_t maxReadAhead) const
 {
     if (count == 0) { return; }
     if (!frozen()) {
-        vespalib::hash_map<uint32_t, ChunkInfo> chunksOnFile;
+        ChunkLidsV chunksOnFile;
         std::vector<LidAndBuffer> buffers;
         {
             std::lock_guard guard(_lock);
@@ -246,8 +235,10 @@ WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IB
                 if ((chunk >= _chunkInfo.size()) || !_chunkInfo[chunk].valid()) {
                     auto copy = get_chunk(chunk).read(li.getLid());
                     buffers.emplace_back(li.getLid(), copy.first, std::move(copy.second));
+                } else if (!chunksOnFile.empty() && (chunksOnFile.back()._begin->getChunkId() == chunk)) {
+                    chunksOnFile.back()._count++;
                 } else {
-                    chunksOnFile[chunk] = _chunkInfo[chunk];
+                    chunksOnFile.emplace_back(_chunkInfo[chunk], begin + i, 1);
                 }
             }
         }
@@ -255,13 +246,9 @@ WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IB
             visitor.visit(entry._lid, vespalib::ConstBufferRef(entry._buf.get(), entry._size));
             entry._buf = vespalib::alloc::Alloc();
         }
-        for (auto & it : chunksOnFile) {
-            auto first = find_first(begin, it.first);
-            auto last = seek_past(first, begin + count, it.first);
-            FileChunk::read(first, last - first, it.second, visitor);
-        }
+        FileChunk::read(chunksOnFile, visitor, maxReadAhead);
     } else {
-        FileChunk::read(begin, count, visitor);
+        FileChunk::read(begin, count, visitor, maxReadAhead);
     }
 }
 
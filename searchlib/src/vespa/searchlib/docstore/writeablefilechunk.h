@@ -50,7 +50,8 @@ public:
     ~WriteableFileChunk() override;
 
     ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const override;
-    void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const override;
+    void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor,
+              size_t maxReadAhead) const override;
 
     LidInfo append(uint64_t serialNum, uint32_t lid, vespalib::ConstBufferRef data,
                    vespalib::CpuUsage::Category cpu_category);
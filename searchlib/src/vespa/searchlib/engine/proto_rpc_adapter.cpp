@@ -17,6 +17,7 @@ LOG_SETUP(".engine.proto_rpc_adapter");
 namespace search::engine {
 
 using vespalib::DataBuffer;
+using vespalib::alloc::Alloc;
 using vespalib::ConstBufferRef;
 using vespalib::compression::CompressionConfig;
 using ProtoSearchRequest = ProtoConverter::ProtoSearchRequest;
@@ -36,33 +37,44 @@ CompressionConfig get_compression_config() {
     return CompressionConfig(streamer.getCompressionType(), streamer.getCompressionLevel(), 80, streamer.getCompressionLimit());
 }
 
+// Serialize directly into a buffer that can be handed over to the
+// rpc return values as shared data, avoiding intermediate copies of
+// (potentially large) replies.
 template <typename MSG>
-void encode_message(const MSG &src, FRT_Values &dst) {
-    using vespalib::compression::compress;
-    auto output = src.SerializeAsString();
-    ConstBufferRef buf(output.data(), output.size());
-    DataBuffer compressed(output.data(), output.size());
-    CompressionConfig::Type type = compress(get_compression_config(), buf, compressed, true);
-    dst.AddInt8(type);
-    dst.AddInt32(buf.size());
-    dst.AddData(compressed.getData(), compressed.getDataLen());
+std::pair<Alloc, size_t> serialize_message(const MSG &src) {
+    size_t size = src.ByteSizeLong();
+    auto buf = Alloc::alloc(size);
+    src.SerializeWithCachedSizesToArray(static_cast<uint8_t *>(buf.get()));
+    return {std::move(buf), size};
 }
 
-void encode_search_reply(const ProtoSearchReply &src, FRT_Values &dst) {
+void add_serialized(Alloc output, size_t size, bool allow_compression, FRT_Values &dst) {
     using vespalib::compression::compress;
-    auto output = src.SerializeAsString();
-    if (src.grouping_blob().empty()) {
-        dst.AddInt8(CompressionConfig::Type::NONE);
-        dst.AddInt32(output.size());
-        dst.AddData(output.data(), output.size());
-    } else {
-        ConstBufferRef buf(output.data(), output.size());
-        DataBuffer compressed(output.data(), output.size());
+    if (allow_compression) {
+        ConstBufferRef buf(output.get(), size);
+        DataBuffer compressed(0);
         CompressionConfig::Type type = compress(get_compression_config(), buf, compressed, true);
-        dst.AddInt8(type);
-        dst.AddInt32(buf.size());
-        dst.AddData(compressed.getData(), compressed.getDataLen());
+        if (type != CompressionConfig::Type::NONE) {
+            dst.AddInt8(type);
+            dst.AddInt32(size);
+            dst.AddData(std::move(compressed));
+            return;
+        }
     }
+    dst.AddInt8(CompressionConfig::Type::NONE);
+    dst.AddInt32(size);
+    dst.AddData(std::move(output), size);
+}
+
+template <typename MSG>
+void encode_message(const MSG &src, FRT_Values &dst) {
+    auto [output, size] = serialize_message(src);
+    add_serialized(std::move(output), size, true, dst);
+}
+
+void encode_search_reply(const ProtoSearchReply &src, FRT_Values &dst) {
+    auto [output, size] = serialize_message(src);
+    add_serialized(std::move(output), size, !src.grouping_blob().empty(), dst);
 }
 
 template <typename MSG>
@@ -120,6 +120,11 @@ public:
         o[2].as_number = 0;  // contains
         o[3].as_number = 1;  // count
     }
+    bool has_prefetch() const override { return true; }
+    void prefetch(uint32_t docId) const override { _attribute.prefetch(docId); }
+    bool has_batch_execute() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t * const> inputs,
+                       std::span<feature_t * const> outputs) override;
     void execute(uint32_t docId) override;
 };
 
@@ -236,6 +241,22 @@ SingleAttributeExecutor<T>::execute(uint32_t docId)
                      : util::getAsFeature(v);
 }
 
+template <typename T>
+void
+SingleAttributeExecutor<T>::execute_batch(std::span<const uint32_t> docids, std::span<const feature_t * const>,
+                                          std::span<feature_t * const> outputs)
+{
+    for (size_t i = 0; i < docids.size(); ++i) {
+        typename T::LoadedValueType v = _attribute.getFast(docids[i]);
+        outputs[0][i] = __builtin_expect(attribute::isUndefined(v), false)
+                        ? attribute::getUndefined<feature_t>()
+                        : util::getAsFeature(v);
+    }
+    std::fill_n(outputs[1], docids.size(), 0.0); // weight
+    std::fill_n(outputs[2], docids.size(), 0.0); // contains
+    std::fill_n(outputs[3], docids.size(), 1.0); // count
+}
+
 template <typename BaseType>
 void
 ArrayAttributeExecutor<BaseType>::execute(uint32_t docId)
@@ -73,6 +73,9 @@ private:
 public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
+    bool has_batch_execute() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t * const> inputs,
+                       std::span<feature_t * const> outputs) override;
     void execute(uint32_t docId) override;
 };
 
@@ -193,6 +196,20 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(_params.data()));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(std::span<const uint32_t> docids,
+                                                 std::span<const feature_t * const> inputs,
+                                                 std::span<feature_t * const> outputs)
+{
+    feature_t *result = outputs[0];
+    for (size_t d = 0; d < docids.size(); ++d) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = inputs[i][d];
+        }
+        result[d] = _ranking_function(_params.data());
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
@@ -3,6 +3,9 @@
 #include "featureexecutor.h"
 #include <vespa/vespalib/util/classname.h>
 
+#include <vespa/log/log.h>
+LOG_SETUP(".fef.featureexecutor");
+
 namespace search::fef {
 
 FeatureExecutor::FeatureExecutor() = default;
@@ -20,6 +23,29 @@ FeatureExecutor::isPure()
     return false;
 }
 
+bool
+FeatureExecutor::has_prefetch() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::prefetch(uint32_t) const
+{
+}
+
+bool
+FeatureExecutor::has_batch_execute() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::execute_batch(std::span<const uint32_t>, std::span<const feature_t * const>, std::span<feature_t * const>)
+{
+    LOG_ABORT("should not be reached");
+}
+
 void
 FeatureExecutor::handle_bind_inputs(std::span<const LazyValue>)
 {
@@ -148,6 +148,51 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor is able to prefetch the memory
+     * it will read when executed for a document. The rank program
+     * will only call prefetch on executors returning true here.
+     *
+     * @return true if this feature executor implements prefetch
+     **/
+    virtual bool has_prefetch() const;
+
+    /**
+     * Hint that this feature executor will soon be executed for the
+     * given document. Executors reading large data structures (like
+     * attribute vectors) may issue software prefetches for the memory
+     * needed, to overlap cache misses with other work. This must not
+     * change the state of the executor, and must not itself wait for
+     * memory, like following a reference that may miss the cache.
+     *
+     * @param docid the local document id soon to be evaluated
+     **/
+    virtual void prefetch(uint32_t docid) const;
+
+    /**
+     * Check if this feature executor is able to calculate its outputs
+     * for a block of documents at a time using execute_batch. An
+     * executor claiming to support batch execution must only depend
+     * on its (number) inputs and the document id, never on match
+     * data, since match data is not unpacked when executing a block.
+     *
+     * @return true if this feature executor implements execute_batch
+     **/
+    virtual bool has_batch_execute() const;
+
+    /**
+     * Execute this feature executor for a block of documents. Each
+     * input and output is a column with one value per document, where
+     * index i holds the value for docids[i].
+     *
+     * @param docids the local document ids being evaluated
+     * @param inputs one column of input values per input
+     * @param outputs one column of output values per output
+     **/
+    virtual void execute_batch(std::span<const uint32_t> docids,
+                               std::span<const feature_t * const> inputs,
+                               std::span<feature_t * const> outputs);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
@@ -30,6 +30,18 @@ FeatureOverrider::isPure()
     return _executor.isPure();
 }
 
+bool
+FeatureOverrider::has_prefetch() const
+{
+    return _executor.has_prefetch();
+}
+
+void
+FeatureOverrider::prefetch(uint32_t docId) const
+{
+    _executor.prefetch(docId);
+}
+
 void
 FeatureOverrider::execute(uint32_t docId)
 {
@@ -32,6 +32,8 @@ public:
     FeatureOverrider &operator=(const FeatureOverrider &) = delete;
     FeatureOverrider(FeatureExecutor &executor, uint32_t outputIdx, feature_t number, Value::UP object);
     bool isPure() override;
+    bool has_prefetch() const override;
+    void prefetch(uint32_t docId) const override;
     void execute(uint32_t docId) override;
 };
 
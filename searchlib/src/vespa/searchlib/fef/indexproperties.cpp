@@ -100,6 +100,10 @@ const std::string UseFastForest::NAME("vespa.eval.use_fast_forest");
 const bool UseFastForest::DEFAULT_VALUE(false);
 bool UseFastForest::check(const Properties &props) { return lookupBool(props, NAME, DEFAULT_VALUE); }
 
+const std::string BatchExecute::NAME("vespa.eval.batch_execute");
+const bool BatchExecute::DEFAULT_VALUE(false);
+bool BatchExecute::check(const Properties &props, bool fallback) { return lookupBool(props, NAME, fallback); }
+
 } // namespace eval
 
 namespace rank {
@@ -474,6 +478,38 @@ TargetHitsMaxAdjustmentFactor::lookup(const Properties& props, double defaultVal
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const std::string FilterFirstThreshold::NAME("vespa.matching.nns.filter_first_threshold");
+
+const double FilterFirstThreshold::DEFAULT_VALUE(0.0);
+
+double
+FilterFirstThreshold::lookup(const Properties& props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+FilterFirstThreshold::lookup(const Properties& props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
+const std::string FilterFirstExploration::NAME("vespa.matching.nns.filter_first_exploration");
+
+const double FilterFirstExploration::DEFAULT_VALUE(0.3);
+
+double
+FilterFirstExploration::lookup(const Properties& props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+FilterFirstExploration::lookup(const Properties& props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
 const std::string FuzzyAlgorithm::NAME("vespa.matching.fuzzy.algorithm");
 const vespalib::FuzzyMatchingAlgorithm FuzzyAlgorithm::DEFAULT_VALUE(vespalib::FuzzyMatchingAlgorithm::DfaTable);
 
@@ -496,6 +532,26 @@ bool SortBlueprintsByCost::check(const Properties &props, bool fallback) {
     return lookupBool(props, NAME, fallback);
 }
 
+const std::string FieldCostSampleInterval::NAME("vespa.matching.field_cost_sample_interval");
+const uint32_t FieldCostSampleInterval::DEFAULT_VALUE(0);
+uint32_t FieldCostSampleInterval::lookup(const Properties &props) { return lookup(props, DEFAULT_VALUE); }
+uint32_t FieldCostSampleInterval::lookup(const Properties &props, uint32_t defaultValue) {
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const std::string UsePostingBitVectorCache::NAME("vespa.matching.use_posting_bitvector_cache");
+const bool UsePostingBitVectorCache::DEFAULT_VALUE(false);
+bool UsePostingBitVectorCache::check(const Properties &props, bool fallback) {
+    return lookupBool(props, NAME, fallback);
+}
+
+const std::string MaxTermExpansions::NAME("vespa.matching.max_term_expansions");
+const uint32_t MaxTermExpansions::DEFAULT_VALUE(1000);
+uint32_t MaxTermExpansions::lookup(const Properties &props) { return lookup(props, DEFAULT_VALUE); }
+uint32_t MaxTermExpansions::lookup(const Properties &props, uint32_t defaultValue) {
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 } // namespace matching
 
 namespace softtimeout {
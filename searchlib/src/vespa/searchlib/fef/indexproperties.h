@@ -36,6 +36,14 @@ struct UseFastForest {
     static bool check(const Properties &props);
 };
 
+// calculate first phase rank for blocks of documents when all involved executors support it
+struct BatchExecute {
+    static const std::string NAME;
+    static const bool DEFAULT_VALUE;
+    static bool check(const Properties &props) { return check(props, DEFAULT_VALUE); }
+    static bool check(const Properties &props, bool fallback);
+};
+
 } // namespace eval
 
 namespace rank {
@@ -330,6 +338,32 @@ namespace matching {
         static double lookup(const Properties &props, double defaultValue);
     };
 
+    /**
+     * Property to control when a nearestNeighbor search using HNSW index with pre-filtering explores the graph
+     * filter-first: Nodes rejected by the global filter are not scored, but their neighbors are considered instead.
+     *
+     * Filter-first exploration is used while the observed ratio of graph neighbors passing the filter (initially
+     * the hit ratio of the global filter) is below this threshold. The default value 0.0 disables it.
+     **/
+    struct FilterFirstThreshold {
+        static const std::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
+
+    /**
+     * Property to control how aggressively filter-first exploration in the HNSW index looks at neighbors of
+     * neighbors. The value is the fraction of the max number of links per node that should be found to pass
+     * the filter when expanding a node, in the range [0,1].
+     **/
+    struct FilterFirstExploration {
+        static const std::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
+
     /**
      * Try to find a word matching less that this whose score will be used as initial heap threshold.
      * The value is given as a fraction of the corpus in the range [0,1]
@@ -384,6 +418,43 @@ namespace matching {
         static bool check(const Properties &props) { return check(props, DEFAULT_VALUE); }
         static bool check(const Properties &props, bool fallback);
     };
+
+    /**
+     * Sample the measured execution cost of leaf iterators for one
+     * out of every N queries. The measured per field cost is used to
+     * adjust the cost estimates used when sorting blueprints by cost.
+     * A value of 0 (default) disables sampling.
+     **/
+    struct FieldCostSampleInterval {
+        static const std::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
+    /**
+     * Keep the bitvectors produced when merging the posting lists of
+     * frequently used attribute terms (e.g. ranges and prefixes) in a
+     * cache, so that later queries using the same terms can reuse them.
+     **/
+    struct UsePostingBitVectorCache {
+        static const std::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props) { return check(props, DEFAULT_VALUE); }
+        static bool check(const Properties &props, bool fallback);
+    };
+
+    /**
+     * The max number of dictionary words a prefix or fuzzy term searching
+     * an index field is expanded to. Words beyond the limit (in dictionary
+     * order) are ignored.
+     **/
+    struct MaxTermExpansions {
+        static const std::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
 }
 
 namespace softtimeout {
@@ -123,6 +123,12 @@ struct ProfiledExecutor : FeatureExecutor {
     bool isPure() override {
         return executor.isPure();
     }
+    bool has_prefetch() const override {
+        return executor.has_prefetch();
+    }
+    void prefetch(uint32_t docId) const override {
+        executor.prefetch(docId);
+    }
     void execute(uint32_t docId) override {
         profiler.start(self);
         executor.lazy_execute(docId);
@@ -222,8 +228,12 @@ RankProgram::RankProgram(BlueprintResolver::SP resolver)
       _hot_stash(32_Ki),
       _cold_stash(),
       _executors(),
+      _prefetchers(),
       _unboxed_seeds(),
-      _is_const()
+      _is_const(),
+      _batch_steps(),
+      _batch_columns(),
+      _batch_seed(nullptr)
 {
 }
 
@@ -279,6 +289,8 @@ RankProgram::setup(const MatchData &md,
         _executors.push_back(executor);
         if (is_const) {
             run_const(executor);
+        } else if (executor->has_prefetch()) {
+            _prefetchers.push_back(executor);
         }
     }
     for (const auto &seed_entry: _resolver->getSeedMap()) {
@@ -288,8 +300,8 @@ RankProgram::setup(const MatchData &md,
         }
     }
     assert(_executors.size() == specs.size());
-    LOG(debug, "Num executors = %ld, hot stash = %ld, cold stash = %ld, match data fields = %d",
-               _executors.size(), _hot_stash.count_used(), _cold_stash.count_used(), md.getNumTermFields());
+    LOG(debug, "Num executors = %ld, prefetching executors = %ld, hot stash = %ld, cold stash = %ld, match data fields = %d",
+               _executors.size(), _prefetchers.size(), _hot_stash.count_used(), _cold_stash.count_used(), md.getNumTermFields());
     if (LOG_WOULD_LOG(debug)) {
         vespalib::hash_map<std::string, size_t> executorStats;
         for (const FeatureExecutor * executor : _executors) {
@@ -306,6 +318,80 @@ RankProgram::setup(const MatchData &md,
     }
 }
 
+bool
+RankProgram::setup_batch_execute()
+{
+    const auto &specs = _resolver->getExecutorSpecs();
+    const auto &seeds = _resolver->getSeedMap();
+    assert(_executors.size() == specs.size());
+    if (seeds.size() != 1) {
+        return false;
+    }
+    auto seed = seeds.begin()->second;
+    if (specs[seed.executor].output_types[seed.output].is_object() ||
+        check_const(_executors[seed.executor]->outputs().get_raw(seed.output)))
+    {
+        return false;
+    }
+    // Assign a column to each output of non-const executors and to each const input
+    struct PlannedStep {
+        uint32_t              executor;
+        std::vector<uint32_t> input_columns;
+    };
+    std::vector<PlannedStep> planned;
+    std::vector<std::pair<uint32_t, feature_t>> const_columns;
+    std::vector<uint32_t> first_output_column(specs.size(), 0);
+    uint32_t num_columns = 0;
+    for (uint32_t i = 0; i < specs.size(); ++i) {
+        const auto &output_types = specs[i].output_types;
+        if (output_types.empty() || check_const(_executors[i]->outputs().get_raw(0))) {
+            continue;
+        }
+        if (!_executors[i]->has_batch_execute()) {
+            return false;
+        }
+        for (const auto &type : output_types) {
+            if (type.is_object()) {
+                return false;
+            }
+        }
+        first_output_column[i] = num_columns;
+        num_columns += output_types.size();
+        auto &step = planned.emplace_back(i, std::vector<uint32_t>());
+        for (auto ref : specs[i].inputs) {
+            if (specs[ref.executor].output_types[ref.output].is_object()) {
+                return false;
+            }
+            const NumberOrObject *input_value = _executors[ref.executor]->outputs().get_raw(ref.output);
+            if (check_const(input_value)) {
+                const_columns.emplace_back(num_columns, input_value->as_number);
+                step.input_columns.push_back(num_columns++);
+            } else {
+                step.input_columns.push_back(first_output_column[ref.executor] + ref.output);
+            }
+        }
+    }
+    std::vector<feature_t> columns(num_columns * max_batch_size, 0.0);
+    auto column = [&columns](uint32_t idx) noexcept { return columns.data() + (idx * max_batch_size); };
+    for (auto [idx, value] : const_columns) {
+        std::fill_n(column(idx), max_batch_size, value);
+    }
+    _batch_steps.reserve(planned.size());
+    for (const auto &step : planned) {
+        auto &batch_step = _batch_steps.emplace_back(*_executors[step.executor]);
+        for (uint32_t idx : step.input_columns) {
+            batch_step.inputs.push_back(column(idx));
+        }
+        for (uint32_t j = 0; j < specs[step.executor].output_types.size(); ++j) {
+            batch_step.outputs.push_back(column(first_output_column[step.executor] + j));
+        }
+    }
+    _batch_seed = column(first_output_column[seed.executor] + seed.output);
+    _batch_columns = std::move(columns);
+    LOG(debug, "Batch execution with %zu executors and %u columns", _batch_steps.size(), num_columns);
+    return true;
+}
+
 FeatureResolver
 RankProgram::get_seeds(bool unbox_seeds) const
 {
@@ -29,7 +29,17 @@ class IQueryEnvironment;
  **/
 class RankProgram
 {
+public:
+    // max number of documents passed to execute_batch
+    static constexpr size_t max_batch_size = 64;
+
 private:
+    struct BatchStep {
+        FeatureExecutor                *executor;
+        std::vector<const feature_t *>  inputs;
+        std::vector<feature_t *>        outputs;
+        explicit BatchStep(FeatureExecutor &executor_in) noexcept : executor(&executor_in), inputs(), outputs() {}
+    };
     using MappedValues = std::map<const NumberOrObject *, LazyValue>;
     using ValueSet = vespalib::hash_set<const NumberOrObject *, vespalib::hash<const NumberOrObject *>,
                                         std::equal_to<>, vespalib::hashtable_base::and_modulator>;
@@ -38,8 +48,12 @@ private:
     vespalib::Stash                  _hot_stash;
     vespalib::Stash                  _cold_stash;
     std::vector<FeatureExecutor *>   _executors;
+    std::vector<FeatureExecutor *>   _prefetchers;
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
+    std::vector<BatchStep>           _batch_steps;
+    std::vector<feature_t>           _batch_columns;
+    const feature_t                 *_batch_seed;
 
     bool check_const(const NumberOrObject *value) const { return (_is_const.count(value) == 1); }
     bool check_const(FeatureExecutor *executor, const std::vector<BlueprintResolver::FeatureRef> &inputs) const;
@@ -73,6 +87,50 @@ public:
                const Properties &featureOverrides = Properties(),
                vespalib::ExecutionProfiler *profiler = nullptr);
 
+    /**
+     * Check if any of the non-constant executors in this rank program
+     * are able to prefetch the memory needed to evaluate a document.
+     **/
+    bool has_prefetch() const { return !_prefetchers.empty(); }
+
+    /**
+     * Hint that the given document will soon be evaluated by this
+     * rank program. Lets executors issue software prefetches for the
+     * memory they will read, to overlap cache misses with other work
+     * like matching or evaluating other documents.
+     **/
+    void prefetch(uint32_t docid) const {
+        for (const FeatureExecutor *executor : _prefetchers) {
+            executor->prefetch(docid);
+        }
+    }
+
+    /**
+     * Prepare this rank program for calculating its single seed
+     * feature for blocks of documents at a time. This is only possible
+     * when all non-constant executors support batch execution and all
+     * involved feature values are numbers. Must be called after setup.
+     *
+     * @return true if this rank program can now use execute_batch
+     **/
+    bool setup_batch_execute();
+    bool has_batch_execute() const { return (_batch_seed != nullptr); }
+
+    /**
+     * Calculate the seed feature for a block of (at most
+     * max_batch_size) documents, evaluating each executor for all the
+     * documents before moving on to the next executor. Match data is
+     * not used when executing a block.
+     *
+     * @return seed feature values, one for each document
+     **/
+    std::span<const feature_t> execute_batch(std::span<const uint32_t> docids) const {
+        for (const auto &step : _batch_steps) {
+            step.executor->execute_batch(docids, step.inputs, step.outputs);
+        }
+        return {_batch_seed, docids.size()};
+    }
+
     /**
      * Obtain the names and storage locations of all seed features for
      * this rank program. Programs for ranking phases will only have a
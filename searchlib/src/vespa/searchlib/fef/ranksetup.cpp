@@ -54,12 +54,16 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _degradationPostFilterMultiplier(1.0),
       _first_phase_rank_score_drop_limit(),
       _second_phase_rank_score_drop_limit(),
+      _field_cost_sample_interval(0),
+      _max_term_expansions(matching::MaxTermExpansions::DEFAULT_VALUE),
       _match_features(),
       _summaryFeatures(),
       _dumpFeatures(),
       _warnings(),
       _feature_rename_map(),
       _sort_blueprints_by_cost(false),
+      _use_posting_bitvector_cache(false),
+      _batch_execute(false),
       _ignoreDefaultRankFeatures(false),
       _compiled(false),
       _compileError(false),
@@ -73,6 +77,8 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _global_filter_lower_limit(0.0),
       _global_filter_upper_limit(1.0),
       _target_hits_max_adjustment_factor(20.0),
+      _filter_first_threshold(0.0),
+      _filter_first_exploration(0.3),
       _weakand_stop_word_adjust_limit(matching::WeakAndStopWordAdjustLimit::DEFAULT_VALUE),
       _weakand_stop_word_drop_limit(matching::WeakAndStopWordDropLimit::DEFAULT_VALUE),
       _fuzzy_matching_algorithm(vespalib::FuzzyMatchingAlgorithm::DfaTable),
@@ -130,6 +136,8 @@ RankSetup::configure()
     set_global_filter_lower_limit(matching::GlobalFilterLowerLimit::lookup(_indexEnv.getProperties()));
     set_global_filter_upper_limit(matching::GlobalFilterUpperLimit::lookup(_indexEnv.getProperties()));
     set_target_hits_max_adjustment_factor(matching::TargetHitsMaxAdjustmentFactor::lookup(_indexEnv.getProperties()));
+    set_filter_first_threshold(matching::FilterFirstThreshold::lookup(_indexEnv.getProperties()));
+    set_filter_first_exploration(matching::FilterFirstExploration::lookup(_indexEnv.getProperties()));
     set_fuzzy_matching_algorithm(matching::FuzzyAlgorithm::lookup(_indexEnv.getProperties()));
     set_weakand_stop_word_adjust_limit(matching::WeakAndStopWordAdjustLimit::lookup(_indexEnv.getProperties()));
     set_weakand_stop_word_drop_limit(matching::WeakAndStopWordDropLimit::lookup(_indexEnv.getProperties()));
@@ -143,6 +151,10 @@ RankSetup::configure()
     _mutateOnSummary._operation = mutate::on_summary::Operation::lookup(_indexEnv.getProperties());
     _mutateAllowQueryOverride = mutate::AllowQueryOverride::check(_indexEnv.getProperties());
     _sort_blueprints_by_cost = matching::SortBlueprintsByCost::check(_indexEnv.getProperties());
+    _field_cost_sample_interval = matching::FieldCostSampleInterval::lookup(_indexEnv.getProperties());
+    _use_posting_bitvector_cache = matching::UsePostingBitVectorCache::check(_indexEnv.getProperties());
+    _batch_execute = eval::BatchExecute::check(_indexEnv.getProperties());
+    _max_term_expansions = matching::MaxTermExpansions::lookup(_indexEnv.getProperties());
 }
 
 void
@@ -63,12 +63,16 @@ private:
     double                   _degradationPostFilterMultiplier;
     std::optional<feature_t> _first_phase_rank_score_drop_limit;
     std::optional<feature_t> _second_phase_rank_score_drop_limit;
+    uint32_t                 _field_cost_sample_interval;
+    uint32_t                 _max_term_expansions;
     std::vector<std::string> _match_features;
     std::vector<std::string> _summaryFeatures;
     std::vector<std::string> _dumpFeatures;
     Warnings                 _warnings;
     StringStringMap          _feature_rename_map;
     bool                     _sort_blueprints_by_cost;
+    bool                     _use_posting_bitvector_cache;
+    bool                     _batch_execute;
     bool                     _ignoreDefaultRankFeatures;
     bool                     _compiled;
     bool                     _compileError;
@@ -82,6 +86,8 @@ private:
     double                   _global_filter_lower_limit;
     double                   _global_filter_upper_limit;
     double                   _target_hits_max_adjustment_factor;
+    double                   _filter_first_threshold;
+    double                   _filter_first_exploration;
     double                   _weakand_stop_word_adjust_limit;
     double                   _weakand_stop_word_drop_limit;
     vespalib::FuzzyMatchingAlgorithm _fuzzy_matching_algorithm;
@@ -407,6 +413,10 @@ public:
     double get_global_filter_upper_limit() const { return _global_filter_upper_limit; }
     void set_target_hits_max_adjustment_factor(double v) { _target_hits_max_adjustment_factor = v; }
     double get_target_hits_max_adjustment_factor() const { return _target_hits_max_adjustment_factor; }
+    void set_filter_first_threshold(double v) { _filter_first_threshold = v; }
+    double get_filter_first_threshold() const { return _filter_first_threshold; }
+    void set_filter_first_exploration(double v) { _filter_first_exploration = v; }
+    double get_filter_first_exploration() const { return _filter_first_exploration; }
     void set_fuzzy_matching_algorithm(vespalib::FuzzyMatchingAlgorithm v) { _fuzzy_matching_algorithm = v; }
     vespalib::FuzzyMatchingAlgorithm get_fuzzy_matching_algorithm() const { return _fuzzy_matching_algorithm; }
     void set_weakand_stop_word_adjust_limit(double v) { _weakand_stop_word_adjust_limit = v; }
@@ -472,6 +482,10 @@ public:
 
     bool allowMutateQueryOverride() const { return _mutateAllowQueryOverride; }
     bool sort_blueprints_by_cost() const noexcept { return _sort_blueprints_by_cost; }
+    uint32_t get_field_cost_sample_interval() const noexcept { return _field_cost_sample_interval; }
+    bool use_posting_bitvector_cache() const noexcept { return _use_posting_bitvector_cache; }
+    bool use_batch_execute() const noexcept { return _batch_execute; }
+    uint32_t get_max_term_expansions() const noexcept { return _max_term_expansions; }
 };
 
 }
@@ -16,6 +16,19 @@ SumExecutor::execute(uint32_t)
     outputs().set_number(0, sum);
 }
 
+void
+SumExecutor::execute_batch(std::span<const uint32_t> docids, std::span<const feature_t * const> inputs_in,
+                           std::span<feature_t * const> outputs_in)
+{
+    for (size_t d = 0; d < docids.size(); ++d) {
+        feature_t sum = 0.0f;
+        for (const feature_t *input : inputs_in) {
+            sum += input[d];
+        }
+        outputs_in[0][d] = sum;
+    }
+}
+
 
 SumBlueprint::SumBlueprint() :
     Blueprint("mysum")
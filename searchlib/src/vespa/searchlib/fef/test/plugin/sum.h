@@ -13,6 +13,9 @@ class SumExecutor : public FeatureExecutor
 {
 public:
     bool isPure() override { return true; }
+    bool has_batch_execute() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t * const> inputs,
+                       std::span<feature_t * const> outputs) override;
     void execute(uint32_t docId) override;
 };
 
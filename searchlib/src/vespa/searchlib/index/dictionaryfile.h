@@ -62,6 +62,13 @@ public:
     virtual bool lookup(std::string_view word, uint64_t &wordNum,
                         PostingListOffsetAndCounts &offsetAndCounts) = 0;
 
+    /**
+     * Lookup the first word not less than the given word. Returns false
+     * if all words in the dictionary are less than the given word.
+     */
+    virtual bool lookup_lower_bound(std::string_view word, std::string &found_word, uint64_t &wordNum,
+                                    PostingListOffsetAndCounts &offsetAndCounts) = 0;
+
     /**
      * Open dictionary file for random read.
      */
@@ -0,0 +1,96 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "term_expander.h"
+#include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
+#include <vespa/vespalib/fuzzy/levenshtein_dfa.h>
+#include <vespa/vespalib/text/utf8.h>
+
+using vespalib::FuzzyMatcher;
+using vespalib::Utf8Reader;
+using vespalib::fuzzy::LevenshteinDfa;
+
+namespace search::index {
+
+namespace {
+
+// Returns the number of bytes used by the first 'num_chars' code points, or npos if 'str' is shorter.
+size_t
+prefix_bytes(std::string_view str, uint32_t num_chars)
+{
+    Utf8Reader reader(str);
+    for (uint32_t i = 0; i < num_chars; ++i) {
+        if (!reader.hasMore()) {
+            return std::string_view::npos;
+        }
+        (void) reader.getChar();
+    }
+    return reader.getPos();
+}
+
+}
+
+TermExpander::TermExpander(std::string prefix)
+    : _prefix(std::move(prefix)),
+      _exact(),
+      _dfa(),
+      _fuzzy_matcher(),
+      _successor(),
+      _exact_only(false)
+{
+}
+
+TermExpander::TermExpander(TermExpander &&) noexcept = default;
+
+TermExpander::~TermExpander() = default;
+
+TermExpander
+TermExpander::make_prefix(std::string_view prefix)
+{
+    return TermExpander(std::string(prefix));
+}
+
+TermExpander
+TermExpander::make_fuzzy(std::string_view target, uint32_t max_edits, uint32_t prefix_lock_length, bool prefix_match)
+{
+    size_t locked_bytes = prefix_bytes(target, prefix_lock_length);
+    if (locked_bytes == std::string_view::npos) {
+        // Target is shorter than the locked prefix, only an exact match is possible
+        TermExpander result{std::string(target)};
+        result._exact = target;
+        result._exact_only = true;
+        return result;
+    }
+    TermExpander result{std::string(target.substr(0, locked_bytes))};
+    if (max_edits == 1 || max_edits == 2) {
+        auto matching = prefix_match ? LevenshteinDfa::Matching::Prefix : LevenshteinDfa::Matching::FullString;
+        result._dfa = std::make_unique<LevenshteinDfa>(LevenshteinDfa::build(target.substr(locked_bytes), max_edits,
+                                                                              LevenshteinDfa::Casing::Cased,
+                                                                              LevenshteinDfa::DfaType::Table,
+                                                                              matching));
+    } else {
+        result._fuzzy_matcher = std::make_unique<FuzzyMatcher>(target, max_edits, prefix_lock_length, true, prefix_match);
+    }
+    return result;
+}
+
+TermExpander::Step
+TermExpander::check(std::string_view word)
+{
+    if (_exact_only) {
+        return (word == _exact) ? Step::MATCH : Step::DONE;
+    }
+    if (!word.starts_with(_prefix)) {
+        return Step::DONE;
+    }
+    if (_dfa) {
+        _successor = _prefix;
+        auto match = _dfa->match(word.substr(_prefix.size()), _successor);
+        return match.matches() ? Step::MATCH : Step::SEEK;
+    }
+    if (_fuzzy_matcher) {
+        return _fuzzy_matcher->isMatch(word) ? Step::MATCH : Step::NEXT;
+    }
+    return Step::MATCH;
+}
+
+}
@@ -0,0 +1,57 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace vespalib { class FuzzyMatcher; }
+namespace vespalib::fuzzy { class LevenshteinDfa; }
+
+namespace search::index {
+
+/**
+ * Expands a prefix or fuzzy query term to the matching words of a
+ * dictionary ordered by byte-wise word comparison (disk and memory index
+ * dictionaries). The caller drives the dictionary traversal:
+ *
+ *   seek to the first word >= first_word()
+ *   while (positioned at a word):
+ *       switch (check(word)):
+ *           MATCH: use word, step to next word
+ *           NEXT:  step to next word
+ *           SEEK:  seek to the first word >= seek_word()
+ *           DONE:  stop
+ *
+ * Fuzzy terms with max edit distance 1 or 2 use a LevenshteinDfa to skip
+ * words that cannot match. Other edit distances scan all words sharing
+ * the locked prefix.
+ */
+class TermExpander {
+public:
+    enum class Step { MATCH, NEXT, SEEK, DONE };
+private:
+    std::string                                     _prefix;
+    std::string                                     _exact;
+    std::unique_ptr<vespalib::fuzzy::LevenshteinDfa> _dfa;
+    std::unique_ptr<vespalib::FuzzyMatcher>         _fuzzy_matcher;
+    std::string                                     _successor;
+    bool                                            _exact_only;
+
+    TermExpander(std::string prefix);
+public:
+    TermExpander(TermExpander &&) noexcept;
+    ~TermExpander();
+
+    static TermExpander make_prefix(std::string_view prefix);
+    static TermExpander make_fuzzy(std::string_view target, uint32_t max_edits, uint32_t prefix_lock_length,
+                                   bool prefix_match);
+
+    const std::string &first_word() const noexcept { return _prefix; }
+    const std::string &seek_word() const noexcept { return _successor; }
+    Step check(std::string_view word);
+};
+
+}
@@ -7,7 +7,9 @@ namespace search::memoryindex {
 BundledFieldsContext::BundledFieldsContext(vespalib::ISequencedTaskExecutor::ExecutorId id)
     : _id(id),
       _fields(),
-      _uri_fields()
+      _uri_fields(),
+      _uri_all_field_ids(),
+      _field_shards()
 {
 }
 
@@ -26,4 +28,10 @@ BundledFieldsContext::add_uri_field(uint32_t uri_field_id, uint32_t uri_all_fiel
     _uri_all_field_ids.emplace_back(uri_all_field_id);
 }
 
+void
+BundledFieldsContext::add_field_shard(uint32_t field_id, uint32_t shard_id)
+{
+    _field_shards.emplace_back(field_id, shard_id);
+}
+
 }
@@ -9,7 +9,9 @@ namespace search::memoryindex {
 /*
  * Base class for PushContext and InvertContext, with mapping to
  * the fields and uri fields handled by this context. Fields using
- * the same thread appear in the same context.
+ * the same thread appear in the same context. For push contexts,
+ * the shards (beyond shard 0) of sharded fields are also mapped to
+ * threads, as {field id, shard id} pairs.
  */
 class BundledFieldsContext
 {
@@ -17,17 +19,20 @@ class BundledFieldsContext
     std::vector<uint32_t>                        _fields;
     std::vector<uint32_t>                        _uri_fields;
     std::vector<uint32_t>                        _uri_all_field_ids;
+    std::vector<std::pair<uint32_t, uint32_t>>   _field_shards;
 protected:
     BundledFieldsContext(vespalib::ISequencedTaskExecutor::ExecutorId id);
     ~BundledFieldsContext();
 public:
     void add_field(uint32_t field_id);
     void add_uri_field(uint32_t uri_field_id, uint32_t uri_all_field_id);
+    void add_field_shard(uint32_t field_id, uint32_t shard_id);
     void set_id(vespalib::ISequencedTaskExecutor::ExecutorId id) { _id = id; }
     vespalib::ISequencedTaskExecutor::ExecutorId get_id() const noexcept { return _id; }
     const std::vector<uint32_t>& get_fields() const noexcept { return _fields; }
     const std::vector<uint32_t>& get_uri_fields() const noexcept { return _uri_fields; }
     const std::vector<uint32_t>& get_uri_all_field_ids() const noexcept { return _uri_all_field_ids; }
+    const std::vector<std::pair<uint32_t, uint32_t>>& get_field_shards() const noexcept { return _field_shards; }
 };
 
 }
@@ -30,10 +30,15 @@ DocumentInverter::DocumentInverter(DocumentInverterContext& context)
     auto& schema = context.get_schema();
     auto& field_indexes = context.get_field_indexes();
     for (uint32_t fieldId = 0; fieldId < schema.getNumIndexFields(); ++fieldId) {
-        auto &remover(field_indexes.get_remover(fieldId));
-        auto &inserter(field_indexes.get_inserter(fieldId));
+        auto &remover(field_indexes.get_remover(fieldId, 0));
+        auto &inserter(field_indexes.get_inserter(fieldId, 0));
         auto &calculator(field_indexes.get_calculator(fieldId));
-        _inverters.push_back(std::make_unique<FieldInverter>(schema, fieldId, remover, inserter, calculator));
+        auto inverter = std::make_unique<FieldInverter>(schema, fieldId, remover, inserter, calculator);
+        uint32_t num_shards = field_indexes.get_num_shards(fieldId);
+        for (uint32_t shard_id = 1; shard_id < num_shards; ++shard_id) {
+            inverter->add_shard(field_indexes.get_remover(fieldId, shard_id), field_indexes.get_inserter(fieldId, shard_id));
+        }
+        _inverters.push_back(std::move(inverter));
     }
     auto& schema_index_fields = context.get_schema_index_fields();
     for (auto &urlField : schema_index_fields._uriFields) {
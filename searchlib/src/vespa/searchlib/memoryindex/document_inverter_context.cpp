@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_inverter_context.h"
+#include "i_field_index_collection.h"
 #include <cassert>
 #include <optional>
 
@@ -11,24 +12,36 @@ using index::SchemaIndexFields;
 
 namespace {
 
+enum class FieldKind { TEXT, URI, TEXT_SHARD };
+
+/*
+ * Shards beyond shard 0 of a sharded field are only mapped when
+ * field_indexes is given (push contexts). They are placed on the
+ * executors following the executor for the field, to let the shards
+ * be pushed in parallel.
+ */
 template <typename Context>
-void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_index_fields, ISequencedTaskExecutor& executor, std::vector<Context>& contexts)
+void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_index_fields, ISequencedTaskExecutor& executor, const IFieldIndexCollection* field_indexes, std::vector<Context>& contexts)
 {
     using ExecutorId = ISequencedTaskExecutor::ExecutorId;
-    using IdMapping = std::vector<std::tuple<ExecutorId, bool, uint32_t, uint32_t>>;
+    using IdMapping = std::vector<std::tuple<ExecutorId, FieldKind, uint32_t, uint32_t>>;
     IdMapping map;
     for (uint32_t field_id : schema_index_fields._textFields) {
         // TODO: Add bias when sharing sequenced task executor between document types
         auto& name = schema.getIndexField(field_id).getName();
         auto id = executor.getExecutorIdFromName(name);
-        map.emplace_back(id, false, field_id, 0);
+        map.emplace_back(id, FieldKind::TEXT, field_id, 0);
+        uint32_t num_shards = (field_indexes != nullptr) ? field_indexes->get_num_shards(field_id) : 1;
+        for (uint32_t shard_id = 1; shard_id < num_shards; ++shard_id) {
+            map.emplace_back(executor.get_alternate_executor_id(id, shard_id), FieldKind::TEXT_SHARD, field_id, shard_id);
+        }
     }
     uint32_t uri_field_id = 0;
     for (auto& uri_field : schema_index_fields._uriFields) {
         // TODO: Add bias when sharing sequenced task executor between document types
         auto& name = schema.getIndexField(uri_field._all).getName();
         auto id = executor.getExecutorIdFromName(name);
-        map.emplace_back(id, true, uri_field_id, uri_field._all);
+        map.emplace_back(id, FieldKind::URI, uri_field_id, uri_field._all);
         ++uri_field_id;
     }
     std::sort(map.begin(), map.end());
@@ -38,10 +51,16 @@ void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_
             contexts.emplace_back(std::get<0>(entry));
             prev_id = std::get<0>(entry);
         }
-        if (std::get<1>(entry)) {
-            contexts.back().add_uri_field(std::get<2>(entry), std::get<3>(entry));
-        } else {
+        switch (std::get<1>(entry)) {
+        case FieldKind::TEXT:
             contexts.back().add_field(std::get<2>(entry));
+            break;
+        case FieldKind::URI:
+            contexts.back().add_uri_field(std::get<2>(entry), std::get<3>(entry));
+            break;
+        case FieldKind::TEXT_SHARD:
+            contexts.back().add_field_shard(std::get<2>(entry), std::get<3>(entry));
+            break;
         }
     }
 }
@@ -54,26 +73,29 @@ void switch_to_alternate_ids(ISequencedTaskExecutor& executor, std::vector<PushC
 }
 
 class PusherMapping {
-    std::vector<std::optional<uint32_t>> _pushers;
+    // A sharded field is pushed by one pusher per shard
+    std::vector<std::vector<uint32_t>> _pushers;
 public:
     PusherMapping(size_t size);
     ~PusherMapping();
 
+    void add_mapping(uint32_t field_id, uint32_t pusher_id) {
+        assert(field_id < _pushers.size());
+        _pushers[field_id].emplace_back(pusher_id);
+    }
+
     void add_mapping(const std::vector<uint32_t>& fields, uint32_t pusher_id) {
         for (auto field_id : fields) {
-            assert(field_id < _pushers.size());
-            auto& opt_pusher = _pushers[field_id];
-            assert(!opt_pusher.has_value());
-            opt_pusher = pusher_id;
+            add_mapping(field_id, pusher_id);
         }
     }
 
     void use_mapping(const std::vector<uint32_t>& fields, std::vector<uint32_t>& pushers) {
         for (auto field_id : fields) {
             assert(field_id < _pushers.size());
-            auto& opt_pusher = _pushers[field_id];
-            assert(opt_pusher.has_value());
-            pushers.emplace_back(opt_pusher.value());
+            auto& field_pushers = _pushers[field_id];
+            assert(!field_pushers.empty());
+            pushers.insert(pushers.end(), field_pushers.begin(), field_pushers.end());
         }
     }
 };
@@ -104,6 +126,9 @@ void connect_contexts(std::vector<InvertContext>& invert_contexts,
     uint32_t pusher_id = 0;
     for (auto& push_context : push_contexts) {
         field_to_pusher.add_mapping(push_context.get_fields(), pusher_id);
+        for (auto& field_shard : push_context.get_field_shards()) {
+            field_to_pusher.add_mapping(field_shard.first, pusher_id);
+        }
         uri_field_to_pusher.add_mapping(push_context.get_uri_fields(), pusher_id);
         ++pusher_id;
     }
@@ -144,8 +169,8 @@ DocumentInverterContext::~DocumentInverterContext() = default;
 void
 DocumentInverterContext::setup_contexts()
 {
-    make_contexts(_schema, _schema_index_fields, _invert_threads, _invert_contexts);
-    make_contexts(_schema, _schema_index_fields, _push_threads, _push_contexts);
+    make_contexts(_schema, _schema_index_fields, _invert_threads, nullptr, _invert_contexts);
+    make_contexts(_schema, _schema_index_fields, _push_threads, &_field_indexes, _push_contexts);
     if (&_invert_threads == &_push_threads) {
         uint32_t bias = _schema_index_fields._textFields.size() + _schema_index_fields._uriFields.size();
         switch_to_alternate_ids(_push_threads, _push_contexts, bias);
@@ -4,8 +4,10 @@
 #include "ordered_field_index_inserter.h"
 #include "posting_iterator.h"
 #include <vespa/searchlib/bitcompression/posocccompression.h>
+#include <vespa/searchlib/index/term_expander.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/queryeval/booleanmatchiteratorwrapper.h>
+#include <vespa/searchlib/queryeval/create_blueprint_visitor_helper.h>
 #include <vespa/searchlib/queryeval/filter_wrapper.h>
 #include <vespa/searchlib/queryeval/flow_tuning.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
@@ -150,52 +152,77 @@ FieldIndex<interleaved_features>::compactFeatures()
     _featureStore.assign_generation(generation);
 }
 
+template <bool interleaved_features>
+FieldIndex<interleaved_features>::WordDumper::WordDumper(FieldIndex& field_index)
+    : _field_index(field_index),
+      _itr(field_index._dict.begin()),
+      _decoder(nullptr),
+      _features()
+{
+    _field_index._featureStore.setupForField(_field_index._fieldId, _decoder);
+    skip_words_without_documents();
+}
+
+template <bool interleaved_features>
+FieldIndex<interleaved_features>::WordDumper::~WordDumper() = default;
+
 template <bool interleaved_features>
 void
-FieldIndex<interleaved_features>::dump(search::index::FieldIndexBuilder & indexBuilder)
+FieldIndex<interleaved_features>::WordDumper::skip_words_without_documents()
 {
-    std::string_view word;
-    FeatureStore::DecodeContextCooked decoder(nullptr);
-    DocIdAndFeatures features;
-    vespalib::Array<uint32_t> wordMap(_numUniqueWords + 1, 0);
-    _featureStore.setupForField(_fieldId, decoder);
-    for (auto itr = _dict.begin(); itr.valid(); ++itr) {
-        const WordKey & wk = itr.getKey();
-        typename PostingListStore::RefType plist(itr.getData().load_relaxed());
-        word = _wordStore.getWord(wk._wordRef);
-        if (!plist.valid()) {
-            continue;
+    while (_itr.valid() && !EntryRef(_itr.getData().load_relaxed()).valid()) {
+        ++_itr;
+    }
+}
+
+template <bool interleaved_features>
+void
+FieldIndex<interleaved_features>::WordDumper::dump_word(search::index::FieldIndexBuilder& indexBuilder)
+{
+    const auto& postingListStore = _field_index._postingListStore;
+    const auto& featureStore = _field_index._featureStore;
+    typename PostingListStore::RefType plist(_itr.getData().load_relaxed());
+    indexBuilder.startWord(word());
+    uint32_t clusterSize = postingListStore.getClusterSize(plist);
+    if (clusterSize == 0) {
+        const PostingList *tree = postingListStore.getTreeEntry(plist);
+        auto pitr = tree->begin(postingListStore.getAllocator());
+        assert(pitr.valid());
+        for (; pitr.valid(); ++pitr) {
+            _features.set_doc_id(pitr.getKey());
+            const PostingListEntryType &entry(pitr.getData());
+            _features.set_num_occs(entry.get_num_occs());
+            _features.set_field_length(entry.get_field_length());
+            featureStore.setupForReadFeatures(entry.get_features_relaxed(), _decoder);
+            _decoder.readFeatures(_features);
+            indexBuilder.add_document(_features);
         }
-        indexBuilder.startWord(word);
-        uint32_t clusterSize = _postingListStore.getClusterSize(plist);
-        if (clusterSize == 0) {
-            const PostingList *tree = _postingListStore.getTreeEntry(plist);
-            auto pitr = tree->begin(_postingListStore.getAllocator());
-            assert(pitr.valid());
-            for (; pitr.valid(); ++pitr) {
-                features.set_doc_id(pitr.getKey());
-                const PostingListEntryType &entry(pitr.getData());
-                features.set_num_occs(entry.get_num_occs());
-                features.set_field_length(entry.get_field_length());
-                _featureStore.setupForReadFeatures(entry.get_features_relaxed(), decoder);
-                decoder.readFeatures(features);
-                indexBuilder.add_document(features);
-            }
-        } else {
-            const PostingListKeyDataType *kd =
-                _postingListStore.getKeyDataEntry(plist, clusterSize);
-            const PostingListKeyDataType *kde = kd + clusterSize;
-            for (; kd != kde; ++kd) {
-                features.set_doc_id(kd->_key);
-                const PostingListEntryType &entry(kd->getData());
-                features.set_num_occs(entry.get_num_occs());
-                features.set_field_length(entry.get_field_length());
-                _featureStore.setupForReadFeatures(entry.get_features_relaxed(), decoder);
-                decoder.readFeatures(features);
-                indexBuilder.add_document(features);
-            }
+    } else {
+        const PostingListKeyDataType *kd =
+            postingListStore.getKeyDataEntry(plist, clusterSize);
+        const PostingListKeyDataType *kde = kd + clusterSize;
+        for (; kd != kde; ++kd) {
+            _features.set_doc_id(kd->_key);
+            const PostingListEntryType &entry(kd->getData());
+            _features.set_num_occs(entry.get_num_occs());
+            _features.set_field_length(entry.get_field_length());
+            featureStore.setupForReadFeatures(entry.get_features_relaxed(), _decoder);
+            _decoder.readFeatures(_features);
+            indexBuilder.add_document(_features);
         }
-        indexBuilder.endWord();
+    }
+    indexBuilder.endWord();
+    ++_itr;
+    skip_words_without_documents();
+}
+
+template <bool interleaved_features>
+void
+FieldIndex<interleaved_features>::dump(search::index::FieldIndexBuilder & indexBuilder)
+{
+    WordDumper dumper(*this);
+    while (dumper.valid()) {
+        dumper.dump_word(indexBuilder);
     }
 }
 
@@ -303,6 +330,19 @@ public:
 
 }
 
+template <bool interleaved_features>
+std::unique_ptr<queryeval::SimpleLeafBlueprint>
+FieldIndex<interleaved_features>::make_posting_list_blueprint(GenerationHandler::Guard guard,
+                                                              typename PostingList::ConstIterator posting_itr,
+                                                              const queryeval::FieldSpec& field,
+                                                              uint32_t field_id,
+                                                              const std::string& term) const
+{
+    bool use_bit_vector = field.isFilter();
+    return std::make_unique<MemoryTermBlueprint<interleaved_features>>
+            (std::move(guard), std::move(posting_itr), getFeatureStore(), field, field_id, term, use_bit_vector);
+}
+
 template <bool interleaved_features>
 std::unique_ptr<queryeval::SimpleLeafBlueprint>
 FieldIndex<interleaved_features>::make_term_blueprint(const std::string& term,
@@ -311,9 +351,51 @@ FieldIndex<interleaved_features>::make_term_blueprint(const std::string& term,
 {
     auto guard = takeGenerationGuard();
     auto posting_itr = findFrozen(term);
-    bool use_bit_vector = field.isFilter();
-    return std::make_unique<MemoryTermBlueprint<interleaved_features>>
-            (std::move(guard), std::move(posting_itr), getFeatureStore(), field, field_id, term, use_bit_vector);
+    return make_posting_list_blueprint(std::move(guard), std::move(posting_itr), field, field_id, term);
+}
+
+template <bool interleaved_features>
+void
+FieldIndex<interleaved_features>::expand_term(index::TermExpander& expander, uint32_t max_expansions,
+                                              ExpandedWords& words) const
+{
+    using TermExpander = index::TermExpander;
+    auto itr = _dict.getFrozenView().lowerBound(WordKey(EntryRef()), KeyComp(_wordStore, expander.first_word()));
+    while (itr.valid() && words.size() < max_expansions) {
+        const char* word = _wordStore.getWord(itr.getKey()._wordRef);
+        auto step = expander.check(word);
+        if (step == TermExpander::Step::DONE) {
+            break;
+        }
+        if (step == TermExpander::Step::SEEK) {
+            itr.seek(WordKey(EntryRef()), KeyComp(_wordStore, expander.seek_word()));
+            continue;
+        }
+        if (step == TermExpander::Step::MATCH) {
+            EntryRef posting_ref = itr.getData().load_acquire();
+            if (posting_ref.valid()) {
+                words.emplace_back(word, _postingListStore.beginFrozen(posting_ref));
+            }
+        }
+        ++itr;
+    }
+}
+
+template <bool interleaved_features>
+std::unique_ptr<queryeval::Blueprint>
+FieldIndex<interleaved_features>::make_expanded_term_blueprint(index::TermExpander& expander,
+                                                               const queryeval::FieldSpec& field,
+                                                               uint32_t field_id,
+                                                               uint32_t max_expansions)
+{
+    auto guard = takeGenerationGuard();
+    ExpandedWords words;
+    expand_term(expander, max_expansions, words);
+    return queryeval::CreateBlueprintVisitorHelper::make_expanded_term_blueprint(field, words.size(),
+            [this, &guard, &words, field_id](const queryeval::FieldSpec& word_field, size_t idx) {
+        return make_posting_list_blueprint(GenerationHandler::Guard(guard), words[idx].second, word_field, field_id,
+                                           words[idx].first);
+    });
 }
 
 template class FieldIndex<false>;
@@ -43,6 +43,27 @@ public:
                                                std::less<uint32_t>,
                                                vespalib::btree::BTreeDefaultTraits>;
     using PostingListKeyDataType = typename PostingListStore::KeyDataType;
+    using ExpandedWords = std::vector<std::pair<std::string, typename PostingList::ConstIterator>>;
+
+    /**
+     * Iterates the dictionary in word order, dumping the posting list for one word at a time.
+     * Words without documents are skipped. Used when merging the shards of a sharded field index.
+     */
+    class WordDumper {
+        FieldIndex&                       _field_index;
+        DictionaryTree::Iterator          _itr;
+        FeatureStore::DecodeContextCooked _decoder;
+        index::DocIdAndFeatures           _features;
+
+        void skip_words_without_documents();
+    public:
+        explicit WordDumper(FieldIndex& field_index);
+        ~WordDumper();
+        bool valid() const noexcept { return _itr.valid(); }
+        const char* word() const { return _field_index._wordStore.getWord(_itr.getKey()._wordRef); }
+        // Dump the current word to the builder and step to the next word.
+        void dump_word(index::FieldIndexBuilder& builder);
+    };
 
 private:
     PostingListStore _postingListStore;
@@ -98,6 +119,23 @@ public:
     std::unique_ptr<queryeval::SimpleLeafBlueprint> make_term_blueprint(const std::string& term,
                                                                         const queryeval::FieldSpec& field,
                                                                         uint32_t field_id) override;
+
+    std::unique_ptr<queryeval::Blueprint> make_expanded_term_blueprint(index::TermExpander& expander,
+                                                                       const queryeval::FieldSpec& field,
+                                                                       uint32_t field_id,
+                                                                       uint32_t max_expansions) override;
+
+    /**
+     * Collect at most max_expansions words (with frozen posting list iterators) matching the expander.
+     * The caller must hold a generation guard while the iterators are in use.
+     */
+    void expand_term(index::TermExpander& expander, uint32_t max_expansions, ExpandedWords& words) const;
+
+    std::unique_ptr<queryeval::SimpleLeafBlueprint> make_posting_list_blueprint(GenerationHandler::Guard guard,
+                                                                                typename PostingList::ConstIterator posting_itr,
+                                                                                const queryeval::FieldSpec& field,
+                                                                                uint32_t field_id,
+                                                                                const std::string& term) const;
 };
 
 }
@@ -24,7 +24,7 @@ class IOrderedFieldIndexInserter;
  *
  * Contains all components that are not dependent of the posting list format.
  */
-class FieldIndexBase : public IFieldIndex {
+class FieldIndexBase : public IFieldIndex, public IFieldIndexShard {
 public:
     /**
      * Class representing a word used as key in the dictionary.
@@ -109,6 +109,8 @@ public:
     const WordStore& getWordStore() const override { return _wordStore; }
     IOrderedFieldIndexInserter& getInserter() override { return *_inserter; }
     index::FieldLengthCalculator& get_calculator() override { return _calculator; }
+    uint32_t get_num_shards() const noexcept override { return 1; }
+    IFieldIndexShard& get_shard(uint32_t) override { return *this; }
 
     GenerationHandler::Guard takeGenerationGuard() override {
         return _generationHandler.takeGuard();
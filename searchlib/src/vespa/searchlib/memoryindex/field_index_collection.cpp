@@ -3,6 +3,7 @@
 #include "field_index_collection.h"
 #include "field_inverter.h"
 #include "ordered_field_index_inserter.h"
+#include "sharded_field_index.h"
 #include <vespa/searchlib/bitcompression/posocccompression.h>
 #include <vespa/searchlib/index/i_field_length_inspector.h>
 #include <vespa/searchcommon/common/schema.h>
@@ -26,7 +27,18 @@ FieldIndexCollection::FieldIndexCollection(const Schema& schema, const IFieldLen
 {
     for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
         const auto& field = schema.getIndexField(fieldId);
-        if (field.use_interleaved_features()) {
+        uint32_t num_shards = field.get_memory_index_shards();
+        if (num_shards > 1) {
+            if (field.use_interleaved_features()) {
+                _fieldIndexes.push_back(std::make_unique<ShardedFieldIndex<true>>(schema, fieldId,
+                                                                                  inspector.get_field_length_info(field.getName()),
+                                                                                  num_shards));
+            } else {
+                _fieldIndexes.push_back(std::make_unique<ShardedFieldIndex<false>>(schema, fieldId,
+                                                                                   inspector.get_field_length_info(field.getName()),
+                                                                                   num_shards));
+            }
+        } else if (field.use_interleaved_features()) {
             _fieldIndexes.push_back(std::make_unique<FieldIndex<true>>(schema, fieldId,
                                                                        inspector.get_field_length_info(field.getName())));
         } else {
@@ -74,16 +86,22 @@ FieldIndexCollection::get_stats(const index::Schema& schema) const
     return stats;
 }
 
+uint32_t
+FieldIndexCollection::get_num_shards(uint32_t field_id) const
+{
+    return _fieldIndexes[field_id]->get_num_shards();
+}
+
 FieldIndexRemover &
-FieldIndexCollection::get_remover(uint32_t field_id)
+FieldIndexCollection::get_remover(uint32_t field_id, uint32_t shard_id)
 {
-    return _fieldIndexes[field_id]->getDocumentRemover();
+    return _fieldIndexes[field_id]->get_shard(shard_id).getDocumentRemover();
 }
 
 IOrderedFieldIndexInserter &
-FieldIndexCollection::get_inserter(uint32_t field_id)
+FieldIndexCollection::get_inserter(uint32_t field_id, uint32_t shard_id)
 {
-    return _fieldIndexes[field_id]->getInserter();
+    return _fieldIndexes[field_id]->get_shard(shard_id).getInserter();
 }
 
 index::FieldLengthCalculator &
@@ -57,8 +57,9 @@ public:
 
     uint32_t getNumFields() const { return _numFields; }
 
-    FieldIndexRemover &get_remover(uint32_t field_id) override;
-    IOrderedFieldIndexInserter &get_inserter(uint32_t field_id) override;
+    uint32_t get_num_shards(uint32_t field_id) const override;
+    FieldIndexRemover &get_remover(uint32_t field_id, uint32_t shard_id) override;
+    IOrderedFieldIndexInserter &get_inserter(uint32_t field_id, uint32_t shard_id) override;
     index::FieldLengthCalculator &get_calculator(uint32_t field_id) override;
 };
 
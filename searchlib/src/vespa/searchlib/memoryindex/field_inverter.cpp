@@ -2,6 +2,7 @@
 
 #include "field_inverter.h"
 #include "ordered_field_index_inserter.h"
+#include "word_shard.h"
 #include <vespa/document/annotation/annotation.h>
 #include <vespa/document/annotation/span.h>
 #include <vespa/document/fieldvalue/arrayfieldvalue.h>
@@ -55,8 +56,7 @@ FieldInverter::processAnnotations(const StringFieldValue &value, const Document&
     for (; it != ite; ) {
         auto it_begin = it;
         for (; it != ite && it->span == it_begin->span; ++it) {
-            uint32_t wordRef = saveWord(it->word);
-            add(wordRef);
+            add_word_to_shard(it->word);
         }
         stepWordPos();
     }
@@ -128,16 +128,28 @@ void
 FieldInverter::startElement(int32_t weight)
 {
     _elems.push_back(ElemInfo(weight)); // Fill in length later
+    for (auto &shard : _other_shards) {
+        shard->startElement(weight);
+    }
 }
 
 void
-FieldInverter::endElement()
+FieldInverter::finish_element(uint32_t len)
 {
-    _elems.back().setLen(_wpos);
+    _elems.back().setLen(len);
     _wpos = 0;
     ++_elem;
 }
 
+void
+FieldInverter::endElement()
+{
+    for (auto &shard : _other_shards) {
+        shard->finish_element(_wpos);
+    }
+    finish_element(_wpos);
+}
+
 uint32_t
 FieldInverter::saveWord(std::string_view word)
 {
@@ -159,6 +171,14 @@ FieldInverter::saveWord(std::string_view word)
     return wordRef;
 }
 
+void
+FieldInverter::add_word_to_shard(std::string_view word)
+{
+    FieldInverter &shard = get_shard(get_word_shard(word, get_num_shards()));
+    uint32_t wordRef = shard.saveWord(word);
+    shard.add(wordRef, _wpos);
+}
+
 void
 FieldInverter::remove(const std::string_view word, uint32_t docId)
 {
@@ -166,8 +186,8 @@ FieldInverter::remove(const std::string_view word, uint32_t docId)
     _positions.emplace_back(wordRef, docId);
 }
 
-void
-FieldInverter::endDoc()
+uint32_t
+FieldInverter::finish_doc()
 {
     uint32_t field_length = 0;
     if (_elem > 0) {
@@ -182,11 +202,21 @@ FieldInverter::endDoc()
             ++itr;
         }
     }
-    _calculator.add_field_length(field_length, _elem);
     uint32_t newPosSize = static_cast<uint32_t>(_positions.size());
     _pendingDocs.insert({ _docId, { _oldPosSize, newPosSize - _oldPosSize } });
     _docId = 0;
     _oldPosSize = newPosSize;
+    return field_length;
+}
+
+void
+FieldInverter::endDoc()
+{
+    for (auto &shard : _other_shards) {
+        shard->finish_doc();
+    }
+    uint32_t field_length = finish_doc();
+    _calculator.add_field_length(field_length, _elem);
 }
 
 void
@@ -194,8 +224,7 @@ FieldInverter::addWord(std::string_view word, const document::Document& doc)
 {
     word = _token_extractor.sanitize_word(word, &doc);
     if (!word.empty()) {
-        uint32_t wordRef = saveWord(word);
-        add(wordRef);
+        add_word_to_shard(word);
         stepWordPos();
     }
 }
@@ -261,12 +290,20 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
       _removeDocs(),
       _remover(remover),
       _inserter(inserter),
-      _calculator(calculator)
+      _calculator(calculator),
+      _other_shards()
 {
 }
 
 FieldInverter::~FieldInverter() = default;
 
+void
+FieldInverter::add_shard(FieldIndexRemover &remover, IOrderedFieldIndexInserter &inserter)
+{
+    // Field lengths are only tracked by the calculator for shard 0
+    _other_shards.emplace_back(std::make_unique<FieldInverter>(_schema, _fieldId, remover, inserter, _calculator));
+}
+
 void
 FieldInverter::abortPendingDoc(uint32_t docId)
 {
@@ -347,6 +384,9 @@ FieldInverter::startDoc(uint32_t docId) {
     _docId = docId;
     _elem = 0;
     _wpos = 0;
+    for (auto &shard : _other_shards) {
+        shard->startDoc(docId);
+    }
 }
 
 void
@@ -9,6 +9,8 @@
 #include <vespa/vespalib/stllike/allocator.h>
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <limits>
+#include <memory>
+#include <vector>
 
 namespace search::index {
     class FieldLengthCalculator;
@@ -193,6 +195,9 @@ private:
     IOrderedFieldIndexInserter       &_inserter;
     index::FieldLengthCalculator     &_calculator;
 
+    // Inverters for shard 1 and upwards when the field index is sharded, this inverter handling shard 0.
+    std::vector<std::unique_ptr<FieldInverter>> _other_shards;
+
     void invertNormalDocTextField(const document::FieldValue &val, const document::Document& doc);
 
 public:
@@ -238,10 +243,22 @@ private:
     /**
      * Add a word reference to posting list (but don't step word pos).
      */
-    void add(uint32_t wordRef) {
-        _positions.emplace_back(wordRef, _docId, _elem, _wpos, _elems.size() - 1);
+    void add(uint32_t wordRef, uint32_t wordPos) {
+        _positions.emplace_back(wordRef, _docId, _elem, wordPos, _elems.size() - 1);
     }
 
+    /**
+     * Save the given word and add it to the posting list in the shard owning the word.
+     */
+    void add_word_to_shard(std::string_view word);
+
+    void finish_element(uint32_t len);
+
+    /**
+     * Finish the current document in this shard, returning the field length.
+     */
+    uint32_t finish_doc();
+
     void stepWordPos() { ++_wpos; }
 
 public:
@@ -291,7 +308,18 @@ public:
     ~FieldInverter() override;
 
     /**
-     * Apply pending removes using the given remover.
+     * Add an inverter for the next shard of a sharded field index. Words are routed to the
+     * shard owning them (see get_word_shard()) when inverting, while removes and pushes are
+     * handled separately for each shard, allowing the shards to be pushed by separate threads.
+     */
+    void add_shard(FieldIndexRemover &remover, IOrderedFieldIndexInserter &inserter);
+    uint32_t get_num_shards() const noexcept { return 1 + _other_shards.size(); }
+    FieldInverter &get_shard(uint32_t shard_id) noexcept {
+        return (shard_id == 0) ? *this : *_other_shards[shard_id - 1];
+    }
+
+    /**
+     * Apply pending removes for this shard using the given remover.
      *
      * The remover is tracking all {word, docId} tuples that should removed,
      * and forwards this to the remove() function in this class (via IFieldIndexRemoveListener interface).
@@ -299,7 +327,7 @@ public:
     void applyRemoves();
 
     /**
-     * Push the current batch of inverted documents to the FieldIndex using the given inserter.
+     * Push the current batch of inverted documents for this shard to the FieldIndex using the given inserter.
      */
     void pushDocuments();
 
@@ -316,6 +344,9 @@ public:
     void removeDocument(uint32_t docId) {
         abortPendingDoc(docId);
         _removeDocs.push_back(docId);
+        for (auto &shard : _other_shards) {
+            shard->removeDocument(docId);
+        }
     }
 
     void startDoc(uint32_t docId);
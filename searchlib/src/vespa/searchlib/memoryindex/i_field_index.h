@@ -2,26 +2,23 @@
 
 #pragma once
 
-#include <vespa/vespalib/util/generationhandler.h>
+#include "i_field_index_shard.h"
 #include <vespa/vespalib/util/memoryusage.h>
 #include <memory>
 
 namespace search::queryeval {
+    class Blueprint;
     struct SimpleLeafBlueprint;
     class FieldSpec;
 }
 namespace search::index {
 class FieldLengthCalculator;
 class FieldIndexBuilder;
+class TermExpander;
 }
 
 namespace search::memoryindex {
 
-class FeatureStore;
-class FieldIndexRemover;
-class IOrderedFieldIndexInserter;
-class WordStore;
-
 /**
  * Interface for a memory index for a single field as seen from the FieldIndexCollection.
  */
@@ -31,20 +28,31 @@ public:
 
     virtual uint64_t getNumUniqueWords() const = 0;
     virtual vespalib::MemoryUsage getMemoryUsage() const = 0;
-    virtual const FeatureStore& getFeatureStore() const = 0;
-    virtual const WordStore& getWordStore() const = 0;
-    virtual IOrderedFieldIndexInserter& getInserter() = 0;
-    virtual FieldIndexRemover& getDocumentRemover() = 0;
     virtual index::FieldLengthCalculator& get_calculator() = 0;
     virtual void compactFeatures() = 0;
     virtual void dump(search::index::FieldIndexBuilder& builder) = 0;
 
+    /**
+     * The field index can be split into shards by word hash (see get_word_shard()), where each
+     * shard has its own stores, inserter and remover and can be updated by a separate thread.
+     * An unsharded field index is its own single shard.
+     */
+    virtual uint32_t get_num_shards() const noexcept = 0;
+    virtual IFieldIndexShard& get_shard(uint32_t shard_id) = 0;
+
     virtual std::unique_ptr<queryeval::SimpleLeafBlueprint> make_term_blueprint(const std::string& term,
                                                                                 const queryeval::FieldSpec& field,
                                                                                 uint32_t field_id) = 0;
 
-    // Should only be directly used by unit tests
-    virtual vespalib::GenerationHandler::Guard takeGenerationGuard() = 0;
+    /**
+     * Make blueprint for a term expanded to the matching words in the dictionary, using at most
+     * max_expansions words.
+     */
+    virtual std::unique_ptr<queryeval::Blueprint> make_expanded_term_blueprint(index::TermExpander& expander,
+                                                                               const queryeval::FieldSpec& field,
+                                                                               uint32_t field_id,
+                                                                               uint32_t max_expansions) = 0;
+
     virtual void commit() = 0;
 };
 
@@ -17,8 +17,9 @@ class IOrderedFieldIndexInserter;
  */
 class IFieldIndexCollection {
 public:
-    virtual FieldIndexRemover &get_remover(uint32_t field_id) = 0;
-    virtual IOrderedFieldIndexInserter &get_inserter(uint32_t field_id) = 0;
+    virtual uint32_t get_num_shards(uint32_t field_id) const = 0;
+    virtual FieldIndexRemover &get_remover(uint32_t field_id, uint32_t shard_id) = 0;
+    virtual IOrderedFieldIndexInserter &get_inserter(uint32_t field_id, uint32_t shard_id) = 0;
     virtual index::FieldLengthCalculator &get_calculator(uint32_t field_id) = 0;
     virtual ~IFieldIndexCollection() = default;
 };
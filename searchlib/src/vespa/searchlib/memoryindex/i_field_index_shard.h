@@ -0,0 +1,33 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/generationhandler.h>
+
+namespace search::memoryindex {
+
+class FeatureStore;
+class FieldIndexRemover;
+class IOrderedFieldIndexInserter;
+class WordStore;
+
+/**
+ * Interface for a single shard of a memory index for a single field.
+ *
+ * Each shard has its own stores, inserter and remover, and is updated by a single thread.
+ * An unsharded field index is its own single shard (see IFieldIndex::get_shard()).
+ */
+class IFieldIndexShard {
+public:
+    virtual ~IFieldIndexShard() = default;
+
+    virtual const FeatureStore& getFeatureStore() const = 0;
+    virtual const WordStore& getWordStore() const = 0;
+    virtual IOrderedFieldIndexInserter& getInserter() = 0;
+    virtual FieldIndexRemover& getDocumentRemover() = 0;
+
+    // Should only be directly used by unit tests
+    virtual vespalib::GenerationHandler::Guard takeGenerationGuard() = 0;
+};
+
+}
@@ -9,8 +9,11 @@
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/searchlib/index/field_length_calculator.h>
 #include <vespa/searchlib/index/schemautil.h>
+#include <vespa/searchlib/index/term_expander.h>
 #include <vespa/searchlib/queryeval/create_blueprint_visitor_helper.h>
+#include <vespa/searchlib/queryeval/create_blueprint_params.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/searchlib/queryeval/irequestcontext.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
 #include <vespa/vespalib/btree/btreenodeallocator.hpp>
 #include <vespa/vespalib/data/slime/cursor.h>
@@ -29,6 +32,7 @@ using index::IFieldLengthInspector;
 using index::IndexBuilder;
 using index::Schema;
 using index::SchemaUtil;
+using index::TermExpander;
 using query::FuzzyTerm;
 using query::LocationTerm;
 using query::NearestNeighborTerm;
@@ -162,16 +166,27 @@ public:
         setResult(fieldIndex->make_term_blueprint(termStr, _field, _fieldId));
     }
 
+    void visit_expanded_term(TermExpander expander) {
+        uint32_t max_expansions = getRequestContext().get_create_blueprint_params().max_term_expansions;
+        IFieldIndex* fieldIndex = _fieldIndexes.getFieldIndex(_fieldId);
+        setResult(fieldIndex->make_expanded_term_blueprint(expander, _field, _fieldId, max_expansions));
+    }
+
     void not_supported(Node &) {}
 
     void visit(LocationTerm &n)  override { visitTerm(n); }
-    void visit(PrefixTerm &n)    override { visitTerm(n); }
+    void visit(PrefixTerm &n)    override {
+        visit_expanded_term(TermExpander::make_prefix(queryeval::termAsString(n)));
+    }
     void visit(RangeTerm &n)     override { visitTerm(n); }
     void visit(StringTerm &n)    override { visitTerm(n); }
     void visit(SubstringTerm &n) override { visitTerm(n); }
     void visit(SuffixTerm &n)    override { visitTerm(n); }
     void visit(RegExpTerm &n)    override { visitTerm(n); }
-    void visit(FuzzyTerm &n)    override { visitTerm(n); }
+    void visit(FuzzyTerm &n)    override {
+        visit_expanded_term(TermExpander::make_fuzzy(queryeval::termAsString(n), n.max_edit_distance(),
+                                                     n.prefix_lock_length(), n.prefix_match()));
+    }
     void visit(PredicateQuery &n) override { not_supported(n); }
     void visit(NearestNeighborTerm &n) override { not_supported(n); }
 
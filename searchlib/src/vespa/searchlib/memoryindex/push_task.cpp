@@ -36,6 +36,9 @@ PushTask::run()
     for (auto field_id : _context.get_fields()) {
         push_inverter(*_inverters[field_id]);
     }
+    for (auto& [field_id, shard_id] : _context.get_field_shards()) {
+        push_inverter(_inverters[field_id]->get_shard(shard_id));
+    }
     for (auto uri_field_id : _context.get_uri_fields()) {
         push_inverter(*_uri_inverters[uri_field_id]);
     }
@@ -0,0 +1,145 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sharded_field_index.h"
+#include <vespa/searchlib/queryeval/blueprint.h>
+#include <vespa/searchlib/queryeval/create_blueprint_visitor_helper.h>
+#include <algorithm>
+#include <cstring>
+
+namespace search::memoryindex {
+
+using vespalib::GenerationHandler;
+
+template <bool interleaved_features>
+ShardedFieldIndex<interleaved_features>::ShardedFieldIndex(const index::Schema& schema, uint32_t field_id,
+                                                           const index::FieldLengthInfo& info,
+                                                           uint32_t num_shards)
+    : _shards()
+{
+    num_shards = std::max(num_shards, 1u);
+    _shards.reserve(num_shards);
+    for (uint32_t shard_id = 0; shard_id < num_shards; ++shard_id) {
+        _shards.emplace_back(std::make_unique<Shard>(schema, field_id, info));
+    }
+}
+
+template <bool interleaved_features>
+ShardedFieldIndex<interleaved_features>::~ShardedFieldIndex() = default;
+
+template <bool interleaved_features>
+uint64_t
+ShardedFieldIndex<interleaved_features>::getNumUniqueWords() const
+{
+    uint64_t num_unique_words = 0;
+    for (auto& shard : _shards) {
+        num_unique_words += shard->getNumUniqueWords();
+    }
+    return num_unique_words;
+}
+
+template <bool interleaved_features>
+vespalib::MemoryUsage
+ShardedFieldIndex<interleaved_features>::getMemoryUsage() const
+{
+    vespalib::MemoryUsage usage;
+    for (auto& shard : _shards) {
+        usage.merge(shard->getMemoryUsage());
+    }
+    return usage;
+}
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::compactFeatures()
+{
+    for (auto& shard : _shards) {
+        shard->compactFeatures();
+    }
+}
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::commit()
+{
+    for (auto& shard : _shards) {
+        shard->commit();
+    }
+}
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::dump(search::index::FieldIndexBuilder& builder)
+{
+    // Words are disjoint between shards, so a k-way merge on the word gives the complete dictionary in order.
+    std::vector<std::unique_ptr<typename Shard::WordDumper>> dumpers;
+    dumpers.reserve(_shards.size());
+    for (auto& shard : _shards) {
+        dumpers.emplace_back(std::make_unique<typename Shard::WordDumper>(*shard));
+    }
+    for (;;) {
+        typename Shard::WordDumper* next = nullptr;
+        for (auto& dumper : dumpers) {
+            if (dumper->valid() && (next == nullptr || strcmp(dumper->word(), next->word()) < 0)) {
+                next = dumper.get();
+            }
+        }
+        if (next == nullptr) {
+            break;
+        }
+        next->dump_word(builder);
+    }
+}
+
+template <bool interleaved_features>
+std::unique_ptr<queryeval::SimpleLeafBlueprint>
+ShardedFieldIndex<interleaved_features>::make_term_blueprint(const std::string& term,
+                                                             const queryeval::FieldSpec& field,
+                                                             uint32_t field_id)
+{
+    return get_word_shard_index(term).make_term_blueprint(term, field, field_id);
+}
+
+template <bool interleaved_features>
+std::unique_ptr<queryeval::Blueprint>
+ShardedFieldIndex<interleaved_features>::make_expanded_term_blueprint(index::TermExpander& expander,
+                                                                      const queryeval::FieldSpec& field,
+                                                                      uint32_t field_id,
+                                                                      uint32_t max_expansions)
+{
+    struct ExpandedWord {
+        uint32_t shard_id;
+        uint32_t idx;
+    };
+    std::vector<GenerationHandler::Guard> guards;
+    std::vector<typename Shard::ExpandedWords> shard_words(_shards.size());
+    std::vector<ExpandedWord> words;
+    guards.reserve(_shards.size());
+    for (uint32_t shard_id = 0; shard_id < _shards.size(); ++shard_id) {
+        guards.emplace_back(_shards[shard_id]->takeGenerationGuard());
+        _shards[shard_id]->expand_term(expander, max_expansions, shard_words[shard_id]);
+        for (uint32_t idx = 0; idx < shard_words[shard_id].size(); ++idx) {
+            words.push_back({shard_id, idx});
+        }
+    }
+    auto word = [&shard_words](const ExpandedWord& w) -> const std::string& {
+        return shard_words[w.shard_id][w.idx].first;
+    };
+    std::sort(words.begin(), words.end(),
+              [&word](const ExpandedWord& lhs, const ExpandedWord& rhs) { return word(lhs) < word(rhs); });
+    if (words.size() > max_expansions) {
+        words.resize(max_expansions);
+    }
+    return queryeval::CreateBlueprintVisitorHelper::make_expanded_term_blueprint(field, words.size(),
+            [this, &guards, &shard_words, &words, field_id](const queryeval::FieldSpec& word_field, size_t idx) {
+        const auto& w = words[idx];
+        const auto& expanded = shard_words[w.shard_id][w.idx];
+        return _shards[w.shard_id]->make_posting_list_blueprint(GenerationHandler::Guard(guards[w.shard_id]),
+                                                                expanded.second, word_field, field_id,
+                                                                expanded.first);
+    });
+}
+
+template class ShardedFieldIndex<false>;
+template class ShardedFieldIndex<true>;
+
+}
@@ -0,0 +1,61 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "field_index.h"
+#include "word_shard.h"
+#include <vector>
+
+namespace search::memoryindex {
+
+/**
+ * Memory index for a single field split into a set of FieldIndex shards by word hash.
+ *
+ * Each word is owned by exactly one shard (see get_word_shard()), and each shard has its own
+ * dictionary, posting lists, feature store, inserter and remover. This lets separate push threads
+ * update the shards of a single field concurrently, removing the single writer thread per field
+ * as the bottleneck when feeding documents with large text fields.
+ *
+ * Term lookups are routed to the shard owning the term, while term expansion and dumping
+ * merge the (disjoint) shard dictionaries in word order.
+ *
+ * The stores, inserter and remover only exist per shard (see get_shard()).
+ *
+ * Field lengths are tracked by the calculator of the first shard only.
+ */
+template <bool interleaved_features>
+class ShardedFieldIndex : public IFieldIndex {
+public:
+    using Shard = FieldIndex<interleaved_features>;
+private:
+    std::vector<std::unique_ptr<Shard>> _shards;
+
+    Shard& get_word_shard_index(std::string_view word) const {
+        return *_shards[get_word_shard(word, _shards.size())];
+    }
+public:
+    ShardedFieldIndex(const index::Schema& schema, uint32_t field_id, const index::FieldLengthInfo& info,
+                      uint32_t num_shards);
+    ~ShardedFieldIndex() override;
+
+    uint64_t getNumUniqueWords() const override;
+    vespalib::MemoryUsage getMemoryUsage() const override;
+    index::FieldLengthCalculator& get_calculator() override { return _shards[0]->get_calculator(); }
+    void compactFeatures() override;
+    void dump(search::index::FieldIndexBuilder& builder) override;
+    uint32_t get_num_shards() const noexcept override { return _shards.size(); }
+    Shard& get_shard(uint32_t shard_id) override { return *_shards[shard_id]; }
+
+    std::unique_ptr<queryeval::SimpleLeafBlueprint> make_term_blueprint(const std::string& term,
+                                                                        const queryeval::FieldSpec& field,
+                                                                        uint32_t field_id) override;
+
+    std::unique_ptr<queryeval::Blueprint> make_expanded_term_blueprint(index::TermExpander& expander,
+                                                                       const queryeval::FieldSpec& field,
+                                                                       uint32_t field_id,
+                                                                       uint32_t max_expansions) override;
+
+    void commit() override;
+};
+
+}
@@ -42,6 +42,24 @@ lowercaseToken(std::string &dest, const char *src, size_t srcSize)
     return dest.size();
 }
 
+// Uri fields push all shards of a sharded sub field from the same thread.
+
+void
+apply_removes(FieldInverter& inverter)
+{
+    for (uint32_t shard_id = 0; shard_id < inverter.get_num_shards(); ++shard_id) {
+        inverter.get_shard(shard_id).applyRemoves();
+    }
+}
+
+void
+push_documents(FieldInverter& inverter)
+{
+    for (uint32_t shard_id = 0; shard_id < inverter.get_num_shards(); ++shard_id) {
+        inverter.get_shard(shard_id).pushDocuments();
+    }
+}
+
 }
 
 using document::ArrayFieldValue;
@@ -276,27 +294,27 @@ UrlFieldInverter::removeDocument(uint32_t docId)
 void
 UrlFieldInverter::applyRemoves()
 {
-    _all->applyRemoves();
-    _scheme->applyRemoves();
-    _host->applyRemoves();
-    _port->applyRemoves();
-    _path->applyRemoves();
-    _query->applyRemoves();
-    _fragment->applyRemoves();
-    _hostname->applyRemoves();
+    apply_removes(*_all);
+    apply_removes(*_scheme);
+    apply_removes(*_host);
+    apply_removes(*_port);
+    apply_removes(*_path);
+    apply_removes(*_query);
+    apply_removes(*_fragment);
+    apply_removes(*_hostname);
 }
 
 void
 UrlFieldInverter::pushDocuments()
 {
-    _all->pushDocuments();
-    _scheme->pushDocuments();
-    _host->pushDocuments();
-    _port->pushDocuments();
-    _path->pushDocuments();
-    _query->pushDocuments();
-    _fragment->pushDocuments();
-    _hostname->pushDocuments();
+    push_documents(*_all);
+    push_documents(*_scheme);
+    push_documents(*_host);
+    push_documents(*_port);
+    push_documents(*_path);
+    push_documents(*_query);
+    push_documents(*_fragment);
+    push_documents(*_hostname);
 }
 
 UrlFieldInverter::UrlFieldInverter(index::schema::CollectionType collectionType,
@@ -0,0 +1,26 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <cstdint>
+#include <string_view>
+
+namespace search::memoryindex {
+
+/**
+ * Returns the shard owning the given word when the memory index for a field is
+ * split into num_shards shards. Used both when pushing inverted documents and
+ * when looking up words, so the mapping must be stable for the lifetime of a
+ * memory index.
+ */
+inline uint32_t
+get_word_shard(std::string_view word, uint32_t num_shards) noexcept
+{
+    if (num_shards <= 1) {
+        return 0;
+    }
+    return vespalib::hashValue(word.data(), word.size()) % num_shards;
+}
+
+}
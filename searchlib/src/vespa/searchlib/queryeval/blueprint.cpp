@@ -3,7 +3,9 @@
 #include "blueprint.h"
 #include "andnotsearch.h"
 #include "andsearch.h"
+#include "cost_sampling_iterator.h"
 #include "emptysearch.h"
+#include "field_cost_model.h"
 #include "field_spec.hpp"
 #include "flow_tuning.h"
 #include "full_search.h"
@@ -52,6 +54,20 @@ void maybe_eliminate_self(Blueprint* &self, Blueprint::UP replacement) {
 
 thread_local Blueprint::Options Blueprint::_opts;
 
+void
+Blueprint::apply_field_cost_factors(const FieldCostFactors &factors) noexcept
+{
+    if (asLeaf() == nullptr) {
+        return;
+    }
+    const State &state = getState();
+    if (state.numFields() == 1) {
+        double factor = factors.cost_factor(state.field(0).getFieldId());
+        _flow_stats.cost *= factor;
+        _flow_stats.strict_cost *= factor;
+    }
+}
+
 Blueprint::HitEstimate
 Blueprint::max(const std::vector<HitEstimate> &data)
 {
@@ -826,7 +842,14 @@ LeafBlueprint::createSearch(fef::MatchData &md) const
     for (size_t i = 0; i < state.numFields(); ++i) {
         tfmda.add(state.field(i).resolve(md));
     }
-    return createLeafSearch(tfmda);
+    auto search = createLeafSearch(tfmda);
+    if (auto *model = CostSamplingIterator::bound_model(); model && (state.numFields() == 1)) [[unlikely]] {
+        // compare with the estimate before it was scaled by the model, otherwise the model learns from itself
+        auto flow_stats = calculate_flow_stats(get_docid_limit());
+        return std::make_unique<CostSamplingIterator>(std::move(search), *model, state.field(0).getFieldId(),
+                                                      strict(), flow_stats.cost, flow_stats.strict_cost);
+    }
+    return search;
 }
 
 bool
@@ -37,6 +37,7 @@ class AndNotBlueprint;
 class OrBlueprint;
 class EmptyBlueprint;
 class AlwaysTrueBlueprint;
+class FieldCostFactors;
 
 /**
  * A Blueprint is an intermediate representation of a search. More
@@ -62,11 +63,13 @@ public:
         bool _sort_by_cost;
         bool _allow_force_strict;
         bool _keep_order;
+        const FieldCostFactors *_field_cost_factors;
     public:
         constexpr Options() noexcept
           : _sort_by_cost(false),
             _allow_force_strict(false),
-            _keep_order(false) {}
+            _keep_order(false),
+            _field_cost_factors(nullptr) {}
         constexpr bool sort_by_cost() const noexcept { return _sort_by_cost; }
         constexpr Options &sort_by_cost(bool value) noexcept {
             _sort_by_cost = value;
@@ -82,6 +85,11 @@ public:
             _keep_order = value;
             return *this;
         }
+        constexpr const FieldCostFactors *field_cost_factors() const noexcept { return _field_cost_factors; }
+        constexpr Options &field_cost_factors(const FieldCostFactors *value) noexcept {
+            _field_cost_factors = value;
+            return *this;
+        }
     };
 
 private:
@@ -113,6 +121,7 @@ public:
     static bool opt_sort_by_cost() noexcept { return thread_opts().sort_by_cost(); }
     static bool opt_allow_force_strict() noexcept { return thread_opts().allow_force_strict(); }
     static bool opt_keep_order() noexcept { return thread_opts().keep_order(); }
+    static const FieldCostFactors *opt_field_cost_factors() noexcept { return thread_opts().field_cost_factors(); }
 
     struct HitEstimate {
         uint32_t estHits;
@@ -381,7 +390,12 @@ public:
     virtual FlowStats calculate_flow_stats(uint32_t docid_limit) const = 0;
     void update_flow_stats(uint32_t docid_limit) {
         _flow_stats = calculate_flow_stats(docid_limit);
+        if (const auto *factors = opt_field_cost_factors()) [[unlikely]] {
+            apply_field_cost_factors(*factors);
+        }
     }
+    // scale the cost of single-field leafs by the measured cost factor of the field
+    void apply_field_cost_factors(const FieldCostFactors &factors) noexcept;
     static FlowStats default_flow_stats(uint32_t docid_limit, uint32_t abs_est, size_t child_cnt);
     static FlowStats default_flow_stats(size_t child_cnt);
 
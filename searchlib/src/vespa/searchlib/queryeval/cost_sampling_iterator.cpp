@@ -0,0 +1,87 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "cost_sampling_iterator.h"
+#include "field_cost_model.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/objects/visit.hpp>
+
+namespace search::queryeval {
+
+FieldCostModel *&
+CostSamplingIterator::thread_model() noexcept
+{
+    thread_local FieldCostModel *model = nullptr;
+    return model;
+}
+
+CostSamplingIterator::CostSamplingIterator(std::unique_ptr<SearchIterator> search, FieldCostModel &model,
+                                           uint32_t field_id, bool strict, double cost, double strict_cost) noexcept
+    : _search(std::move(search)),
+      _model(model),
+      _field_id(field_id),
+      _strict(strict),
+      _cost(cost),
+      _strict_cost(strict_cost),
+      _seeks(0),
+      _docs(0),
+      _time(vespalib::duration::zero())
+{
+}
+
+CostSamplingIterator::~CostSamplingIterator()
+{
+    if (_seeks > 0) {
+        _model.add_sample(_field_id, estimated_cost(), vespalib::count_ns(_time));
+    }
+}
+
+void
+CostSamplingIterator::initRange(uint32_t begin_id, uint32_t end_id)
+{
+    auto start = vespalib::steady_clock::now();
+    SearchIterator::initRange(begin_id, end_id);
+    _search->initRange(begin_id, end_id);
+    setDocId(_search->getDocId());
+    _time += (vespalib::steady_clock::now() - start);
+    if (end_id > begin_id) {
+        _docs += (end_id - begin_id);
+    }
+}
+
+void
+CostSamplingIterator::doSeek(uint32_t docid)
+{
+    auto start = vespalib::steady_clock::now();
+    _search->doSeek(docid);
+    setDocId(_search->getDocId());
+    _time += (vespalib::steady_clock::now() - start);
+    ++_seeks;
+}
+
+std::unique_ptr<BitVector>
+CostSamplingIterator::get_hits(uint32_t begin_id)
+{
+    return _search->get_hits(begin_id);
+}
+
+void
+CostSamplingIterator::or_hits_into(BitVector &result, uint32_t begin_id)
+{
+    _search->or_hits_into(result, begin_id);
+}
+
+void
+CostSamplingIterator::and_hits_into(BitVector &result, uint32_t begin_id)
+{
+    _search->and_hits_into(result, begin_id);
+}
+
+void
+CostSamplingIterator::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    visit(visitor, "search", _search);
+    visit(visitor, "field_id", _field_id);
+    visit(visitor, "strict", _strict);
+}
+
+}
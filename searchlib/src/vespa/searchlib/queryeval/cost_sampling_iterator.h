@@ -0,0 +1,75 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "searchiterator.h"
+#include <vespa/vespalib/util/time.h>
+
+namespace search::queryeval {
+
+class FieldCostModel;
+
+/**
+ * Wraps a leaf iterator searching a single field to measure the time
+ * spent seeking it. When the iterator is destructed, the measured
+ * time is reported to a FieldCostModel together with the cost the
+ * query planner estimated for the same work.
+ *
+ * Leaf blueprints wrap their iterators with this class when a
+ * FieldCostModel is bound to the current thread (see Bind) while
+ * creating the search iterator tree.
+ **/
+class CostSamplingIterator : public SearchIterator
+{
+private:
+    std::unique_ptr<SearchIterator> _search;
+    FieldCostModel                 &_model;
+    uint32_t                        _field_id;
+    bool                            _strict;
+    double                          _cost;
+    double                          _strict_cost;
+    uint64_t                        _seeks;
+    uint64_t                        _docs;
+    vespalib::duration              _time;
+
+    static FieldCostModel *&thread_model() noexcept;
+public:
+    CostSamplingIterator(std::unique_ptr<SearchIterator> search, FieldCostModel &model,
+                         uint32_t field_id, bool strict, double cost, double strict_cost) noexcept;
+    ~CostSamplingIterator() override;
+    void initRange(uint32_t begin_id, uint32_t end_id) override;
+    void doSeek(uint32_t docid) override;
+    void doUnpack(uint32_t docid) override { _search->doUnpack(docid); }
+    std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
+    void or_hits_into(BitVector &result, uint32_t begin_id) override;
+    void and_hits_into(BitVector &result, uint32_t begin_id) override;
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+    UP andWith(UP filter, uint32_t estimate) override { return _search->andWith(std::move(filter), estimate); }
+    Trinary is_strict() const override { return _search->is_strict(); }
+    Trinary matches_any() const override { return _search->matches_any(); }
+    const PostingInfo *getPostingInfo() const override { return _search->getPostingInfo(); }
+
+    /**
+     * The estimated cost of the work performed so far; strict
+     * iterators are charged for the docid range they cover, while
+     * non-strict iterators are charged for each seek.
+     **/
+    double estimated_cost() const noexcept {
+        return _strict ? (_strict_cost * _docs) : (_cost * _seeks);
+    }
+
+    static FieldCostModel *bound_model() noexcept { return thread_model(); }
+    struct Bind {
+        FieldCostModel *prev;
+        explicit Bind(FieldCostModel *model) noexcept : prev(thread_model()) {
+            thread_model() = model;
+        }
+        ~Bind() noexcept { thread_model() = prev; }
+        Bind(Bind &&) = delete;
+        Bind(const Bind &) = delete;
+        Bind &operator=(Bind &&) = delete;
+        Bind &operator=(const Bind &) = delete;
+    };
+};
+
+}
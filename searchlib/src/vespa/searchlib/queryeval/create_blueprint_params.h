@@ -16,9 +16,13 @@ struct CreateBlueprintParams
     double global_filter_lower_limit;
     double global_filter_upper_limit;
     double target_hits_max_adjustment_factor;
+    double filter_first_threshold;
+    double filter_first_exploration;
     vespalib::FuzzyMatchingAlgorithm fuzzy_matching_algorithm;
     queryeval::wand::StopWordStrategy weakand_stop_word_strategy;
     std::optional<double> filter_threshold;
+    bool use_posting_bitvector_cache;
+    uint32_t max_term_expansions;
 
     CreateBlueprintParams(double global_filter_lower_limit_in,
                           double global_filter_upper_limit_in,
@@ -29,9 +33,13 @@ struct CreateBlueprintParams
         : global_filter_lower_limit(global_filter_lower_limit_in),
           global_filter_upper_limit(global_filter_upper_limit_in),
           target_hits_max_adjustment_factor(target_hits_max_adjustment_factor_in),
+          filter_first_threshold(fef::indexproperties::matching::FilterFirstThreshold::DEFAULT_VALUE),
+          filter_first_exploration(fef::indexproperties::matching::FilterFirstExploration::DEFAULT_VALUE),
           fuzzy_matching_algorithm(fuzzy_matching_algorithm_in),
           weakand_stop_word_strategy(weakand_stop_word_strategy_in),
-          filter_threshold(filter_threshold_in)
+          filter_threshold(filter_threshold_in),
+          use_posting_bitvector_cache(fef::indexproperties::matching::UsePostingBitVectorCache::DEFAULT_VALUE),
+          max_term_expansions(fef::indexproperties::matching::MaxTermExpansions::DEFAULT_VALUE)
     {
     }
 
@@ -4,6 +4,7 @@
 #include "create_blueprint_visitor_helper.h"
 #include "leaf_blueprints.h"
 #include "dot_product_blueprint.h"
+#include "equiv_blueprint.h"
 #include "get_weight_from_node.h"
 #include "wand/parallel_weak_and_blueprint.h"
 #include "simple_phrase_blueprint.h"
@@ -77,6 +78,33 @@ CreateBlueprintVisitorHelper::handleNumberTermAsText(query::NumberTerm &n)
     }
 }
 
+std::unique_ptr<Blueprint>
+CreateBlueprintVisitorHelper::make_expanded_term_blueprint(const FieldSpec &field, size_t num_words,
+                                                           const MakeWordBlueprint &make_word_blueprint)
+{
+    if (num_words == 0) {
+        return std::make_unique<EmptyBlueprint>(field);
+    }
+    if (num_words == 1) {
+        return make_word_blueprint(field, 0);
+    }
+    fef::MatchDataLayout layout;
+    std::vector<fef::TermFieldHandle> handles;
+    handles.reserve(num_words);
+    for (size_t i = 0; i < num_words; ++i) {
+        handles.push_back(layout.allocTermField(field.getFieldId()));
+    }
+    FieldSpecBaseList fields;
+    fields.add(field);
+    auto equiv = std::make_unique<EquivBlueprint>(std::move(fields), std::move(layout));
+    FieldSpec word_field(field);
+    for (size_t i = 0; i < num_words; ++i) {
+        word_field.setBase(FieldSpecBase(field.getFieldId(), handles[i], field.isFilter()));
+        equiv->addTerm(make_word_blueprint(word_field, i), 1.0);
+    }
+    return equiv;
+}
+
 template <typename WS, typename NODE>
 void
 CreateBlueprintVisitorHelper::createWeightedSet(std::unique_ptr<WS> bp, NODE &n) {
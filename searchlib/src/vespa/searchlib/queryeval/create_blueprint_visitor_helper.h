@@ -9,6 +9,7 @@
 #include <vespa/searchlib/query/tree/termnodes.h>
 #include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchcommon/attribute/search_context_params.h>
+#include <functional>
 #include <memory>
 
 namespace search::queryeval {
@@ -53,6 +54,16 @@ public:
 
     void handleNumberTermAsText(query::NumberTerm &n);
 
+    using MakeWordBlueprint = std::function<std::unique_ptr<Blueprint>(const FieldSpec &word_field, size_t word_idx)>;
+    /**
+     * Create blueprint for a term (e.g. prefix or fuzzy) expanded to
+     * multiple dictionary words in the given field. Each word gets its
+     * own term field match data, merged into the match data for the
+     * field by an equiv.
+     */
+    static std::unique_ptr<Blueprint> make_expanded_term_blueprint(const FieldSpec &field, size_t num_words,
+                                                                   const MakeWordBlueprint &make_word_blueprint);
+
     void illegalVisit() {}
 
     void visit(query::And &) override { illegalVisit(); }
@@ -0,0 +1,104 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "field_cost_model.h"
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+namespace search::queryeval {
+
+FieldCostFactors::FieldCostFactors() = default;
+FieldCostFactors::~FieldCostFactors() = default;
+
+FieldCostModel::FieldCostModel(uint32_t min_samples, double decay, uint32_t update_interval)
+    : _lock(),
+      _fields(),
+      _total(),
+      _min_samples(min_samples),
+      _decay(decay),
+      _update_interval(std::max(1u, update_interval)),
+      _samples_since_update(0),
+      _query_cnt(0),
+      _cost_factors()
+{
+}
+
+FieldCostModel::~FieldCostModel() = default;
+
+void
+FieldCostModel::add_sample(uint32_t field_id, double estimated_cost, double measured_ns)
+{
+    if (!(estimated_cost > 0.0) || (measured_ns < 0.0)) {
+        return;
+    }
+    std::lock_guard guard(_lock);
+    _fields[field_id].add(estimated_cost, measured_ns, _decay);
+    _total.add(estimated_cost, measured_ns, _decay);
+    if (++_samples_since_update >= _update_interval) {
+        _cost_factors.reset();
+        _samples_since_update = 0;
+    }
+}
+
+double
+FieldCostModel::factor_of(const FieldStats &stats) const noexcept
+{
+    double total = _total.ns_per_cost();
+    double field = stats.ns_per_cost();
+    if ((stats.samples < _min_samples) || !(total > 0.0) || !(field > 0.0)) {
+        return 1.0;
+    }
+    return std::clamp(field / total, 1.0 / max_cost_factor, max_cost_factor);
+}
+
+double
+FieldCostModel::cost_factor(uint32_t field_id) const
+{
+    std::lock_guard guard(_lock);
+    auto itr = _fields.find(field_id);
+    return (itr != _fields.end()) ? factor_of(itr->second) : 1.0;
+}
+
+std::shared_ptr<const FieldCostFactors>
+FieldCostModel::get_cost_factors() const
+{
+    std::lock_guard guard(_lock);
+    if (!_cost_factors) {
+        auto factors = std::make_shared<FieldCostFactors>();
+        for (const auto &entry : _fields) {
+            factors->set(entry.first, factor_of(entry.second));
+        }
+        _cost_factors = std::move(factors);
+        _samples_since_update = 0;
+    }
+    return _cost_factors;
+}
+
+FieldCostModel::FieldStats
+FieldCostModel::get_field_stats(uint32_t field_id) const
+{
+    std::lock_guard guard(_lock);
+    auto itr = _fields.find(field_id);
+    return (itr != _fields.end()) ? itr->second : FieldStats();
+}
+
+void
+FieldCostModel::to_slime(vespalib::slime::Cursor &object, const FieldNameResolver &field_name) const
+{
+    std::lock_guard guard(_lock);
+    object.setLong("samples", _total.samples);
+    object.setDouble("ns_per_cost", _total.ns_per_cost());
+    auto &fields = object.setArray("fields");
+    for (const auto &entry : _fields) {
+        auto &field = fields.addObject();
+        field.setLong("field_id", entry.first);
+        field.setString("name", field_name(entry.first));
+        field.setLong("samples", entry.second.samples);
+        field.setDouble("ns_per_cost", entry.second.ns_per_cost());
+        field.setDouble("cost_factor", factor_of(entry.second));
+    }
+}
+
+}
+
+VESPALIB_HASH_MAP_INSTANTIATE(uint32_t, search::queryeval::FieldCostModel::FieldStats);
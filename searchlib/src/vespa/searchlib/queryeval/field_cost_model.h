@@ -0,0 +1,129 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace vespalib::slime { struct Cursor; }
+
+namespace search::queryeval {
+
+/**
+ * Immutable snapshot of the cost factors of the sampled fields in a
+ * FieldCostModel. Used during query planning, where it is looked up
+ * for each leaf blueprint without any locking.
+ **/
+class FieldCostFactors
+{
+    vespalib::hash_map<uint32_t, double> _factors;
+public:
+    FieldCostFactors();
+    ~FieldCostFactors();
+    void set(uint32_t field_id, double factor) { _factors[field_id] = factor; }
+    double cost_factor(uint32_t field_id) const noexcept {
+        auto itr = _factors.find(field_id);
+        return (itr != _factors.end()) ? itr->second : 1.0;
+    }
+};
+
+/**
+ * Keeps track of the measured execution time of leaf iterators
+ * searching a single field, relative to the cost estimated by the
+ * query planner (see flow_tuning.h). Samples are reported by
+ * CostSamplingIterator instances wrapping the leaf iterators of
+ * sampled queries.
+ *
+ * The cost factor of a field tells how expensive a unit of estimated
+ * cost is for that field compared to the average across all sampled
+ * fields. It is used to scale the flow stats of single-field leaf
+ * blueprints during query planning, making the planner adapt to the
+ * actual data distribution. Older samples are gradually decayed. The
+ * samples are compared with the unscaled estimates of the planner.
+ *
+ * This class is thread-safe.
+ **/
+class FieldCostModel
+{
+public:
+    struct FieldStats {
+        uint64_t samples;
+        double   estimated_cost;
+        double   measured_ns;
+        FieldStats() noexcept : samples(0), estimated_cost(0.0), measured_ns(0.0) {}
+        void add(double estimated_cost_in, double measured_ns_in, double decay) noexcept {
+            ++samples;
+            estimated_cost = estimated_cost * decay + estimated_cost_in;
+            measured_ns = measured_ns * decay + measured_ns_in;
+        }
+        double ns_per_cost() const noexcept {
+            return (estimated_cost > 0.0) ? (measured_ns / estimated_cost) : 0.0;
+        }
+    };
+    static constexpr uint32_t default_min_samples = 100;
+    static constexpr double default_decay = 0.999;
+    static constexpr uint32_t default_update_interval = 100;
+    static constexpr double max_cost_factor = 4.0;
+
+private:
+    mutable std::mutex                       _lock;
+    vespalib::hash_map<uint32_t, FieldStats> _fields;
+    FieldStats                               _total;
+    uint32_t                                 _min_samples;
+    double                                   _decay;
+    uint32_t                                 _update_interval;
+    mutable uint32_t                         _samples_since_update;
+    std::atomic<uint64_t>                    _query_cnt;
+    mutable std::shared_ptr<const FieldCostFactors> _cost_factors;
+
+    double factor_of(const FieldStats &stats) const noexcept;
+
+public:
+    FieldCostModel() : FieldCostModel(default_min_samples, default_decay) {}
+    FieldCostModel(uint32_t min_samples, double decay, uint32_t update_interval = default_update_interval);
+    FieldCostModel(const FieldCostModel &) = delete;
+    FieldCostModel &operator=(const FieldCostModel &) = delete;
+    ~FieldCostModel();
+
+    /**
+     * Decide whether the next query should be sampled, sampling one
+     * out of every 'interval' queries. An interval of 0 disables
+     * sampling.
+     **/
+    bool should_sample(uint32_t interval) noexcept {
+        return (interval > 0) && ((_query_cnt.fetch_add(1, std::memory_order_relaxed) % interval) == 0);
+    }
+
+    /**
+     * Report the estimated cost (in the same unit as the cost and
+     * strict_cost of FlowStats, multiplied by the number of documents
+     * flowing into the iterator) and measured time of evaluating a
+     * leaf iterator searching the given field.
+     **/
+    void add_sample(uint32_t field_id, double estimated_cost, double measured_ns);
+
+    /**
+     * Obtain the factor the estimated cost of evaluating a leaf
+     * searching the given field should be multiplied with. Returns
+     * 1.0 if there is not enough information about the field.
+     **/
+    double cost_factor(uint32_t field_id) const;
+
+    /**
+     * Obtain a snapshot of the current cost factors of all sampled
+     * fields. The snapshot is only rebuilt after 'update_interval' new
+     * samples have been added since it was built.
+     **/
+    std::shared_ptr<const FieldCostFactors> get_cost_factors() const;
+
+    FieldStats get_field_stats(uint32_t field_id) const;
+    using FieldNameResolver = std::function<std::string(uint32_t field_id)>;
+    void to_slime(vespalib::slime::Cursor &object, const FieldNameResolver &field_name) const;
+};
+
+}
@@ -9,6 +9,7 @@
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/engine/trace.h>
 #include <vespa/vespalib/data/slime/slime.h>
+#include <algorithm>
 #include <cassert>
 
 using search::engine::Trace;
@@ -92,12 +93,13 @@ struct MakePart : Runnable {
     Blueprint &blueprint;
     uint32_t begin;
     uint32_t end;
+    BitVector *target;
     PartResult result;
     std::unique_ptr<Trace> trace;
     std::unique_ptr<ExecutionProfiler> profiler;
     MakePart(MakePart &&) = default;
-    MakePart(Blueprint &blueprint_in, uint32_t begin_in, uint32_t end_in, Trace *parent_trace)
-      : blueprint(blueprint_in), begin(begin_in), end(end_in), result(), trace(), profiler()
+    MakePart(Blueprint &blueprint_in, uint32_t begin_in, uint32_t end_in, BitVector *target_in, Trace *parent_trace)
+      : blueprint(blueprint_in), begin(begin_in), end(end_in), target(target_in), result(), trace(), profiler()
     {
         if (parent_trace && parent_trace->getLevel() > 0) {
             trace = parent_trace->make_trace_up();
@@ -124,7 +126,12 @@ struct MakePart : Runnable {
             auto bits = filter->get_hits(begin);
             // count bits in parallel and cache the results for later
             bits->countTrueBits();
-            result = PartResult(std::move(bits));
+            if (target != nullptr) {
+                target->copy_part(*bits);
+                result = PartResult(Trinary::Undefined);
+            } else {
+                result = PartResult(std::move(bits));
+            }
         } else {
             result = PartResult(matches_any);
         }
@@ -202,16 +209,27 @@ GlobalFilter::create(std::vector<std::unique_ptr<BitVector>> vectors)
 std::shared_ptr<GlobalFilter>
 GlobalFilter::create(Blueprint &blueprint, uint32_t docid_limit, ThreadBundle &thread_bundle, Trace *trace)
 {
+    // Parts end at cache line boundaries, letting each thread copy
+    // its hits straight into a single shared bit vector.
+    constexpr uint32_t part_alignment = 512;
     uint32_t num_threads = thread_bundle.size();
+    uint32_t num_chunks = (docid_limit + part_alignment - 1) / part_alignment;
+    uint32_t num_parts = std::max(1u, std::min(num_threads, num_chunks));
+    uint32_t chunks_per_part = num_chunks / num_parts;
+    uint32_t rest_chunks = num_chunks % num_parts;
+    std::unique_ptr<BitVector> target;
+    if (num_parts > 1) {
+        target = BitVector::create(1, docid_limit);
+    }
     std::vector<MakePart> parts;
-    parts.reserve(num_threads);
+    parts.reserve(num_parts);
     uint32_t docid = 1;
-    uint32_t per_thread = (docid_limit - docid) / num_threads;
-    uint32_t rest_docs = (docid_limit - docid) % num_threads;
+    uint32_t chunk = 0;
     while (docid < docid_limit) {
-        uint32_t part_size = per_thread + (parts.size() < rest_docs);
-        parts.emplace_back(blueprint, docid, docid + part_size, trace);
-        docid += part_size;
+        chunk += chunks_per_part + (parts.size() < rest_chunks);
+        uint32_t part_end = std::min(uint64_t(chunk) * part_alignment, uint64_t(docid_limit));
+        parts.emplace_back(blueprint, docid, part_end, target.get(), trace);
+        docid = part_end;
     }
     assert(parts.size() <= num_threads);
     assert((docid == docid_limit) || parts.empty());
@@ -224,9 +242,14 @@ GlobalFilter::create(Blueprint &blueprint, uint32_t docid_limit, ThreadBundle &t
         case Trinary::False: return std::make_unique<EmptyFilter>(docid_limit);
         case Trinary::True: return create(); // filter not needed after all
         case Trinary::Undefined:
-            vectors.push_back(std::move(part.result.bits));
+            if (part.result.bits) {
+                vectors.push_back(std::move(part.result.bits));
+            }
         }
     }
+    if (target) {
+        return create(std::move(target));
+    }
     if (vectors.size() == 1) {
         return create(std::move(vectors[0]));
     }
@@ -44,6 +44,8 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
                                                    double global_filter_lower_limit,
                                                    double global_filter_upper_limit,
                                                    double target_hits_max_adjustment_factor,
+                                                   double filter_first_threshold,
+                                                   double filter_first_exploration,
                                                    const vespalib::Doom& doom)
     : ComplexLeafBlueprint(field),
       _distance_calc(std::move(distance_calc)),
@@ -57,6 +59,8 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
       _global_filter_lower_limit(global_filter_lower_limit),
       _global_filter_upper_limit(global_filter_upper_limit),
       _target_hits_max_adjustment_factor(target_hits_max_adjustment_factor),
+      _filter_first_threshold(filter_first_threshold),
+      _filter_first_exploration(filter_first_exploration),
       _distance_heap(target_hits),
       _found_hits(),
       _algorithm(Algorithm::EXACT),
@@ -118,7 +122,8 @@ NearestNeighborBlueprint::perform_top_k(const search::tensor::NearestNeighborInd
     uint32_t k = _adjusted_target_hits;
     const auto &df = _distance_calc->function();
     if (_global_filter->is_active()) {
-        _found_hits = nns_index->find_top_k_with_filter(k, df, *_global_filter, k + _explore_additional_hits, _doom, _distance_threshold);
+        _found_hits = nns_index->find_top_k_with_filter(k, df, *_global_filter, _filter_first_threshold, _filter_first_exploration,
+                                                        k + _explore_additional_hits, _doom, _distance_threshold);
         _algorithm = Algorithm::INDEX_TOP_K_WITH_FILTER;
     } else {
         _found_hits = nns_index->find_top_k(k, df, k + _explore_additional_hits, _doom, _distance_threshold);
@@ -172,6 +177,7 @@ NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) const
     visitor.visitBool("calculated", _global_filter->is_active());
     visitor.visitFloat("lower_limit", _global_filter_lower_limit);
     visitor.visitFloat("upper_limit", _global_filter_upper_limit);
+    visitor.visitFloat("filter_first_threshold", _filter_first_threshold);
     if (_global_filter_hits.has_value()) {
         visitor.visitInt("hits", _global_filter_hits.value());
     }
@@ -39,6 +39,8 @@ private:
     double _global_filter_lower_limit;
     double _global_filter_upper_limit;
     double _target_hits_max_adjustment_factor;
+    double _filter_first_threshold;
+    double _filter_first_exploration;
     mutable NearestNeighborDistanceHeap _distance_heap;
     std::vector<search::tensor::NearestNeighborIndex::Neighbor> _found_hits;
     Algorithm _algorithm;
@@ -58,6 +60,8 @@ public:
                              double global_filter_lower_limit,
                              double global_filter_upper_limit,
                              double target_hits_max_adjustment_factor,
+                             double filter_first_threshold,
+                             double filter_first_exploration,
                              const vespalib::Doom& doom);
     NearestNeighborBlueprint(const NearestNeighborBlueprint&) = delete;
     NearestNeighborBlueprint& operator=(const NearestNeighborBlueprint&) = delete;
@@ -1,10 +1,114 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "dense_tensor_attribute.h"
+#include "nearest_neighbor_index.h"
+#include <vespa/document/fieldvalue/tensorfieldvalue.h>
+#include <vespa/document/update/tensor_modify_update.h>
+#include <vespa/eval/eval/value.h>
 #include <vespa/searchcommon/attribute/config.h>
+#include <vespa/vespalib/util/shared_string_repo.h>
+#include <vespa/vespalib/util/typify.h>
+#include <cstring>
+#include <optional>
+
+using document::TensorModifyUpdate;
+using vespalib::datastore::EntryRef;
+using vespalib::eval::TypifyCellType;
+using vespalib::eval::Value;
+using vespalib::eval::ValueType;
+using vespalib::SharedStringRepo;
+using vespalib::string_id;
 
 namespace search::tensor {
 
+namespace {
+
+/**
+ * Returns the dense index addressed by the labels of a cell in a sparse modifier tensor,
+ * where each label is the index in the corresponding (indexed) dimension of the dense tensor.
+ */
+std::optional<size_t>
+dense_index_of(std::span<const string_id> labels, const std::vector<size_t>& dim_sizes)
+{
+    size_t index = 0;
+    for (size_t i = 0; i < labels.size(); ++i) {
+        std::string label = SharedStringRepo::Handle::string_from_id(labels[i]);
+        if (label.empty()) {
+            return std::nullopt;
+        }
+        size_t coord = 0;
+        for (char c : label) {
+            if (c < '0' || c > '9') {
+                return std::nullopt;
+            }
+            coord = coord * 10 + (c - '0');
+            if (coord >= dim_sizes[i]) {
+                return std::nullopt;
+            }
+        }
+        index = index * dim_sizes[i] + coord;
+    }
+    return index;
+}
+
+/**
+ * Applies the modifier to a copy of the cells of a stored dense tensor. The copy is only
+ * allocated when a cell actually changes value, otherwise an invalid ref is returned.
+ */
+struct ModifyCells {
+    template <typename CT, typename MCT>
+    static EntryRef invoke(DenseTensorStore& store, EntryRef old_ref, const Value& modifier,
+                           TensorModifyUpdate::JoinFunction function, const std::vector<size_t>& dim_sizes)
+    {
+        const auto old_cells = store.get_typed_cells(old_ref).typify<CT>();
+        const auto modifier_cells = modifier.cells().typify<MCT>();
+        std::vector<string_id> labels(dim_sizes.size());
+        std::vector<string_id*> label_refs;
+        for (auto& label : labels) {
+            label_refs.push_back(&label);
+        }
+        vespalib::datastore::Handle<char> new_raw;
+        CT* new_cells = nullptr;
+        auto view = modifier.index().create_view({});
+        view->lookup({});
+        size_t modifier_subspace;
+        while (view->next_result(label_refs, modifier_subspace)) {
+            auto index = dense_index_of(labels, dim_sizes);
+            if (!index.has_value()) {
+                continue;
+            }
+            CT old_cell = (new_cells != nullptr) ? new_cells[index.value()] : old_cells[index.value()];
+            CT new_cell = function(old_cell, modifier_cells[modifier_subspace]);
+            if (static_cast<double>(new_cell) == static_cast<double>(old_cell)) {
+                continue;
+            }
+            if (new_cells == nullptr) {
+                new_raw = store.allocRawBuffer();
+                memcpy(new_raw.data, old_cells.data(), store.getBufSize());
+                new_cells = reinterpret_cast<CT*>(new_raw.data);
+            }
+            new_cells[index.value()] = new_cell;
+        }
+        return new_raw.ref;
+    }
+};
+
+bool
+modifier_matches_dense_type(const ValueType& modifier_type, const ValueType& dense_type)
+{
+    if (!modifier_type.is_sparse() || modifier_type.dimensions().size() != dense_type.dimensions().size()) {
+        return false;
+    }
+    for (size_t i = 0; i < dense_type.dimensions().size(); ++i) {
+        if (modifier_type.dimensions()[i].name != dense_type.dimensions()[i].name) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
 DenseTensorAttribute::DenseTensorAttribute(std::string_view baseFileName, const Config& cfg,
                                            const NearestNeighborIndexFactory& index_factory)
     : TensorAttribute(baseFileName, cfg, _denseTensorStore, index_factory),
@@ -19,6 +123,51 @@ DenseTensorAttribute::~DenseTensorAttribute()
     _tensorStore.reclaim_all_memory();
 }
 
+bool
+DenseTensorAttribute::try_modify_cells(DocId docId, const TensorModifyUpdate& update)
+{
+    EntryRef old_ref;
+    if (docId < getCommittedDocIdLimit()) {
+        old_ref = _refVector[docId].load_relaxed();
+    }
+    const auto* modifier = update.getTensor().getAsTensorPtr();
+    const auto& type = _denseTensorStore.type();
+    if (!old_ref.valid() || modifier == nullptr || !modifier_matches_dense_type(modifier->type(), type)) {
+        return false;
+    }
+    std::vector<size_t> dim_sizes;
+    for (const auto& dim : type.dimensions()) {
+        dim_sizes.push_back(dim.size);
+    }
+    EntryRef new_ref = vespalib::typify_invoke<2, TypifyCellType, ModifyCells>(
+            type.cell_type(), modifier->cells().type,
+            _denseTensorStore, old_ref, *modifier, update.get_join_function(), dim_sizes);
+    if (!new_ref.valid()) {
+        // No cells changed value, so neither the stored tensor nor the nearest neighbor index is touched.
+        return true;
+    }
+    // The old cells are put on hold, as readers might still be using them.
+    consider_remove_from_index(docId);
+    setTensorRef(docId, new_ref);
+    if (_index) {
+        _index->add_document(docId);
+    }
+    return true;
+}
+
+void
+DenseTensorAttribute::update_tensor(DocId docId, const document::TensorUpdate& update,
+                                    bool create_empty_if_non_existing)
+{
+    // Modifying cells of an existing dense tensor is done directly on a copy of the stored cells,
+    // avoiding the round trip via a generic tensor value.
+    const auto* modify = dynamic_cast<const TensorModifyUpdate*>(&update);
+    if (modify != nullptr && try_modify_cells(docId, *modify)) {
+        return;
+    }
+    TensorAttribute::update_tensor(docId, update, create_empty_if_non_existing);
+}
+
 vespalib::eval::TypedCells
 DenseTensorAttribute::extract_cells_ref(DocId docId) const
 {
@@ -7,6 +7,8 @@
 #include "tensor_attribute.h"
 #include <memory>
 
+namespace document { class TensorModifyUpdate; }
+
 namespace search::tensor {
 
 /**
@@ -17,6 +19,8 @@ class DenseTensorAttribute : public TensorAttribute {
 private:
     DenseTensorStore _denseTensorStore;
 
+    bool try_modify_cells(DocId docId, const document::TensorModifyUpdate& update);
+
 public:
     DenseTensorAttribute(std::string_view baseFileName, const Config& cfg,
                          const NearestNeighborIndexFactory& index_factory = DefaultNearestNeighborIndexFactory());
@@ -24,6 +28,7 @@ public:
     // Implements AttributeVector and ITensorAttribute
     vespalib::eval::TypedCells extract_cells_ref(DocId docId) const override;
     bool supports_extract_cells_ref() const override { return true; }
+    void update_tensor(DocId docId, const document::TensorUpdate& update, bool create_empty_if_non_existing) override;
 
     // Implements DocVectorAccess
     vespalib::eval::TypedCells get_vector(uint32_t docid, uint32_t subspace) const noexcept override;
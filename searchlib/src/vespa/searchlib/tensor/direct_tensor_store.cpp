@@ -117,6 +117,12 @@ DirectTensorStore::store_encoded_tensor(vespalib::nbostream& encoded)
     return add_entry(deserialize_tensor(encoded));
 }
 
+EntryRef
+DirectTensorStore::store_decoded_tensor(std::unique_ptr<Value> tensor)
+{
+    return store_tensor(std::move(tensor));
+}
+
 std::unique_ptr<Value>
 DirectTensorStore::get_tensor(EntryRef ref) const
 {
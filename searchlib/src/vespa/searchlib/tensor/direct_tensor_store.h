@@ -60,6 +60,7 @@ public:
     std::unique_ptr<vespalib::datastore::ICompactionContext> start_compact(const vespalib::datastore::CompactionStrategy& compaction_strategy) override;
     EntryRef store_tensor(const vespalib::eval::Value& tensor) override;
     EntryRef store_encoded_tensor(vespalib::nbostream& encoded) override;
+    EntryRef store_decoded_tensor(std::unique_ptr<vespalib::eval::Value> tensor) override;
     std::unique_ptr<vespalib::eval::Value> get_tensor(EntryRef ref) const override;
     bool encode_stored_tensor(EntryRef ref, vespalib::nbostream& target) const override;
     vespalib::eval::TypedCells get_empty_subspace() const noexcept {
@@ -0,0 +1,59 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace search::tensor {
+
+/*
+ * Locks used when multiple threads add documents to a hnsw graph that is
+ * not yet visible to searches.
+ *
+ * A node lock serializes changes to the link arrays of the nodes mapped to
+ * it. The graph lock serializes allocations in the graph data stores and
+ * changes to the nodeid mapping, the nodes vector and the entry node.
+ * The graph lock can be taken while holding a node lock, but not the other
+ * way around, and at most one node lock is held at a time.
+ */
+class HnswBulkAddLocks {
+    static constexpr uint32_t num_node_locks = 4096;
+    std::mutex                              _graph_mutex;
+    std::array<std::mutex, num_node_locks> _node_mutexes;
+public:
+    HnswBulkAddLocks() : _graph_mutex(), _node_mutexes() {}
+    std::unique_lock<std::mutex> lock_graph() { return std::unique_lock(_graph_mutex); }
+    std::unique_lock<std::mutex> lock_node(uint32_t nodeid) { return std::unique_lock(_node_mutexes[nodeid % num_node_locks]); }
+};
+
+/*
+ * Progress of documents added to a hnsw index using bulk add, exposed
+ * through the state explorer.
+ */
+class HnswBulkAddProgress {
+    std::atomic<bool>     _active;
+    std::atomic<uint64_t> _added_docs;
+    std::atomic<uint64_t> _pending_docs;
+public:
+    HnswBulkAddProgress() noexcept : _active(false), _added_docs(0), _pending_docs(0) {}
+    void start(uint64_t docs) noexcept {
+        _pending_docs.store(docs, std::memory_order_relaxed);
+        _active.store(true, std::memory_order_release);
+    }
+    void added() noexcept {
+        _added_docs.fetch_add(1, std::memory_order_relaxed);
+        _pending_docs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    void stop() noexcept {
+        _pending_docs.store(0, std::memory_order_relaxed);
+        _active.store(false, std::memory_order_release);
+    }
+    bool active() const noexcept { return _active.load(std::memory_order_acquire); }
+    uint64_t added_docs() const noexcept { return _added_docs.load(std::memory_order_relaxed); }
+    uint64_t pending_docs() const noexcept { return _pending_docs.load(std::memory_order_relaxed); }
+};
+
+}
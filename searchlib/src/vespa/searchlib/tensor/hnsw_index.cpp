@@ -14,10 +14,13 @@
 #include <vespa/searchlib/queryeval/global_filter.h>
 #include <vespa/searchlib/util/fileutil.h>
 #include <vespa/vespalib/datastore/array_store.hpp>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/doom.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/time.h>
+#include <cmath>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.tensor.hnsw_index");
@@ -260,9 +263,14 @@ template <HnswIndexType type>
 void
 HnswIndex<type>::shrink_if_needed(uint32_t nodeid, uint32_t level)
 {
-    auto old_links = _graph.get_link_array(nodeid, level);
-    uint32_t max_links = max_links_for_level(level);
-    if (old_links.size() > max_links) {
+    LinkArray removed;
+    {
+        auto guard = lock_node(nodeid);
+        auto old_links = _graph.get_link_array(nodeid, level);
+        uint32_t max_links = max_links_for_level(level);
+        if (old_links.size() <= max_links) {
+            return;
+        }
         HnswTraversalCandidateVector neighbors;
         neighbors.reserve(old_links.size());
         auto df = _distance_ff->for_insertion_vector(get_vector(nodeid));
@@ -276,10 +284,11 @@ HnswIndex<type>::shrink_if_needed(uint32_t nodeid, uint32_t level)
         for (const auto & neighbor : split.used) {
             new_links.push_back(neighbor.nodeid);
         }
-        _graph.set_link_array(nodeid, level, new_links);
-        for (uint32_t removed_nodeid : split.unused) {
-            remove_link_to(removed_nodeid, nodeid, level);
-        }
+        set_link_array(nodeid, level, new_links);
+        removed = std::move(split.unused);
+    }
+    for (uint32_t removed_nodeid : removed) {
+        remove_link_to(removed_nodeid, nodeid, level);
     }
 }
 
@@ -287,8 +296,12 @@ template <HnswIndexType type>
 void
 HnswIndex<type>::connect_new_node(uint32_t nodeid, const LinkArrayRef &neighbors, uint32_t level)
 {
-    _graph.set_link_array(nodeid, level, neighbors);
+    {
+        auto guard = lock_node(nodeid);
+        set_link_array(nodeid, level, neighbors);
+    }
     for (uint32_t neighbor_nodeid : neighbors) {
+        auto guard = lock_node(neighbor_nodeid);
         auto old_links = _graph.get_link_array(neighbor_nodeid, level);
         add_link_to(neighbor_nodeid, level, old_links, nodeid);
     }
@@ -302,12 +315,13 @@ void
 HnswIndex<type>::remove_link_to(uint32_t remove_from, uint32_t remove_id, uint32_t level)
 {
     LinkArray new_links;
+    auto guard = lock_node(remove_from);
     auto old_links = _graph.get_link_array(remove_from, level);
     new_links.reserve(old_links.size());
     for (uint32_t id : old_links) {
         if (id != remove_id) new_links.push_back(id);
     }
-    _graph.set_link_array(remove_from, level, new_links);
+    set_link_array(remove_from, level, new_links);
 }
 
 namespace {
@@ -475,6 +489,155 @@ HnswIndex<type>::search_layer(const BoundDistanceFunction &df, uint32_t neighbor
     }
 }
 
+/*
+ * Search variant for restrictive filters, see ACORN (https://arxiv.org/abs/2403.04871).
+ * Neighbors rejected by the filter are not scored. Instead, their neighbors passing the
+ * filter are considered, until a fraction (filter_first_exploration) of the max number of
+ * links have been found when expanding a candidate. This also brings the search from an
+ * entry point rejected by the filter to nearby nodes that pass it.
+ *
+ * The pass rate of the filter among graph neighbors is tracked during the search, starting
+ * out with the hit ratio of the filter. Rejected neighbors are scored and explored as usual
+ * while the pass rate is at or above filter_first_threshold, e.g. when the nodes near the
+ * query vector mostly pass the filter.
+ */
+template <HnswIndexType type>
+template <class VisitedTracker, class BestNeighbors>
+void
+HnswIndex<type>::search_layer_filter_first_helper(const BoundDistanceFunction &df, uint32_t neighbors_to_find,
+                                                  BestNeighbors& best_neighbors, uint32_t level, const GlobalFilter &filter,
+                                                  double filter_first_threshold, double filter_first_exploration,
+                                                  uint32_t nodeid_limit, const vespalib::Doom* const doom,
+                                                  uint32_t estimated_visited_nodes) const
+{
+    NearestPriQ candidates;
+    GlobalFilterWrapper<type> filter_wrapper(&filter);
+    filter_wrapper.clamp_nodeid_limit(nodeid_limit);
+    VisitedTracker visited(nodeid_limit, estimated_visited_nodes);
+    if (doom != nullptr && doom->soft_doom()) {
+        while (!best_neighbors.empty()) {
+            best_neighbors.pop();
+        }
+        return;
+    }
+    // Copy the entry points, as entries rejected by the filter are popped from best_neighbors
+    HnswCandidateVector entry_points(best_neighbors.peek());
+    for (const auto &entry : entry_points) {
+        if (entry.nodeid >= nodeid_limit) {
+            continue;
+        }
+        candidates.push(entry);
+        visited.mark(entry.nodeid);
+        if (!filter_wrapper.check(entry.docid)) {
+            assert(best_neighbors.peek().size() == 1);
+            best_neighbors.pop();
+        }
+    }
+    double limit_dist = std::numeric_limits<double>::max();
+    uint32_t max_links = max_links_for_level(level);
+    uint32_t wanted_links = std::max(1.0, std::ceil(std::clamp(filter_first_exploration, 0.0, 1.0) * max_links));
+    double checked = max_links;
+    double passed = (filter.size() > 0) ? (max_links * static_cast<double>(filter.count()) / filter.size()) : 0.0;
+    std::vector<vespalib::datastore::EntryRef> rejected;
+    rejected.reserve(max_links);
+
+    auto consider = [&](uint32_t nodeid, const auto& node, vespalib::datastore::EntryRef ref, uint32_t docid, bool passes) {
+        double dist_to_input = calc_distance(df, docid, node.acquire_subspace());
+        if (dist_to_input < limit_dist) {
+            candidates.emplace(nodeid, ref, dist_to_input);
+            if (passes) {
+                best_neighbors.emplace(nodeid, docid, ref, dist_to_input);
+                while (best_neighbors.size() > neighbors_to_find) {
+                    best_neighbors.pop();
+                    limit_dist = best_neighbors.top().distance;
+                }
+            }
+        }
+    };
+    while (!candidates.empty()) {
+        auto cand = candidates.top();
+        if (cand.distance > limit_dist) {
+            break;
+        }
+        candidates.pop();
+        bool filter_first = (passed < filter_first_threshold * checked);
+        uint32_t found = 0;
+        rejected.clear();
+        for (uint32_t neighbor_nodeid : _graph.get_link_array(cand.levels_ref, level)) {
+            if (neighbor_nodeid >= nodeid_limit) {
+                continue;
+            }
+            auto& neighbor_node = _graph.acquire_node(neighbor_nodeid);
+            auto neighbor_ref = neighbor_node.levels_ref().load_acquire();
+            if ((! neighbor_ref.valid())
+                || ! visited.try_mark(neighbor_nodeid))
+            {
+                continue;
+            }
+            uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
+            bool passes = filter_wrapper.check(neighbor_docid);
+            checked += 1.0;
+            if (passes) {
+                passed += 1.0;
+                ++found;
+                consider(neighbor_nodeid, neighbor_node, neighbor_ref, neighbor_docid, true);
+            } else if (filter_first) {
+                rejected.push_back(neighbor_ref);
+            } else {
+                consider(neighbor_nodeid, neighbor_node, neighbor_ref, neighbor_docid, false);
+            }
+        }
+        for (auto rejected_ref : rejected) {
+            if (found >= wanted_links) {
+                break;
+            }
+            for (uint32_t nodeid : _graph.get_link_array(rejected_ref, level)) {
+                if (nodeid >= nodeid_limit) {
+                    continue;
+                }
+                auto& node = _graph.acquire_node(nodeid);
+                auto ref = node.levels_ref().load_acquire();
+                if (! ref.valid()) {
+                    continue;
+                }
+                // Nodes two hops away that are rejected by the filter are not marked as visited,
+                // allowing them to be expanded later if reached as direct neighbors.
+                uint32_t docid = acquire_docid(node, nodeid);
+                if (! filter_wrapper.check(docid) || ! visited.try_mark(nodeid)) {
+                    continue;
+                }
+                consider(nodeid, node, ref, docid, true);
+                if (++found >= wanted_links) {
+                    break;
+                }
+            }
+        }
+        if (doom != nullptr && doom->soft_doom()) {
+            break;
+        }
+    }
+}
+
+template <HnswIndexType type>
+template <class BestNeighbors>
+void
+HnswIndex<type>::search_layer_filter_first(const BoundDistanceFunction &df, uint32_t neighbors_to_find, BestNeighbors& best_neighbors,
+                                           uint32_t level, const vespalib::Doom* const doom, const GlobalFilter &filter,
+                                           double filter_first_threshold, double filter_first_exploration) const
+{
+    uint32_t nodeid_limit = _graph.nodes_size.load(std::memory_order_acquire);
+    uint32_t estimated_visited_nodes = estimate_visited_nodes(level, nodeid_limit, neighbors_to_find, &filter);
+    if (estimated_visited_nodes >= nodeid_limit / 128) {
+        search_layer_filter_first_helper<BitVectorVisitedTracker>(df, neighbors_to_find, best_neighbors, level, filter,
+                                                                  filter_first_threshold, filter_first_exploration,
+                                                                  nodeid_limit, doom, estimated_visited_nodes);
+    } else {
+        search_layer_filter_first_helper<HashSetVisitedTracker>(df, neighbors_to_find, best_neighbors, level, filter,
+                                                                filter_first_threshold, filter_first_exploration,
+                                                                nodeid_limit, doom, estimated_visited_nodes);
+    }
+}
+
 template <HnswIndexType type>
 HnswIndex<type>::HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFactory::UP distance_ff,
                            RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg)
@@ -483,7 +646,9 @@ HnswIndex<type>::HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFacto
       _distance_ff(std::move(distance_ff)),
       _level_generator(std::move(level_generator)),
       _id_mapping(),
-      _cfg(cfg)
+      _cfg(cfg),
+      _bulk_add_locks(),
+      _bulk_add_progress()
 {
     assert(_distance_ff);
 }
@@ -610,16 +775,38 @@ void
 HnswIndex<type>::internal_complete_add_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, PreparedAddNode &prepared_node)
 {
     int32_t num_levels = prepared_node.connections.size();
-    auto levels_ref = _graph.make_node(nodeid, docid, subspace, num_levels);
+    auto levels_ref = [&]() {
+        auto guard = lock_graph();
+        return _graph.make_node(nodeid, docid, subspace, num_levels);
+    }();
     for (int level = 0; level < num_levels; ++level) {
         auto neighbors = filter_valid_nodeids(level, prepared_node.connections[level], nodeid);
         connect_new_node(nodeid, neighbors, level);
     }
+    auto guard = lock_graph();
     if (num_levels - 1 > get_entry_level()) {
         _graph.set_entry_node({nodeid, levels_ref, num_levels - 1});
     }
 }
 
+template <HnswIndexType type>
+void
+HnswIndex<type>::bulk_add_document(uint32_t docid)
+{
+    PreparedAddDoc op = internal_prepare_add(docid, get_vectors(docid), vespalib::GenerationHandler::Guard());
+    std::vector<uint32_t> nodeids;
+    {
+        // The nodeid mapping returns a view of its own state, copy it before releasing the lock
+        auto guard = lock_graph();
+        auto ids = _id_mapping.allocate_ids(docid, op.nodes.size());
+        nodeids.assign(ids.begin(), ids.end());
+    }
+    assert(nodeids.size() == op.nodes.size());
+    for (uint32_t subspace = 0; subspace < nodeids.size(); ++subspace) {
+        internal_complete_add_node(nodeids[subspace], docid, subspace, op.nodes[subspace]);
+    }
+}
+
 template <HnswIndexType type>
 std::unique_ptr<PrepareResult>
 HnswIndex<type>::prepare_add_document(uint32_t docid, VectorBundle vectors, vespalib::GenerationHandler::Guard read_guard) const
@@ -634,6 +821,45 @@ HnswIndex<type>::prepare_add_document(uint32_t docid, VectorBundle vectors, vesp
     return std::make_unique<PreparedAddDoc>(std::move(op));
 }
 
+template <HnswIndexType type>
+bool
+HnswIndex<type>::bulk_add_documents(std::span<const uint32_t> docids, vespalib::Executor& executor, uint32_t num_tasks)
+{
+    _bulk_add_progress.start(docids.size());
+    size_t first_parallel = 0;
+    // The first documents are added by the calling thread to ensure that they are linked together
+    while (first_parallel < docids.size() && _graph.get_active_nodes() < _cfg.min_size_before_two_phase()) {
+        add_document(docids[first_parallel++]);
+        _bulk_add_progress.added();
+    }
+    if (first_parallel < docids.size()) {
+        _bulk_add_locks = std::make_unique<HnswBulkAddLocks>();
+        std::atomic<size_t> next(first_parallel);
+        auto worker = [this, docids, &next]() {
+            for (size_t i = next++; i < docids.size(); i = next++) {
+                bulk_add_document(docids[i]);
+                _bulk_add_progress.added();
+            }
+        };
+        vespalib::CountDownLatch latch(num_tasks);
+        for (uint32_t i = 0; i < num_tasks; ++i) {
+            auto task = vespalib::makeLambdaTask([&worker, &latch]() {
+                worker();
+                latch.countDown();
+            });
+            auto rejected = executor.execute(std::move(task));
+            if (rejected) {
+                latch.countDown();
+            }
+        }
+        worker();
+        latch.await();
+        _bulk_add_locks.reset();
+    }
+    _bulk_add_progress.stop();
+    return true;
+}
+
 template <HnswIndexType type>
 void
 HnswIndex<type>::complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result)
@@ -884,9 +1110,11 @@ struct NeighborsByDocId {
 template <HnswIndexType type>
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex<type>::top_k_by_docid(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter *filter,
+                                double filter_first_threshold, double filter_first_exploration,
                                 uint32_t explore_k, const vespalib::Doom& doom, double distance_threshold) const
 {
-    SearchBestNeighbors candidates = top_k_candidates(df, std::max(k, explore_k), filter, doom);
+    SearchBestNeighbors candidates = top_k_candidates(df, std::max(k, explore_k), filter,
+                                                      filter_first_threshold, filter_first_exploration, doom);
     auto result = candidates.get_neighbors(k, distance_threshold);
     std::sort(result.begin(), result.end(), NeighborsByDocId());
     return result;
@@ -897,20 +1125,23 @@ std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex<type>::find_top_k(uint32_t k, const BoundDistanceFunction &df, uint32_t explore_k,
                             const vespalib::Doom& doom, double distance_threshold) const
 {
-    return top_k_by_docid(k, df, nullptr, explore_k, doom, distance_threshold);
+    return top_k_by_docid(k, df, nullptr, 0.0, 0.0, explore_k, doom, distance_threshold);
 }
 
 template <HnswIndexType type>
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex<type>::find_top_k_with_filter(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter &filter,
+                                        double filter_first_threshold, double filter_first_exploration,
                                         uint32_t explore_k, const vespalib::Doom& doom, double distance_threshold) const
 {
-    return top_k_by_docid(k, df, &filter, explore_k, doom, distance_threshold);
+    return top_k_by_docid(k, df, &filter, filter_first_threshold, filter_first_exploration, explore_k, doom, distance_threshold);
 }
 
 template <HnswIndexType type>
 typename HnswIndex<type>::SearchBestNeighbors
-HnswIndex<type>::top_k_candidates(const BoundDistanceFunction &df, uint32_t k, const GlobalFilter *filter, const vespalib::Doom& doom) const
+HnswIndex<type>::top_k_candidates(const BoundDistanceFunction &df, uint32_t k, const GlobalFilter *filter,
+                                  double filter_first_threshold, double filter_first_exploration,
+                                  const vespalib::Doom& doom) const
 {
     SearchBestNeighbors best_neighbors;
     auto entry = _graph.get_entry_node();
@@ -928,7 +1159,11 @@ HnswIndex<type>::top_k_candidates(const BoundDistanceFunction &df, uint32_t k, c
         --search_level;
     }
     best_neighbors.push(entry_point);
-    search_layer(df, k, best_neighbors, 0, &doom, filter);
+    if (filter != nullptr && filter_first_threshold > 0.0) {
+        search_layer_filter_first(df, k, best_neighbors, 0, &doom, *filter, filter_first_threshold, filter_first_exploration);
+    } else {
+        search_layer(df, k, best_neighbors, 0, &doom, filter);
+    }
     return best_neighbors;
 }
 
@@ -6,6 +6,7 @@
 #include "distance_function.h"
 #include "distance_function_factory.h"
 #include "doc_vector_access.h"
+#include "hnsw_bulk_add.h"
 #include "hnsw_identity_mapping.h"
 #include "hnsw_index_utils.h"
 #include "hnsw_multi_best_neighbors.h"
@@ -120,12 +121,25 @@ protected:
     RandomLevelGenerator::UP _level_generator;
     IdMapping _id_mapping; // mapping from docid to nodeid vector
     HnswIndexConfig _cfg;
+    std::unique_ptr<HnswBulkAddLocks> _bulk_add_locks; // only set while adding documents in parallel
+    HnswBulkAddProgress _bulk_add_progress;
+
+    std::unique_lock<std::mutex> lock_graph() const {
+        return _bulk_add_locks ? _bulk_add_locks->lock_graph() : std::unique_lock<std::mutex>();
+    }
+    std::unique_lock<std::mutex> lock_node(uint32_t nodeid) const {
+        return _bulk_add_locks ? _bulk_add_locks->lock_node(nodeid) : std::unique_lock<std::mutex>();
+    }
+    void set_link_array(uint32_t nodeid, uint32_t level, const LinkArrayRef& new_links) {
+        auto guard = lock_graph();
+        _graph.set_link_array(nodeid, level, new_links);
+    }
 
     uint32_t max_links_for_level(uint32_t level) const;
     void add_link_to(uint32_t nodeid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
         LinkArray new_links(old_links.begin(), old_links.end());
         new_links.push_back(new_link);
-        _graph.set_link_array(nodeid, level, new_links);
+        set_link_array(nodeid, level, new_links);
     }
 
     /**
@@ -179,7 +193,17 @@ protected:
     template <class BestNeighbors>
     void search_layer(const BoundDistanceFunction &df, uint32_t neighbors_to_find, BestNeighbors& best_neighbors,
                       uint32_t level, const vespalib::Doom* const doom, const GlobalFilter *filter = nullptr) const;
+    template <class VisitedTracker, class BestNeighbors>
+    void search_layer_filter_first_helper(const BoundDistanceFunction &df, uint32_t neighbors_to_find, BestNeighbors& best_neighbors,
+                                          uint32_t level, const GlobalFilter &filter, double filter_first_threshold,
+                                          double filter_first_exploration, uint32_t nodeid_limit,
+                                          const vespalib::Doom* const doom, uint32_t estimated_visited_nodes) const __attribute__((noinline));
+    template <class BestNeighbors>
+    void search_layer_filter_first(const BoundDistanceFunction &df, uint32_t neighbors_to_find, BestNeighbors& best_neighbors,
+                                   uint32_t level, const vespalib::Doom* const doom, const GlobalFilter &filter,
+                                   double filter_first_threshold, double filter_first_exploration) const;
     std::vector<Neighbor> top_k_by_docid(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter *filter,
+                                         double filter_first_threshold, double filter_first_exploration,
                                          uint32_t explore_k, const vespalib::Doom& doom, double distance_threshold) const;
 
     internal::PreparedAddDoc internal_prepare_add(uint32_t docid, VectorBundle input_vectors,
@@ -188,6 +212,7 @@ protected:
     LinkArray filter_valid_nodeids(uint32_t level, const internal::PreparedAddNode::Links &neighbors, uint32_t self_nodeid);
     void internal_complete_add(uint32_t docid, internal::PreparedAddDoc &op);
     void internal_complete_add_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, internal::PreparedAddNode &prepared_node);
+    void bulk_add_document(uint32_t docid);
 
     // Called from writer only.
     uint32_t get_subspaces(uint32_t docid) const noexcept;
@@ -203,6 +228,8 @@ public:
     std::unique_ptr<PrepareResult> prepare_add_document(uint32_t docid, VectorBundle vectors,
                                                         vespalib::GenerationHandler::Guard read_guard) const override;
     void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) override;
+    bool bulk_add_documents(std::span<const uint32_t> docids, vespalib::Executor& executor, uint32_t num_tasks) override;
+    bool supports_bulk_add() const noexcept override { return true; }
     void remove_node(uint32_t nodeid);
     void remove_document(uint32_t docid) override;
     void assign_generation(generation_t current_gen) override;
@@ -223,17 +250,24 @@ public:
                                      const vespalib::Doom& doom, double distance_threshold) const override;
 
     std::vector<Neighbor> find_top_k_with_filter(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter &filter,
+                                                 double filter_first_threshold, double filter_first_exploration,
                                                  uint32_t explore_k, const vespalib::Doom& doom, double distance_threshold) const override;
 
     DistanceFunctionFactory &distance_function_factory() const override { return *_distance_ff; }
 
     SearchBestNeighbors top_k_candidates(const BoundDistanceFunction &df, uint32_t k, const GlobalFilter *filter,
+                                         const vespalib::Doom& doom) const {
+        return top_k_candidates(df, k, filter, 0.0, 0.0, doom);
+    }
+    SearchBestNeighbors top_k_candidates(const BoundDistanceFunction &df, uint32_t k, const GlobalFilter *filter,
+                                         double filter_first_threshold, double filter_first_exploration,
                                          const vespalib::Doom& doom) const;
 
     uint32_t get_entry_nodeid() const { return _graph.get_entry_node().nodeid; }
     int32_t get_entry_level() const { return _graph.get_entry_node().level; }
 
     uint32_t get_active_nodes() const noexcept { return _graph.get_active_nodes(); }
+    const HnswBulkAddProgress& bulk_add_progress() const noexcept { return _bulk_add_progress; }
 
     // Called from writer only.
     uint32_t check_consistency(uint32_t docid_limit) const noexcept override;
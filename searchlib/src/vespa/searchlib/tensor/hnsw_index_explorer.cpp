@@ -63,6 +63,11 @@ HnswIndexExplorer<type>::get_state(const vespalib::slime::Inserter& inserter, bo
     auto entry_node = graph.get_entry_node();
     object.setLong("entry_nodeid", entry_node.nodeid);
     object.setLong("entry_level", entry_node.level);
+    auto& bulk_add_progress = _index.bulk_add_progress();
+    auto& bulk_add_obj = object.setObject("bulk_add");
+    bulk_add_obj.setBool("active", bulk_add_progress.active());
+    bulk_add_obj.setLong("added_docs", bulk_add_progress.added_docs());
+    bulk_add_obj.setLong("pending_docs", bulk_add_progress.pending_docs());
     auto& cfgObj = object.setObject("cfg");
     auto& cfg = _index.config();
     cfgObj.setLong("max_links_at_level_0", cfg.max_links_at_level_0());
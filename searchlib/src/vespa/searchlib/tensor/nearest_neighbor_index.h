@@ -10,12 +10,14 @@
 #include <vespa/vespalib/util/memoryusage.h>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
 class FastOS_FileInterface;
 
 namespace vespalib { class Doom; }
 namespace vespalib {
+class Executor;
 class GenericHeader;
 struct StateExplorer;
 }
@@ -77,6 +79,19 @@ public:
      */
     virtual void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) = 0;
 
+    /**
+     * Adds the given documents to the index, using the calling thread and up to 'num_tasks' tasks
+     * in the given executor to insert documents in parallel, including the graph changes.
+     *
+     * This is only allowed when the index is not visible to searches and not modified by any other thread,
+     * e.g. when the index is rebuilt while loading the enclosing tensor attribute.
+     * The caller should commit between calls to allow memory held by replaced graph data to be reclaimed.
+     * Returns false if bulk add is not supported, in which case no documents have been added.
+     */
+    virtual bool bulk_add_documents(std::span<const uint32_t> docids, vespalib::Executor& executor, uint32_t num_tasks) = 0;
+    // Tells if bulk_add_documents() is supported by this index.
+    virtual bool supports_bulk_add() const noexcept = 0;
+
     virtual void remove_document(uint32_t docid) = 0;
     virtual void assign_generation(generation_t current_gen) = 0;
     virtual void reclaim_memory(generation_t first_used_gen) = 0;
@@ -109,9 +124,12 @@ public:
                                              double distance_threshold) const = 0;
 
     // only return neighbors where the corresponding filter bit is set
+    // filter_first_threshold and filter_first_exploration tune graph exploration for restrictive filters
     virtual std::vector<Neighbor> find_top_k_with_filter(uint32_t k,
                                                          const BoundDistanceFunction &df,
                                                          const GlobalFilter &filter,
+                                                         double filter_first_threshold,
+                                                         double filter_first_exploration,
                                                          uint32_t explore_k,
                                                          const vespalib::Doom& doom,
                                                          double distance_threshold) const = 0;
@@ -0,0 +1,40 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "parallel_workers.h"
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadexecutor.h>
+
+using vespalib::CpuUsage;
+
+namespace search::tensor {
+
+uint32_t
+executor_num_threads(const vespalib::Executor& executor) noexcept
+{
+    auto thread_executor = dynamic_cast<const vespalib::ThreadExecutor*>(&executor);
+    return (thread_executor != nullptr) ? thread_executor->getNumThreads() : 0;
+}
+
+void
+run_parallel_workers(vespalib::Executor& executor, uint32_t num_workers,
+                     CpuUsage::Category category, const std::function<void()>& worker)
+{
+    uint32_t num_tasks = (num_workers > 1) ? (num_workers - 1) : 0;
+    vespalib::CountDownLatch latch(num_tasks);
+    for (uint32_t i = 0; i < num_tasks; ++i) {
+        auto task = vespalib::makeLambdaTask([&worker, &latch]() {
+            worker();
+            latch.countDown();
+        });
+        auto rejected = executor.execute(CpuUsage::wrap(std::move(task), category));
+        if (rejected) {
+            latch.countDown();
+        }
+    }
+    worker();
+    latch.await();
+}
+
+}
@@ -0,0 +1,29 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/cpu_usage.h>
+#include <cstdint>
+#include <functional>
+
+namespace vespalib { class Executor; }
+
+namespace search::tensor {
+
+/*
+ * Returns the number of threads in the executor, or 0 if the executor
+ * doesn't tell. Used to size the work posted to a shared executor.
+ */
+uint32_t executor_num_threads(const vespalib::Executor& executor) noexcept;
+
+/*
+ * Runs the worker function in the calling thread and in (num_workers - 1)
+ * tasks on the executor, and returns when all of them are done.
+ *
+ * Workers are expected to pick work items from shared state (e.g. an atomic
+ * counter), so a task rejected by the executor only reduces parallelism.
+ */
+void run_parallel_workers(vespalib::Executor& executor, uint32_t num_workers,
+                          vespalib::CpuUsage::Category category, const std::function<void()>& worker);
+
+}
@@ -4,8 +4,10 @@
 #include "dense_tensor_store.h"
 #include "nearest_neighbor_index.h"
 #include "nearest_neighbor_index_loader.h"
+#include "parallel_workers.h"
 #include "tensor_attribute_constants.h"
 #include "tensor_attribute_saver.h"
+#include <vespa/eval/eval/value.h>
 #include <vespa/fastlib/io/bufferedfile.h>
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/attribute/attribute_header.h>
@@ -18,8 +20,11 @@
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/jsonwriter.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/time.h>
+#include <atomic>
 #include <condition_variable>
+#include <exception>
 #include <filesystem>
 #include <mutex>
 
@@ -59,6 +64,10 @@ public:
 };
 
 constexpr uint32_t LOAD_COMMIT_INTERVAL = 256;
+// Number of lids read from file before the tensors are decoded in parallel.
+constexpr uint32_t LOAD_BATCH_SIZE = 16384;
+// Number of lids decoded by a task before picking the next range of lids in the batch.
+constexpr uint32_t LOAD_DECODE_CHUNK_SIZE = 256;
 const std::string tensorTypeTag("tensortype");
 
 bool can_use_index_save_file(const std::string& attrName,
@@ -203,6 +212,48 @@ ThreadedIndexBuilder::add(uint32_t lid) {
     _shared_executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
 }
 
+/**
+ * Will build nearest neighbor index by adding batches of documents in parallel, where also
+ * the graph changes are done in parallel. This is possible since the index is not visible
+ * to searches while the attribute is loaded.
+ */
+class BulkIndexBuilder : public IndexBuilder {
+public:
+    BulkIndexBuilder(AttributeVector& attr, NearestNeighborIndex& index, vespalib::Executor& shared_executor)
+        : _attr(attr),
+          _index(index),
+          _shared_executor(shared_executor),
+          _num_tasks(executor_num_threads(shared_executor)),
+          _batch()
+    {
+        _batch.reserve(BATCH_SIZE);
+    }
+    void add(uint32_t lid) override {
+        _batch.push_back(lid);
+        if (_batch.size() >= BATCH_SIZE) {
+            flush();
+        }
+    }
+    void wait_complete() override {
+        flush();
+    }
+private:
+    void flush() {
+        if (!_batch.empty()) {
+            _index.bulk_add_documents(_batch, _shared_executor, _num_tasks);
+            _batch.clear();
+            // Allow memory held by replaced graph data to be reclaimed
+            _attr.commit();
+        }
+    }
+    static constexpr uint32_t BATCH_SIZE = 65536;
+    AttributeVector&      _attr;
+    NearestNeighborIndex& _index;
+    vespalib::Executor&   _shared_executor;
+    uint32_t              _num_tasks;
+    std::vector<uint32_t> _batch;
+};
+
 class ForegroundIndexBuilder : public IndexBuilder {
 public:
     ForegroundIndexBuilder(AttributeVector& attr, NearestNeighborIndex& index)
@@ -282,11 +333,83 @@ TensorAttributeLoader::load_tensor_store(BlobSequenceReader& reader, uint32_t do
     }
 }
 
+/*
+ * Reads the saved tensors in batches, decoding each batch in parallel
+ * using the executor. Decoded tensors are then stored in lid order by
+ * this thread, which is the only one modifying the tensor store.
+ */
+void
+TensorAttributeLoader::load_tensor_store_in_batches(BlobSequenceReader& reader, uint32_t docid_limit, vespalib::Executor& executor)
+{
+    assert(reader.getVersion() == TENSOR_ATTRIBUTE_VERSION);
+    // The calling thread is also a worker
+    const uint32_t num_tasks = 1 + executor_num_threads(executor);
+    vespalib::Array<char> buffer(64_Ki);
+    std::vector<size_t> offsets;
+    std::vector<std::unique_ptr<vespalib::eval::Value>> decoded;
+    for (uint32_t batch_start = 0; batch_start < docid_limit; batch_start += LOAD_BATCH_SIZE) {
+        const uint32_t batch_size = std::min(LOAD_BATCH_SIZE, docid_limit - batch_start);
+        offsets.clear();
+        offsets.push_back(0);
+        size_t used = 0;
+        for (uint32_t i = 0; i < batch_size; ++i) {
+            uint32_t tensorSize = reader.getNextSize();
+            if (used + tensorSize > buffer.size()) {
+                buffer.resize(std::max(2 * buffer.size(), used + tensorSize));
+            }
+            if (tensorSize != 0) {
+                reader.readBlob(&buffer[used], tensorSize);
+                used += tensorSize;
+            }
+            offsets.push_back(used);
+        }
+        decoded.clear();
+        decoded.resize(batch_size);
+        std::atomic<uint32_t> next(0);
+        std::mutex error_mutex;
+        std::exception_ptr error;
+        run_parallel_workers(executor, num_tasks, CpuUsage::Category::SETUP, [&]() {
+            try {
+                for (uint32_t start = next.fetch_add(LOAD_DECODE_CHUNK_SIZE); start < batch_size; start = next.fetch_add(LOAD_DECODE_CHUNK_SIZE)) {
+                    uint32_t end = std::min(batch_size, start + LOAD_DECODE_CHUNK_SIZE);
+                    for (uint32_t i = start; i < end; ++i) {
+                        if (offsets[i + 1] != offsets[i]) {
+                            vespalib::nbostream source(&buffer[offsets[i]], offsets[i + 1] - offsets[i]);
+                            decoded[i] = _store.decode_encoded_tensor(source);
+                        }
+                    }
+                }
+            } catch (...) {
+                std::lock_guard guard(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        for (uint32_t i = 0; i < batch_size; ++i) {
+            EntryRef ref;
+            if (decoded[i]) {
+                ref = _store.store_decoded_tensor(std::move(decoded[i]));
+            }
+            _ref_vector.push_back(AtomicEntryRef(ref));
+            if (((batch_start + i) % LOAD_COMMIT_INTERVAL) == 0) {
+                _attr.commit();
+            }
+        }
+    }
+}
+
 void
 TensorAttributeLoader::build_index(vespalib::Executor* executor, uint32_t docid_limit)
 {
     std::unique_ptr<IndexBuilder> builder;
-    if (executor != nullptr) {
+    if (executor != nullptr && _index->supports_bulk_add()) {
+        builder = std::make_unique<BulkIndexBuilder>(_attr, *_index, *executor);
+        Event(_attr).addKV("execution", "multi-threaded-bulk").log("hnsw.index.rebuild.start");
+    } else if (executor != nullptr) {
         builder = std::make_unique<ThreadedIndexBuilder>(_attr, _generation_handler, _store, *_index, *executor);
         Event(_attr).addKV("execution", "multi-threaded").log("hnsw.index.rebuild.start");
     } else {
@@ -365,6 +488,8 @@ TensorAttributeLoader::on_load(vespalib::Executor* executor)
     auto dense_store = _store.as_dense();
     if (dense_store != nullptr) {
         load_dense_tensor_store(reader, docid_limit, *dense_store);
+    } else if (executor != nullptr) {
+        load_tensor_store_in_batches(reader, docid_limit, *executor);
     } else {
         load_tensor_store(reader, docid_limit);
     }
@@ -32,6 +32,7 @@ class TensorAttributeLoader {
 
     void load_dense_tensor_store(search::attribute::BlobSequenceReader& reader, uint32_t docid_limit, DenseTensorStore& dense_store);
     void load_tensor_store(search::attribute::BlobSequenceReader& reader, uint32_t docid_limit);
+    void load_tensor_store_in_batches(search::attribute::BlobSequenceReader& reader, uint32_t docid_limit, vespalib::Executor& executor);
     void build_index(vespalib::Executor* executor, uint32_t docid_limit);
     bool load_index();
     uint64_t get_index_size_on_disk();
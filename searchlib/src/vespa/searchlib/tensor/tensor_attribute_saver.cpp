@@ -3,16 +3,30 @@
 #include "tensor_attribute_saver.h"
 #include "dense_tensor_store.h"
 #include "nearest_neighbor_index_saver.h"
+#include "parallel_workers.h"
 #include "tensor_attribute_constants.h"
 #include <vespa/searchlib/util/bufferwriter.h>
 #include <vespa/searchlib/attribute/iattributesavetarget.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <exception>
+#include <mutex>
 
 using vespalib::GenerationHandler;
 
 namespace search::tensor {
 
+namespace {
+
+/*
+ * Number of lids encoded by a single task when saving in parallel.
+ */
+constexpr uint32_t SAVE_SEGMENT_SIZE = 4096;
+
+}
+
 TensorAttributeSaver::TensorAttributeSaver(GenerationHandler::Guard &&guard,
                                            const attribute::AttributeHeader &header,
                                            attribute::EntryRefVector&& refs,
@@ -46,6 +60,8 @@ TensorAttributeSaver::onSave(IAttributeSaveTarget &saveTarget)
     auto dense_tensor_store = _tensor_store.as_dense();
     if (dense_tensor_store != nullptr) {
         save_dense_tensor_store(*dat_writer, *dense_tensor_store);
+    } else if (get_executor() != nullptr && _refs.size() > SAVE_SEGMENT_SIZE) {
+        save_tensor_store_in_segments(*dat_writer, *get_executor());
     } else {
         save_tensor_store(*dat_writer);
     }
@@ -77,6 +93,65 @@ TensorAttributeSaver::save_tensor_store(BufferWriter& writer) const
     writer.flush();
 }
 
+/*
+ * Encodes lid-range segments in parallel into memory buffers that are
+ * written to the file in lid order, giving the same file as
+ * save_tensor_store(). At most two segments per task are buffered.
+ */
+void
+TensorAttributeSaver::save_tensor_store_in_segments(BufferWriter& writer, vespalib::Executor& executor) const
+{
+    assert(get_header_version() == TENSOR_ATTRIBUTE_VERSION);
+    const uint32_t docid_limit(_refs.size());
+    // The calling thread is also a worker
+    const uint32_t num_tasks = 1 + executor_num_threads(executor);
+    std::vector<vespalib::nbostream> segments(2 * num_tasks);
+    const size_t window_size = segments.size() * SAVE_SEGMENT_SIZE;
+    for (size_t window_start = 0; window_start < docid_limit; window_start += window_size) {
+        uint32_t num_segments = std::min(segments.size(), (docid_limit - window_start + SAVE_SEGMENT_SIZE - 1) / SAVE_SEGMENT_SIZE);
+        std::atomic<uint32_t> next(0);
+        std::mutex error_mutex;
+        std::exception_ptr error;
+        run_parallel_workers(executor, std::min(num_tasks, num_segments), vespalib::CpuUsage::Category::WRITE, [&]() {
+            try {
+                for (uint32_t i = next++; i < num_segments; i = next++) {
+                    uint32_t start_lid = window_start + i * SAVE_SEGMENT_SIZE;
+                    uint32_t end_lid = std::min(docid_limit, start_lid + SAVE_SEGMENT_SIZE);
+                    encode_segment(start_lid, end_lid, segments[i]);
+                }
+            } catch (...) {
+                std::lock_guard guard(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        for (uint32_t i = 0; i < num_segments; ++i) {
+            writer.write(segments[i].peek(), segments[i].size());
+            segments[i].clear();
+        }
+    }
+    writer.flush();
+}
+
+void
+TensorAttributeSaver::encode_segment(uint32_t start_lid, uint32_t end_lid, vespalib::nbostream& segment) const
+{
+    vespalib::nbostream stream;
+    for (uint32_t lid = start_lid; lid < end_lid; ++lid) {
+        uint32_t sz = 0;
+        if (_tensor_store.encode_stored_tensor(_refs[lid], stream)) {
+            sz = stream.size();
+        }
+        segment.write(&sz, sizeof(sz));
+        segment.write(stream.peek(), sz);
+        stream.clear();
+    }
+}
+
 void
 TensorAttributeSaver::save_dense_tensor_store(BufferWriter& writer, const DenseTensorStore& dense_tensor_store) const
 {
@@ -7,6 +7,7 @@
 #include <vespa/searchlib/attribute/save_utils.h>
 
 namespace search { class BufferWriter; }
+namespace vespalib { class Executor; class nbostream; }
 
 namespace search::tensor {
 
@@ -28,6 +29,8 @@ class TensorAttributeSaver : public AttributeSaver {
     bool onSave(IAttributeSaveTarget &saveTarget) override;
     void save_dense_tensor_store(BufferWriter& writer, const DenseTensorStore& dense_tensor_store) const;
     void save_tensor_store(BufferWriter& writer) const;
+    void save_tensor_store_in_segments(BufferWriter& writer, vespalib::Executor& executor) const;
+    void encode_segment(uint32_t start_lid, uint32_t end_lid, vespalib::nbostream& segment) const;
 
 public:
     TensorAttributeSaver(GenerationHandler::Guard &&guard,
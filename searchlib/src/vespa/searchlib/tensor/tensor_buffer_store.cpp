@@ -97,13 +97,19 @@ TensorBufferStore::store_tensor(const Value &tensor)
 
 EntryRef
 TensorBufferStore::store_encoded_tensor(vespalib::nbostream &encoded)
+{
+    return store_tensor(*decode_encoded_tensor(encoded));
+}
+
+std::unique_ptr<Value>
+TensorBufferStore::decode_encoded_tensor(vespalib::nbostream &encoded) const
 {
     const auto &factory = StreamedValueBuilderFactory::get();
     auto val = vespalib::eval::decode_value(encoded, factory);
     if (!encoded.empty()) {
         throw DeserializeException("Leftover bytes deserializing tensor attribute value.", VESPA_STRLOC);
     }
-    return store_tensor(*val);
+    return val;
 }
 
 std::unique_ptr<Value>
@@ -1,6 +1,8 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "tensor_store.h"
+#include "tensor_deserialize.h"
+#include <vespa/eval/eval/value.h>
 #include <vespa/vespalib/datastore/data_store_explorer.h>
 
 using vespalib::datastore::DataStoreExplorer;
@@ -14,6 +16,18 @@ TensorStore::TensorStore(vespalib::datastore::DataStoreBase &store)
 
 TensorStore::~TensorStore() = default;
 
+std::unique_ptr<vespalib::eval::Value>
+TensorStore::decode_encoded_tensor(vespalib::nbostream& encoded) const
+{
+    return deserialize_tensor(encoded);
+}
+
+TensorStore::EntryRef
+TensorStore::store_decoded_tensor(std::unique_ptr<vespalib::eval::Value> tensor)
+{
+    return store_tensor(*tensor);
+}
+
 const DenseTensorStore*
 TensorStore::as_dense() const
 {
@@ -49,6 +49,13 @@ public:
 
     virtual EntryRef store_tensor(const vespalib::eval::Value& tensor) = 0;
     virtual EntryRef store_encoded_tensor(vespalib::nbostream& encoded) = 0;
+    /*
+     * Decodes a tensor without modifying the store. This is thread safe,
+     * allowing tensors to be decoded in parallel (e.g. during load) before
+     * being stored by the writer using store_decoded_tensor().
+     */
+    virtual std::unique_ptr<vespalib::eval::Value> decode_encoded_tensor(vespalib::nbostream& encoded) const;
+    virtual EntryRef store_decoded_tensor(std::unique_ptr<vespalib::eval::Value> tensor);
     virtual std::unique_ptr<vespalib::eval::Value> get_tensor(EntryRef ref) const = 0;
     virtual bool encode_stored_tensor(EntryRef ref, vespalib::nbostream& target) const = 0;
     virtual const DenseTensorStore* as_dense() const;
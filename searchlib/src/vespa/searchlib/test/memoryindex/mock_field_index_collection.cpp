@@ -17,13 +17,13 @@ MockFieldIndexCollection::MockFieldIndexCollection(FieldIndexRemover& remover,
 MockFieldIndexCollection::~MockFieldIndexCollection() = default;
 
 FieldIndexRemover&
-MockFieldIndexCollection::get_remover(uint32_t)
+MockFieldIndexCollection::get_remover(uint32_t, uint32_t)
 {
     return _remover;
 }
 
 IOrderedFieldIndexInserter&
-MockFieldIndexCollection::get_inserter(uint32_t field_id)
+MockFieldIndexCollection::get_inserter(uint32_t field_id, uint32_t)
 {
     if (_inserters.size() <= field_id) {
         _inserters.resize(field_id + 1);
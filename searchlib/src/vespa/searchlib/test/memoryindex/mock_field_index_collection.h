@@ -27,8 +27,9 @@ public:
                              OrderedFieldIndexInserterBackend& inserter_backend,
                              index::FieldLengthCalculator& calculator);
     ~MockFieldIndexCollection() override;
-    FieldIndexRemover& get_remover(uint32_t) override;
-    IOrderedFieldIndexInserter& get_inserter(uint32_t field_id) override;
+    uint32_t get_num_shards(uint32_t) const override { return 1; }
+    FieldIndexRemover& get_remover(uint32_t, uint32_t) override;
+    IOrderedFieldIndexInserter& get_inserter(uint32_t field_id, uint32_t) override;
     index::FieldLengthCalculator& get_calculator(uint32_t) override;
 };
 
@@ -9,6 +9,8 @@ namespace search::memoryindex::test {
 
 /**
  * Test class used to populate a FieldIndex.
+ *
+ * When constructed from a FieldIndexCollection the field index is assumed to be unsharded.
  */
 class WrapInserter {
 private:
@@ -16,11 +18,11 @@ private:
 
 public:
     WrapInserter(FieldIndexCollection& field_indexes, uint32_t field_id)
-        : _inserter(field_indexes.getFieldIndex(field_id)->getInserter())
+        : _inserter(field_indexes.get_inserter(field_id, 0))
     {
     }
 
-    WrapInserter(IFieldIndex& field_index)
+    WrapInserter(IFieldIndexShard& field_index)
             : _inserter(field_index.getInserter())
     {
     }
@@ -42,6 +42,14 @@ ImpureValueBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash
 
 struct DocidExecutor : FeatureExecutor {
     void execute(uint32_t docid) override { outputs().set_number(0, docid); }
+    bool has_batch_execute() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t * const>,
+                       std::span<feature_t * const> outputs_in) override
+    {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            outputs_in[0][i] = docids[i];
+        }
+    }
 };
 
 bool
@@ -121,4 +129,36 @@ TrackingBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash &st
 
 //-----------------------------------------------------------------------------
 
+struct PrefetchingExecutor : FeatureExecutor {
+    std::vector<uint32_t> &prefetched;
+    PrefetchingExecutor(std::vector<uint32_t> &prefetched_in) : prefetched(prefetched_in) {}
+    bool isPure() override { return true; }
+    bool has_prefetch() const override { return true; }
+    void prefetch(uint32_t docid) const override { prefetched.push_back(docid); }
+    void execute(uint32_t) override {
+        outputs().set_number(0, inputs().get_number(0));
+    }
+};
+
+bool
+PrefetchingBlueprint::setup(const IIndexEnvironment &, const std::vector<std::string> &params)
+{
+    bool failed = false;
+    EXPECT_EQ(1u, params.size()) << (failed = true, "");
+    if (failed) {
+        return false;
+    }
+    defineInput(params[0]);
+    describeOutput("out", "prefetched value");
+    return true;
+}
+
+FeatureExecutor &
+PrefetchingBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash &stash) const
+{
+    return stash.create<PrefetchingExecutor>(prefetched);
+}
+
+//-----------------------------------------------------------------------------
+
 }
@@ -57,6 +57,18 @@ struct TrackingBlueprint : Blueprint {
 
 //-----------------------------------------------------------------------------
 
+// "prefetch(docid)" calculates docid and records the docids it is asked to prefetch
+struct PrefetchingBlueprint : Blueprint {
+    std::vector<uint32_t> &prefetched;
+    PrefetchingBlueprint(std::vector<uint32_t> &prefetched_in) : Blueprint("prefetch"), prefetched(prefetched_in) {}
+    void visitDumpFeatures(const IIndexEnvironment &, IDumpFeatureVisitor &) const override {}
+    Blueprint::UP createInstance() const override { return Blueprint::UP(new PrefetchingBlueprint(prefetched)); }
+    bool setup(const IIndexEnvironment &, const std::vector<std::string> &params) override;
+    FeatureExecutor &createExecutor(const IQueryEnvironment &, vespalib::Stash &stash) const override;
+};
+
+//-----------------------------------------------------------------------------
+
 } // namespace test
 } // namespace fef
 } // namespace search
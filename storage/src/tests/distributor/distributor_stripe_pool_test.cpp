@@ -89,4 +89,34 @@ TEST_F(DistributorStripePoolThreadingTest, can_park_and_unpark_multiple_stripes)
     _pool.stop_and_join();
 }
 
+TEST_F(DistributorStripePoolThreadingTest, parked_threads_run_task_on_their_own_stripe) {
+    ParkingInvariantCheckingMockStripe s1(_is_parked);
+    ParkingInvariantCheckingMockStripe s2(_is_parked);
+    ParkingInvariantCheckingMockStripe s3(_is_parked);
+    ParkingInvariantCheckingMockStripe s4(_is_parked);
+    std::vector<TickableStripe*> stripes({&s1, &s2, &s3, &s4});
+
+    _pool.start(stripes);
+    for (size_t cycle = 0; cycle < 10; ++cycle) {
+        std::vector<std::thread::id> task_threads(stripes.size());
+        std::vector<TickableStripe*> task_stripes(stripes.size());
+        _pool.park_all_threads();
+        _is_parked = true;
+        _pool.run_on_all_parked_threads([&](size_t stripe_idx, TickableStripe& stripe) {
+            task_threads[stripe_idx] = std::this_thread::get_id();
+            task_stripes[stripe_idx] = &stripe;
+        });
+        _is_parked = false;
+        _pool.unpark_all_threads();
+        EXPECT_EQ(stripes, task_stripes);
+        for (size_t i = 0; i < stripes.size(); ++i) {
+            EXPECT_NE(std::this_thread::get_id(), task_threads[i]);
+            for (size_t j = i + 1; j < stripes.size(); ++j) {
+                EXPECT_NE(task_threads[i], task_threads[j]);
+            }
+        }
+    }
+    _pool.stop_and_join();
+}
+
 }
@@ -168,6 +168,12 @@ struct DistributorStripeTest : Test, DistributorStripeTestUtil {
         });
     }
 
+    void configure_concurrent_consistent_gets_enabled(bool enabled) {
+        configure_stripe_with([&](auto& builder) {
+            builder.enableConcurrentGetsForConsistentBuckets = enabled;
+        });
+    }
+
     [[nodiscard]] bool distributor_owns_bucket_in_current_and_pending_states(document::BucketId bucket_id) const {
         return (getDistributorBucketSpace().get_bucket_ownership_flags(bucket_id).owned_in_pending_state() &&
                 getDistributorBucketSpace().check_ownership_in_pending_and_current_state(bucket_id).isOwned());
@@ -177,6 +183,7 @@ struct DistributorStripeTest : Test, DistributorStripeTestUtil {
     void configure_merge_busy_inhibit_duration(int seconds);
 
     void set_up_and_start_get_op_with_stale_reads_enabled(bool enabled);
+    void set_up_and_start_get_op_with_concurrent_consistent_gets(const std::string& replicas);
 
     void simulate_cluster_state_transition(const std::string& state_str, bool clear_pending);
     static std::shared_ptr<api::RemoveReply> make_remove_reply_with_bucket_remap(api::StorageCommand& originator_cmd);
@@ -793,6 +800,19 @@ TEST_F(DistributorStripeTest, stale_reads_config_is_propagated_to_external_opera
     EXPECT_FALSE(getExternalOperationHandler().concurrent_gets_enabled());
 }
 
+TEST_F(DistributorStripeTest, concurrent_consistent_gets_config_is_propagated_to_external_operation_handler)
+{
+    setup_stripe(Redundancy(1), NodeCount(1), "distributor:1 storage:1");
+    EXPECT_FALSE(getExternalOperationHandler().concurrent_consistent_gets_enabled());
+
+    configure_concurrent_consistent_gets_enabled(true);
+    EXPECT_TRUE(getConfig().enable_concurrent_gets_for_consistent_buckets());
+    EXPECT_TRUE(getExternalOperationHandler().concurrent_consistent_gets_enabled());
+
+    configure_concurrent_consistent_gets_enabled(false);
+    EXPECT_FALSE(getExternalOperationHandler().concurrent_consistent_gets_enabled());
+}
+
 TEST_F(DistributorStripeTest, fast_path_on_consistent_gets_config_is_propagated_to_internal_config)
 {
     setup_stripe(Redundancy(1), NodeCount(1), "distributor:1 storage:1");
@@ -895,6 +915,37 @@ TEST_F(DistributorStripeTest, gets_are_not_started_outside_main_stripe_logic_if_
     EXPECT_THAT(_sender.replies(), SizeIs(0));
 }
 
+void
+DistributorStripeTest::set_up_and_start_get_op_with_concurrent_consistent_gets(const std::string& replicas)
+{
+    setup_stripe(Redundancy(2), NodeCount(2), "distributor:1 storage:2");
+    configure_concurrent_consistent_gets_enabled(true);
+
+    document::BucketId bucket(16, 1);
+    addNodesToBucketDB(bucket, replicas);
+    _stripe->handle_or_enqueue_message(make_dummy_get_command_for_bucket_1());
+}
+
+TEST_F(DistributorStripeTest, gets_to_consistent_buckets_are_started_outside_main_stripe_logic_if_enabled)
+{
+    set_up_and_start_get_op_with_concurrent_consistent_gets("0=1/1/1/t,1=1/1/1/t");
+    ASSERT_THAT(_sender.commands(), SizeIs(1));
+    EXPECT_THAT(_sender.replies(), SizeIs(0));
+
+    auto reply = std::shared_ptr<api::StorageReply>(_sender.command(0)->makeReply());
+    _stripe->handle_or_enqueue_message(reply);
+    ASSERT_THAT(_sender.commands(), SizeIs(1));
+    EXPECT_THAT(_sender.replies(), SizeIs(1));
+}
+
+TEST_F(DistributorStripeTest, gets_to_inconsistent_buckets_are_not_started_outside_main_stripe_logic)
+{
+    set_up_and_start_get_op_with_concurrent_consistent_gets("0=1/1/1/t,1=2/2/2/t");
+    // Get has been placed into distributor queue, so no external messages are produced.
+    EXPECT_THAT(_sender.commands(), SizeIs(0));
+    EXPECT_THAT(_sender.replies(), SizeIs(0));
+}
+
 // There's no need or desire to track "lockfree" Gets in the main pending message tracker,
 // as we only have to track mutations to inhibit maintenance ops safely. Furthermore,
 // the message tracker is a multi-index and therefore has some runtime cost.
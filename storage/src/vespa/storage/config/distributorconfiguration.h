@@ -237,6 +237,12 @@ public:
     [[nodiscard]] bool symmetric_put_and_activate_replica_selection() const noexcept {
         return _symmetric_put_and_activate_replica_selection;
     }
+    void set_enable_concurrent_gets_for_consistent_buckets(bool enable) noexcept {
+        _enable_concurrent_gets_for_consistent_buckets = enable;
+    }
+    [[nodiscard]] bool enable_concurrent_gets_for_consistent_buckets() const noexcept {
+        return _enable_concurrent_gets_for_consistent_buckets;
+    }
 
     [[nodiscard]] bool containsTimeStatement(const std::string& documentSelection) const;
     
@@ -280,6 +286,7 @@ private:
     bool _enable_metadata_only_fetch_phase_for_inconsistent_updates; //TODO Rewrite tests and GC
     bool _enable_operation_cancellation;
     bool _symmetric_put_and_activate_replica_selection;
+    bool _enable_concurrent_gets_for_consistent_buckets;
 
     ReplicaCountingMode _minimumReplicaCountingMode;
 };
@@ -891,6 +891,8 @@ DistributorStripe::propagate_config_snapshot_to_internal_components()
     _bucketDBUpdater.set_stale_reads_enabled(getConfig().allowStaleReadsDuringClusterStateTransitions());
     _externalOperationHandler.set_concurrent_gets_enabled(
             getConfig().allowStaleReadsDuringClusterStateTransitions());
+    _externalOperationHandler.set_concurrent_consistent_gets_enabled(
+            getConfig().enable_concurrent_gets_for_consistent_buckets());
     _externalOperationHandler.set_use_weak_internal_read_consistency_for_gets(
             getConfig().use_weak_internal_read_consistency_for_client_gets());
 }
@@ -65,6 +65,30 @@ void DistributorStripePool::unpark_all_threads() noexcept {
     _parker_cond.wait(lock, [this]{ return (_parked_threads == 0); });
 }
 
+void DistributorStripePool::run_on_all_parked_threads(const std::function<void(size_t, TickableStripe&)>& task) {
+    if (_single_threaded_test_mode) {
+        for (size_t i = 0; i < _stripes.size(); ++i) {
+            task(i, _stripes[i]->stripe());
+        }
+        return;
+    }
+    std::vector<std::function<void()>> thread_tasks;
+    thread_tasks.reserve(_stripes.size());
+    for (size_t i = 0; i < _stripes.size(); ++i) {
+        thread_tasks.emplace_back([&task, i, &stripe = _stripes[i]->stripe()]() { task(i, stripe); });
+    }
+    for (size_t i = 0; i < _stripes.size(); ++i) {
+        _stripes[i]->run_task_while_parked(thread_tasks[i]);
+    }
+    for (auto& s : _stripes) {
+        s->wait_until_parked_task_done();
+    }
+}
+
+size_t DistributorStripePool::stripe_index_of_key(uint64_t key) const noexcept {
+    return stripe_of_bucket_key(key, _n_stripe_bits);
+}
+
 const TickableStripe& DistributorStripePool::stripe_of_key(uint64_t key) const noexcept {
     return stripe_thread(stripe_of_bucket_key(key, _n_stripe_bits)).stripe();
 }
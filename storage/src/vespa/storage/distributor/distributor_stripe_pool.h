@@ -5,6 +5,7 @@
 #include <vespa/vespalib/util/thread.h>
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <vector>
 
@@ -27,6 +28,9 @@ class TickableStripe;
  *   - unpark_all_threads() returns once ALL threads have been confirmed released from
  *     a previously parked state. Must be called after park_all_threads().
  *
+ * While parked, the threads may be used to do work on their own stripes in parallel by
+ * calling run_on_all_parked_threads().
+ *
  * Neither park_all_threads() or unpark_all_threads() may be called prior to calling start().
  *
  * It's possible to set stripe thread tick-specific options (wait duration, ticks before
@@ -74,6 +78,11 @@ public:
 
     void park_all_threads() noexcept;
     void unpark_all_threads() noexcept;
+    // Runs task(stripe_index, stripe) for all stripes, each on its own (parked) stripe thread,
+    // and returns once all of them have completed. Must be called between park_all_threads()
+    // and unpark_all_threads(). The task must only access state owned by the given stripe, or
+    // state that is safe to access concurrently.
+    void run_on_all_parked_threads(const std::function<void(size_t, TickableStripe&)>& task);
 
     [[nodiscard]] const DistributorStripeThread& stripe_thread(size_t idx) const noexcept {
         return *_stripes[idx];
@@ -82,6 +91,7 @@ public:
         return *_stripes[idx];
     }
     void notify_stripe_event_has_triggered(size_t stripe_idx) noexcept;
+    [[nodiscard]] size_t stripe_index_of_key(uint64_t key) const noexcept;
     [[nodiscard]] const TickableStripe& stripe_of_key(uint64_t key) const noexcept;
     [[nodiscard]] TickableStripe& stripe_of_key(uint64_t key) noexcept;
     [[nodiscard]] size_t stripe_count() const noexcept { return _stripes.size(); }
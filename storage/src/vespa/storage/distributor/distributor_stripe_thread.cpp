@@ -18,7 +18,8 @@ DistributorStripeThread::DistributorStripeThread(TickableStripe& stripe,
       _ticks_before_wait(10),
       _should_park(false),
       _should_stop(false),
-      _waiting_for_event(false)
+      _waiting_for_event(false),
+      _parked_task(nullptr)
 {}
 
 DistributorStripeThread::~DistributorStripeThread() = default;
@@ -70,8 +71,30 @@ void DistributorStripeThread::wait_until_event_notified_or_timed_out() noexcept
 
 void DistributorStripeThread::wait_until_unparked() noexcept {
     std::unique_lock lock(_mutex);
-    // _should_park is always written within _mutex, relaxed load is safe.
-    _park_cond.wait(lock, [this]{ return !should_park_relaxed(); });
+    for (;;) {
+        // _should_park is always written within _mutex, relaxed load is safe.
+        _park_cond.wait(lock, [this]{ return (!should_park_relaxed() || (_parked_task != nullptr)); });
+        if (_parked_task == nullptr) {
+            return;
+        }
+        lock.unlock();
+        (*_parked_task)();
+        lock.lock();
+        _parked_task = nullptr;
+        _park_cond.notify_all();
+    }
+}
+
+void DistributorStripeThread::run_task_while_parked(const std::function<void()>& task) noexcept {
+    std::lock_guard lock(_mutex);
+    assert(should_park_relaxed() && (_parked_task == nullptr));
+    _parked_task = &task;
+    _park_cond.notify_all();
+}
+
+void DistributorStripeThread::wait_until_parked_task_done() noexcept {
+    std::unique_lock lock(_mutex);
+    _park_cond.wait(lock, [this]{ return (_parked_task == nullptr); });
 }
 
 void DistributorStripeThread::notify_event_has_triggered() noexcept {
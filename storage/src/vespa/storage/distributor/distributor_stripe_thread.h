@@ -4,6 +4,7 @@
 #include <vespa/vespalib/util/time.h>
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <vector>
 
@@ -33,6 +34,7 @@ class DistributorStripeThread {
     std::atomic<bool>       _should_park;
     std::atomic<bool>       _should_stop;
     bool                    _waiting_for_event;
+    const std::function<void()>* _parked_task; // Must be protected by _mutex
 
     friend class DistributorStripePool;
 public:
@@ -76,6 +78,9 @@ private:
     void unpark_thread() noexcept;
     void wait_until_event_notified_or_timed_out() noexcept;
     void wait_until_unparked() noexcept;
+    // Hands a task to a parked thread, which runs it before going back to waiting for being unparked.
+    void run_task_while_parked(const std::function<void()>& task) noexcept;
+    void wait_until_parked_task_done() noexcept;
 
     void signal_should_stop() noexcept;
 };
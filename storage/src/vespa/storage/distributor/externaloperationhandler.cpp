@@ -91,6 +91,7 @@ ExternalOperationHandler::ExternalOperationHandler(DistributorNodeContext& node_
       _non_main_thread_ops_owner(*_direct_dispatch_sender, _node_ctx.clock()),
       _uuid_generator(std::make_unique<CryptoUuidGenerator>()),
       _concurrent_gets_enabled(false),
+      _concurrent_consistent_gets_enabled(false),
       _use_weak_internal_read_consistency_for_gets(false)
 {
 }
@@ -441,7 +442,7 @@ api::InternalReadConsistency ExternalOperationHandler::desired_get_read_consiste
             : api::InternalReadConsistency::Strong);
 }
 
-std::shared_ptr<Operation> ExternalOperationHandler::try_generate_get_operation(const std::shared_ptr<api::GetCommand>& cmd) {
+std::shared_ptr<GetOperation> ExternalOperationHandler::try_generate_get_operation(const std::shared_ptr<api::GetCommand>& cmd) {
     document::Bucket bucket(cmd->getBucket().getBucketSpace(), _op_ctx.make_split_bit_constrained_bucket_id(cmd->getDocumentId()));
     auto& metrics = getMetrics().gets;
     auto snapshot = _op_ctx.read_snapshot_for_bucket(bucket);
@@ -515,10 +516,16 @@ bool ExternalOperationHandler::try_handle_message_outside_main_thread(const std:
         //  4) Get-reply from content node is disregarded since concurrent reads are no longer allowed
         //  5) We've effectively leaked a Get operation, and the client will time out
         // TODO consider having stale reads _not_ be a live config instead!
-        if (!concurrent_gets_enabled()) {
+        const bool all_gets = concurrent_gets_enabled();
+        if (!all_gets && !concurrent_consistent_gets_enabled()) {
             return false;
         }
         auto op = try_generate_get_operation(std::dynamic_pointer_cast<api::GetCommand>(msg));
+        if (op && !all_gets && !op->all_bucket_metadata_initially_consistent()) {
+            // Out of sync replicas may require several rounds of sending, so leave these to the
+            // stripe thread. The operation has not been started, so it can just be dropped.
+            return false;
+        }
         if (op) {
             std::lock_guard g(_non_main_thread_ops_mutex);
             _non_main_thread_ops_owner.start(std::move(op), msg->getPriority());
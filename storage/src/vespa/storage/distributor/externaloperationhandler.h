@@ -17,6 +17,7 @@ namespace storage::distributor {
 
 class DistributorMetricSet;
 class DirectDispatchSender;
+class GetOperation;
 class MaintenanceOperationGenerator;
 class OperationSequencer;
 class OperationOwner;
@@ -72,6 +73,14 @@ public:
         return _concurrent_gets_enabled.load(std::memory_order_relaxed);
     }
 
+    void set_concurrent_consistent_gets_enabled(bool enabled) noexcept {
+        _concurrent_consistent_gets_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool concurrent_consistent_gets_enabled() const noexcept {
+        return _concurrent_consistent_gets_enabled.load(std::memory_order_relaxed);
+    }
+
     void set_use_weak_internal_read_consistency_for_gets(bool use_weak) noexcept {
         _use_weak_internal_read_consistency_for_gets.store(use_weak, std::memory_order_relaxed);
     }
@@ -101,6 +110,7 @@ private:
     OperationOwner _non_main_thread_ops_owner;
     std::unique_ptr<UuidGenerator> _uuid_generator;
     std::atomic<bool> _concurrent_gets_enabled;
+    std::atomic<bool> _concurrent_consistent_gets_enabled;
     std::atomic<bool> _use_weak_internal_read_consistency_for_gets;
 
     template <typename Func>
@@ -118,7 +128,7 @@ private:
                                                   const lib::ClusterState& pending_state);
     void bounce_with_result(api::StorageCommand& cmd, const api::ReturnCode& result);
     void bounce_with_feed_blocked(api::StorageCommand& cmd);
-    std::shared_ptr<Operation> try_generate_get_operation(const std::shared_ptr<api::GetCommand>&);
+    std::shared_ptr<GetOperation> try_generate_get_operation(const std::shared_ptr<api::GetCommand>&);
 
     bool checkSafeTimeReached(api::StorageCommand& cmd);
     api::ReturnCode makeSafeTimeRejectionResult(TimePoint unsafeTime);
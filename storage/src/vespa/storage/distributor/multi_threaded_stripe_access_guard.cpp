@@ -70,10 +70,14 @@ MultiThreadedStripeAccessGuard::remove_superfluous_buckets(document::BucketSpace
                                                            const lib::ClusterState& new_state,
                                                            bool is_distribution_change)
 {
-    PotentialDataLossReport report;
-    for_each_stripe([&](TickableStripe& stripe) {
-        report.merge(stripe.remove_superfluous_buckets(bucket_space, new_state, is_distribution_change));
+    std::vector<PotentialDataLossReport> stripe_reports(_stripe_pool.stripe_count());
+    for_each_stripe_in_parallel([&](size_t stripe_idx, TickableStripe& stripe) {
+        stripe_reports[stripe_idx] = stripe.remove_superfluous_buckets(bucket_space, new_state, is_distribution_change);
     });
+    PotentialDataLossReport report;
+    for (const auto& stripe_report : stripe_reports) {
+        report.merge(stripe_report);
+    }
     return report;
 }
 
@@ -89,23 +93,20 @@ MultiThreadedStripeAccessGuard::merge_entries_into_db(document::BucketSpace buck
     if (entries.empty()) {
         return;
     }
-    std::vector<dbtransition::Entry> stripe_entries;
-    stripe_entries.reserve(entries.size() / _stripe_pool.stripe_count());
-    auto* curr_stripe = &_stripe_pool.stripe_of_key(entries[0].bucket_key);
-    stripe_entries.push_back(entries[0]);
-    for (size_t i = 1; i < entries.size(); ++i) {
-        const auto& entry = entries[i];
-        auto* next_stripe = &_stripe_pool.stripe_of_key(entry.bucket_key);
-        if (curr_stripe != next_stripe) {
-            curr_stripe->merge_entries_into_db(bucket_space, gathered_at_timestamp, distribution,
-                                               new_state, storage_up_states, outdated_nodes, stripe_entries);
-            stripe_entries.clear();
-        }
-        curr_stripe = next_stripe;
-        stripe_entries.push_back(entry);
+    // Entries are sorted by bucket key, so each stripe's entries remain sorted.
+    std::vector<std::vector<dbtransition::Entry>> stripe_entries(_stripe_pool.stripe_count());
+    for (auto& e : stripe_entries) {
+        e.reserve(entries.size() / _stripe_pool.stripe_count());
+    }
+    for (const auto& entry : entries) {
+        stripe_entries[_stripe_pool.stripe_index_of_key(entry.bucket_key)].push_back(entry);
     }
-    curr_stripe->merge_entries_into_db(bucket_space, gathered_at_timestamp, distribution,
-                                       new_state, storage_up_states, outdated_nodes, stripe_entries);
+    for_each_stripe_in_parallel([&](size_t stripe_idx, TickableStripe& stripe) {
+        if (!stripe_entries[stripe_idx].empty()) {
+            stripe.merge_entries_into_db(bucket_space, gathered_at_timestamp, distribution,
+                                         new_state, storage_up_states, outdated_nodes, stripe_entries[stripe_idx]);
+        }
+    });
 }
 
 void MultiThreadedStripeAccessGuard::update_read_snapshot_before_db_pruning() {
@@ -174,6 +175,11 @@ void MultiThreadedStripeAccessGuard::for_each_stripe(Func&& f) {
     }
 }
 
+template <typename Func>
+void MultiThreadedStripeAccessGuard::for_each_stripe_in_parallel(Func&& f) {
+    _stripe_pool.run_on_all_parked_threads(std::forward<Func>(f));
+}
+
 template <typename Func>
 void MultiThreadedStripeAccessGuard::for_each_stripe(Func&& f) const {
     for (const auto& stripe_thread : _stripe_pool) {
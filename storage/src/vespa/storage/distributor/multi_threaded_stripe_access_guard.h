@@ -67,6 +67,11 @@ private:
 
     template <typename Func>
     void for_each_stripe(Func&& f) const;
+
+    // Runs f(stripe_index, stripe) on each stripe's own thread. Only for work touching
+    // stripe-local state, such as the stripe's part of the bucket database.
+    template <typename Func>
+    void for_each_stripe_in_parallel(Func&& f);
 };
 
 /**
@@ -18,6 +18,7 @@
 #include <vespa/vespalib/datastore/compaction_strategy.h>
 #include <vespa/vespalib/test/btree/btree_printer.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <limits>
 #include <string>
 
 #include <vespa/log/log.h>
@@ -711,6 +712,92 @@ TEST_F(BTreeTest, require_that_node_lower_bound_works)
     cleanup(g, m, nPair.ref, n);
 }
 
+template <typename KeyT>
+void
+check_key_search(std::vector<KeyT> keys, const std::vector<KeyT> &needles)
+{
+    std::sort(keys.begin(), keys.end());
+    static_assert(use_simd_key_search<KeyT, std::less<KeyT>>);
+    for (uint32_t begin = 0; begin <= keys.size(); ++begin) {
+        for (uint32_t end = begin; end <= keys.size(); ++end) {
+            for (KeyT needle : needles) {
+                auto exp_lower = std::lower_bound(keys.data() + begin, keys.data() + end, needle) - keys.data();
+                auto exp_upper = std::upper_bound(keys.data() + begin, keys.data() + end, needle) - keys.data();
+                EXPECT_EQ(exp_lower, key_search::lower_bound(keys.data(), begin, end, needle));
+                EXPECT_EQ(exp_upper, key_search::upper_bound(keys.data(), begin, end, needle));
+            }
+        }
+    }
+}
+
+template <typename KeyT>
+void
+check_key_search()
+{
+    constexpr KeyT min_key = std::numeric_limits<KeyT>::min();
+    constexpr KeyT max_key = std::numeric_limits<KeyT>::max();
+    std::vector<KeyT> keys;
+    std::vector<KeyT> needles({min_key, max_key});
+    for (uint32_t i = 0; i < 35; ++i) {
+        KeyT key = static_cast<KeyT>(i * 3) - static_cast<KeyT>(std::is_signed_v<KeyT> ? 40 : 0);
+        keys.push_back(key);
+        needles.push_back(key);
+        needles.push_back(key + 1);
+    }
+    keys[10] = keys[11];
+    keys.push_back(max_key);
+    keys.push_back(max_key - 1);
+    keys.push_back(min_key);
+    keys.push_back(max_key / 2 + 1);
+    needles.push_back(max_key / 2);
+    needles.push_back(max_key / 2 + 1);
+    check_key_search(std::move(keys), needles);
+}
+
+TEST_F(BTreeTest, require_that_node_key_search_matches_std_lower_and_upper_bound)
+{
+    check_key_search<int32_t>();
+    check_key_search<uint32_t>();
+    check_key_search<int64_t>();
+    check_key_search<uint64_t>();
+    EXPECT_FALSE((use_simd_key_search<uint32_t, std::greater<uint32_t>>));
+    EXPECT_FALSE((use_simd_key_search<EntryRef, std::less<EntryRef>>));
+}
+
+TEST_F(BTreeTest, require_that_seek_works_for_unsigned_keys_above_signed_range)
+{
+    using UTree = BTree<uint32_t, BTreeNoLeafData, btree::NoAggregated, std::less<uint32_t>, BTreeTraits<32, 16, 10, true>>;
+    GenerationHandler g;
+    UTree t;
+    std::vector<uint32_t> keys;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        uint32_t key = (i % 2 == 0) ? (i * 7) : (0xffffffffu - i * 11);
+        keys.push_back(key);
+        EXPECT_TRUE(t.insert(key, BTreeNoLeafData()));
+    }
+    std::sort(keys.begin(), keys.end());
+    for (uint32_t needle : {0u, 1u, 6999u, 0x7fffffffu, 0x80000000u, 0xfffea000u, 0xfffffff4u, 0xffffffffu}) {
+        auto exp_lower = std::lower_bound(keys.begin(), keys.end(), needle);
+        auto exp_upper = std::upper_bound(keys.begin(), keys.end(), needle);
+        auto itr = t.lowerBound(needle);
+        ASSERT_EQ(exp_lower != keys.end(), itr.valid());
+        if (itr.valid()) {
+            EXPECT_EQ(*exp_lower, itr.getKey());
+        }
+        auto uitr = t.upperBound(needle);
+        ASSERT_EQ(exp_upper != keys.end(), uitr.valid());
+        if (uitr.valid()) {
+            EXPECT_EQ(*exp_upper, uitr.getKey());
+        }
+        auto sitr = t.begin();
+        sitr.seek(needle);
+        EXPECT_EQ(itr.valid(), sitr.valid());
+        if (sitr.valid()) {
+            EXPECT_EQ(itr.getKey(), sitr.getKey());
+        }
+    }
+}
+
 void
 generateData(std::vector<LeafPair> & data, size_t numEntries)
 {
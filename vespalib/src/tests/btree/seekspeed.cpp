@@ -0,0 +1,163 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/btree/btree.h>
+#include <vespa/vespalib/btree/btreebuilder.h>
+#include <vespa/vespalib/btree/btreenodeallocator.h>
+#include <vespa/vespalib/btree/btree.hpp>
+#include <vespa/vespalib/btree/btreebuilder.hpp>
+#include <vespa/vespalib/btree/btreeiterator.hpp>
+#include <vespa/vespalib/btree/btreenode.hpp>
+#include <vespa/vespalib/btree/btreenodeallocator.hpp>
+#include <vespa/vespalib/btree/btreenodestore.hpp>
+#include <vespa/vespalib/btree/btreeroot.hpp>
+#include <vespa/vespalib/datastore/buffer_type.hpp>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/time.h>
+#include <cassert>
+#include <cinttypes>
+#include <unistd.h>
+
+/*
+ * Measures seek and lower bound speed on btrees with uint32_t keys (like
+ * posting lists with docid keys), comparing the node key search used with
+ * std::less against std::lower_bound / std::upper_bound (selected by using
+ * a comparator not eligible for the vectorized node key search).
+ */
+
+namespace vespalib::btree {
+
+namespace {
+
+struct ScalarLess {
+    bool operator()(uint32_t lhs, uint32_t rhs) const noexcept { return lhs < rhs; }
+};
+
+const char *compare_name(bool simd) { return simd ? "vectorized" : "std"; }
+
+}
+
+class SeekSpeed
+{
+    template <typename Traits, typename CompareT>
+    void work_loop(int loops, uint32_t stride, int leaf_slots);
+    void usage();
+public:
+    int main(int argc, char **argv);
+};
+
+template <typename Traits, typename CompareT>
+void
+SeekSpeed::work_loop(int loops, uint32_t stride, int leaf_slots)
+{
+    if (leaf_slots != 0 && leaf_slots != static_cast<int>(Traits::LEAF_SLOTS)) {
+        return;
+    }
+    using Tree = BTree<uint32_t, BTreeNoLeafData, NoAggregated, CompareT, Traits>;
+    using Builder = typename Tree::Builder;
+    using ConstIterator = typename Tree::ConstIterator;
+    constexpr bool simd = use_simd_key_search<uint32_t, CompareT>;
+    Tree tree;
+    Builder builder(tree.getAllocator());
+    vespalib::Rand48 rnd;
+    rnd.srand48(42);
+    size_t num_entries = 1000000;
+    uint32_t key = 0;
+    for (size_t i = 0; i < num_entries; ++i) {
+        key += 1 + rnd.lrand48() % 10;
+        builder.insert(key, BTreeNoLeafData());
+    }
+    tree.assign(builder);
+    assert(num_entries == tree.size());
+    uint32_t key_limit = key + 1;
+    std::vector<uint32_t> needles;
+    for (size_t i = 0; i < 1000000; ++i) {
+        needles.push_back(rnd.lrand48() % key_limit);
+    }
+    for (int l = 0; l < loops; ++l) {
+        uint64_t sum = 0;
+        uint64_t seeks = 0;
+        vespalib::Timer timer;
+        for (size_t inner = 0; inner < 10; ++inner) {
+            ConstIterator itr(BTreeNode::Ref(), tree.getAllocator());
+            itr.begin(tree.getRoot());
+            uint32_t next = 1 + inner;
+            while (itr.valid()) {
+                itr.seek(next);
+                ++seeks;
+                if (itr.valid()) {
+                    sum += itr.getKey();
+                    next = itr.getKey() + stride;
+                }
+            }
+        }
+        double seek_used = vespalib::to_s(timer.elapsed());
+        timer = vespalib::Timer();
+        for (uint32_t needle : needles) {
+            auto itr = tree.lowerBound(needle);
+            if (itr.valid()) {
+                sum += itr.getKey();
+            }
+        }
+        double lower_bound_used = vespalib::to_s(timer.elapsed());
+        printf("Elapsed time for %" PRIu64 " seeks (stride=%u) is %8.5f, "
+               "for %zu lower bound lookups is %8.5f, "
+               "search=%s, fanout=%u,%u, sum=%" PRIu64 "\n",
+               seeks, stride, seek_used, needles.size(), lower_bound_used,
+               compare_name(simd),
+               static_cast<int>(Traits::LEAF_SLOTS),
+               static_cast<int>(Traits::INTERNAL_SLOTS),
+               sum);
+        fflush(stdout);
+    }
+}
+
+void
+SeekSpeed::usage()
+{
+    printf("seekspeed "
+           "[-F <leafSlots>] "
+           "[-c <numLoops>] "
+           "[-s <seekStride>]\n");
+}
+
+int
+SeekSpeed::main(int argc, char **argv)
+{
+    int c;
+    int loops = 1;
+    int leaf_slots = 0;
+    uint32_t stride = 50;
+    while ((c = getopt(argc, argv, "F:c:s:")) != -1) {
+        switch (c) {
+        case 'F':
+            leaf_slots = atoi(optarg);
+            break;
+        case 'c':
+            loops = atoi(optarg);
+            break;
+        case 's':
+            stride = atoi(optarg);
+            break;
+        default:
+            usage();
+            return 1;
+        }
+    }
+    using DefTraits = BTreeDefaultTraits;
+    using LargeTraits = BTreeTraits<32, 16, 10, true>;
+    using HugeTraits = BTreeTraits<64, 16, 10, true>;
+    work_loop<DefTraits, ScalarLess>(loops, stride, leaf_slots);
+    work_loop<DefTraits, std::less<uint32_t>>(loops, stride, leaf_slots);
+    work_loop<LargeTraits, ScalarLess>(loops, stride, leaf_slots);
+    work_loop<LargeTraits, std::less<uint32_t>>(loops, stride, leaf_slots);
+    work_loop<HugeTraits, ScalarLess>(loops, stride, leaf_slots);
+    work_loop<HugeTraits, std::less<uint32_t>>(loops, stride, leaf_slots);
+    return 0;
+}
+
+}
+
+int main(int argc, char **argv) {
+    vespalib::btree::SeekSpeed app;
+    return app.main(argc, argv);
+}
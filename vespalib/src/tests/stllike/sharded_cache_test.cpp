@@ -0,0 +1,192 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/stllike/sharded_cache.hpp>
+#include <vespa/vespalib/stllike/cache_budget_manager.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <map>
+#include <string>
+
+using namespace vespalib;
+using namespace ::testing;
+
+namespace {
+
+class Store : public std::map<uint32_t, std::string> {
+public:
+    bool read(uint32_t k, std::string& v) const {
+        auto found = find(k);
+        if (found == end()) {
+            return false;
+        }
+        v = found->second;
+        return true;
+    }
+    void write(uint32_t k, const std::string& v) { (*this)[k] = v; }
+    void erase(uint32_t k) { std::map<uint32_t, std::string>::erase(k); }
+};
+
+using Cache = sharded_cache<CacheParam<LruParam<uint32_t, std::string>, Store, zero<uint32_t>, size<std::string>>>;
+
+class MockClient : public CacheBudgetManager::Client {
+public:
+    CacheStats stats;
+    size_t     capacity;
+    explicit MockClient(size_t capacity_in) : stats(), capacity(capacity_in) {}
+    ~MockClient() override;
+    CacheStats get_stats() const override { return stats; }
+    size_t capacity_bytes() const override { return capacity; }
+    void set_capacity_bytes(size_t capacity_bytes) override { capacity = capacity_bytes; }
+    void use(size_t hits, size_t memory_used) {
+        stats.hits += hits;
+        stats.memory_used = memory_used;
+    }
+};
+
+MockClient::~MockClient() = default;
+
+}
+
+TEST(ShardedCacheTest, number_of_shards_is_rounded_up_to_power_of_2) {
+    Store store;
+    EXPECT_EQ(1u, Cache(store, 1000, 0).num_shards());
+    EXPECT_EQ(1u, Cache(store, 1000, 1).num_shards());
+    EXPECT_EQ(4u, Cache(store, 1000, 3).num_shards());
+    EXPECT_EQ(16u, Cache(store, 1000, 16).num_shards());
+}
+
+TEST(ShardedCacheTest, capacity_is_split_between_shards) {
+    Store store;
+    Cache cache(store, 8000, 2000, 8);
+    EXPECT_EQ(10000u, cache.capacityBytes());
+    EXPECT_EQ(8000u, cache.segment_capacity_bytes(CacheSegment::Probationary));
+    EXPECT_EQ(2000u, cache.segment_capacity_bytes(CacheSegment::Protected));
+    cache.setCapacityBytes(16000);
+    EXPECT_EQ(16000u, cache.capacityBytes());
+    EXPECT_EQ(0u, cache.segment_capacity_bytes(CacheSegment::Protected));
+    cache.maxElements(800);
+    EXPECT_EQ(800u, cache.capacity());
+}
+
+TEST(ShardedCacheTest, elements_are_read_written_and_invalidated_across_shards) {
+    Store store;
+    Cache cache(store, -1, 8);
+    for (uint32_t i = 0; i < 100; ++i) {
+        store[i] = "value " + std::to_string(i);
+    }
+    EXPECT_TRUE(cache.empty());
+    for (uint32_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(store[i], cache.read(i));
+    }
+    for (uint32_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(cache.hasKey(i));
+        EXPECT_EQ(store[i], cache.read(i));
+    }
+    EXPECT_EQ(100u, cache.size());
+    cache.write(200, "written");
+    EXPECT_EQ("written", store[200]);
+    EXPECT_TRUE(cache.hasKey(200));
+    cache.invalidate(3);
+    EXPECT_FALSE(cache.hasKey(3));
+    EXPECT_EQ("value 3", store[3]);
+    cache.erase(4);
+    EXPECT_FALSE(cache.hasKey(4));
+    EXPECT_FALSE(store.contains(4));
+    auto stats = cache.get_stats();
+    EXPECT_EQ(100u, stats.hits);
+    EXPECT_EQ(100u, stats.misses);
+    EXPECT_EQ(99u, stats.elements);
+    EXPECT_EQ(2u, stats.invalidations);
+    EXPECT_EQ(cache.sizeBytes(), stats.memory_used);
+}
+
+TEST(ShardedCacheTest, budget_client_keeps_segment_ratio) {
+    Store store;
+    Cache cache(store, 3000, 1000, 4);
+    CacheBudgetClient client(cache);
+    client.set_capacity_bytes(8000);
+    EXPECT_EQ(8000u, cache.capacityBytes());
+    EXPECT_EQ(2000u, cache.segment_capacity_bytes(CacheSegment::Protected));
+}
+
+TEST(CacheBudgetManagerTest, capacity_is_moved_from_idle_to_busy_caches) {
+    CacheBudgetManager manager(10000, 100);
+    MockClient idle(5000);
+    MockClient busy(5000);
+    manager.add_client(idle);
+    manager.add_client(busy);
+    for (int i = 0; i < 10; ++i) {
+        idle.use(0, 1000);
+        busy.use(100, busy.capacity);
+        manager.rebalance();
+        EXPECT_LE(idle.capacity + busy.capacity, 10000u);
+    }
+    EXPECT_NEAR(1250, idle.capacity, 10);
+    EXPECT_NEAR(8750, busy.capacity, 10);
+    manager.remove_client(idle);
+    EXPECT_EQ(1u, manager.num_clients());
+}
+
+TEST(CacheBudgetManagerTest, full_caches_share_remaining_budget_by_hits) {
+    CacheBudgetManager manager(12000, 0);
+    MockClient a(4000);
+    MockClient b(4000);
+    MockClient c(4000);
+    manager.add_client(a);
+    manager.add_client(b);
+    manager.add_client(c);
+    for (int i = 0; i < 20; ++i) {
+        a.use(300, a.capacity);
+        b.use(100, b.capacity);
+        c.use(0, c.capacity);
+        manager.rebalance();
+        EXPECT_LE(a.capacity + b.capacity + c.capacity, 12000u);
+    }
+    // Each cache keeps a quarter of its initial capacity, the rest is shared by hits
+    EXPECT_NEAR(7750, a.capacity, 10);
+    EXPECT_NEAR(3250, b.capacity, 10);
+    EXPECT_EQ(1000u, c.capacity);
+}
+
+TEST(CacheBudgetManagerTest, caches_without_hits_keep_a_quarter_of_their_initial_capacity) {
+    CacheBudgetManager manager(10000, 0);
+    MockClient idle(5000);
+    MockClient busy(5000);
+    manager.add_client(idle);
+    manager.add_client(busy);
+    for (int i = 0; i < 20; ++i) {
+        idle.use(0, idle.capacity);
+        busy.use(100, busy.capacity);
+        manager.rebalance();
+    }
+    EXPECT_EQ(1250u, idle.capacity);
+    EXPECT_NEAR(8750, busy.capacity, 10);
+}
+
+TEST(CacheBudgetManagerTest, capacity_moves_at_most_a_quarter_of_initial_capacity_per_rebalance) {
+    CacheBudgetManager manager(10000, 0);
+    MockClient idle(5000);
+    MockClient busy(5000);
+    manager.add_client(idle);
+    manager.add_client(busy);
+    idle.use(0, 0);
+    busy.use(100, busy.capacity);
+    manager.rebalance();
+    EXPECT_EQ(3750u, idle.capacity);
+    EXPECT_EQ(6250u, busy.capacity);
+}
+
+TEST(CacheBudgetManagerTest, lowering_budget_shrinks_all_clients) {
+    CacheBudgetManager manager(10000, 100);
+    MockClient a(5000);
+    MockClient b(5000);
+    manager.add_client(a);
+    manager.add_client(b);
+    manager.set_budget_bytes(4000);
+    a.use(10, a.capacity);
+    b.use(10, b.capacity);
+    manager.rebalance();
+    EXPECT_LE(a.capacity + b.capacity, 4000u);
+    EXPECT_EQ(a.capacity, b.capacity);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
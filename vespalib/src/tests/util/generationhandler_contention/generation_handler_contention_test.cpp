@@ -0,0 +1,116 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/time.h>
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <thread>
+#include <vector>
+
+// Measures the cost of taking and releasing generation guards when
+// many reader threads use the same generation handler concurrently,
+// comparing a single shared reference count with per-thread reader
+// slots. A writer thread bumps the generation in the background, as
+// when an attribute vector is fed while being searched.
+
+using vespalib::GenerationHandler;
+
+namespace {
+
+bool smoke_test = false;
+const std::string smoke_test_option = "--smoke-test";
+
+struct Result {
+    double ns_per_guard;
+    uint64_t generations;
+};
+
+Result
+measure(uint32_t num_reader_slots, uint32_t num_readers, uint64_t guards_per_reader)
+{
+    GenerationHandler handler(num_reader_slots);
+    std::atomic<uint32_t> readers_left(num_readers);
+    std::atomic<bool> start(false);
+    uint64_t generations = 0;
+    std::thread writer([&]() {
+        while (!start.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        while (readers_left.load(std::memory_order_relaxed) != 0) {
+            handler.incGeneration();
+            ++generations;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+    std::vector<std::thread> readers;
+    for (uint32_t i = 0; i < num_readers; ++i) {
+        readers.emplace_back([&]() {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            uint64_t sum = 0;
+            for (uint64_t j = 0; j < guards_per_reader; ++j) {
+                auto guard = handler.takeGuard();
+                sum += guard.getGeneration();
+            }
+            EXPECT_LE(sum, guards_per_reader * handler.getCurrentGeneration());
+            readers_left.fetch_sub(1, std::memory_order_relaxed);
+        });
+    }
+    auto before = vespalib::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    auto elapsed = vespalib::steady_clock::now() - before;
+    writer.join();
+    EXPECT_EQ(0u, handler.getGenerationRefCount());
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    return {ns / guards_per_reader, generations};
+}
+
+void
+run_benchmark(uint32_t num_readers)
+{
+    uint64_t guards_per_reader = smoke_test ? 10000 : 10000000;
+    uint32_t sharded_slots = std::max({GenerationHandler::default_num_reader_slots(), num_readers, 2u});
+    for (uint32_t num_reader_slots : {1u, sharded_slots}) {
+        auto result = measure(num_reader_slots, num_readers, guards_per_reader);
+        fprintf(stderr, "%2u readers, %2u reader slots: %8.2f ns per guard (%" PRIu64 " generations)\n",
+                num_readers, num_reader_slots, result.ns_per_guard, result.generations);
+    }
+}
+
+}
+
+TEST(GenerationHandlerContentionTest, take_guard_with_1_reader)
+{
+    run_benchmark(1);
+}
+
+TEST(GenerationHandlerContentionTest, take_guard_with_4_readers)
+{
+    run_benchmark(4);
+}
+
+TEST(GenerationHandlerContentionTest, take_guard_with_16_readers)
+{
+    run_benchmark(16);
+}
+
+TEST(GenerationHandlerContentionTest, take_guard_with_64_readers)
+{
+    run_benchmark(smoke_test ? 8 : 64);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && argv[1] == smoke_test_option) {
+        smoke_test = true;
+        ++argv;
+        --argc;
+    }
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
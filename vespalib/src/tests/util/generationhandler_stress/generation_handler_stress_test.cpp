@@ -76,6 +76,7 @@ protected:
     bool _reportWork;
 
     Fixture();
+    explicit Fixture(uint32_t num_reader_slots);
     ~Fixture();
 
     void set_read_threads(uint32_t read_threads);
@@ -97,8 +98,13 @@ private:
 
 
 Fixture::Fixture()
+    : Fixture(1u)
+{
+}
+
+Fixture::Fixture(uint32_t num_reader_slots)
     : ::testing::Test(),
-      _generationHandler(),
+      _generationHandler(num_reader_slots),
       _readThreads(1),
       _writer(1),
       _readers(),
@@ -286,6 +292,11 @@ Fixture::stress_test_indirect(uint64_t write_cnt)
 
 using GenerationHandlerStressTest = Fixture;
 
+class ShardedGenerationHandlerStressTest : public Fixture {
+protected:
+    ShardedGenerationHandlerStressTest() : Fixture(4u) { }
+};
+
 TEST_F(GenerationHandlerStressTest, stress_test_2_readers)
 {
     set_read_threads(2);
@@ -310,6 +321,18 @@ TEST_F(GenerationHandlerStressTest, stress_test_indirect_4_readers)
     stress_test_indirect(smoke_test ? 10000 : 1000000);
 }
 
+TEST_F(ShardedGenerationHandlerStressTest, stress_test_4_readers)
+{
+    set_read_threads(4);
+    stressTest(smoke_test ? 10000 : 1000000);
+}
+
+TEST_F(ShardedGenerationHandlerStressTest, stress_test_indirect_4_readers)
+{
+    set_read_threads(4);
+    stress_test_indirect(smoke_test ? 10000 : 1000000);
+}
+
 int main(int argc, char **argv) {
     if (argc > 1 && argv[1] == smoke_test_option) {
         smoke_test = true;
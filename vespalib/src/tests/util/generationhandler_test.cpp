@@ -3,12 +3,13 @@
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <deque>
+#include <thread>
 
 namespace vespalib {
 
 using GenGuard = GenerationHandler::Guard;
 
-class GenerationHandlerTest : public ::testing::Test {
+class GenerationHandlerTest : public ::testing::TestWithParam<uint32_t> {
 protected:
     GenerationHandler gh;
     GenerationHandlerTest();
@@ -16,14 +17,14 @@ protected:
 };
 
 GenerationHandlerTest::GenerationHandlerTest()
-    : ::testing::Test(),
-      gh()
+    : ::testing::TestWithParam<uint32_t>(),
+      gh(GetParam())
 {
 }
 
 GenerationHandlerTest::~GenerationHandlerTest() = default;
 
-TEST_F(GenerationHandlerTest, require_that_generation_can_be_increased)
+TEST_P(GenerationHandlerTest, require_that_generation_can_be_increased)
 {
     EXPECT_EQ(0u, gh.getCurrentGeneration());
     EXPECT_EQ(0u, gh.get_oldest_used_generation());
@@ -32,7 +33,7 @@ TEST_F(GenerationHandlerTest, require_that_generation_can_be_increased)
     EXPECT_EQ(1u, gh.get_oldest_used_generation());
 }
 
-TEST_F(GenerationHandlerTest, require_that_readers_can_take_guards)
+TEST_P(GenerationHandlerTest, require_that_readers_can_take_guards)
 {
     EXPECT_EQ(0u, gh.getGenerationRefCount(0));
     {
@@ -70,7 +71,7 @@ TEST_F(GenerationHandlerTest, require_that_readers_can_take_guards)
     EXPECT_EQ(0u, gh.getGenerationRefCount(2));
 }
 
-TEST_F(GenerationHandlerTest, require_that_guards_can_be_copied)
+TEST_P(GenerationHandlerTest, require_that_guards_can_be_copied)
 {
     GenGuard g1 = gh.takeGuard();
     EXPECT_EQ(1u, gh.getGenerationRefCount(0));
@@ -85,7 +86,7 @@ TEST_F(GenerationHandlerTest, require_that_guards_can_be_copied)
     EXPECT_EQ(0u, gh.getGenerationRefCount(1));
 }
 
-TEST_F(GenerationHandlerTest, require_that_the_first_used_generation_is_correct)
+TEST_P(GenerationHandlerTest, require_that_the_first_used_generation_is_correct)
 {
     EXPECT_EQ(0u, gh.get_oldest_used_generation());
     gh.incGeneration();
@@ -117,7 +118,7 @@ TEST_F(GenerationHandlerTest, require_that_the_first_used_generation_is_correct)
     EXPECT_EQ(4u, gh.get_oldest_used_generation());
 }
 
-TEST_F(GenerationHandlerTest, require_that_generation_can_grow_large)
+TEST_P(GenerationHandlerTest, require_that_generation_can_grow_large)
 {
     std::deque<GenGuard> guards;
     for (size_t i = 0; i < 10000; ++i) {
@@ -132,4 +133,41 @@ TEST_F(GenerationHandlerTest, require_that_generation_can_grow_large)
     }
 }
 
+TEST_P(GenerationHandlerTest, require_that_guards_from_many_threads_are_counted)
+{
+    EXPECT_EQ(GetParam(), gh.getNumReaderSlots());
+    constexpr uint32_t num_threads = 8;
+    std::vector<GenGuard> guards(num_threads);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([this, &guards, i]() { guards[i] = gh.takeGuard(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(num_threads, gh.getGenerationRefCount(0));
+    gh.incGeneration();
+    EXPECT_EQ(0u, gh.get_oldest_used_generation());
+    GenGuard copy(guards[3]);
+    EXPECT_EQ(num_threads + 1, gh.getGenerationRefCount(0));
+    guards.clear();
+    gh.update_oldest_used_generation();
+    EXPECT_EQ(0u, gh.get_oldest_used_generation());
+    copy = GenGuard();
+    EXPECT_EQ(0u, gh.getGenerationRefCount(0));
+    gh.update_oldest_used_generation();
+    EXPECT_EQ(1u, gh.get_oldest_used_generation());
+}
+
+TEST(GenerationHandlerDefaultsTest, default_number_of_reader_slots_is_bounded)
+{
+    auto num_reader_slots = GenerationHandler::default_num_reader_slots();
+    EXPECT_LE(1u, num_reader_slots);
+    EXPECT_GE(16u, num_reader_slots);
+}
+
+auto test_values = ::testing::Values(1u, 4u);
+
+INSTANTIATE_TEST_SUITE_P(ReaderSlots, GenerationHandlerTest, test_values, ::testing::PrintToStringParamName());
+
 }
@@ -0,0 +1,91 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace vespalib::btree {
+
+/**
+ * Tells if keys in a btree node can be searched by comparing the needle
+ * against all keys in the node instead of using a binary search. This is
+ * the case for 32-bit and 64-bit integer keys ordered by std::less. The
+ * selection is done at compile time based on the key type and the
+ * comparator used by the tree.
+ */
+template <typename KeyT, typename CompareT>
+constexpr bool use_simd_key_search =
+    std::is_integral_v<KeyT> && !std::is_same_v<KeyT, bool> &&
+    (sizeof(KeyT) == 4 || sizeof(KeyT) == 8) &&
+    (std::is_same_v<CompareT, std::less<KeyT>> || std::is_same_v<CompareT, std::less<>>);
+
+namespace key_search {
+
+/*
+ * Find the first position in [begin, end) with a key that is not less
+ * than (greater than when 'upper' is true) 'key', by counting the keys
+ * before it. Whole vectors of keys are compared with AVX2 when available,
+ * stopping at the first vector containing the bound. Remaining keys are
+ * counted without branching.
+ */
+template <bool upper, typename KeyT>
+uint32_t
+find_bound(const KeyT *keys, uint32_t begin, uint32_t end, KeyT key) noexcept
+{
+    uint32_t i = begin;
+#ifdef __AVX2__
+    if constexpr (sizeof(KeyT) == 4) {
+        // Flip sign bit to get unsigned order with signed compare
+        const __m256i bias = _mm256_set1_epi32(std::is_signed_v<KeyT> ? 0 : INT32_MIN);
+        const __m256i needle = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int32_t>(key)), bias);
+        for (; i + 8 <= end; i += 8) {
+            __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)), bias);
+            __m256i cmp = upper ? _mm256_cmpgt_epi32(v, needle) : _mm256_cmpgt_epi32(needle, v);
+            uint32_t mask = _mm256_movemask_ps(_mm256_castsi256_ps(cmp));
+            if (upper ? (mask != 0) : (mask != 0xffu)) {
+                return i + (upper ? std::countr_zero(mask) : std::countr_one(mask));
+            }
+        }
+    } else {
+        const __m256i bias = _mm256_set1_epi64x(std::is_signed_v<KeyT> ? 0 : INT64_MIN);
+        const __m256i needle = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<int64_t>(key)), bias);
+        for (; i + 4 <= end; i += 4) {
+            __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)), bias);
+            __m256i cmp = upper ? _mm256_cmpgt_epi64(v, needle) : _mm256_cmpgt_epi64(needle, v);
+            uint32_t mask = _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+            if (upper ? (mask != 0) : (mask != 0xfu)) {
+                return i + (upper ? std::countr_zero(mask) : std::countr_one(mask));
+            }
+        }
+    }
+#endif
+    uint32_t pos = i;
+    for (; i < end; ++i) {
+        pos += upper ? (keys[i] <= key) : (keys[i] < key);
+    }
+    return pos;
+}
+
+template <typename KeyT>
+uint32_t
+lower_bound(const KeyT *keys, uint32_t begin, uint32_t end, KeyT key) noexcept
+{
+    return find_bound<false>(keys, begin, end, key);
+}
+
+template <typename KeyT>
+uint32_t
+upper_bound(const KeyT *keys, uint32_t begin, uint32_t end, KeyT key) noexcept
+{
+    return find_bound<true>(keys, begin, end, key);
+}
+
+}
+
+}
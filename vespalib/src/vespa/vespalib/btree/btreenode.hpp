@@ -3,6 +3,7 @@
 #pragma once
 
 #include "btreenode.h"
+#include "btree_key_search.h"
 #include <algorithm>
 #include <cassert>
 
@@ -44,6 +45,9 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 lower_bound(uint32_t sidx, const KeyT & key, CompareT comp) const noexcept
 {
+    if constexpr (use_simd_key_search<KeyT, CompareT>) {
+        return key_search::lower_bound(_keys, sidx, validSlots(), key);
+    }
     const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
         (_keys + sidx, _keys + validSlots(), key, comp);
     return itr - _keys;
@@ -54,6 +58,9 @@ template <typename CompareT>
 uint32_t
 BTreeNodeT<KeyT, NumSlots>::lower_bound(const KeyT & key, CompareT comp) const noexcept
 {
+    if constexpr (use_simd_key_search<KeyT, CompareT>) {
+        return key_search::lower_bound(_keys, 0u, validSlots(), key);
+    }
     const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
         (_keys, _keys + validSlots(), key, comp);
     return itr - _keys;
@@ -66,6 +73,9 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 upper_bound(uint32_t sidx, const KeyT & key, CompareT comp) const noexcept
 {
+    if constexpr (use_simd_key_search<KeyT, CompareT>) {
+        return key_search::upper_bound(_keys, sidx, validSlots(), key);
+    }
     const KeyT * itr = std::upper_bound<const KeyT *, KeyT, CompareT>
         (_keys + sidx, _keys + validSlots(), key, comp);
     return itr - _keys;
@@ -0,0 +1,148 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "cache_budget_manager.h"
+#include <algorithm>
+
+namespace vespalib {
+
+namespace {
+
+// A cache using less than this fraction of its capacity is not limited by its capacity.
+constexpr double full_ratio = 0.9;
+
+// Fraction of the capacity a client had when added that it always keeps, and that it can
+// move per rebalance.
+constexpr size_t min_share_divisor = 4;
+constexpr size_t max_step_divisor = 4;
+
+size_t
+delta(size_t now, size_t before) noexcept
+{
+    return (now > before) ? (now - before) : 0;
+}
+
+}
+
+CacheBudgetManager::CacheBudgetManager(size_t budget_bytes, size_t min_client_bytes)
+    : _lock(),
+      _budget_bytes(budget_bytes),
+      _min_client_bytes(min_client_bytes),
+      _clients()
+{
+}
+
+CacheBudgetManager::~CacheBudgetManager() = default;
+
+void
+CacheBudgetManager::add_client(Client& client)
+{
+    size_t initial_bytes = client.capacity_bytes();
+    size_t floor_bytes = std::max(initial_bytes / min_share_divisor, _min_client_bytes);
+    std::lock_guard guard(_lock);
+    _clients.emplace_back(client, client.get_stats(), floor_bytes, initial_bytes / max_step_divisor);
+}
+
+void
+CacheBudgetManager::remove_client(Client& client)
+{
+    std::lock_guard guard(_lock);
+    std::erase_if(_clients, [&client](const ClientState& state) noexcept { return state.client == &client; });
+}
+
+void
+CacheBudgetManager::set_budget_bytes(size_t budget_bytes)
+{
+    std::lock_guard guard(_lock);
+    _budget_bytes = budget_bytes;
+}
+
+size_t
+CacheBudgetManager::budget_bytes() const
+{
+    std::lock_guard guard(_lock);
+    return _budget_bytes;
+}
+
+size_t
+CacheBudgetManager::num_clients() const
+{
+    std::lock_guard guard(_lock);
+    return _clients.size();
+}
+
+void
+CacheBudgetManager::rebalance()
+{
+    std::lock_guard guard(_lock);
+    size_t num_clients = _clients.size();
+    if (num_clients == 0) {
+        return;
+    }
+    std::vector<size_t> capacity(num_clients);
+    std::vector<size_t> hits(num_clients);
+    std::vector<size_t> target(num_clients, 0);
+    std::vector<bool> full(num_clients);
+    size_t reserved = 0;
+    size_t total_full_hits = 0;
+    size_t num_full = 0;
+    for (size_t i = 0; i < num_clients; ++i) {
+        auto& state = _clients[i];
+        auto stats = state.client->get_stats();
+        capacity[i] = state.client->capacity_bytes();
+        hits[i] = delta(stats.hits, state.last_stats.hits);
+        state.last_stats = stats;
+        full[i] = (stats.memory_used >= capacity[i] * full_ratio);
+        if (full[i]) {
+            total_full_hits += hits[i];
+            ++num_full;
+            target[i] = state.floor_bytes;
+        } else {
+            // Leave some headroom for growth
+            target[i] = std::max(stats.memory_used + stats.memory_used / 8, state.floor_bytes);
+        }
+        reserved += target[i];
+    }
+    size_t remaining = (_budget_bytes > reserved) ? (_budget_bytes - reserved) : 0;
+    for (size_t i = 0; i < num_clients; ++i) {
+        double share;
+        if (num_full == 0) {
+            // Nobody is limited by capacity, spread the rest evenly.
+            share = 1.0 / num_clients;
+        } else if (!full[i]) {
+            continue;
+        } else if (total_full_hits == 0) {
+            share = 1.0 / num_full;
+        } else {
+            share = static_cast<double>(hits[i]) / total_full_hits;
+        }
+        target[i] += static_cast<size_t>(remaining * share);
+    }
+    // Move halfway towards the target capacity, limited by the max step of the client.
+    std::vector<size_t> next(num_clients);
+    size_t sum = 0;
+    size_t floor_sum = 0;
+    for (size_t i = 0; i < num_clients; ++i) {
+        const auto& state = _clients[i];
+        size_t lower = (capacity[i] > state.max_step_bytes) ? (capacity[i] - state.max_step_bytes) : 0;
+        size_t upper = capacity[i] + state.max_step_bytes;
+        next[i] = std::max(std::clamp(capacity[i] / 2 + target[i] / 2, lower, upper), state.floor_bytes);
+        sum += next[i];
+        floor_sum += state.floor_bytes;
+    }
+    // The budget is a hard limit, even if the clients then move more than their max step.
+    // Only capacity above the floor of each client is scaled down.
+    if (sum > _budget_bytes) {
+        double scale = (_budget_bytes > floor_sum) ? static_cast<double>(_budget_bytes - floor_sum) / (sum - floor_sum) : 0.0;
+        for (size_t i = 0; i < num_clients; ++i) {
+            size_t floor_bytes = _clients[i].floor_bytes;
+            next[i] = floor_bytes + static_cast<size_t>((next[i] - floor_bytes) * scale);
+        }
+    }
+    for (size_t i = 0; i < num_clients; ++i) {
+        if (next[i] != capacity[i]) {
+            _clients[i].client->set_capacity_bytes(next[i]);
+        }
+    }
+}
+
+}
@@ -0,0 +1,93 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "cache.h"
+#include "cache_stats.h"
+#include <mutex>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Distributes a shared memory budget between a set of caches.
+ *
+ * Each call to rebalance() looks at the cache stats of each client since the previous call.
+ * Caches that do not use most of their capacity only get what they use plus some headroom,
+ * while the remaining budget is given to the full caches, on top of their minimum, in
+ * proportion to the number of hits they had, as hits in a full cache is the best available
+ * estimate of the benefit of giving it more memory. Capacities are only moved part of the way towards their target for each
+ * call, and by at most a quarter of the capacity the client had when added, to avoid
+ * oscillation. No client gets less than a quarter of the capacity it had when added, or
+ * the configured minimum, so a single idle interval can not empty a cache.
+ */
+class CacheBudgetManager {
+public:
+    class Client {
+    public:
+        virtual ~Client() = default;
+        [[nodiscard]] virtual CacheStats get_stats() const = 0;
+        [[nodiscard]] virtual size_t capacity_bytes() const = 0;
+        virtual void set_capacity_bytes(size_t capacity_bytes) = 0;
+    };
+private:
+    struct ClientState {
+        Client*    client;
+        CacheStats last_stats;
+        size_t     floor_bytes;
+        size_t     max_step_bytes;
+        ClientState(Client& client_in, const CacheStats& stats, size_t floor_bytes_in, size_t max_step_bytes_in) noexcept
+            : client(&client_in),
+              last_stats(stats),
+              floor_bytes(floor_bytes_in),
+              max_step_bytes(max_step_bytes_in)
+        {}
+    };
+    mutable std::mutex       _lock;
+    size_t                   _budget_bytes;
+    size_t                   _min_client_bytes;
+    std::vector<ClientState> _clients;
+public:
+    CacheBudgetManager(size_t budget_bytes, size_t min_client_bytes);
+    ~CacheBudgetManager();
+    /**
+     * Adds a client, keeping its current capacity until the next rebalance. The client must
+     * be removed before it is destroyed.
+     */
+    void add_client(Client& client);
+    void remove_client(Client& client);
+    void set_budget_bytes(size_t budget_bytes);
+    [[nodiscard]] size_t budget_bytes() const;
+    [[nodiscard]] size_t num_clients() const;
+    void rebalance();
+};
+
+/**
+ * Adapts a cache or sharded cache to the budget manager client interface, keeping the
+ * ratio between the probationary and protected segment capacities when resizing.
+ */
+template <typename CacheT>
+class CacheBudgetClient : public CacheBudgetManager::Client {
+    CacheT& _cache;
+public:
+    explicit CacheBudgetClient(CacheT& cache) noexcept : _cache(cache) {}
+    ~CacheBudgetClient() override = default;
+    [[nodiscard]] CacheStats get_stats() const override { return _cache.get_stats(); }
+    [[nodiscard]] size_t capacity_bytes() const override { return _cache.capacityBytes(); }
+    void set_capacity_bytes(size_t capacity_bytes) override;
+};
+
+template <typename CacheT>
+void
+CacheBudgetClient<CacheT>::set_capacity_bytes(size_t capacity_bytes)
+{
+    size_t old_capacity = _cache.capacityBytes();
+    size_t old_protected = _cache.segment_capacity_bytes(CacheSegment::Protected);
+    if (old_protected == 0 || old_capacity == 0) {
+        _cache.setCapacityBytes(capacity_bytes);
+        return;
+    }
+    auto new_protected = static_cast<size_t>(static_cast<double>(capacity_bytes) * old_protected / old_capacity);
+    _cache.setCapacityBytes(capacity_bytes - new_protected, new_protected);
+}
+
+}
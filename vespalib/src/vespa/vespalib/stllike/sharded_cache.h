@@ -0,0 +1,92 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "cache.h"
+#include "cache_stats.h"
+#include <memory>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * A cache split into a number of independent shards, each being a @ref cache with its own
+ * lock, LRU/SLRU segments and optional LFU frequency sketch. The shard used for a key is
+ * selected by the hash of the key, so threads accessing different keys will mostly not
+ * contend for the same lock.
+ *
+ * The capacity (in bytes and elements) and the frequency sketch size are split evenly
+ * between the shards. Eviction decisions are made per shard, so the cache as a whole only
+ * approximates a single LRU/SLRU over all elements. This approximation gets worse with
+ * few elements per shard, so small caches should use few shards.
+ */
+template <typename P>
+class sharded_cache {
+protected:
+    using BackingStore = typename P::BackingStore;
+    using Hash         = typename P::Hash;
+    using K            = typename P::Key;
+    using V            = typename P::Value;
+private:
+    using Shard        = cache<P>;
+
+    [[no_unique_address]] Hash          _hasher;
+    uint32_t                            _shard_bits;
+    std::vector<std::unique_ptr<Shard>> _shards;
+
+    [[nodiscard]] Shard& shard(const K& key) const noexcept {
+        if (_shard_bits == 0) {
+            return *_shards[0];
+        }
+        // Mix the hash to avoid correlation with the bucket selection within each shard.
+        uint64_t h = static_cast<uint64_t>(_hasher(key)) * 0x9e3779b97f4a7c15ul;
+        return *_shards[h >> (64 - _shard_bits)];
+    }
+    [[nodiscard]] size_t per_shard(size_t value) const noexcept {
+        return (value == 0) ? 0 : std::max(value / _shards.size(), size_t(1));
+    }
+public:
+    using key_type = K;
+
+    /**
+     * Creates a cache with the given number of shards, rounded up to a power of 2.
+     * A protected capacity of 0 means that SLRU mode is not used.
+     */
+    sharded_cache(BackingStore& backing_store, size_t max_probationary_bytes, size_t max_protected_bytes, uint32_t num_shards);
+    sharded_cache(BackingStore& backing_store, size_t max_bytes, uint32_t num_shards);
+    ~sharded_cache();
+
+    sharded_cache& maxElements(size_t elems);
+    sharded_cache& maxElements(size_t probationary_elems, size_t protected_elems);
+    sharded_cache& setCapacityBytes(size_t sz);
+    sharded_cache& setCapacityBytes(size_t probationary_sz, size_t protected_sz);
+    void set_frequency_sketch_size(size_t cache_max_elem_count);
+
+    [[nodiscard]] uint32_t num_shards() const noexcept { return _shards.size(); }
+    [[nodiscard]] size_t capacity() const noexcept;
+    [[nodiscard]] size_t capacityBytes() const noexcept;
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] size_t sizeBytes() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+    [[nodiscard]] size_t segment_capacity_bytes(CacheSegment seg) const noexcept;
+    [[nodiscard]] MemoryUsage getStaticMemoryUsage() const;
+    /**
+     * Static memory used by the sharding itself with the given number of shards,
+     * i.e. in addition to the static memory usage of each shard.
+     */
+    [[nodiscard]] static constexpr size_t sharding_overhead_bytes(uint32_t num_shards) noexcept {
+        return sizeof(sharded_cache) + num_shards * sizeof(std::unique_ptr<Shard>);
+    }
+    [[nodiscard]] CacheStats get_stats() const;
+
+    // See the corresponding functions in cache.
+    void erase(const K& key) { shard(key).erase(key); }
+    void invalidate(const K& key) { shard(key).invalidate(key); }
+    template <typename... BackingStoreArgs>
+    [[nodiscard]] V read(const K& key, BackingStoreArgs&&... backing_store_args) {
+        return shard(key).read(key, std::forward<BackingStoreArgs>(backing_store_args)...);
+    }
+    void write(const K& key, V value) { shard(key).write(key, std::move(value)); }
+    [[nodiscard]] bool hasKey(const K& key) const { return shard(key).hasKey(key); }
+};
+
+}
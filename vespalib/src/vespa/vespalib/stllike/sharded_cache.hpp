@@ -0,0 +1,161 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "sharded_cache.h"
+#include "cache.hpp"
+#include <bit>
+
+namespace vespalib {
+
+template <typename P>
+sharded_cache<P>::sharded_cache(BackingStore& backing_store, size_t max_probationary_bytes,
+                                 size_t max_protected_bytes, uint32_t num_shards)
+    : _hasher(),
+      _shard_bits(std::bit_width(std::bit_ceil(std::max(num_shards, 1u))) - 1),
+      _shards()
+{
+    size_t shards = size_t(1) << _shard_bits;
+    _shards.reserve(shards);
+    for (size_t i = 0; i < shards; ++i) {
+        _shards.emplace_back(std::make_unique<Shard>(backing_store, per_shard(max_probationary_bytes),
+                                                     per_shard(max_protected_bytes)));
+    }
+}
+
+template <typename P>
+sharded_cache<P>::sharded_cache(BackingStore& backing_store, size_t max_bytes, uint32_t num_shards)
+    : sharded_cache(backing_store, max_bytes, 0, num_shards)
+{
+}
+
+template <typename P>
+sharded_cache<P>::~sharded_cache() = default;
+
+template <typename P>
+sharded_cache<P>&
+sharded_cache<P>::maxElements(size_t elems) {
+    for (auto& s : _shards) {
+        s->maxElements(per_shard(elems));
+    }
+    return *this;
+}
+
+template <typename P>
+sharded_cache<P>&
+sharded_cache<P>::maxElements(size_t probationary_elems, size_t protected_elems) {
+    for (auto& s : _shards) {
+        s->maxElements(per_shard(probationary_elems), per_shard(protected_elems));
+    }
+    return *this;
+}
+
+template <typename P>
+sharded_cache<P>&
+sharded_cache<P>::setCapacityBytes(size_t sz) {
+    for (auto& s : _shards) {
+        s->setCapacityBytes(per_shard(sz));
+    }
+    return *this;
+}
+
+template <typename P>
+sharded_cache<P>&
+sharded_cache<P>::setCapacityBytes(size_t probationary_sz, size_t protected_sz) {
+    for (auto& s : _shards) {
+        s->setCapacityBytes(per_shard(probationary_sz), per_shard(protected_sz));
+    }
+    return *this;
+}
+
+template <typename P>
+void
+sharded_cache<P>::set_frequency_sketch_size(size_t cache_max_elem_count) {
+    for (auto& s : _shards) {
+        s->set_frequency_sketch_size(per_shard(cache_max_elem_count));
+    }
+}
+
+template <typename P>
+size_t
+sharded_cache<P>::capacity() const noexcept {
+    size_t sum = 0;
+    for (const auto& s : _shards) {
+        sum += s->capacity();
+    }
+    return sum;
+}
+
+template <typename P>
+size_t
+sharded_cache<P>::capacityBytes() const noexcept {
+    size_t sum = 0;
+    for (const auto& s : _shards) {
+        sum += s->capacityBytes();
+    }
+    return sum;
+}
+
+template <typename P>
+size_t
+sharded_cache<P>::size() const noexcept {
+    size_t sum = 0;
+    for (const auto& s : _shards) {
+        sum += s->size();
+    }
+    return sum;
+}
+
+template <typename P>
+size_t
+sharded_cache<P>::sizeBytes() const noexcept {
+    size_t sum = 0;
+    for (const auto& s : _shards) {
+        sum += s->sizeBytes();
+    }
+    return sum;
+}
+
+template <typename P>
+bool
+sharded_cache<P>::empty() const noexcept {
+    for (const auto& s : _shards) {
+        if (!s->empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename P>
+size_t
+sharded_cache<P>::segment_capacity_bytes(CacheSegment seg) const noexcept {
+    size_t sum = 0;
+    for (const auto& s : _shards) {
+        sum += s->segment_capacity_bytes(seg);
+    }
+    return sum;
+}
+
+template <typename P>
+MemoryUsage
+sharded_cache<P>::getStaticMemoryUsage() const {
+    MemoryUsage usage;
+    usage.incAllocatedBytes(sizeof(*this) + _shards.capacity() * sizeof(_shards[0]));
+    usage.incUsedBytes(sharding_overhead_bytes(_shards.size()));
+    for (const auto& s : _shards) {
+        usage.merge(s->getStaticMemoryUsage());
+    }
+    return usage;
+}
+
+template <typename P>
+CacheStats
+sharded_cache<P>::get_stats() const {
+    CacheStats stats;
+    for (const auto& s : _shards) {
+        stats += s->get_stats();
+    }
+    return stats;
+}
+
+}
@@ -1,15 +1,47 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generationhandler.h"
+#include <algorithm>
 #include <cassert>
+#include <thread>
 
 namespace vespalib {
 
-GenerationHandler::GenerationHold::GenerationHold() noexcept
+namespace {
+
+/*
+ * Each generation hold allocates a cache line per reader slot beyond the
+ * first, so the number of slots is kept low. Reader threads beyond this
+ * share slots round-robin.
+ */
+constexpr uint32_t max_default_reader_slots = 16;
+
+std::atomic<uint32_t> next_reader_id(0);
+
+/*
+ * Reader threads are assigned ids round-robin when they first take a
+ * guard, spreading them evenly over the reader slots.
+ */
+uint32_t
+get_reader_id() noexcept
+{
+    thread_local uint32_t reader_id = next_reader_id.fetch_add(1, std::memory_order_relaxed);
+    return reader_id;
+}
+
+}
+
+GenerationHandler::GenerationHold::GenerationHold(uint32_t numReaderSlots)
     : _refCount(1),
+      _numReaderSlots(std::max(numReaderSlots, 1u)),
+      _readerSlots(),
       _generation(0),
       _next(0)
-{ }
+{
+    if (_numReaderSlots > 1) {
+        _readerSlots = std::make_unique<ReaderSlot[]>(_numReaderSlots - 1);
+    }
+}
 
 GenerationHandler::GenerationHold::~GenerationHold() {
     assert(getRefCount() == 0);
@@ -21,13 +53,35 @@ GenerationHandler::GenerationHold::setValid() noexcept {
     assert(!valid(old));
 }
 
+bool
+GenerationHandler::GenerationHold::readers_in_slots() noexcept {
+    for (uint32_t i = 0; i + 1 < _numReaderSlots; ++i) {
+        if (_readerSlots[i]._refCount.load(std::memory_order_seq_cst) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool
 GenerationHandler::GenerationHold::setInvalid() noexcept {
     uint32_t refs = 0;
     if (_refCount.compare_exchange_strong(refs, 1,
-                                          std::memory_order_acq_rel,
+                                          std::memory_order_seq_cst,
                                           std::memory_order_relaxed))
     {
+        /*
+         * Readers in other slots bump their own count before checking
+         * the invalid flag, and the writer sets the invalid flag before
+         * checking their counts. Thus either the reader observes the
+         * invalid flag or the writer observes the reader.
+         */
+        if (readers_in_slots()) {
+            auto old = _refCount.fetch_sub(1, std::memory_order_release);
+            (void) old;
+            assert(!valid(old));
+            return false;
+        }
         return true;
     } else {
         assert(valid(refs));
@@ -35,26 +89,58 @@ GenerationHandler::GenerationHold::setInvalid() noexcept {
     }
 }
 
+bool
+GenerationHandler::GenerationHold::acquire_slot(uint32_t slot) noexcept {
+    if (slot == 0) {
+        return valid(_refCount.fetch_add(2, std::memory_order_acq_rel));
+    }
+    _readerSlots[slot - 1]._refCount.fetch_add(1, std::memory_order_seq_cst);
+    return valid(_refCount.load(std::memory_order_seq_cst));
+}
+
 GenerationHandler::GenerationHold *
-GenerationHandler::GenerationHold::acquire() noexcept {
-    if (valid(_refCount.fetch_add(2, std::memory_order_acq_rel))) {
+GenerationHandler::GenerationHold::acquire(uint32_t slot) noexcept {
+    if (acquire_slot(slot)) {
         return this;
     } else {
-        release();
+        release(slot);
         return nullptr;
     }
 }
 
 GenerationHandler::GenerationHold *
-GenerationHandler::GenerationHold::copy(GenerationHold *self) noexcept {
+GenerationHandler::GenerationHold::copy(GenerationHold *self, uint32_t slot) noexcept {
     if (self == nullptr) {
         return nullptr;
-    } else {
+    } else if (slot == 0) {
         uint32_t oldRefCount = self->_refCount.fetch_add(2, std::memory_order_relaxed);
         (void) oldRefCount;
         assert(valid(oldRefCount));
         return self;
+    } else {
+        uint32_t oldRefCount = self->_readerSlots[slot - 1]._refCount.fetch_add(1, std::memory_order_relaxed);
+        (void) oldRefCount;
+        assert(oldRefCount != 0);
+        return self;
+    }
+}
+
+uint32_t
+GenerationHandler::GenerationHold::getRefCount() const noexcept {
+    uint32_t refs = _refCount.load(std::memory_order_relaxed) / 2;
+    for (uint32_t i = 0; i + 1 < _numReaderSlots; ++i) {
+        refs += _readerSlots[i]._refCount.load(std::memory_order_relaxed);
+    }
+    return refs;
+}
+
+uint32_t
+GenerationHandler::GenerationHold::getRefCountAcqRel() noexcept {
+    uint32_t refs = _refCount.fetch_add(0, std::memory_order_acq_rel) / 2;
+    for (uint32_t i = 0; i + 1 < _numReaderSlots; ++i) {
+        refs += _readerSlots[i]._refCount.fetch_add(0, std::memory_order_acq_rel);
     }
+    return refs;
 }
 
 GenerationHandler::Guard &
@@ -62,7 +148,8 @@ GenerationHandler::Guard::operator=(const Guard & rhs) noexcept
 {
     if (&rhs != this) {
         cleanup();
-        _hold = GenerationHold::copy(rhs._hold);
+        _hold = GenerationHold::copy(rhs._hold, rhs._slot);
+        _slot = rhs._slot;
     }
     return *this;
 }
@@ -73,6 +160,7 @@ GenerationHandler::Guard::operator=(Guard &&rhs) noexcept
     if (&rhs != this) {
         cleanup();
         _hold = rhs._hold;
+        _slot = rhs._slot;
         rhs._hold = nullptr;
     }
     return *this;
@@ -97,14 +185,20 @@ GenerationHandler::update_oldest_used_generation()
 }
 
 GenerationHandler::GenerationHandler()
+    : GenerationHandler(1u)
+{
+}
+
+GenerationHandler::GenerationHandler(uint32_t numReaderSlots)
     : _generation(0),
       _oldest_used_generation(0),
       _last(nullptr),
       _first(nullptr),
       _free(nullptr),
-      _numHolds(0u)
+      _numHolds(0u),
+      _numReaderSlots(std::max(numReaderSlots, 1u))
 {
-    _last = _first = new GenerationHold;
+    _last = _first = new GenerationHold(_numReaderSlots);
     ++_numHolds;
     _first->_generation.store(getCurrentGeneration(), std::memory_order_relaxed);
     _first->setValid();
@@ -124,10 +218,24 @@ GenerationHandler::~GenerationHandler(void)
     delete _first;
 }
 
+uint32_t
+GenerationHandler::default_num_reader_slots() noexcept
+{
+    uint32_t num_cpus = std::thread::hardware_concurrency();
+    return std::clamp(num_cpus, 1u, max_default_reader_slots);
+}
+
+uint32_t
+GenerationHandler::reader_slot() const noexcept
+{
+    return (_numReaderSlots > 1) ? (get_reader_id() % _numReaderSlots) : 0u;
+}
+
 GenerationHandler::Guard
 GenerationHandler::takeGuard() const
 {
-    Guard guard(_last.load(std::memory_order_acquire));
+    uint32_t slot = reader_slot();
+    Guard guard(_last.load(std::memory_order_acquire), slot);
     for (;;) {
         // Must check valid() after increasing refcount
         if (guard.valid())
@@ -136,7 +244,7 @@ GenerationHandler::takeGuard() const
          * Clashed with writer freeing entry.  Must abandon current
          * guard and try again.
          */
-        guard = Guard(_last.load(std::memory_order_acquire));
+        guard = Guard(_last.load(std::memory_order_acquire), slot);
     }
     // Guard has been valid after bumping refCount
     return guard;
@@ -158,7 +266,7 @@ GenerationHandler::incGeneration()
     }
     GenerationHold *nhold = nullptr;
     if (_free == nullptr) {
-        nhold = new GenerationHold;
+        nhold = new GenerationHold(_numReaderSlots);
         ++_numHolds;
     } else {
         nhold = _free;
@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <atomic>
+#include <memory>
 
 namespace vespalib {
 
@@ -12,6 +13,17 @@ namespace vespalib {
  * (changed by a single writer), and previous generations still
  * occupied by multiple readers.  Readers will take a generation guard
  * by calling takeGuard().
+ *
+ * By default all readers of a generation update a single reference
+ * count.  With many reader threads this cache line is bounced between
+ * cores on every takeGuard().  A handler can instead be created with
+ * multiple reader slots, where each reader thread updates the
+ * reference count in its own cache line.  This makes taking a guard
+ * cheaper for readers at the cost of the writer having to check all
+ * slots when freeing a generation.  Each generation hold then has one
+ * cache line per extra reader slot.  Holds are recycled through a free
+ * list, so this memory is only allocated when the number of generations
+ * held by readers at the same time grows.
  **/
 class GenerationHandler {
 public:
@@ -25,30 +37,45 @@ public:
      */
     class GenerationHold
     {
-        // least significant bit is invalid flag
+        // Reference count for reader slot > 0, in its own cache line.
+        struct alignas(64) ReaderSlot {
+            std::atomic<uint32_t> _refCount;
+            ReaderSlot() noexcept : _refCount(0) { }
+        };
+
+        // least significant bit is invalid flag, remaining bits is reference count for reader slot 0
         std::atomic<uint32_t> _refCount;
+        uint32_t                      _numReaderSlots;
+        std::unique_ptr<ReaderSlot[]> _readerSlots; // reader slots 1 .. _numReaderSlots - 1
 
         static bool valid(uint32_t refCount) noexcept { return (refCount & 1) == 0u; }
+        bool acquire_slot(uint32_t slot) noexcept;
+        bool readers_in_slots() noexcept;
     public:
         std::atomic<generation_t> _generation;
         GenerationHold *_next;	// next free element or next newer element.
 
-        GenerationHold() noexcept;
+        GenerationHold() noexcept : GenerationHold(1u) { }
+        explicit GenerationHold(uint32_t numReaderSlots);
         ~GenerationHold();
 
         void setValid() noexcept;
         bool setInvalid() noexcept;
-        void release() noexcept {
-            _refCount.fetch_sub(2, std::memory_order_release);
-        }
-        GenerationHold *acquire() noexcept;
-        static GenerationHold *copy(GenerationHold *self) noexcept;
-        uint32_t getRefCount() const noexcept {
-            return _refCount.load(std::memory_order_relaxed) / 2;
-        }
-        uint32_t getRefCountAcqRel() noexcept {
-            return _refCount.fetch_add(0, std::memory_order_acq_rel) / 2;
+        void release(uint32_t slot) noexcept {
+            if (slot == 0) {
+                _refCount.fetch_sub(2, std::memory_order_release);
+            } else {
+                _readerSlots[slot - 1]._refCount.fetch_sub(1, std::memory_order_release);
+            }
         }
+        void release() noexcept { release(0); }
+        GenerationHold *acquire(uint32_t slot) noexcept;
+        GenerationHold *acquire() noexcept { return acquire(0); }
+        static GenerationHold *copy(GenerationHold *self, uint32_t slot) noexcept;
+        static GenerationHold *copy(GenerationHold *self) noexcept { return copy(self, 0); }
+        uint32_t getNumReaderSlots() const noexcept { return _numReaderSlots; }
+        uint32_t getRefCount() const noexcept;
+        uint32_t getRefCountAcqRel() noexcept;
     };
 
     /**
@@ -57,19 +84,22 @@ public:
     class Guard {
     private:
         GenerationHold *_hold;
+        uint32_t        _slot;  // reader slot in _hold
         void cleanup() noexcept {
             if (_hold != nullptr) {
-                _hold->release();
+                _hold->release(_slot);
                 _hold = nullptr;
             }
         }
     public:
-        Guard() noexcept : _hold(nullptr) { }
-        Guard(GenerationHold *hold) noexcept : _hold(hold->acquire()) { } // hold is never nullptr
+        Guard() noexcept : _hold(nullptr), _slot(0) { }
+        Guard(GenerationHold *hold) noexcept : Guard(hold, 0) { } // hold is never nullptr
+        Guard(GenerationHold *hold, uint32_t slot) noexcept : _hold(hold->acquire(slot)), _slot(slot) { }
         ~Guard() { cleanup(); }
-        Guard(const Guard & rhs) noexcept : _hold(GenerationHold::copy(rhs._hold)) { }
+        Guard(const Guard & rhs) noexcept : _hold(GenerationHold::copy(rhs._hold, rhs._slot)), _slot(rhs._slot) { }
         Guard(Guard &&rhs) noexcept
-            : _hold(rhs._hold)
+            : _hold(rhs._hold),
+              _slot(rhs._slot)
         {
             rhs._hold = nullptr;
         }
@@ -89,16 +119,36 @@ private:
     GenerationHold               *_first;     // Points to "firstUsedGeneration" entry
     GenerationHold               *_free;      // List of free entries
     uint32_t                      _numHolds;  // Number of allocated generation hold entries
+    uint32_t                      _numReaderSlots;
 
     void set_generation(generation_t generation) noexcept { _generation.store(generation, std::memory_order_relaxed); }
+    uint32_t reader_slot() const noexcept;
 
 public:
     /**
-     * Creates a new generation handler.
+     * Creates a new generation handler where all readers share a
+     * single reference count per generation.
      **/
     GenerationHandler();
+
+    /**
+     * Creates a new generation handler with the given number of
+     * reader slots. Each reader thread is assigned one of the slots,
+     * and readers in different slots update different cache lines
+     * when taking and releasing guards.
+     **/
+    explicit GenerationHandler(uint32_t numReaderSlots);
     ~GenerationHandler();
 
+    /**
+     * Returns the number of reader slots suitable for this host, used
+     * for generation handlers with many concurrent readers. This is
+     * bounded to limit the memory used per generation hold.
+     **/
+    static uint32_t default_num_reader_slots() noexcept;
+
+    uint32_t getNumReaderSlots() const noexcept { return _numReaderSlots; }
+
     /**
      * Take a generation guard on the current generation.
      * Should be called by reader threads.